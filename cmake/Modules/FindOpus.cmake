@@ -0,0 +1,61 @@
+#
+# Try to find Opus libraries and include paths.
+# Once done this will define
+#
+# OPUS_FOUND
+# OPUS_INCLUDE_DIR
+# OPUS_LIBRARY
+# OPUSFILE_INCLUDE_DIR
+# OPUSFILE_LIBRARY
+#
+
+find_path(OPUS_INCLUDE_DIR opus.h PATH_SUFFIXES opus)
+find_path(OPUSFILE_INCLUDE_DIR opusfile.h PATH_SUFFIXES opus)
+find_path(OGG_INCLUDE_DIR ogg/ogg.h)
+
+find_library(OPUS_LIBRARY NAMES opus)
+find_library(OPUSFILE_LIBRARY NAMES opusfile)
+find_library(OGG_LIBRARY NAMES ogg)
+
+include(FindPackageHandleStandardArgs)
+
+find_package_handle_standard_args(Opus DEFAULT_MSG
+    OPUS_INCLUDE_DIR
+    OPUS_LIBRARY
+    OPUSFILE_INCLUDE_DIR
+    OPUSFILE_LIBRARY
+    OGG_INCLUDE_DIR
+    OGG_LIBRARY)
+mark_as_advanced(
+    OPUS_INCLUDE_DIR
+    OPUS_LIBRARY
+    OPUSFILE_INCLUDE_DIR
+    OPUSFILE_LIBRARY)
+
+if(NOT TARGET Ogg::ogg)
+    add_library(Ogg::ogg IMPORTED UNKNOWN)
+    set_target_properties(Ogg::ogg PROPERTIES INTERFACE_INCLUDE_DIRECTORIES ${OGG_INCLUDE_DIR})
+    if(OGG_LIBRARY MATCHES "/([^/]+)\\.framework$")
+        set_target_properties(Ogg::ogg PROPERTIES IMPORTED_LOCATION ${OGG_LIBRARY}/${CMAKE_MATCH_1})
+    else()
+        set_target_properties(Ogg::ogg PROPERTIES IMPORTED_LOCATION ${OGG_LIBRARY})
+    endif()
+endif()
+
+add_library(Opus::opus IMPORTED UNKNOWN)
+set_target_properties(Opus::opus PROPERTIES INTERFACE_INCLUDE_DIRECTORIES ${OPUS_INCLUDE_DIR})
+if(OPUS_LIBRARY MATCHES "/([^/]+)\\.framework$")
+    set_target_properties(Opus::opus PROPERTIES IMPORTED_LOCATION ${OPUS_LIBRARY}/${CMAKE_MATCH_1})
+else()
+    set_target_properties(Opus::opus PROPERTIES IMPORTED_LOCATION ${OPUS_LIBRARY})
+endif()
+
+add_library(Opus::opusfile IMPORTED UNKNOWN)
+set_target_properties(Opus::opusfile PROPERTIES
+    INTERFACE_INCLUDE_DIRECTORIES ${OPUSFILE_INCLUDE_DIR}
+    INTERFACE_LINK_LIBRARIES "Opus::opus;Ogg::ogg")
+if(OPUSFILE_LIBRARY MATCHES "/([^/]+)\\.framework$")
+    set_target_properties(Opus::opusfile PROPERTIES IMPORTED_LOCATION ${OPUSFILE_LIBRARY}/${CMAKE_MATCH_1})
+else()
+    set_target_properties(Opus::opusfile PROPERTIES IMPORTED_LOCATION ${OPUSFILE_LIBRARY})
+endif()
@@ -28,12 +28,17 @@
 // Headers
 ////////////////////////////////////////////////////////////
 
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/Music.hpp>
+#include <SFML/Audio/OpusDecoder.hpp>
+#include <SFML/Audio/OpusEncoder.hpp>
 #include <SFML/Audio/OutputSoundFile.hpp>
 #include <SFML/Audio/PlaybackDevice.hpp>
 #include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundAnalyzer.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Audio/SoundBufferRecorder.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
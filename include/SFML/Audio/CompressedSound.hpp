@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+
+#include <SFML/Audio/SoundStream.hpp>
+
+#include <memory>
+#include <optional>
+
+#include <cstdint>
+
+
+namespace sf
+{
+class CompressedSoundBuffer;
+class Time;
+
+////////////////////////////////////////////////////////////
+/// \brief Voice playing a compressed sound buffer, decoding it on the fly
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSound : public SoundStream
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound with a buffer
+    ///
+    /// \param buffer Compressed sound buffer containing the audio data to play
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompressedSound(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Disallow construction from a temporary sound buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompressedSound(CompressedSoundBuffer&& buffer) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedSound() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSound(CompressedSound&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSound& operator=(CompressedSound&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the audio buffer attached to the sound
+    ///
+    /// \return Compressed sound buffer attached to the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    const CompressedSoundBuffer& getBuffer() const;
+
+protected:
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// This function decodes the next samples of the buffer.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool onGetData(Chunk& data) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// \param timeOffset New playing position, from the beginning of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    void onSeek(Time timeOffset) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source to the beginning of the loop
+    ///
+    /// \return The seek position after looping (or std::nullopt if there's no loop)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<std::uint64_t> onLoop() override;
+
+private:
+    friend class CompressedSoundBuffer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Point the sound to its buffer after the buffer was moved
+    ///
+    /// \param buffer New location of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void rebindBuffer(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the sound and detach it from its buffer
+    ///
+    /// This function is called by the buffer when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachBuffer();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    struct Impl;
+    std::unique_ptr<Impl> m_impl; //!< Implementation details
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSound
+/// \ingroup audio
+///
+/// sf::CompressedSound plays a sf::CompressedSoundBuffer like
+/// sf::Sound plays a sf::SoundBuffer, except that the audio
+/// data is decoded while it is played. Each instance owns its
+/// own decoder and a buffer of a tenth of a second of decoded
+/// samples, so many instances can play the same buffer at
+/// different positions.
+///
+/// As a sound stream, it supports looping, seeking and all
+/// the spatialization parameters of sf::SoundSource.
+///
+/// The buffer must remain alive as long as it is used by the
+/// sound.
+///
+/// Usage example:
+/// \code
+/// const auto buffer = sf::CompressedSoundBuffer::loadFromFile("dialogue.ogg").value();
+/// sf::CompressedSound sound(buffer);
+/// sound.play();
+/// \endcode
+///
+/// \see sf::CompressedSoundBuffer, sf::Sound, sf::Music
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,312 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+
+#include <SFML/Audio/SoundChannel.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+class CompressedSound;
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Storage for an encoded audio file, decoded on the fly while played
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSoundBuffer
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The sounds using \a copy are not attached to the new buffer.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer(const CompressedSoundBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The sounds using \a right are attached to the new buffer
+    /// and keep playing from it.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer(CompressedSoundBuffer&& right) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The sounds still using the buffer are stopped and detached.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedSoundBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    /// Sounds decode the data of the buffer while playing, so
+    /// it must not be replaced while they still use it.
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer& operator=(const CompressedSoundBuffer&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer& operator=(CompressedSoundBuffer&&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file
+    ///
+    /// The encoded content of the file is kept in memory as is.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return Sound buffer if loading succeeded, `std::nullopt` if it failed
+    ///
+    /// \see loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<CompressedSoundBuffer> loadFromFile(const std::filesystem::path& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a file in memory
+    ///
+    /// The data is copied, the buffer can be deallocated right
+    /// after calling this function.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return Sound buffer if loading succeeded, `std::nullopt` if it failed
+    ///
+    /// \see loadFromFile, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<CompressedSoundBuffer> loadFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from a custom stream
+    ///
+    /// The whole stream is read and kept in memory.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Sound buffer if loading succeeded, `std::nullopt` if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<CompressedSoundBuffer> loadFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the encoded audio file data
+    ///
+    /// \return Read-only pointer to the encoded data
+    ///
+    /// \see getDataSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the encoded audio file data
+    ///
+    /// \return Size of the encoded data, in bytes
+    ///
+    /// \see getData
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDataSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples of the decoded sound
+    ///
+    /// \return Number of samples
+    ///
+    ////////////////////////////////////////////////////////////
+    std::uint64_t getSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the sound
+    ///
+    /// \return Sample rate (number of samples per second)
+    ///
+    /// \see getChannelCount, getChannelMap, getDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels used by the sound
+    ///
+    /// \return Number of channels
+    ///
+    /// \see getSampleRate, getChannelMap, getDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the map of position in sample frame to sound channel
+    ///
+    /// \return Map of position in sample frame to sound channel
+    ///
+    /// \see getSampleRate, getChannelCount, getDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<SoundChannel> getChannelMap() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total duration of the sound
+    ///
+    /// \return Sound duration
+    ///
+    /// \see getSampleRate, getChannelCount, getChannelMap
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getDuration() const;
+
+private:
+    friend class CompressedSound;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from encoded data
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompressedSoundBuffer(std::vector<std::byte>&& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Validate the encoded data and read the sound parameters
+    ///
+    /// \param data         Encoded audio file data
+    /// \param errorContext Description of the source, for error messages
+    ///
+    /// \return Sound buffer if the data could be decoded, `std::nullopt` otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<CompressedSoundBuffer> initialize(std::vector<std::byte>&& data,
+                                                                         const char*              errorContext);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sound to the list of sounds that use this buffer
+    ///
+    /// \param sound Sound instance to attach
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachSound(CompressedSound* sound) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sound from the list of sounds that use this buffer
+    ///
+    /// \param sound Sound instance to detach
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachSound(CompressedSound* sound) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    using SoundList = std::unordered_set<CompressedSound*>; //!< Set of unique sound instances
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::byte>    m_data;          //!< Encoded audio file data
+    std::uint64_t             m_sampleCount{}; //!< Number of samples of the decoded sound
+    unsigned int              m_sampleRate{};  //!< Number of samples per second
+    std::vector<SoundChannel> m_channelMap;    //!< The map of position in sample frame to sound channel
+    Time                      m_duration;      //!< Sound duration
+    mutable SoundList         m_sounds;        //!< List of sounds that are using this buffer
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSoundBuffer
+/// \ingroup audio
+///
+/// sf::SoundBuffer stores fully decoded samples, which takes
+/// around 10 times more memory than a compressed audio file.
+/// sf::CompressedSoundBuffer instead keeps the encoded file
+/// in memory, and each sf::CompressedSound playing it decodes
+/// it on the fly with its own small decoder state.
+///
+/// This is a trade-off between memory and CPU usage: it is
+/// well suited to long sounds that must be played by several
+/// voices at once (dialogue, ambiences), while short and very
+/// frequent sounds are better decoded once in a sf::SoundBuffer.
+///
+/// Destroying the buffer stops and detaches the
+/// sf::CompressedSound instances that use it, and moving it
+/// attaches them to the new buffer. It cannot be assigned:
+/// load a new buffer instead.
+///
+/// Usage example:
+/// \code
+/// // Load an ambience, keeping it compressed
+/// const auto buffer = sf::CompressedSoundBuffer::loadFromFile("wind.ogg").value();
+///
+/// // Play it from two voices, independently
+/// sf::CompressedSound left(buffer);
+/// sf::CompressedSound right(buffer);
+/// left.setPosition({-10, 0, 0});
+/// right.setPosition({10, 0, 0});
+/// left.play();
+/// right.setPlayingOffset(sf::seconds(5));
+/// right.play();
+/// \endcode
+///
+/// \see sf::CompressedSound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
@@ -55,7 +55,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file from the disk for reading
     ///
-    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC, MP3.
+    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC, MP3,
+    /// and OGG/Opus if SFML was built with the SFML_USE_OPUS option.
     /// The supported sample sizes for FLAC and WAV are 8, 16, 24 and 32 bit.
     ///
     /// Because of minimp3_ex limitation, for MP3 files with big (>16kb) APEv2 tag,
@@ -73,7 +74,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file in memory for reading
     ///
-    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC.
+    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC,
+    /// and OGG/Opus if SFML was built with the SFML_USE_OPUS option.
     /// The supported sample sizes for FLAC and WAV are 8, 16, 24 and 32 bit.
     ///
     /// \param data        Pointer to the file data in memory
@@ -87,7 +89,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file from a custom stream for reading
     ///
-    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC.
+    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC,
+    /// and OGG/Opus if SFML was built with the SFML_USE_OPUS option.
     /// The supported sample sizes for FLAC and WAV are 8, 16, 24 and 32 bit.
     ///
     /// \param stream Source stream to read from
@@ -31,6 +31,8 @@
 
 #include <SFML/Audio/SoundStream.hpp>
 
+#include <SFML/System/PrefetchInputStream.hpp>
+
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -149,6 +151,35 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] static std::optional<Music> openFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a music from an audio file in a slow custom stream
+    ///
+    /// The \a stream is read ahead asynchronously through a
+    /// sf::PrefetchInputStream keeping up to \a readAheadSize bytes
+    /// ready. While playing, audio is only decoded once enough
+    /// data is ready, otherwise silence is played and the music
+    /// reports that it is buffering, instead of stalling the audio
+    /// device while waiting for the stream.
+    ///
+    /// \a readAheadSize should be able to hold a few seconds of the
+    /// encoded audio file.
+    ///
+    /// \warning Since the music is not loaded at once but rather
+    /// streamed continuously, the \a stream must remain accessible
+    /// until the sf::Music object loads a new music or is destroyed.
+    /// It is accessed from a background thread and must not be used
+    /// directly meanwhile.
+    ///
+    /// \param stream        Source stream to read from
+    /// \param readAheadSize Maximum number of bytes read ahead of the decoder
+    ///
+    /// \return Music if loading succeeded, `std::nullopt` if it failed
+    ///
+    /// \see isBuffering, getReadAheadStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<Music> openFromStream(InputStream& stream, std::size_t readAheadSize);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the total duration of the music
     ///
@@ -196,6 +227,29 @@ public:
     ////////////////////////////////////////////////////////////
     void setLoopPoints(TimeSpan timePoints);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the music is waiting for its stream to read ahead
+    ///
+    /// This can only be the case for a music opened with a
+    /// read-ahead size.
+    ///
+    /// \return True if the last chunk of audio could not be decoded in time
+    ///
+    /// \see openFromStream, getReadAheadStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isBuffering() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buffering state and health of the read-ahead stream
+    ///
+    /// \return Statistics of the read-ahead stream, or `std::nullopt` if the music was not opened with a read-ahead size
+    ///
+    /// \see openFromStream, isBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<PrefetchInputStream::Statistics> getReadAheadStatistics() const;
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Request a new chunk of audio samples from the stream source
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+
+#include <memory>
+#include <optional>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Decode Opus packets into raw audio samples
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API OpusDecoder
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a decoder
+    ///
+    /// Opus can decode any packet at 8000, 12000, 16000, 24000
+    /// or 48000 Hz, with 1 or 2 channels, regardless of how it
+    /// was encoded.
+    ///
+    /// This function always fails if SFML was built without
+    /// Opus support (see the SFML_USE_OPUS CMake option).
+    ///
+    /// \param sampleRate   Sample rate of the decoded samples, in samples per second
+    /// \param channelCount Number of channels of the decoded samples
+    ///
+    /// \return Decoder if it was successfully created, otherwise `std::nullopt`
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<OpusDecoder> create(unsigned int sampleRate, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~OpusDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusDecoder(const OpusDecoder&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusDecoder& operator=(const OpusDecoder&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusDecoder(OpusDecoder&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusDecoder& operator=(OpusDecoder&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a packet into audio samples
+    ///
+    /// A packet holds at most 120 ms of audio, so a buffer of
+    /// sampleRate * 120 / 1000 frames is always large enough.
+    ///
+    /// If a packet was lost, pass a null \a packet to let the
+    /// decoder conceal the loss: \a maxFrameCount must then be
+    /// the exact duration of the missing packet.
+    ///
+    /// \param packet        Pointer to the packet to decode, or a null pointer for a lost packet
+    /// \param packetSize    Size of the packet, in bytes
+    /// \param samples       Pointer to the buffer receiving the interleaved samples
+    /// \param maxFrameCount Number of frames the sample buffer can hold
+    ///
+    /// \return Number of decoded frames, or `std::nullopt` if decoding failed
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<std::size_t> decode(const void*   packet,
+                                                    std::size_t   packetSize,
+                                                    std::int16_t* samples,
+                                                    std::size_t   maxFrameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the decoder
+    ///
+    /// \return Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the decoder
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned int getChannelCount() const;
+
+private:
+    struct Impl;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the decoder from its implementation
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit OpusDecoder(std::unique_ptr<Impl>&& impl);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<Impl> m_impl; //!< Implementation details
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OpusDecoder
+/// \ingroup audio
+///
+/// sf::OpusDecoder decompresses the packets produced by a
+/// sf::OpusEncoder (or any other Opus encoder) into raw
+/// 16-bit audio samples, ready to be played by a custom
+/// sf::SoundStream.
+///
+/// Packets must be decoded in the order they were encoded,
+/// each decoder keeps track of a single stream. Lost packets
+/// can be concealed by decoding a null packet in their place.
+///
+/// Opus is not bundled with SFML: this class is only functional
+/// if SFML was built with the SFML_USE_OPUS CMake option.
+///
+/// Usage example:
+/// \code
+/// auto decoder = sf::OpusDecoder::create(48000, 1).value();
+///
+/// // For each packet received from the network
+/// std::array<std::int16_t, 48000 * 120 / 1000> samples;
+/// if (const auto frameCount = decoder.decode(packet.getData(), packet.getDataSize(), samples.data(), samples.size()))
+/// {
+///     // Queue samples[0 .. *frameCount] in the sound stream
+/// }
+/// \endcode
+///
+/// \see sf::OpusEncoder, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
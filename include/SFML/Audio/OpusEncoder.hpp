@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+
+#include <memory>
+#include <optional>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Encode raw audio samples into Opus packets
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API OpusEncoder
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Kind of signal the encoder is tuned for
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class Application
+    {
+        Voip,    //!< Speech, favors intelligibility (best choice for voice chat)
+        Audio,   //!< Music and mixed content, favors faithfulness to the input
+        LowDelay //!< Lowest achievable latency, disables the speech optimized modes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Size of a buffer that can hold any packet produced by the encoder
+    ///
+    ////////////////////////////////////////////////////////////
+    static constexpr std::size_t MaxPacketSize{4000};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an encoder
+    ///
+    /// Opus only supports sample rates of 8000, 12000, 16000,
+    /// 24000 and 48000 Hz, with 1 or 2 channels.
+    ///
+    /// This function always fails if SFML was built without
+    /// Opus support (see the SFML_USE_OPUS CMake option).
+    ///
+    /// \param sampleRate   Sample rate of the samples to encode, in samples per second
+    /// \param channelCount Number of channels of the samples to encode
+    /// \param application  Kind of signal to tune the encoder for
+    ///
+    /// \return Encoder if it was successfully created, otherwise `std::nullopt`
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<OpusEncoder> create(unsigned int sampleRate,
+                                                           unsigned int channelCount,
+                                                           Application  application = Application::Voip);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~OpusEncoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusEncoder(const OpusEncoder&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusEncoder& operator=(const OpusEncoder&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusEncoder(OpusEncoder&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusEncoder& operator=(OpusEncoder&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the target bitrate of the encoder
+    ///
+    /// By default, the bitrate is chosen by the encoder
+    /// according to the sample rate and channel count.
+    /// Around 24000 bits per second is enough for good
+    /// quality wideband speech.
+    ///
+    /// \param bitsPerSecond Target bitrate, in bits per second (from 500 to 512000)
+    ///
+    /// \return True if the bitrate was accepted
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool setBitrate(std::int32_t bitsPerSecond);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a frame of audio samples into a packet
+    ///
+    /// Opus encodes frames of fixed durations: \a frameCount
+    /// must correspond to 2.5, 5, 10, 20, 40 or 60 ms at the
+    /// sample rate of the encoder (for example 960 frames at
+    /// 48000 Hz for 20 ms, the usual choice for voice chat).
+    ///
+    /// \param samples       Pointer to the interleaved samples to encode
+    /// \param frameCount    Number of frames to encode (a frame contains one sample per channel)
+    /// \param packet        Pointer to the buffer receiving the packet
+    /// \param maxPacketSize Size of the packet buffer, in bytes (MaxPacketSize is always enough)
+    ///
+    /// \return Size of the encoded packet in bytes, or `std::nullopt` if encoding failed
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<std::size_t> encode(const std::int16_t* samples,
+                                                    std::size_t         frameCount,
+                                                    void*               packet,
+                                                    std::size_t         maxPacketSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the encoder
+    ///
+    /// \return Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the encoder
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned int getChannelCount() const;
+
+private:
+    struct Impl;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the encoder from its implementation
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit OpusEncoder(std::unique_ptr<Impl>&& impl);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<Impl> m_impl; //!< Implementation details
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OpusEncoder
+/// \ingroup audio
+///
+/// sf::OpusEncoder compresses raw 16-bit audio samples into
+/// Opus packets, independently of any container. It is meant
+/// for real-time use, for example to send the samples captured
+/// by a sf::SoundRecorder over the network: at 20 ms per packet,
+/// speech typically needs between 16 and 32 kbps, about 20 to
+/// 40 times less than raw 16-bit PCM.
+///
+/// Packets must be decoded in order by a sf::OpusDecoder with
+/// the same sample rate and channel count. To store Opus audio
+/// in files, use sf::OutputSoundFile with the ".opus" extension
+/// instead.
+///
+/// Opus is not bundled with SFML: this class is only functional
+/// if SFML was built with the SFML_USE_OPUS CMake option.
+///
+/// Usage example:
+/// \code
+/// auto encoder = sf::OpusEncoder::create(48000, 1).value();
+///
+/// // In sf::SoundRecorder::onProcessSamples, with 960 samples (20 ms) at a time
+/// std::array<std::uint8_t, sf::OpusEncoder::MaxPacketSize> buffer;
+/// if (const auto size = encoder.encode(samples, 960, buffer.data(), buffer.size()))
+/// {
+///     sf::Packet packet;
+///     packet.append(buffer.data(), *size);
+///     socket.send(packet);
+/// }
+/// \endcode
+///
+/// \see sf::OpusDecoder, sf::SoundRecorder
+///
+////////////////////////////////////////////////////////////
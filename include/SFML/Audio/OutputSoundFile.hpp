@@ -52,7 +52,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open the sound file from the disk for writing
     ///
-    /// The supported audio formats are: WAV, OGG/Vorbis, FLAC.
+    /// The supported audio formats are: WAV, OGG/Vorbis, FLAC,
+    /// and OGG/Opus (".opus" extension) if SFML was built with
+    /// the SFML_USE_OPUS option.
     ///
     /// \param filename     Path of the sound file to write
     /// \param sampleRate   Sample rate of the sound
@@ -29,10 +29,21 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 
+#include <SFML/System/Time.hpp>
+
+#include <array>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+class SoundAnalyzer;
+} // namespace sf
 
 namespace sf::PlaybackDevice
 {
@@ -107,4 +118,87 @@ namespace sf::PlaybackDevice
 ////////////////////////////////////////////////////////////
 [[nodiscard]] SFML_AUDIO_API std::optional<std::string> getDevice();
 
+////////////////////////////////////////////////////////////
+/// \brief Set the analyzer fed with the final mix
+///
+/// The analyzer receives the mix of all playing sounds, as
+/// it is sent to the audio playback device. It keeps being
+/// fed when the audio playback device is switched.
+///
+/// The analyzer must stay alive as long as it is attached,
+/// and must not be attached to a sound at the same time.
+/// Replacing or detaching the analyzer waits until the
+/// audio thread is done with it, after which it can be
+/// safely destroyed.
+///
+/// \param analyzer The analyzer to attach, or a null pointer to detach the current one
+///
+/// \see SoundAnalyzer
+///
+////////////////////////////////////////////////////////////
+SFML_AUDIO_API void setAnalyzer(SoundAnalyzer* analyzer);
+
+////////////////////////////////////////////////////////////
+/// \brief Timing statistics of the audio thread
+///
+/// Every time the audio playback device needs more data, the
+/// audio thread mixes all the playing sounds. This is called
+/// a period. If mixing takes longer than the duration of the
+/// audio it produces, the period misses its deadline and the
+/// device will likely play a glitch.
+///
+////////////////////////////////////////////////////////////
+struct Statistics
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of buckets in the callback load histogram
+    ///
+    /// Bucket i counts the periods whose processing took between
+    /// i * 10% and (i + 1) * 10% of the period duration, the last
+    /// bucket counts the periods that missed their deadline.
+    ///
+    ////////////////////////////////////////////////////////////
+    static constexpr std::size_t HistogramSize{11};
+
+    std::uint64_t                            periodCount{};           //!< Number of periods processed
+    std::uint64_t                            deadlineMissCount{};     //!< Number of periods that took longer than their duration
+    std::uint64_t                            underrunCount{};         //!< Number of times a playing stream had no data ready
+    unsigned int                             activeVoiceCount{};      //!< Number of sounds mixed during the last period
+    Time                                     periodDuration;          //!< Duration of the audio produced by the last period
+    Time                                     lastCallbackDuration;    //!< Processing time of the last period
+    Time                                     maxCallbackDuration;     //!< Longest processing time of a period
+    std::array<std::uint64_t, HistogramSize> callbackLoadHistogram{}; //!< Distribution of the processing time relative to the period duration
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Get the timing statistics of the audio thread
+///
+/// The statistics are updated by the audio thread without
+/// any locking and can be read from any thread at any time.
+/// Since the values are read one by one while the audio
+/// thread keeps updating them, they may be off by a period
+/// relative to each other.
+///
+/// Statistics are kept when the audio playback device is
+/// switched.
+///
+/// \return Statistics accumulated since the program started or since the last call to resetStatistics
+///
+/// \see resetStatistics, sf::SoundSource::getStatistics
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] SFML_AUDIO_API Statistics getStatistics();
+
+////////////////////////////////////////////////////////////
+/// \brief Reset the timing statistics of the audio thread
+///
+/// Every field of the statistics is set back to zero,
+/// including the values describing the last period, until
+/// the audio thread processes the next one.
+///
+/// \see getStatistics
+///
+////////////////////////////////////////////////////////////
+SFML_AUDIO_API void resetStatistics();
+
 } // namespace sf::PlaybackDevice
@@ -173,6 +173,25 @@ public:
     ////////////////////////////////////////////////////////////
     void setEffectProcessor(EffectProcessor effectProcessor) override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the analyzer fed with the sound data
+    ///
+    /// The analyzer receives the sound data after the effect
+    /// processor, if any, and before spatialization and mixing.
+    /// It must stay alive as long as it is attached, and must
+    /// not be attached to more than one sound at a time.
+    ///
+    /// Replacing or detaching the analyzer waits until the
+    /// audio thread is done with it, after which it can be
+    /// safely destroyed.
+    ///
+    /// \param analyzer The analyzer to attach to this sound, or a null pointer to detach the current one
+    ///
+    /// \see SoundAnalyzer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAnalyzer(SoundAnalyzer* analyzer) override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the audio buffer attached to the sound
     ///
@@ -209,6 +228,14 @@ public:
     ////////////////////////////////////////////////////////////
     Status getStatus() const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the sound
+    ///
+    /// \return Statistics accumulated since the sound was created
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Real-time spectrum and loudness analysis of audio data
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundAnalyzer
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the latest analysis results
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::vector<float> spectrum;        //!< Magnitude of each frequency bin, bin i is centered on i * sampleRate / fftSize Hz
+        float              rms{};           //!< Root mean square level of the last analysis window, in [0, 1]
+        float              peak{};          //!< Peak absolute level of the last analysis window, in [0, 1]
+        float              loudness{-70.f}; //!< Momentary loudness (400 ms window) in LUFS, as defined by ITU-R BS.1770
+        unsigned int       sampleRate{};    //!< Sample rate of the analyzed data, in samples per second
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the analyzer
+    ///
+    /// The FFT size determines both the frequency resolution
+    /// of the spectrum and the length of the window over which
+    /// RMS and peak levels are computed. It is rounded up to
+    /// the next power of two and clamped to [64, 16384].
+    ///
+    /// \param fftSize Number of samples per analysis window
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundAnalyzer(std::size_t fftSize = 1024);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundAnalyzer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundAnalyzer(const SoundAnalyzer&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundAnalyzer& operator=(const SoundAnalyzer&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples per analysis window
+    ///
+    /// \return FFT size, the spectrum contains half as many bins
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFftSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Analyze a block of audio frames
+    ///
+    /// This function is called by the audio thread when the
+    /// analyzer is attached to a sound source or to the playback
+    /// device. It never blocks nor allocates memory, and can also
+    /// be called manually to analyze custom data (for example
+    /// from a sf::SoundRecorder).
+    ///
+    /// Only one thread may feed the analyzer at a time, which
+    /// means that an analyzer should only be attached to a
+    /// single sound source or to the playback device.
+    ///
+    /// \param frames       Interleaved floating point frames to analyze
+    /// \param frameCount   Number of frames
+    /// \param channelCount Number of channels per frame
+    /// \param sampleRate   Sample rate of the data, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(const float* frames, unsigned int frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the latest analysis results
+    ///
+    /// The results are published by the audio thread without
+    /// locking: this function never waits for the audio thread
+    /// and always returns a complete, consistent set of values.
+    ///
+    /// The returned reference stays valid and unchanged until
+    /// the next call to this function. Only one thread may read
+    /// the results at a time.
+    ///
+    /// \return Latest analysis results
+    ///
+    ////////////////////////////////////////////////////////////
+    const Result& getResult();
+
+private:
+    struct Impl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<Impl> m_impl; //!< Implementation details
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundAnalyzer
+/// \ingroup audio
+///
+/// sf::SoundAnalyzer computes the frequency spectrum, the
+/// RMS and peak levels and the momentary loudness of audio
+/// data on the audio thread, and makes the results available
+/// to any other thread without locking.
+///
+/// It can be attached to a single sound source (sf::Sound,
+/// sf::Music or any other sf::SoundStream) to analyze that
+/// source after its effect processor, or to the playback
+/// device to analyze the final mix.
+///
+/// The analyzer must outlive every attachment: detach it
+/// (by attaching a null pointer) before destroying it.
+///
+/// Usage example:
+/// \code
+/// sf::SoundAnalyzer analyzer(2048);
+/// music.setAnalyzer(&analyzer);
+/// music.play();
+///
+/// while (window.isOpen())
+/// {
+///     const sf::SoundAnalyzer::Result& result = analyzer.getResult();
+///
+///     // Draw result.spectrum, show result.loudness, ...
+/// }
+///
+/// music.setAnalyzer(nullptr);
+/// \endcode
+///
+/// \see sf::SoundSource, sf::PlaybackDevice::setAnalyzer
+///
+////////////////////////////////////////////////////////////
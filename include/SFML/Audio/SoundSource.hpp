@@ -32,13 +32,19 @@
 #include <SFML/Audio/AudioResource.hpp>
 
 #include <SFML/System/Angle.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/System/Vector3.hpp>
 
 #include <functional>
 
+#include <cstddef>
+#include <cstdint>
+
 
 namespace sf
 {
+class SoundAnalyzer;
+
 // NOLINTBEGIN(readability-make-member-function-const)
 ////////////////////////////////////////////////////////////
 /// \brief Base class defining a sound's properties
@@ -76,6 +82,37 @@ public:
         float outerGain{}; //!< Outer gain
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining the spatial state of a sound source
+    ///
+    /// Used to update the position, velocity and direction
+    /// of many sound sources at once with setSpatialStates.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SpatialState
+    {
+        SoundSource* source{};            //!< Sound source to update
+        Vector3f     position;            //!< New position of the source
+        Vector3f     velocity;            //!< New velocity of the source
+        Vector3f     direction{0, 0, -1}; //!< New direction of the source
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Timing statistics of a sound source
+    ///
+    /// The processing time covers everything done on the audio
+    /// thread on behalf of the source: reading or decoding its
+    /// data (including sf::SoundStream::onGetData), its effect
+    /// processor and its analyzer.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Time          processingTime;    //!< Total time spent processing the source on the audio thread
+        Time          maxProcessingTime; //!< Longest time spent processing a single block of the source
+        std::uint64_t underrunCount{};   //!< Number of times the source had no data ready while still playing
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Callable that is provided with sound data for processing
     ///
@@ -424,6 +461,25 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setEffectProcessor(EffectProcessor effectProcessor);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the analyzer fed with the sound data
+    ///
+    /// The analyzer receives the sound data after the effect
+    /// processor, if any, and before spatialization and mixing.
+    /// It must stay alive as long as it is attached, and must
+    /// not be attached to more than one sound at a time.
+    ///
+    /// Replacing or detaching the analyzer waits until the
+    /// audio thread is done with it, after which it can be
+    /// safely destroyed.
+    ///
+    /// \param analyzer The analyzer to attach to this sound, or a null pointer to detach the current one
+    ///
+    /// \see SoundAnalyzer
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setAnalyzer(SoundAnalyzer* analyzer);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the pitch of the sound
     ///
@@ -638,6 +694,46 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Status getStatus() const = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the sound
+    ///
+    /// The statistics are updated by the audio thread without
+    /// any locking and can be read from any thread at any time.
+    ///
+    /// \return Statistics accumulated since the sound was created
+    ///
+    /// \see sf::PlaybackDevice::getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the spatial state of many sound sources at once
+    ///
+    /// Calling setPosition, setVelocity and setDirection on
+    /// each source applies every value individually, which means
+    /// that the audio thread may mix a period in which only part
+    /// of the new values are visible.
+    ///
+    /// This function instead submits the whole batch to the audio
+    /// engine, which applies it in one go right before mixing the
+    /// next audio period. Either all of the states are taken into
+    /// account for a given period or none of them are.
+    ///
+    /// Consequently, the getters (getPosition, etc.) keep returning
+    /// the previous values until the next audio period has started.
+    /// If a batch is submitted before the previous one has been
+    /// applied, only the latest state of each source is kept and
+    /// applied in the next audio period.
+    ///
+    /// \param states Pointer to the array of states to apply
+    /// \param count  Number of states in the array
+    ///
+    /// \see setPosition, setVelocity, setDirection
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSpatialStates(const SpatialState* states, std::size_t count);
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
@@ -673,6 +769,20 @@ private:
 /// volume, position, attenuation, etc. All of them can be
 /// changed at any time with no impact on performances.
 ///
+/// When many sources move every frame, their position,
+/// velocity and direction can be submitted in a single batch
+/// with setSpatialStates, which guarantees that the audio
+/// engine never mixes a half-updated scene.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::SoundSource::SpatialState> states;
+/// for (Emitter& emitter : emitters)
+///     states.push_back({&emitter.sound, emitter.position, emitter.velocity, emitter.direction});
+///
+/// sf::SoundSource::setSpatialStates(states.data(), states.size());
+/// \endcode
+///
 /// \see sf::Sound, sf::SoundStream
 ///
 ////////////////////////////////////////////////////////////
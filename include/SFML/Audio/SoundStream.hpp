@@ -156,6 +156,14 @@ public:
     ////////////////////////////////////////////////////////////
     Status getStatus() const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the stream
+    ///
+    /// \return Statistics accumulated since the stream was created
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const override;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current playing position of the stream
     ///
@@ -217,6 +225,25 @@ public:
     ////////////////////////////////////////////////////////////
     void setEffectProcessor(EffectProcessor effectProcessor) override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the analyzer fed with the sound data
+    ///
+    /// The analyzer receives the sound data after the effect
+    /// processor, if any, and before spatialization and mixing.
+    /// It must stay alive as long as it is attached, and must
+    /// not be attached to more than one sound at a time.
+    ///
+    /// Replacing or detaching the analyzer waits until the
+    /// audio thread is done with it, after which it can be
+    /// safely destroyed.
+    ///
+    /// \param analyzer The analyzer to attach to this sound, or a null pointer to detach the current one
+    ///
+    /// \see SoundAnalyzer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAnalyzer(SoundAnalyzer* analyzer) override;
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
@@ -251,9 +278,10 @@ protected:
     /// streaming loop, in a separate thread.
     /// The source can choose to stop the streaming loop at any time, by
     /// returning false to the caller.
-    /// If you return true (i.e. continue streaming) it is important that
-    /// the returned array of samples is not empty; this would stop the stream
-    /// due to an internal limitation.
+    /// If you return true (i.e. continue streaming) with an empty array
+    /// of samples, silence is played until the next request and the
+    /// period is counted as an underrun. This lets a source that is
+    /// still waiting for its data avoid blocking the audio thread.
     ///
     /// \param data Chunk of data to fill
     ///
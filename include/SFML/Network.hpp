@@ -28,15 +28,23 @@
 // Headers
 ////////////////////////////////////////////////////////////
 
+#include <SFML/Network/BitPacket.hpp>
+#include <SFML/Network/EventLoop.hpp>
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/HttpServer.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Resolver.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 #include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpListener.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsContext.hpp>
+#include <SFML/Network/TlsSocket.hpp>
+#include <SFML/Network/UdpConnection.hpp>
 #include <SFML/Network/UdpSocket.hpp>
 
 #include <SFML/System.hpp>
@@ -0,0 +1,336 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/Packet.hpp>
+
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet serializing values with bit granularity,
+///        optionally delta-encoded against a baseline
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API BitPacket : public Packet
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the lowest bits of a value
+    ///
+    /// \param value    Value to append, its bits above \a bitCount are ignored
+    /// \param bitCount Number of bits to append, between 0 and 64
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readBits
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeBits(std::uint64_t value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a boolean as a single bit
+    ///
+    /// \param value Value to append
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readBool
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeBool(bool value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an integer known to lie in a range
+    ///
+    /// The value takes just enough bits to represent every
+    /// integer between \a min and \a max. Values outside the
+    /// range are clamped.
+    ///
+    /// \param value Value to append
+    /// \param min   Smallest possible value
+    /// \param max   Largest possible value
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readInteger
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeInteger(std::int64_t value, std::int64_t min, std::int64_t max);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a floating point number quantized to a given precision
+    ///
+    /// The value is clamped to [\a min, \a max] and rounded to
+    /// the nearest multiple of \a precision above \a min, which
+    /// is then written like a ranged integer. For example a
+    /// coordinate in [-1000, 1000] with a precision of 0.01 takes
+    /// 18 bits instead of 32.
+    ///
+    /// \param value     Value to append
+    /// \param min       Smallest possible value
+    /// \param max       Largest possible value
+    /// \param precision Quantization step, must be positive
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readFloat
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& writeFloat(float value, float min, float max, float precision);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pad the data with zero bits up to the next byte boundary
+    ///
+    /// \return Reference to the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& alignToByte();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract bits written by writeBits
+    ///
+    /// If not enough bits are left, the packet becomes invalid
+    /// and \a value is left unchanged.
+    ///
+    /// \param value    Variable to fill
+    /// \param bitCount Number of bits to extract, between 0 and 64
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeBits
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readBits(std::uint64_t& value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract a boolean written by writeBool
+    ///
+    /// \param value Variable to fill
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeBool
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readBool(bool& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract an integer written by writeInteger
+    ///
+    /// \a min and \a max must be the same as when writing.
+    ///
+    /// \param value Variable to fill
+    /// \param min   Smallest possible value
+    /// \param max   Largest possible value
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeInteger
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readInteger(std::int64_t& value, std::int64_t min, std::int64_t max);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract a floating point number written by writeFloat
+    ///
+    /// \a min, \a max and \a precision must be the same as when
+    /// writing.
+    ///
+    /// \param value     Variable to fill
+    /// \param min       Smallest possible value
+    /// \param max       Largest possible value
+    /// \param precision Quantization step, must be positive
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeFloat
+    ///
+    ////////////////////////////////////////////////////////////
+    BitPacket& readFloat(float& value, float min, float max, float precision);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bits written to the packet
+    ///
+    /// \return Size of the data, in bits
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getBitSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bits left to read
+    ///
+    /// \return Number of bits after the current reading position
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getRemainingBits() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the data of another packet as the baseline for delta encoding
+    ///
+    /// Once a baseline is set, the packet is sent as its
+    /// difference with the baseline, which is very small when
+    /// both packets are laid out the same way and most values
+    /// didn't change. The receiving packet must be given the
+    /// same baseline before receiving, otherwise it becomes
+    /// invalid. Packets larger than 16 MiB are always sent
+    /// without delta encoding.
+    /// The data of \a baseline is copied, so it can be modified
+    /// or destroyed afterwards.
+    ///
+    /// \param baseline Packet to compute the difference with
+    ///
+    /// \see clearBaseline
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBaseline(const BitPacket& baseline);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop delta encoding the packet
+    ///
+    /// \see setBaseline
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearBaseline();
+
+protected:
+    ////////////////////////////////////////////////////////////
+    /// \brief Produce the bytes to send, delta-encoded if a baseline is set
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* onSend(std::size_t& size) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the received bytes, using the baseline if they are delta-encoded
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void onReceive(const void* data, std::size_t size) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the bit cursors when the packet is cleared
+    ///
+    /// The baseline is kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void onClear() override;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the written bits, including the incomplete last bytes
+    ///
+    /// \param bytes Vector to append the bytes to
+    ///
+    ////////////////////////////////////////////////////////////
+    void copyBytes(std::vector<std::byte>& bytes) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::uint64_t          m_pendingBits{};     //!< Written bits not appended to the packet data yet
+    unsigned int           m_pendingBitCount{}; //!< Number of bits in m_pendingBits (less than 32)
+    std::size_t            m_readBit{};         //!< Current reading position, in bits
+    bool                   m_hasBaseline{};     //!< Whether the packet is delta-encoded
+    std::vector<std::byte> m_baseline;          //!< Bytes of the baseline packet
+    std::vector<std::byte> m_sendBuffer;        //!< Bytes produced by onSend
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BitPacket
+/// \ingroup network
+///
+/// sf::Packet writes every value with its full width, which
+/// wastes bandwidth when replicating game state: a flag takes
+/// a byte, a health value between 0 and 100 takes 4 bytes, and
+/// a position is sent with more precision than needed.
+///
+/// sf::BitPacket writes values with just the bits they need:
+/// booleans take one bit, integers take the bits of their
+/// range, and floating point numbers are quantized to a chosen
+/// precision. The bits are packed in order, starting with the
+/// least significant bit of each byte.
+///
+/// Successive snapshots of the same state are usually almost
+/// identical. Setting a baseline, such as the last snapshot
+/// acknowledged by the receiver, sends only the bytes that
+/// differ from it. Both ends must use the same baseline; how
+/// they agree on it (for example with a sequence number sent
+/// in a separate packet or a header) is up to the application.
+///
+/// sf::BitPacket derives from sf::Packet and can be sent with
+/// any socket. Its bit-level functions don't use the byte
+/// oriented operators of sf::Packet, and the two shouldn't be
+/// mixed in the same packet.
+///
+/// Usage example:
+/// \code
+/// // Sender
+/// sf::BitPacket packet;
+/// packet.setBaseline(lastAcknowledgedSnapshot);
+/// for (const Player& player : players)
+/// {
+///     packet.writeInteger(player.health, 0, 100);
+///     packet.writeFloat(player.x, -1000.f, 1000.f, 0.01f);
+///     packet.writeFloat(player.y, -1000.f, 1000.f, 0.01f);
+///     packet.writeBool(player.isJumping);
+/// }
+/// socket.send(packet, address, port);
+///
+/// // Receiver
+/// sf::BitPacket packet;
+/// packet.setBaseline(lastAcknowledgedSnapshot);
+/// socket.receive(packet, address, port);
+/// for (Player& player : players)
+/// {
+///     std::int64_t health = 0;
+///     packet.readInteger(health, 0, 100);
+///     packet.readFloat(player.x, -1000.f, 1000.f, 0.01f);
+///     packet.readFloat(player.y, -1000.f, 1000.f, 0.01f);
+///     packet.readBool(player.isJumping);
+/// }
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include <cstddef>
+
+
+namespace sf
+{
+class Packet;
+class TcpListener;
+class TcpSocket;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Event loop completing socket operations asynchronously
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API EventLoop
+{
+public:
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    // Completion of accept, connect and packet operations
+    using Handler = std::function<void(Socket::Status)>;
+
+    // Completion of raw sends and receives, with the number of bytes transferred
+    using SizeHandler = std::function<void(Socket::Status, std::size_t)>;
+
+    // Completion of datagram receives, with the number of bytes received and the sender
+    using DatagramHandler = std::function<void(Socket::Status, std::size_t, std::optional<IpAddress>, unsigned short)>;
+
+    // Function posted to the loop
+    using Task = std::function<void()>;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the event loop
+    ///
+    /// With \a threadCount set to 0, completion handlers run
+    /// on the thread that calls run or runOnce. Otherwise they
+    /// run on a pool of \a threadCount threads owned by the
+    /// loop, while run only waits for the sockets and performs
+    /// the I/O. Handlers may then run concurrently, on different
+    /// sockets or for the two directions of a same socket.
+    ///
+    /// \param threadCount Number of threads running the completion handlers
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit EventLoop(std::size_t threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Handlers that were already handed to the thread pool
+    /// are run, pending operations are abandoned without
+    /// calling their handler.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~EventLoop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    EventLoop(const EventLoop&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept a new connection asynchronously
+    ///
+    /// \param listener Listener to accept the connection from
+    /// \param socket   Socket that will hold the new connection
+    /// \param handler  Function called with the status of the operation
+    ///
+    /// \see TcpListener::accept
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncAccept(TcpListener& listener, TcpSocket& socket, Handler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect a TCP socket to a remote peer asynchronously
+    ///
+    /// \param socket        Socket to connect
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    /// \param handler       Function called with the status of the operation
+    ///
+    /// \see TcpSocket::connect
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncConnect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, Handler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data through a TCP socket asynchronously
+    ///
+    /// The handler is called once all the data was sent, or on
+    /// error. The data must stay valid until then.
+    ///
+    /// \param socket  Socket to send the data through
+    /// \param data    Pointer to the sequence of bytes to send
+    /// \param size    Number of bytes to send
+    /// \param handler Function called with the status and the number of bytes sent
+    ///
+    /// \see TcpSocket::send
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncSend(TcpSocket& socket, const void* data, std::size_t size, SizeHandler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a packet through a TCP socket asynchronously
+    ///
+    /// The packet must stay alive, and must not be modified,
+    /// until the handler is called.
+    ///
+    /// \param socket  Socket to send the packet through
+    /// \param packet  Packet to send
+    /// \param handler Function called with the status of the operation
+    ///
+    /// \see TcpSocket::send
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncSend(TcpSocket& socket, Packet& packet, Handler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data from a TCP socket asynchronously
+    ///
+    /// Like TcpSocket::receive, the operation completes as soon
+    /// as some data is received, possibly less than \a size bytes.
+    /// The buffer must stay valid until the handler is called.
+    ///
+    /// \param socket  Socket to receive the data from
+    /// \param data    Pointer to the array to fill with the received bytes
+    /// \param size    Maximum number of bytes that can be received
+    /// \param handler Function called with the status and the number of bytes received
+    ///
+    /// \see TcpSocket::receive
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncReceive(TcpSocket& socket, void* data, std::size_t size, SizeHandler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a packet from a TCP socket asynchronously
+    ///
+    /// The handler is called once the whole packet was received.
+    /// The packet must stay alive until then.
+    ///
+    /// \param socket  Socket to receive the packet from
+    /// \param packet  Packet to fill with the received data
+    /// \param handler Function called with the status of the operation
+    ///
+    /// \see TcpSocket::receive
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncReceive(TcpSocket& socket, Packet& packet, Handler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a datagram through a UDP socket asynchronously
+    ///
+    /// The data must stay valid until the handler is called.
+    ///
+    /// \param socket        Socket to send the datagram through
+    /// \param data          Pointer to the sequence of bytes to send
+    /// \param size          Number of bytes to send
+    /// \param remoteAddress Address of the receiver
+    /// \param remotePort    Port of the receiver to send the data to
+    /// \param handler       Function called with the status of the operation
+    ///
+    /// \see UdpSocket::send
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncSend(UdpSocket&       socket,
+                   const void*      data,
+                   std::size_t      size,
+                   const IpAddress& remoteAddress,
+                   unsigned short   remotePort,
+                   Handler          handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a datagram from a UDP socket asynchronously
+    ///
+    /// The buffer must stay valid until the handler is called.
+    ///
+    /// \param socket  Socket to receive the datagram from
+    /// \param data    Pointer to the array to fill with the received bytes
+    /// \param size    Maximum number of bytes that can be received
+    /// \param handler Function called with the status, the number of bytes received and the sender
+    ///
+    /// \see UdpSocket::receive
+    ///
+    ////////////////////////////////////////////////////////////
+    void asyncReceive(UdpSocket& socket, void* data, std::size_t size, DatagramHandler handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a function on the loop
+    ///
+    /// The task runs like a completion handler: on the thread
+    /// pool if there is one, on the thread calling run otherwise.
+    ///
+    /// \param task Function to run
+    ///
+    ////////////////////////////////////////////////////////////
+    void post(Task task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the pending operations of a socket
+    ///
+    /// The handlers of the cancelled operations are called
+    /// with sf::Socket::Status::Error. A socket must not be
+    /// destroyed while it has pending operations: cancel them
+    /// first, and wait for their handlers.
+    ///
+    /// \param socket Socket whose operations to cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the loop until there is no more work, or until stopped
+    ///
+    /// Work is any pending operation, posted task or handler
+    /// that hasn't returned yet. Handlers usually start new
+    /// operations, so this typically runs until stop is called.
+    ///
+    /// \return Number of handlers that were run or handed to the thread pool
+    ///
+    /// \see runOnce, stop
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Perform a single iteration of the loop
+    ///
+    /// This waits until at least one operation completes, or
+    /// until \a timeout is elapsed. Like SocketSelector::wait,
+    /// a timeout of Time::Zero waits forever. This is the
+    /// function to call from an existing loop, such as the
+    /// main loop of a game.
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Number of handlers that were run or handed to the thread pool
+    ///
+    /// \see run
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t runOnce(Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make run return as soon as possible
+    ///
+    /// This function can be called from any thread, including
+    /// from a handler. Pending operations are kept and resume
+    /// on the next call to run or runOnce.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+private:
+    struct EventLoopImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<EventLoopImpl> m_impl; //!< Opaque pointer to the implementation
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::EventLoop
+/// \ingroup network
+///
+/// sf::EventLoop lets a single thread serve a large number
+/// of sockets without polling each of them: an operation is
+/// started with one of the async functions, and its handler
+/// is called when it completes. Handlers usually start the
+/// next operation, for example another receive.
+///
+/// The loop waits for the sockets with the same mechanism as
+/// sf::SocketSelector (epoll on Linux, kqueue on macOS and
+/// BSD, WSAPoll on Windows), so the cost of a wait depends on
+/// the number of active sockets rather than on the total
+/// number of sockets. The sockets are switched to non-blocking
+/// mode when an operation is started on them.
+///
+/// At most one receive-like operation (accept, receive) and
+/// one send-like operation (connect, send) can be pending on a
+/// socket at any time; starting another one completes it
+/// immediately with an error.
+///
+/// The async functions, post, cancel and stop can be called
+/// from any thread. run and runOnce must only be called by one
+/// thread at a time.
+///
+/// Usage example:
+/// \code
+/// // Echo server
+/// sf::EventLoop   loop(4);
+/// sf::TcpListener listener;
+/// if (listener.listen(55001) != sf::Socket::Status::Done)
+/// {
+///     // error...
+/// }
+///
+/// struct Client
+/// {
+///     sf::TcpSocket        socket;
+///     std::array<char, 256> buffer;
+/// };
+/// std::list<Client> clients;
+///
+/// std::function<void(Client&)> echo = [&](Client& client)
+/// {
+///     loop.asyncReceive(client.socket, client.buffer.data(), client.buffer.size(),
+///         [&](sf::Socket::Status status, std::size_t received)
+///         {
+///             if (status != sf::Socket::Status::Done)
+///                 return; // the client left
+///
+///             loop.asyncSend(client.socket, client.buffer.data(), received,
+///                 [&](sf::Socket::Status, std::size_t) { echo(client); });
+///         });
+/// };
+///
+/// std::function<void()> accept = [&]
+/// {
+///     Client& client = clients.emplace_back();
+///     loop.asyncAccept(listener, client.socket,
+///         [&](sf::Socket::Status status)
+///         {
+///             if (status == sf::Socket::Status::Done)
+///                 echo(client);
+///             accept();
+///         });
+/// };
+///
+/// accept();
+/// loop.run();
+/// \endcode
+///
+/// \see sf::SocketSelector, sf::TcpSocket, sf::UdpSocket
+///
+////////////////////////////////////////////////////////////
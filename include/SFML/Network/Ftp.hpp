@@ -34,9 +34,13 @@
 #include <SFML/System/Time.hpp>
 
 #include <filesystem>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <cstdint>
+
 
 namespace sf
 {
@@ -60,6 +64,26 @@ public:
         Ebcdic  //!< Text mode using EBCDIC encoding
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a file transfer, reported while it runs
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TransferProgress
+    {
+        std::uint64_t position{};       //!< Number of bytes of the file transferred, including resumed ones
+        std::uint64_t size{};           //!< Size of the whole file, or 0 if the server didn't report it
+        Time          elapsed;          //!< Time since the start of the transfer
+        double        bytesPerSecond{}; //!< Average throughput since the start of the transfer
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called while a file is transferred
+    ///
+    /// Return false to abort the transfer.
+    ///
+    ////////////////////////////////////////////////////////////
+    using ProgressCallback = std::function<bool(const TransferProgress& progress)>;
+
     ////////////////////////////////////////////////////////////
     /// \brief Define a FTP response
     ///
@@ -292,6 +316,25 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Response connect(const IpAddress& server, unsigned short port = 21, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect to the specified FTP server, given its host name
+    ///
+    /// The name is resolved by the default sf::Resolver, so that
+    /// it is taken from its cache when connecting again. If it
+    /// has several addresses, they are tried as described in
+    /// TcpSocket::connect.
+    ///
+    /// \param host    Network name of the FTP server to connect to
+    /// \param port    Port used for the connection
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server response to the request
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Response connect(std::string_view host, unsigned short port = 21, Time timeout = Time::Zero);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the connection with the server
     ///
@@ -466,11 +509,17 @@ public:
     /// of your application.
     /// If a file with the same filename as the distant file
     /// already exists in the local destination path, it will
-    /// be overwritten.
+    /// be overwritten, unless \a resume is true: the download
+    /// then continues after the bytes of the local file, if the
+    /// server supports it (REST command).
+    /// If the download fails, the partial local file is deleted,
+    /// unless \a resume is true so that it can be continued later.
     ///
     /// \param remoteFile Filename of the distant file to download
     /// \param localPath  The directory in which to put the file on the local computer
     /// \param mode       Transfer mode
+    /// \param resume     Pass true to continue a previous partial download
+    /// \param onProgress Function called regularly during the transfer
     ///
     /// \return Server response to the request
     ///
@@ -479,7 +528,9 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Response download(const std::filesystem::path& remoteFile,
                                     const std::filesystem::path& localPath,
-                                    TransferMode                 mode = TransferMode::Binary);
+                                    TransferMode                 mode       = TransferMode::Binary,
+                                    bool                         resume     = false,
+                                    const ProgressCallback&      onProgress = {});
 
     ////////////////////////////////////////////////////////////
     /// \brief Upload a file to the server
@@ -491,11 +542,16 @@ public:
     ///
     /// The append parameter controls whether the remote file is
     /// appended to or overwritten if it already exists.
+    /// With \a resume set to true, the bytes already present in
+    /// the remote file are skipped (SIZE and REST commands) and
+    /// \a append is ignored.
     ///
     /// \param localFile  Path of the local file to upload
     /// \param remotePath The directory in which to put the file on the server
     /// \param mode       Transfer mode
     /// \param append     Pass true to append to or false to overwrite the remote file if it already exists
+    /// \param resume     Pass true to continue a previous partial upload
+    /// \param onProgress Function called regularly during the transfer
     ///
     /// \return Server response to the request
     ///
@@ -504,8 +560,10 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Response upload(const std::filesystem::path& localFile,
                                   const std::filesystem::path& remotePath,
-                                  TransferMode                 mode   = TransferMode::Binary,
-                                  bool                         append = false);
+                                  TransferMode                 mode       = TransferMode::Binary,
+                                  bool                         append     = false,
+                                  bool                         resume     = false,
+                                  const ProgressCallback&      onProgress = {});
 
     ////////////////////////////////////////////////////////////
     /// \brief Send a command to the FTP server
@@ -537,6 +595,16 @@ private:
     ////////////////////////////////////////////////////////////
     Response getResponse();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a file on the server
+    ///
+    /// \param remoteFile Filename of the distant file
+    ///
+    /// \return Size of the file, or 0 if the server can't tell it
+    ///
+    ////////////////////////////////////////////////////////////
+    std::uint64_t getRemoteFileSize(const std::filesystem::path& remoteFile);
+
     ////////////////////////////////////////////////////////////
     /// \brief Utility class for exchanging data with the server
     ///        on the data channel
@@ -585,7 +653,18 @@ private:
 /// All commands, especially upload and download, may take some
 /// time to complete. This is important to know if you don't want
 /// to block your application while the server is completing
-/// the task.
+/// the task. A progress callback can be passed to upload and
+/// download to follow a transfer, or abort it.
+///
+/// File data goes straight between the file and the socket:
+/// uploads use the system's zero-copy file transmission where
+/// it is available (see sf::TcpSocket::sendFile), and downloads
+/// are received in large blocks written directly to the file.
+/// Interrupted transfers can be resumed.
+///
+/// A FTP connection performs one transfer at a time. To run
+/// several transfers concurrently, use one sf::Ftp instance per
+/// transfer, each on its own thread: instances share no state.
 ///
 /// Usage example:
 /// \code
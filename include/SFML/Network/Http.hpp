@@ -29,15 +29,22 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 
-#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsContext.hpp>
 
 #include <SFML/System/Time.hpp>
 
+#include <atomic>
+#include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
+
+#include <cstddef>
 
 
 namespace sf
@@ -335,11 +342,20 @@ public:
         std::string  m_body;                             //!< Body of the response
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function receiving the body of a response as it arrives
+    ///
+    /// It is called with consecutive parts of the body, and
+    /// returns false to abort the transfer.
+    ///
+    ////////////////////////////////////////////////////////////
+    using BodyCallback = std::function<bool(const void* data, std::size_t size)>;
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
     ////////////////////////////////////////////////////////////
-    Http() = default;
+    Http();
 
     ////////////////////////////////////////////////////////////
     /// \brief Construct the HTTP client with the target host
@@ -347,9 +363,9 @@ public:
     /// This is equivalent to calling setHost(host, port).
     /// The port has a default value of 0, which means that the
     /// HTTP client will use the right port according to the
-    /// protocol used (80 for HTTP). You should leave it like
-    /// this unless you really need a port other than the
-    /// standard one, or use an unknown protocol.
+    /// protocol used (80 for HTTP, 443 for HTTPS). You should
+    /// leave it like this unless you really need a port other
+    /// than the standard one, or use an unknown protocol.
     ///
     /// \param host Web server to connect to
     /// \param port Port to use for connection
@@ -357,6 +373,14 @@ public:
     ////////////////////////////////////////////////////////////
     Http(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the connections kept open to the host.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Http();
+
     ////////////////////////////////////////////////////////////
     /// \brief Deleted copy constructor
     ///
@@ -376,9 +400,14 @@ public:
     /// doesn't actually connect to it until you send a request.
     /// The port has a default value of 0, which means that the
     /// HTTP client will use the right port according to the
-    /// protocol used (80 for HTTP). You should leave it like
-    /// this unless you really need a port other than the
-    /// standard one, or use an unknown protocol.
+    /// protocol used (80 for HTTP, 443 for HTTPS). You should
+    /// leave it like this unless you really need a port other
+    /// than the standard one, or use an unknown protocol.
+    /// Hosts starting with "https://" are reached over TLS,
+    /// which requires SFML to be built with SFML_USE_OPENSSL.
+    /// The host name is resolved in the background by the default
+    /// sf::Resolver, which keeps it in its cache for later requests.
+    /// The connections kept open to the previous host are closed.
     ///
     /// \param host Web server to connect to
     /// \param port Port to use for connection
@@ -386,6 +415,23 @@ public:
     ////////////////////////////////////////////////////////////
     void setHost(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the TLS context used to connect to HTTPS hosts
+    ///
+    /// By default, the certificate of the server is verified
+    /// against the certificate authorities trusted by the system.
+    /// Use this function to trust other certificates, or to
+    /// share the session cache with other connections. It must
+    /// be a client context.
+    /// The connections kept open to the host are closed.
+    ///
+    /// \param context TLS context of the connections
+    ///
+    /// \see setHost
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTlsContext(const TlsContext& context);
+
     ////////////////////////////////////////////////////////////
     /// \brief Send a HTTP request and return the server's response.
     ///
@@ -397,6 +443,10 @@ public:
     /// application, or use a timeout to limit the time to wait. A value
     /// of Time::Zero means that the client will use the system default timeout
     /// (which is usually pretty long).
+    /// If a connection kept open by a previous request was
+    /// closed by the server in the meantime, GET and HEAD
+    /// requests are sent again on a new connection; other
+    /// requests fail, since the server may have handled them.
     ///
     /// \param request Request to send
     /// \param timeout Maximum time to wait
@@ -406,14 +456,105 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and stream the body of the response
+    ///
+    /// This works like the other overload, except that the
+    /// body is passed to \a onBody as it is received instead
+    /// of being stored in the response, so large downloads
+    /// don't need to fit in memory. Chunked bodies are decoded
+    /// before being passed to the callback.
+    ///
+    /// \param request Request to send
+    /// \param onBody  Function receiving the body of the response
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, with an empty body
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Response sendRequest(const Request& request, const BodyCallback& onBody, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several HTTP requests on a single connection
+    ///
+    /// The requests are written ahead of the responses
+    /// (pipelining), which saves a round trip per request.
+    /// A bounded number of requests is kept in flight, so
+    /// that large batches don't fill the socket buffers.
+    /// If the server closes the connection before answering
+    /// all of them, the remaining requests are sent again on a
+    /// new connection. When the connection fails instead, the
+    /// requests that were written but not answered are only
+    /// sent again if they are GET or HEAD requests, since the
+    /// server may have handled them; otherwise their responses
+    /// and the following ones are left empty.
+    ///
+    /// \param requests Requests to send
+    /// \param timeout  Maximum time to wait for a connection
+    ///
+    /// \return Server's responses, in the order of the requests
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::vector<Response> sendRequests(const std::vector<Request>& requests, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of idle connections kept open
+    ///
+    /// Connections are reused by the next requests instead of
+    /// paying for a new TCP handshake each time. Concurrent
+    /// requests each use their own connection; when they are
+    /// over, up to \a count connections are kept for later.
+    /// Setting it to 0 disables persistent connections: the
+    /// requests then ask the server to close the connection.
+    /// The default is 8.
+    ///
+    /// \param count Maximum number of idle connections
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxIdleConnections(std::size_t count);
+
 private:
+    struct Connection;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request
+    ///
+    /// \param request Request to complete
+    ///
+    /// \return Request ready to be sent
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Request completeRequest(const Request& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take an idle connection, or connect a new one
+    ///
+    /// \param timeout Maximum time to wait for a new connection
+    /// \param reused  Set to true if the connection was idle
+    ///
+    /// \return Connection to the host, or a null pointer on error
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::unique_ptr<Connection> acquireConnection(Time timeout, bool& reused);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep a connection for later requests
+    ///
+    /// \param connection Connection that finished its last response
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseConnection(std::unique_ptr<Connection> connection);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket                m_connection; //!< Connection to the host
-    std::optional<IpAddress> m_host;       //!< Web host address
-    std::string              m_hostName;   //!< Web host name
-    unsigned short           m_port{};     //!< Port used for connection with host
+    std::string                              m_hostName;              //!< Web host name
+    unsigned short                           m_port{};                //!< Port used for connection with host
+    bool                                     m_secure{};              //!< Is the host reached over TLS?
+    std::optional<TlsContext>                m_tlsContext;            //!< TLS context of the HTTPS connections
+    std::mutex                               m_mutex;                 //!< Protects the connections and TLS context
+    std::vector<std::unique_ptr<Connection>> m_idleConnections;       //!< Connections kept open for later requests
+    std::atomic<std::size_t>                 m_maxIdleConnections{8}; //!< Maximum number of idle connections
 };
 
 } // namespace sf
@@ -427,7 +568,8 @@ private:
 /// to communicate with a web server. You can retrieve
 /// web pages, send data to an interactive resource,
 /// download a remote file, etc. The HTTPS protocol is
-/// not supported.
+/// supported when SFML is built with SFML_USE_OPENSSL
+/// (see sf::TlsSocket).
 ///
 /// The HTTP client is split into 3 classes:
 /// \li sf::Http::Request
@@ -451,6 +593,14 @@ private:
 /// sf::Http::Request and return the corresponding sf::Http::Response
 /// from the server.
 ///
+/// Connections are persistent: after a response, the connection
+/// is kept open (unless the server closes it) and reused by the
+/// next request, which avoids a TCP handshake per request.
+/// sendRequest can be called from several threads at once, each
+/// request then gets its own connection. Several requests can
+/// also be pipelined on one connection with sendRequests, and
+/// large bodies can be streamed instead of stored in memory.
+///
 /// Usage example:
 /// \code
 /// // Create a new HTTP client
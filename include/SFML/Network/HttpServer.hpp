@@ -0,0 +1,319 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/Http.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Lightweight HTTP server, for tooling and metrics endpoints
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API HttpServer
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Request received by the server
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Request
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the value of a field
+        ///
+        /// If the field \a field is not found in the request header,
+        /// the empty string is returned. This function uses
+        /// case-insensitive comparisons.
+        ///
+        /// \param field Name of the field to get
+        ///
+        /// \return Value of the field, or empty string if not found
+        ///
+        ////////////////////////////////////////////////////////////
+        [[nodiscard]] const std::string& getField(const std::string& field) const;
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Http::Request::Method              method{Http::Request::Method::Get}; //!< Method of the request
+        std::string                        uri;                                //!< Decoded path of the resource
+        std::string                        query;                              //!< Query string, after the '?'
+        unsigned int                       majorVersion{1};                    //!< Major HTTP version
+        unsigned int                       minorVersion{1};                    //!< Minor HTTP version
+        std::map<std::string, std::string> fields;                             //!< Header fields, with lowercase names
+        std::string                        body;                               //!< Body, unless passed to a handler
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Response to send back to the client
+    ///
+    /// The Content-Length and Connection fields are added by the
+    /// server. When \a file is set, the file is sent as the body
+    /// and \a body is ignored.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Response
+    {
+        Http::Response::Status             status{Http::Response::Status::Ok}; //!< Status code
+        std::map<std::string, std::string> fields;                             //!< Header fields
+        std::string                        body;                               //!< Body
+        std::filesystem::path              file;                               //!< File sent as the body, if not empty
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    // Called once a request was received entirely, to fill its response
+    using Handler = std::function<void(const Request& request, Response& response)>;
+
+    // Called with each block of the body of a request as it arrives; return false to reject the request
+    using BodyHandler = std::function<bool(const Request& request, const void* data, std::size_t size)>;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    HttpServer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the listening socket and all the connections.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~HttpServer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    HttpServer(const HttpServer&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start listening for connections
+    ///
+    /// \param port    Port to listen on, or Socket::AnyPort to let the system pick one
+    /// \param address Address of the interface to listen on
+    ///
+    /// \return Status code
+    ///
+    /// \see close, getLocalPort
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status listen(unsigned short port, const IpAddress& address = IpAddress::Any);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port the server is listening on
+    ///
+    /// \return Port the server listens on, or 0 if it isn't listening
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned short getLocalPort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop listening and close all the connections
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a handler for requests to a path
+    ///
+    /// A path ending with '/' matches every path that starts
+    /// with it, other paths must match exactly. When several
+    /// routes match, the longest path wins. HEAD requests are
+    /// handled by the GET route if there is no HEAD route, and
+    /// their response body is dropped.
+    ///
+    /// Without a body handler, the body of the request is
+    /// stored in Request::body, up to the maximum body size.
+    /// With one, the body is passed to it as it arrives and
+    /// its size is not limited.
+    ///
+    /// \param method  Method of the requests to handle
+    /// \param path    Path of the requests to handle
+    /// \param handler Function filling the response
+    /// \param onBody  Function receiving the body of the requests
+    ///
+    /// \see addStaticFiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void addRoute(Http::Request::Method method, const std::string& path, Handler handler, BodyHandler onBody = {});
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Serve the files of a directory
+    ///
+    /// GET requests to \a path + "name" are answered with the
+    /// file \a directory / "name", which is sent with the
+    /// socket's zero-copy file transmission when available.
+    /// Requests for a directory are answered with its
+    /// index.html file. Paths escaping \a directory are
+    /// rejected.
+    ///
+    /// \param path      Path prefix of the files, ending with '/'
+    /// \param directory Directory containing the files
+    ///
+    /// \see addRoute
+    ///
+    ////////////////////////////////////////////////////////////
+    void addStaticFiles(const std::string& path, const std::filesystem::path& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the largest request body stored in Request::body
+    ///
+    /// Larger requests are answered with status 413 and their
+    /// connection is closed. The default is 1 MiB.
+    ///
+    /// \param size Maximum size of a body, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxBodySize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time after which inactive connections are closed
+    ///
+    /// The default is 30 seconds. Time::Zero keeps connections
+    /// open until the client closes them.
+    ///
+    /// \param timeout Maximum inactivity of a connection
+    ///
+    ////////////////////////////////////////////////////////////
+    void setIdleTimeout(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of open connections
+    ///
+    /// \return Number of connections with clients
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getConnectionCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept connections and process requests
+    ///
+    /// This waits until at least one socket is ready, or until
+    /// \a timeout is elapsed, then does all the work that can
+    /// be done without blocking: handlers are called on the
+    /// calling thread. Like SocketSelector::wait, a timeout of
+    /// Time::Zero waits forever.
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Number of requests that were handled
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t update(Time timeout = Time::Zero);
+
+private:
+    struct HttpServerImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<HttpServerImpl> m_impl; //!< Opaque pointer to the implementation
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::HttpServer
+/// \ingroup network
+///
+/// sf::HttpServer answers HTTP/1.1 requests on a TCP port,
+/// which makes it easy to expose debugging, metrics or
+/// administration endpoints from a game server, or to serve
+/// files to local tools. It is not meant to face the public
+/// internet: there is no HTTPS support.
+///
+/// All the sockets are non-blocking and observed with an
+/// sf::SocketSelector, so a single call to update serves all
+/// the clients; it can be called from the main loop of an
+/// application, or from a dedicated thread. Requests are
+/// parsed as their bytes arrive, connections are kept alive
+/// between requests, and pipelined requests are answered in
+/// order. A client that stops reading its responses is not
+/// read from until they are sent.
+///
+/// Request bodies are only buffered when the route has no
+/// body handler, and up to a maximum size. Chunked request
+/// bodies are not supported and are answered with status 501.
+///
+/// Usage example:
+/// \code
+/// sf::HttpServer server;
+/// if (server.listen(8080, sf::IpAddress::LocalHost) != sf::Socket::Status::Done)
+/// {
+///     // error...
+/// }
+///
+/// server.addRoute(sf::Http::Request::Method::Get, "/metrics",
+///     [&](const sf::HttpServer::Request&, sf::HttpServer::Response& response)
+///     {
+///         response.fields["Content-Type"] = "text/plain";
+///         response.body = "players " + std::to_string(playerCount) + "\n";
+///     });
+///
+/// server.addStaticFiles("/replays/", "replays");
+///
+/// while (running)
+/// {
+///     server.update(sf::milliseconds(10));
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::Http, sf::SocketSelector
+///
+////////////////////////////////////////////////////////////
@@ -31,10 +31,12 @@
 
 #include <SFML/System/Time.hpp>
 
+#include <array>
 #include <iosfwd>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <cstdint>
 
@@ -42,25 +44,62 @@
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-/// \brief Encapsulate an IPv4 network address
+/// \brief Encapsulate an IPv4 or IPv6 network address
 ///
 ////////////////////////////////////////////////////////////
 class SFML_NETWORK_API IpAddress
 {
 public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Version of the Internet Protocol of an address
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class Type
+    {
+        IpV4, //!< 32-bits IPv4 address
+        IpV6  //!< 128-bits IPv6 address
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct the address from a null-terminated string view
     ///
-    /// Here \a address can be either a decimal address
-    /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// Here \a address can be either a decimal IPv4 address
+    /// (ex: "192.168.1.56"), an IPv6 address (ex: "2001:db8::1",
+    /// optionally enclosed in brackets) or a network name
+    /// (ex: "localhost").
+    ///
+    /// A network name may have both IPv4 and IPv6 addresses:
+    /// the first IPv4 address is preferred, so that hosts only
+    /// reachable over IPv6 still resolve. Use resolveAll to get
+    /// all of them.
     ///
     /// \param address IP address or network name
     ///
     /// \return Address if provided argument was valid, otherwise `std::nullopt`
     ///
+    /// \see resolveAll
+    ///
     ////////////////////////////////////////////////////////////
     [[nodiscard]] static std::optional<IpAddress> resolve(std::string_view address);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the addresses of a network name
+    ///
+    /// The addresses of both IPv4 and IPv6 are returned, in the
+    /// order of preference of the system. When a network name is
+    /// looked up, only the families that the computer has a
+    /// configured address for are included. Numeric addresses
+    /// are always converted, whatever their version.
+    ///
+    /// \param address IP address or network name
+    ///
+    /// \return Addresses of the name, empty if it could not be resolved
+    ///
+    /// \see resolve
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::vector<IpAddress> resolveAll(std::string_view address);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct the address from 4 bytes
     ///
@@ -91,12 +130,34 @@ public:
     ////////////////////////////////////////////////////////////
     explicit IpAddress(std::uint32_t address);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IPv6 address from its 16 bytes
+    ///
+    /// IPv4-mapped addresses (::ffff:a.b.c.d) are converted
+    /// to the IPv4 address they contain.
+    ///
+    /// \param bytes Bytes of the address, in network order
+    ///
+    /// \see toBytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IpAddress(const std::array<std::uint8_t, 16>& bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the version of the Internet Protocol of the address
+    ///
+    /// \return Type of the address
+    ///
+    ////////////////////////////////////////////////////////////
+    Type getType() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a string representation of the address
     ///
-    /// The returned string is the decimal representation of the
-    /// IP address (like "192.168.1.56"), even if it was constructed
-    /// from a host name.
+    /// The returned string is the decimal representation of an
+    /// IPv4 address (like "192.168.1.56") or the hexadecimal
+    /// representation of an IPv6 address (like "2001:db8::1"),
+    /// even if it was constructed from a host name.
     ///
     /// \return String representation of the address
     ///
@@ -114,13 +175,31 @@ public:
     /// The integer produced by this function can then be converted
     /// back to a sf::IpAddress with the proper constructor.
     ///
-    /// \return 32-bits unsigned integer representation of the address
+    /// IPv6 addresses don't fit in an integer: use toBytes for them.
+    ///
+    /// \return 32-bits unsigned integer representation of the address,
+    ///         or 0 if it is an IPv6 address
     ///
-    /// \see toString
+    /// \see toString, toBytes
     ///
     ////////////////////////////////////////////////////////////
     std::uint32_t toInteger() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bytes of the address, as an IPv6 address
+    ///
+    /// IPv4 addresses are returned in their IPv4-mapped form
+    /// (::ffff:a.b.c.d). The bytes produced by this function can
+    /// be converted back to a sf::IpAddress with the proper
+    /// constructor.
+    ///
+    /// \return 16 bytes of the address, in network order
+    ///
+    /// \see toInteger
+    ///
+    ////////////////////////////////////////////////////////////
+    std::array<std::uint8_t, 16> toBytes() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the computer's local address
     ///
@@ -168,6 +247,9 @@ public:
     static const IpAddress Any;       //!< Value representing any address (0.0.0.0)
     static const IpAddress LocalHost; //!< The "localhost" address (for connecting a computer to itself locally)
     static const IpAddress Broadcast; //!< The "broadcast" address (for sending UDP messages to everyone on a local network)
+
+    static const IpAddress AnyV6;       //!< Value representing any IPv6 address (::), also accepting IPv4 when listening
+    static const IpAddress LocalHostV6; //!< The IPv6 "localhost" address (::1)
     // NOLINTEND(readability-identifier-naming)
 
 private:
@@ -176,7 +258,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::uint32_t m_address; //!< Address stored as an unsigned 32 bits integer
+    std::uint32_t                m_address{};        //!< IPv4 address stored as an unsigned 32 bits integer
+    std::array<std::uint8_t, 16> m_addressV6{};      //!< IPv6 address bytes, in network order
+    Type                         m_type{Type::IpV4}; //!< Version of the address
 };
 
 ////////////////////////////////////////////////////////////
@@ -289,9 +373,12 @@ SFML_NETWORK_API std::ostream& operator<<(std::ostream& stream, const IpAddress&
 /// auto a7 = sf::IpAddress::resolve("www.google.com"); // a distant address created from a network name
 /// auto a8 = sf::IpAddress::getLocalAddress();         // my address on the local network
 /// auto a9 = sf::IpAddress::getPublicAddress();        // my address on the internet
+/// auto b1 = sf::IpAddress::resolve("2001:db8::1");    // an IPv6 address
+/// auto b2 = sf::IpAddress::resolveAll("example.com"); // all the IPv4 and IPv6 addresses of a host
 /// \endcode
 ///
-/// Note that sf::IpAddress currently doesn't support IPv6
-/// nor other types of network addresses.
+/// Both IPv4 and IPv6 addresses are supported. An IPv4 address
+/// is never equal to an IPv6 one, even to its IPv4-mapped form,
+/// and all IPv4 addresses are lesser than IPv6 ones.
 ///
 ////////////////////////////////////////////////////////////
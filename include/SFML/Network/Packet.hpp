@@ -98,6 +98,20 @@ public:
     ////////////////////////////////////////////////////////////
     void append(const void* data, std::size_t sizeInBytes);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve storage for data appended later
+    ///
+    /// Calling this function before writing a large amount of
+    /// data avoids growing the packet storage several times.
+    /// It doesn't change the data of the packet.
+    ///
+    /// \param capacity Total number of bytes the packet can hold without reallocating
+    ///
+    /// \see append
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t capacity);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the current reading position in the packet
     ///
@@ -364,8 +378,199 @@ public:
     ////////////////////////////////////////////////////////////
     Packet& operator<<(const String& data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an array of values to the end of the packet
+    ///
+    /// The values are encoded exactly like successive calls to
+    /// operator<< would encode them, but in a single pass over
+    /// the array. The number of values is not written: insert
+    /// it first if the receiver can't know it.
+    ///
+    /// \param data  Pointer to the values to append
+    /// \param count Number of values
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::int8_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::uint8_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::int16_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::uint16_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::int32_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::uint32_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::int64_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const std::uint64_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const float* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract an array of values from the packet
+    ///
+    /// The values are decoded exactly like successive calls to
+    /// operator>> would decode them, but in a single pass over
+    /// the array. If the packet doesn't contain \a count values,
+    /// nothing is extracted and the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of values to extract
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::int8_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::uint8_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::int16_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::uint16_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::int32_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::uint32_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::int64_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(std::uint64_t* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(float* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an unsigned integer with a variable-length encoding
+    ///
+    /// The value is written 7 bits per byte, starting with the
+    /// least significant bits, so that values below 128 take a
+    /// single byte and the largest ones take 10 bytes (LEB128).
+    ///
+    /// \param data Value to append
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readVarUint, writeVarInt
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeVarUint(std::uint64_t data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a signed integer with a variable-length encoding
+    ///
+    /// The value is first mapped to an unsigned one with the
+    /// zigzag encoding (0, -1, 1, -2, ... become 0, 1, 2, 3, ...)
+    /// so that values of small magnitude stay short whatever
+    /// their sign, then written like writeVarUint.
+    ///
+    /// \param data Value to append
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readVarInt, writeVarUint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeVarInt(std::int64_t data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract an unsigned integer written by writeVarUint
+    ///
+    /// The packet becomes invalid if the data is truncated or
+    /// doesn't hold a valid encoding.
+    ///
+    /// \param data Variable to fill
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeVarUint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarUint(std::uint64_t& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract a signed integer written by writeVarInt
+    ///
+    /// The packet becomes invalid if the data is truncated or
+    /// doesn't hold a valid encoding.
+    ///
+    /// \param data Variable to fill
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see writeVarInt
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarInt(std::int64_t& data);
+
 protected:
     friend class TcpSocket;
+    friend class TlsSocket;
+    friend class UdpConnection;
     friend class UdpSocket;
 
     ////////////////////////////////////////////////////////////
@@ -407,6 +612,32 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onReceive(const void* data, std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Called after the packet is cleared
+    ///
+    /// This function can be defined by derived classes to
+    /// reset their own reading and writing state along with
+    /// the data of the packet, so that clear() works the same
+    /// whether it is called through the base class or not.
+    /// The default implementation does nothing.
+    ///
+    /// \see clear
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onClear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the packet as invalid for reading
+    ///
+    /// Derived classes that provide their own extraction
+    /// functions call this when not enough data is left, so
+    /// that operator bool reports the failure.
+    ///
+    /// \see operator bool
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
 private:
     ////////////////////////////////////////////////////////////
     /// \brief Check if the packet can extract a given number of bytes
@@ -420,6 +651,29 @@ private:
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if the packet can extract a given number of elements
+    ///
+    /// This function updates accordingly the state of the packet.
+    ///
+    /// \param count       Number of elements to check
+    /// \param elementSize Size of an element, in bytes
+    ///
+    /// \return True if \a count elements of \a elementSize bytes can be read from the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool checkCount(std::size_t count, std::size_t elementSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Grow the packet by a given number of bytes
+    ///
+    /// \param size Number of bytes to add at the end of the packet
+    ///
+    /// \return Pointer to the first added byte, to be written by the caller
+    ///
+    ////////////////////////////////////////////////////////////
+    std::byte* grow(std::size_t size);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -513,6 +767,22 @@ private:
 /// }
 /// \endcode
 ///
+/// Large amounts of data are serialized faster with the
+/// bulk functions: reserve grows the storage once, writeArray
+/// and readArray process whole arrays of numbers at a time,
+/// and writeVarUint/writeVarInt store integers in as few bytes
+/// as their value allows. sf::PacketPool recycles packets, and
+/// the storage they allocated, between messages.
+///
+/// \code
+/// std::vector<float> positions = ...;
+///
+/// sf::Packet packet;
+/// packet.reserve(sizeof(std::uint32_t) + positions.size() * sizeof(float));
+/// packet << static_cast<std::uint32_t>(positions.size());
+/// packet.writeArray(positions.data(), positions.size());
+/// \endcode
+///
 /// Packets also provide an extra feature that allows to apply
 /// custom transformations to the data before it is sent,
 /// and after it is received. This is typically used to
@@ -547,6 +817,6 @@ private:
 /// ...
 /// \endcode
 ///
-/// \see sf::TcpSocket, sf::UdpSocket
+/// \see sf::TcpSocket, sf::UdpSocket, sf::PacketPool
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/Packet.hpp>
+
+#include <vector>
+
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Recycler of packets and of their storage
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool
+    ///
+    /// \param maxPackets Maximum number of released packets kept for reuse
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketPool(std::size_t maxPackets = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an empty packet
+    ///
+    /// The packet is taken from the released ones if there
+    /// are any, in which case it keeps the storage it had
+    /// allocated. Otherwise a new packet is created.
+    ///
+    /// \return Empty packet, ready to be written
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Packet acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a packet back to the pool
+    ///
+    /// The packet is cleared and kept, with its storage, until
+    /// the next call to acquire. If the pool already holds its
+    /// maximum number of packets, the packet is destroyed.
+    ///
+    /// \param packet Packet to recycle
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Packet&& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of packets waiting to be reused
+    ///
+    /// \return Number of released packets held by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the packets held by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Packet> m_packets;      //!< Released packets, waiting to be reused
+    std::size_t         m_maxPackets{}; //!< Maximum number of packets kept in m_packets
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// Serializing many messages into fresh packets allocates and
+/// frees memory for each of them. A packet pool avoids that:
+/// packets are acquired from the pool, filled and sent, then
+/// released to the pool, which keeps them with the storage
+/// they allocated until they are acquired again. After a few
+/// messages, serializing doesn't allocate anymore.
+///
+/// Only plain sf::Packet instances are pooled; packets with
+/// custom transformations (classes derived from sf::Packet)
+/// can't be stored. A pool is not thread-safe: use one pool
+/// per thread, or protect it with a mutex.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool;
+///
+/// while (running)
+/// {
+///     sf::Packet packet = pool.acquire();
+///     packet << snapshot;
+///     socket.send(packet);
+///     pool.release(std::move(packet));
+/// }
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
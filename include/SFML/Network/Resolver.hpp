@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/IpAddress.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Resolve host names in the background, with a cache
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API Resolver
+{
+public:
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    // Completion of a resolution, with the addresses of the host (empty if it could not be resolved)
+    using Callback = std::function<void(const std::vector<IpAddress>&)>;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the resolver
+    ///
+    /// The threads are started on demand, when a host name that
+    /// is not in the cache is resolved asynchronously.
+    ///
+    /// \param threadCount Maximum number of names resolved at the same time
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Resolver(std::size_t threadCount = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the resolutions in progress. The requests
+    /// that were not started yet complete with no address.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Resolver();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Resolver(const Resolver&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    Resolver& operator=(const Resolver&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the resolver shared by the whole program
+    ///
+    /// sf::Http and sf::Ftp resolve host names with this instance.
+    ///
+    /// The default resolver is never destroyed, so that exiting
+    /// the program doesn't wait for the resolutions in progress,
+    /// which can take as long as the system's DNS timeout. Its
+    /// threads are stopped with the process, and the pending
+    /// callbacks are not called.
+    ///
+    /// \return Default resolver
+    ///
+    ////////////////////////////////////////////////////////////
+    static Resolver& getDefault();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve a host name, waiting for the result
+    ///
+    /// The result is taken from the cache when possible. If the
+    /// same name is already being resolved, by another thread or
+    /// asynchronously, this function waits for that resolution
+    /// rather than starting another one.
+    ///
+    /// \param host IP address or network name
+    ///
+    /// \return Addresses of the host, empty if it could not be resolved
+    ///
+    /// \see resolveAsync, IpAddress::resolveAll
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::vector<IpAddress> resolve(std::string_view host);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve a host name asynchronously, with a callback
+    ///
+    /// If the name is in the cache, \a callback is called right
+    /// away by this function. Otherwise it is called by one of
+    /// the threads of the resolver once the name is resolved, and
+    /// it should return quickly so that the other names are not
+    /// delayed. An empty callback just fills the cache ahead of time.
+    ///
+    /// \param host     IP address or network name
+    /// \param callback Function called with the addresses of the host
+    ///
+    /// \see resolve
+    ///
+    ////////////////////////////////////////////////////////////
+    void resolveAsync(std::string_view host, Callback callback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve a host name asynchronously, with a future
+    ///
+    /// \param host IP address or network name
+    ///
+    /// \return Future holding the addresses of the host, empty if it could not be resolved
+    ///
+    /// \see resolve
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::future<std::vector<IpAddress>> resolveAsync(std::string_view host);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how long resolved names stay in the cache
+    ///
+    /// The system resolver doesn't give the lifetime of the DNS
+    /// records, so the same one is used for all the names.
+    /// The default is 60 seconds for names that were resolved,
+    /// and 5 seconds for names that could not be resolved.
+    /// Use Time::Zero to disable caching. The names already in
+    /// the cache keep their lifetime, unless clearCache is called.
+    ///
+    /// \param timeToLive         Lifetime of the names that were resolved
+    /// \param negativeTimeToLive Lifetime of the names that could not be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTimeToLive(Time timeToLive, Time negativeTimeToLive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the addresses of a host name, overriding the system
+    ///
+    /// Like an entry of a hosts file, this never expires and is
+    /// not removed by clearCache. Passing no address makes the
+    /// name unresolvable.
+    ///
+    /// \param host      Network name
+    /// \param addresses Addresses of the host
+    ///
+    /// \see removeHost
+    ///
+    ////////////////////////////////////////////////////////////
+    void addHost(std::string_view host, std::vector<IpAddress> addresses);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a host name set with addHost
+    ///
+    /// The name is resolved by the system again.
+    ///
+    /// \param host Network name
+    ///
+    /// \see addHost
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeHost(std::string_view host);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the cached names
+    ///
+    /// The names set with addHost are kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearCache();
+
+private:
+    struct ResolverImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<ResolverImpl> m_impl; //!< Opaque pointer to the implementation
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Resolver
+/// \ingroup network
+///
+/// Resolving a host name can take a long time, up to several
+/// seconds when the DNS server is slow or unreachable, during
+/// which IpAddress::resolve blocks the calling thread.
+/// sf::Resolver performs the resolutions on its own threads,
+/// so that the program can go on and be notified through a
+/// callback or a future.
+///
+/// The results are cached, including the failures, and the
+/// concurrent requests for a same name share one resolution.
+/// Names can also be given fixed addresses with addHost, for
+/// example to test a program without a network.
+///
+/// All the functions can be called from any thread.
+///
+/// Usage example:
+/// \code
+/// sf::Resolver resolver;
+///
+/// // With a callback, called from a thread of the resolver
+/// resolver.resolveAsync("www.sfml-dev.org", [](const std::vector<sf::IpAddress>& addresses)
+/// {
+///     if (!addresses.empty())
+///         std::cout << "Resolved to " << addresses.front() << std::endl;
+/// });
+///
+/// // With a future, checked once per frame
+/// std::future<std::vector<sf::IpAddress>> result = resolver.resolveAsync("example.com");
+/// while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+///     drawLoadingScreen();
+///
+/// sf::TcpSocket socket;
+/// if (socket.connect(result.get(), 80) == sf::Socket::Status::Done)
+/// {
+///     // connected to the first reachable address...
+/// }
+/// \endcode
+///
+/// \see sf::IpAddress
+///
+////////////////////////////////////////////////////////////
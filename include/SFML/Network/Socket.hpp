@@ -29,8 +29,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 
+#include <array>
+#include <memory>
+
+#include <cstddef>
+#include <cstdint>
+
 
 namespace sf
 {
@@ -61,6 +68,32 @@ public:
     // NOLINTNEXTLINE(readability-identifier-naming)
     static constexpr unsigned short AnyPort{0}; //!< Special value that tells the system to pick any available port
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Traffic statistics of a socket
+    ///
+    /// Packets are the sf::Packet instances sent and received over
+    /// TCP, with their size on the wire, and the datagrams sent and
+    /// received over UDP. Bucket `i` of the size histograms counts
+    /// the packets of `2^(i+5)` to `2^(i+6) - 1` bytes, except that
+    /// the first bucket counts all the packets under 64 bytes and
+    /// the last one all the packets of 1 MiB or more.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        std::uint64_t                 bytesSent{};       //!< Number of bytes sent by the system
+        std::uint64_t                 bytesReceived{};   //!< Number of bytes received from the system
+        std::uint64_t                 packetsSent{};     //!< Number of packets sent or queued
+        std::uint64_t                 packetsReceived{}; //!< Number of packets received
+        std::uint64_t                 sendCalls{};       //!< Number of system calls sending data
+        std::uint64_t                 receiveCalls{};    //!< Number of system calls receiving data
+        std::uint64_t                 partialSends{};    //!< Number of send calls that sent only a part of their data
+        std::uint64_t                 notReady{};        //!< Number of calls that failed because they would block
+        std::uint64_t                 errors{};          //!< Number of calls that failed with an error
+        std::array<std::uint64_t, 16> sentSizes{};       //!< Histogram of the sizes of the packets sent
+        std::array<std::uint64_t, 16> receivedSizes{};   //!< Histogram of the sizes of the packets received
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -120,6 +153,50 @@ public:
     ////////////////////////////////////////////////////////////
     bool isBlocking() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the traffic statistics of the socket
+    ///
+    /// Statistics are disabled by default. When they are enabled,
+    /// every system call and packet updates a few counters, which
+    /// is cheap enough to leave them on in production, for example
+    /// to spot slow clients or saturated links.
+    /// Disabling the statistics discards them.
+    ///
+    /// \param enabled True to enable the statistics, false to disable them
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatisticsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the traffic statistics of the socket are enabled
+    ///
+    /// \return True if the statistics are enabled
+    ///
+    /// \see setStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isStatisticsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the traffic statistics of the socket
+    ///
+    /// \return Statistics since they were enabled or reset, all zero if they are disabled
+    ///
+    /// \see setStatisticsEnabled, resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the traffic statistics of the socket to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Types of protocols that the socket can use
@@ -157,20 +234,36 @@ protected:
     /// \brief Create the internal representation of the socket
     ///
     /// This function can only be accessed by derived classes.
+    /// It creates an IPv4 socket.
     ///
     ////////////////////////////////////////////////////////////
     void create();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the internal representation of the socket
+    ///        for a version of the Internet Protocol
+    ///
+    /// This function can only be accessed by derived classes.
+    /// IPv6 sockets are created dual-stack: they can also
+    /// communicate with IPv4 addresses, in their IPv4-mapped form.
+    ///
+    /// \param addressType Version of the addresses used by the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(IpAddress::Type addressType);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
     ///        from a socket handle
     ///
     /// This function can only be accessed by derived classes.
     ///
-    /// \param handle OS-specific handle of the socket to wrap
+    /// \param handle      OS-specific handle of the socket to wrap
+    /// \param blockingSet True if \a handle is already in the
+    ///                    blocking state of this socket
     ///
     ////////////////////////////////////////////////////////////
-    void create(SocketHandle handle);
+    void create(SocketHandle handle, bool blockingSet = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Close the socket gracefully
@@ -180,15 +273,71 @@ protected:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Take over the handle of another socket
+    ///
+    /// The current handle is closed. Unlike move assignment,
+    /// this socket keeps its blocking mode and its statistics.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param socket Socket of the same type, left without a handle
+    ///
+    ////////////////////////////////////////////////////////////
+    void takeHandle(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a system call sending data in the statistics
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param status    Done if the call succeeded, otherwise the error it returned
+    /// \param requested Number of bytes that the call had to send
+    /// \param sent      Number of bytes actually sent
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordSend(Status status, std::size_t requested, std::size_t sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a system call receiving data in the statistics
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param status   Done if the call succeeded, otherwise the error it returned
+    /// \param received Number of bytes received
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordReceive(Status status, std::size_t received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a packet sent in the statistics
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param size Size of the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordPacketSent(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a packet received in the statistics
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param size Size of the packet
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordPacketReceived(std::size_t size);
+
 private:
     friend class SocketSelector;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;             //!< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;           //!< Socket descriptor
-    bool         m_isBlocking{true}; //!< Current blocking mode of the socket
+    Type                        m_type;             //!< Type of the socket (TCP or UDP)
+    SocketHandle                m_socket;           //!< Socket descriptor
+    bool                        m_isBlocking{true}; //!< Current blocking mode of the socket
+    std::unique_ptr<Statistics> m_statistics;       //!< Traffic statistics, when they are enabled
 };
 
 } // namespace sf
@@ -32,6 +32,9 @@
 #include <SFML/System/Time.hpp>
 
 #include <memory>
+#include <vector>
+
+#include <cstdint>
 
 
 namespace sf
@@ -45,6 +48,41 @@ class Socket;
 class SFML_NETWORK_API SocketSelector
 {
 public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Readiness a socket is observed for
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class Interest
+    {
+        Receive,       //!< Wait until the socket has data to receive, or a connection to accept
+        Send,          //!< Wait until data can be sent through the socket without blocking
+        ReceiveAndSend //!< Wait for both conditions
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Socket found ready by the last call to wait()
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ReadySocket
+    {
+        Socket* socket{};  //!< Socket, as passed to add()
+        bool    receive{}; //!< True if the socket is ready to receive data, or accept a connection
+        bool    send{};    //!< True if the socket is ready to send data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of the calls to wait
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        std::uint64_t waitCalls{};    //!< Number of calls to wait
+        std::uint64_t timeouts{};     //!< Number of calls to wait that returned without any ready socket
+        std::uint64_t readySockets{}; //!< Total number of sockets found ready
+        Time          waitTime;       //!< Total time spent blocked in wait
+        Time          maxWaitTime;    //!< Longest time spent blocked in a single call to wait
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -94,13 +132,16 @@ public:
     /// so you have to make sure that the socket is not destroyed
     /// while it is stored in the selector.
     /// This function does nothing if the socket is not valid.
+    /// If the socket is already in the selector, its interest
+    /// is updated.
     ///
-    /// \param socket Reference to the socket to add
+    /// \param socket   Reference to the socket to add
+    /// \param interest Readiness to observe the socket for
     ///
     /// \see remove, clear
     ///
     ////////////////////////////////////////////////////////////
-    void add(Socket& socket);
+    void add(Socket& socket, Interest interest = Interest::Receive);
 
     ////////////////////////////////////////////////////////////
     /// \brief Remove a socket from the selector
@@ -128,11 +169,12 @@ public:
     void clear();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Wait until one or more sockets are ready to receive
+    /// \brief Wait until one or more sockets are ready
     ///
-    /// This function returns as soon as at least one socket has
-    /// some data available to be received. To know which sockets are
-    /// ready, use the isReady function.
+    /// This function returns as soon as at least one socket is
+    /// ready for what it is observed for (by default, has some
+    /// data available to be received). To know which sockets are
+    /// ready, use getReadySockets or the isReady function.
     /// If you use a timeout and no socket is ready before the timeout
     /// is over, the function returns false.
     ///
@@ -140,7 +182,7 @@ public:
     ///
     /// \return True if there are sockets ready, false otherwise
     ///
-    /// \see isReady
+    /// \see getReadySockets, isReady, isReadyToSend
     ///
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool wait(Time timeout = Time::Zero);
@@ -159,11 +201,89 @@ public:
     ///
     /// \return True if the socket is ready to read, false otherwise
     ///
-    /// \see isReady
+    /// \see isReadyToSend, getReadySockets
     ///
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Test a socket to know if it is ready to send data
+    ///
+    /// This function must be used after a call to wait, for a
+    /// socket observed with Interest::Send or Interest::ReceiveAndSend.
+    /// If a socket is ready, a call to send will not block.
+    ///
+    /// \param socket Socket to test
+    ///
+    /// \return True if the socket is ready to send, false otherwise
+    ///
+    /// \see isReady, getReadySockets
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReadyToSend(Socket& socket) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sockets found ready by the last call to wait
+    ///
+    /// Iterating over the ready sockets only, instead of testing
+    /// every socket with isReady, scales to selectors holding
+    /// thousands of sockets. The sockets are identified by the
+    /// address passed to add, so they must not be moved while
+    /// they are in the selector for this function to be useful.
+    ///
+    /// The list only changes on the next call to wait or clear:
+    /// sockets can be added and removed while iterating over it.
+    ///
+    /// \return Sockets that are ready, in no particular order
+    ///
+    /// \see wait, isReady, isReadyToSend
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const std::vector<ReadySocket>& getReadySockets() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the statistics of the selector
+    ///
+    /// Statistics are disabled by default. When they are enabled,
+    /// each call to wait is timed, which tells how much of the time
+    /// of a network thread is spent idle waiting for the sockets.
+    /// Disabling the statistics discards them.
+    ///
+    /// \param enabled True to enable the statistics, false to disable them
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStatisticsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the statistics of the selector are enabled
+    ///
+    /// \return True if the statistics are enabled
+    ///
+    /// \see setStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isStatisticsEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the selector
+    ///
+    /// \return Statistics since they were enabled or reset, all zero if they are disabled
+    ///
+    /// \see setStatisticsEnabled, resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the statistics of the selector to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 private:
     struct SocketSelectorImpl;
 
@@ -188,6 +308,12 @@ private:
 /// for each socket; with selectors, a single thread can handle
 /// all the sockets.
 ///
+/// Depending on the operating system, selectors are built on
+/// epoll (Linux, Android), kqueue (macOS, iOS, BSD), WSAPoll
+/// (Windows) or select (other systems, or when SFML is built with
+/// SFML_NETWORK_USE_SELECT). Only select limits the number and
+/// the values of socket handles, to FD_SETSIZE.
+///
 /// All types of sockets can be used in a selector:
 /// \li sf::TcpListener
 /// \li sf::TcpSocket
@@ -268,6 +394,35 @@ private:
 /// }
 /// \endcode
 ///
+/// When a selector holds many sockets, iterating over the ready
+/// ones is faster than testing all of them. Sockets can also be
+/// observed for their ability to send, to flush pending data
+/// written by non-blocking sockets:
+/// \code
+/// // Store the clients where they never move
+/// std::list<sf::TcpSocket> clients;
+///
+/// while (running)
+/// {
+///     if (selector.wait())
+///     {
+///         for (const auto& [socket, receive, send] : selector.getReadySockets())
+///         {
+///             if (receive)
+///             {
+///                 // Receive from the socket (or accept from the listener)...
+///             }
+///
+///             if (send)
+///             {
+///                 // Send pending data, then stop observing the socket for sending
+///                 selector.add(*socket, sf::SocketSelector::Interest::Receive);
+///             }
+///         }
+///     }
+/// }
+/// \endcode
+///
 /// \see sf::Socket
 ///
 ////////////////////////////////////////////////////////////
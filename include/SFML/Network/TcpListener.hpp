@@ -32,6 +32,8 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
 
+#include <vector>
+
 
 namespace sf
 {
@@ -44,6 +46,17 @@ class TcpSocket;
 class SFML_NETWORK_API TcpListener : public Socket
 {
 public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Options of a listening socket
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ListenOptions
+    {
+        int  backlog{};   //!< Maximum number of pending connections, 0 for the system maximum
+        bool reusePort{}; //!< Share the port with other listeners having this option, the system spreads connections
+        bool ipV6Only{};  //!< Refuse IPv4 connections when listening on an IPv6 address
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -77,6 +90,9 @@ public:
     /// will request an available port from the system.
     /// The chosen port can be retrieved by calling getLocalPort().
     ///
+    /// Listening on an IPv6 address, like sf::IpAddress::AnyV6,
+    /// also accepts connections from IPv4 clients (dual-stack).
+    ///
     /// \param port    Port to listen on for incoming connection attempts
     /// \param address Address of the interface to listen on
     ///
@@ -87,6 +103,28 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Status listen(unsigned short port, const IpAddress& address = IpAddress::Any);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start listening for incoming connection attempts,
+    ///        with specific options
+    ///
+    /// This overload works like the one above, but allows to set
+    /// the size of the queue of pending connections and to share
+    /// the port between several listeners.
+    ///
+    /// Sharing a port requires SO_REUSEPORT, which is not supported
+    /// on Windows: in this case the function returns an error.
+    ///
+    /// \param port    Port to listen on for incoming connection attempts
+    /// \param address Address of the interface to listen on
+    /// \param options Options of the listener
+    ///
+    /// \return Status code
+    ///
+    /// \see accept, close
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status listen(unsigned short port, const IpAddress& address, const ListenOptions& options);
+
     ////////////////////////////////////////////////////////////
     /// \brief Stop listening and close the socket
     ///
@@ -112,6 +150,29 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Status accept(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept all the pending connections
+    ///
+    /// New connections are appended to \a sockets until none is
+    /// pending or \a maxCount of them have been accepted. This
+    /// empties the queue of the listener after a single readiness
+    /// notification, for example from sf::SocketSelector.
+    ///
+    /// If the listener is in blocking mode, this function only
+    /// waits for the first connection.
+    ///
+    /// \param sockets  Sockets to append the new connections to
+    /// \param maxCount Maximum number of connections to accept
+    /// \param blocking Blocking state of the new sockets
+    ///
+    /// \return Status::Done if at least one connection was accepted,
+    ///         otherwise the status of the failed accept
+    ///
+    /// \see accept
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status acceptAll(std::vector<TcpSocket>& sockets, std::size_t maxCount, bool blocking = true);
 };
 
 
@@ -161,6 +222,35 @@ public:
 /// }
 /// \endcode
 ///
+/// On systems that support it, several listeners can share the
+/// same port by setting ListenOptions::reusePort. The system
+/// then spreads the incoming connections between them, which
+/// lets each worker thread accept its own connections without
+/// contention:
+/// \code
+/// sf::TcpListener::ListenOptions options;
+/// options.reusePort = true;
+///
+/// // One listener per worker thread, all on port 55001
+/// for (std::size_t i = 0; i < workerCount; ++i)
+/// {
+///     workers.emplace_back([&options]
+///     {
+///         sf::TcpListener listener;
+///         if (listener.listen(55001, sf::IpAddress::Any, options) != sf::Socket::Status::Done)
+///             return;
+///
+///         std::vector<sf::TcpSocket> clients;
+///         while (running)
+///         {
+///             // Wait for the first connection, then take all the pending ones
+///             if (listener.acceptAll(clients, 64, false) == sf::Socket::Status::Done)
+///                 serve(clients);
+///         }
+///     });
+/// }
+/// \endcode
+///
 /// \see sf::TcpSocket, sf::Socket
 ///
 ////////////////////////////////////////////////////////////
@@ -33,15 +33,20 @@
 
 #include <SFML/System/Time.hpp>
 
+#include <filesystem>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 
 
 namespace sf
 {
+class Ftp;
+class HttpServer;
 class TcpListener;
 class IpAddress;
 class Packet;
@@ -53,6 +58,17 @@ class Packet;
 class SFML_NETWORK_API TcpSocket : public Socket
 {
 public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Options for the compression of packets
+    ///
+    ////////////////////////////////////////////////////////////
+    struct PacketCompression
+    {
+        bool                   enabled{};      //!< Use the compressed packet framing, which both peers must enable
+        std::size_t            threshold{128}; //!< Size from which the packets sent are compressed
+        std::vector<std::byte> dictionary;     //!< Data typical of the packets, the same on both peers
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -117,6 +133,53 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Status connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to the first reachable address of a peer
+    ///
+    /// The addresses are tried alternating between IPv6 and IPv4,
+    /// starting with the version of the first one. If an attempt
+    /// takes more than 250 milliseconds, the next one is started
+    /// in parallel without cancelling it, and the first connection
+    /// to succeed is kept ("Happy Eyeballs", RFC 8305). This avoids
+    /// waiting for a broken address family to time out, and lets
+    /// IPv6-only networks connect directly rather than through NAT64.
+    ///
+    /// Unlike the overload taking a single address, this function
+    /// always waits for the outcome of the attempts, even if the
+    /// socket is in non-blocking mode. The socket keeps its blocking
+    /// mode and its packet compression options.
+    ///
+    /// \param remoteAddresses Addresses of the remote peer, in order of preference
+    /// \param remotePort      Port of the remote peer
+    /// \param timeout         Optional maximum time to wait for all the attempts
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status connect(const std::vector<IpAddress>& remoteAddresses,
+                                 unsigned short                remotePort,
+                                 Time                          timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to a remote host, by name
+    ///
+    /// All the IPv4 and IPv6 addresses of the host are tried, in
+    /// the order of preference of the system, as described in the
+    /// overload taking a list of addresses.
+    ///
+    /// \param remoteHost IP address or network name of the remote host
+    /// \param remotePort Port of the remote host
+    /// \param timeout    Optional maximum time to wait for all the attempts
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect, IpAddress::resolveAll
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status connect(std::string_view remoteHost, unsigned short remotePort, Time timeout = Time::Zero);
+
     ////////////////////////////////////////////////////////////
     /// \brief Disconnect the socket from its remote peer
     ///
@@ -162,6 +225,34 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Status send(const void* data, std::size_t size, std::size_t& sent);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a part of a file to the remote peer
+    ///
+    /// The bytes go from the file to the socket without being
+    /// copied through a user-space buffer on systems that can
+    /// do it (sendfile on Linux). On other systems, the file is
+    /// read in blocks that are sent like raw data.
+    /// Over a non-blocking socket, this may send only part of
+    /// the range: the rest can be sent by calling this function
+    /// again with \a offset moved forward by \a sent bytes.
+    /// This function will fail if the socket is not connected,
+    /// or if the file can't be read or is shorter than the range.
+    ///
+    /// \param filename Path of the file to send
+    /// \param offset   Position of the first byte to send in the file
+    /// \param size     Number of bytes to send
+    /// \param sent     The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status sendFile(const std::filesystem::path& filename,
+                                  std::uint64_t                offset,
+                                  std::size_t                  size,
+                                  std::size_t&                 sent);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive raw data from the remote peer
     ///
@@ -214,7 +305,129 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Status receive(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive all the formatted packets that are ready
+    ///
+    /// This function receives a first packet like receive(Packet&),
+    /// but reads from the system in a large block, then appends
+    /// every other packet that is complete in that block without
+    /// calling the system again. Small packets sent in a burst
+    /// are therefore received with a single system call.
+    /// Only an incomplete packet may be left in the block, so
+    /// sf::SocketSelector still reports the socket as ready
+    /// when the rest of it arrives.
+    /// Received packets are appended to \a packets, which is
+    /// not cleared first.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Vector to append the received packets to
+    ///
+    /// \return Status of the first packet reception, or Error if a following packet can't be decompressed
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status receivePackets(std::vector<Packet>& packets);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a formatted packet of data to the send queue
+    ///
+    /// The packet is copied, with its size, to the end of the
+    /// send queue. Nothing is sent until flush is called, so
+    /// that many small packets can be sent with a single system
+    /// call. The packet can be modified or reused as soon as
+    /// this function returns.
+    /// Queued packets are not ordered with respect to packets
+    /// and data sent directly with send: flush the queue first
+    /// if the order matters.
+    ///
+    /// \param packet Packet to queue
+    ///
+    /// \see flush, getSendQueueSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void queue(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the packets added to the send queue
+    ///
+    /// In non-blocking mode, this function may return
+    /// sf::Socket::Status::Partial or sf::Socket::Status::NotReady,
+    /// in which case the rest of the queue stays pending until
+    /// the next call. More packets can be queued meanwhile.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \return Status code, sf::Socket::Status::Done if the queue is empty
+    ///
+    /// \see queue, getSendQueueSize
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes waiting in the send queue
+    ///
+    /// \return Number of queued bytes not sent yet
+    ///
+    /// \see queue, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getSendQueueSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the compression of the packets sent and received
+    ///
+    /// When compression is enabled, the packets sent with
+    /// send(Packet&) and queue whose size reaches the threshold
+    /// are compressed in the LZ4 block format, unless that
+    /// doesn't make them smaller. Compressed packets are flagged
+    /// by the highest bit of their size prefix, so both peers
+    /// must enable compression, and packets must be smaller than
+    /// 2 GiB. When it is disabled, which is the default, packets
+    /// are sent as usual and the socket can communicate with
+    /// peers that don't support compression.
+    ///
+    /// The dictionary is data that compressed packets can refer
+    /// to, such as typical messages or common strings, which
+    /// makes small repetitive packets much smaller. Only its
+    /// last 64 KiB are used. Decompressing a packet requires the
+    /// same dictionary that compressed it.
+    ///
+    /// \param compression Compression options
+    ///
+    /// \see getPacketCompression
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPacketCompression(PacketCompression compression);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression of the packets sent and received
+    ///
+    /// \return Compression options
+    ///
+    /// \see setPacketCompression
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const PacketCompression& getPacketCompression() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the round-trip time of the connection estimated by the system
+    ///
+    /// This is the smoothed estimate that the TCP stack maintains
+    /// from the acknowledgments of the peer, it costs a single
+    /// system call and nothing is sent over the network.
+    /// It is only available on Linux, Android and FreeBSD.
+    ///
+    /// \return Round-trip time, or `std::nullopt` if the socket is not connected or the system doesn't report it
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<Time> getRoundTripTime() const;
+
 private:
+    friend class Ftp;
+    friend class HttpServer;
     friend class TcpListener;
 
     ////////////////////////////////////////////////////////////
@@ -225,14 +438,100 @@ private:
     {
         std::uint32_t          size{};         //!< Data of packet size
         std::size_t            sizeReceived{}; //!< Number of size bytes received so far
-        std::vector<std::byte> data;           //!< Data of the packet
+        std::size_t            dataReceived{}; //!< Number of data bytes received so far
+        std::vector<std::byte> data;           //!< Storage of the packet data, reused across packets
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the options and buffers of packet compression
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CompressionState
+    {
+        PacketCompression      options;      //!< Options set by the user
+        std::vector<std::byte> input;        //!< Dictionary followed by the packet to compress
+        std::vector<std::byte> output;       //!< Original size and compressed data of the last compressed packet
+        std::vector<std::byte> decompressed; //!< Dictionary followed by the last decompressed packet
+        const Packet*          sending{};    //!< Packet whose compressed data is in the output, to resume its send
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a part of a file that is already open
+    ///
+    /// This lets a file sent in several calls, over a non-blocking
+    /// socket or in blocks, be opened only once.
+    ///
+    /// \param file     File to send, opened for reading in binary mode
+    /// \param offset   Position of the first byte to send in the file
+    /// \param size     Number of bytes to send
+    /// \param sent     The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status sendFile(std::FILE& file, std::uint64_t offset, std::size_t size, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a formatted packet, optionally reading ahead into the receive buffer
+    ///
+    /// \param packet   Packet to fill with the received data
+    /// \param buffered True to read from the system in large blocks, which may contain the next packets
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status receivePacket(Packet& packet, bool buffered);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive as much data as possible into the empty receive buffer
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status fillReceiveBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take data out of the receive buffer
+    ///
+    /// \param data Pointer to the array to fill with the buffered bytes
+    /// \param size Maximum number of bytes to take
+    ///
+    /// \return Number of bytes taken
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t readReceiveBuffer(void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the data of a packet to send, compressed if needed
+    ///
+    /// \param packet     Packet to send
+    /// \param data       Variable to fill with the address of the data to send
+    /// \param size       Variable to fill with the size of the data to send
+    /// \param packetSize Variable to fill with the size prefix of the packet, in network byte order
+    ///
+    /// \return True if the packet can be sent, false if it is too large
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool preparePacket(Packet& packet, const void*& data, std::size_t& size, std::uint32_t& packetSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decompress the data of the pending packet
+    ///
+    /// \return True if the data was valid
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool decompressPendingPacket();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket          m_pendingPacket;     //!< Temporary data of the packet currently being received
-    std::vector<std::byte> m_blockToSendBuffer; //!< Buffer used to prepare data being sent from the socket
+    PendingPacket          m_pendingPacket;   //!< Temporary data of the packet currently being received
+    std::vector<std::byte> m_receiveBuffer;   //!< Data received from the system but not consumed yet
+    std::size_t            m_receiveBegin{};  //!< Position of the first unconsumed byte in the receive buffer
+    std::size_t            m_receiveEnd{};    //!< Position past the last received byte in the receive buffer
+    std::vector<std::byte> m_sendQueue;       //!< Queued packets, with their sizes, waiting to be flushed
+    std::size_t            m_sendQueueSent{}; //!< Number of bytes at the front of the send queue already sent
+    CompressionState       m_compression;     //!< Compression of the packets
 };
 
 } // namespace sf
@@ -268,6 +567,12 @@ private:
 /// the data that is exchanged. You can look at the sf::Packet
 /// class to get more details about how they work.
 ///
+/// receivePackets reads packets from the system in large
+/// blocks, so that several small packets arriving together
+/// cost a single system call and are returned at once. In
+/// the other direction, queue and flush gather many small
+/// packets into a single send.
+///
 /// The socket is automatically disconnected when it is destroyed,
 /// but if you want to explicitly close the connection while
 /// the socket instance is still alive, you can call disconnect.
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Configuration shared by TLS connections
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API TlsContext
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a context for the client side of connections
+    ///
+    /// Servers are authenticated with the certificate authorities
+    /// trusted by the system, plus the ones added with
+    /// addTrustedCertificates.
+    ///
+    /// This function always fails if SFML was built without
+    /// TLS support (see the SFML_USE_OPENSSL CMake option).
+    ///
+    /// \return Context if it was successfully created, otherwise `std::nullopt`
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<TlsContext> createClient();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a context for the server side of connections
+    ///
+    /// The certificate chain starts with the certificate of the
+    /// server, optionally followed by the intermediate certificates
+    /// that lead to a trusted authority.
+    ///
+    /// This function always fails if SFML was built without
+    /// TLS support (see the SFML_USE_OPENSSL CMake option).
+    ///
+    /// \param certificateChain Certificates of the server, in PEM format
+    /// \param privateKey       Private key of the server certificate, in PEM format
+    ///
+    /// \return Context if it was successfully created, otherwise `std::nullopt`
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::optional<TlsContext> createServer(std::string_view certificateChain,
+                                                                std::string_view privateKey);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TlsContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The copy shares the configuration and the session cache
+    /// of the original context.
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsContext(const TlsContext&);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsContext& operator=(const TlsContext&);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsContext(TlsContext&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsContext& operator=(TlsContext&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Trust additional certificate authorities
+    ///
+    /// This is mostly useful to connect to servers using a
+    /// self-signed certificate, whose certificate is then
+    /// trusted directly.
+    ///
+    /// \param certificates Certificates to trust, in PEM format
+    ///
+    /// \return True if at least one certificate was added
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool addTrustedCertificates(std::string_view certificates);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the verification of the peer
+    ///
+    /// Client contexts verify the certificate of the server and
+    /// its name by default. Disabling the verification exposes
+    /// the connections to man-in-the-middle attacks, it should
+    /// only be done for testing. Server contexts don't ask the
+    /// clients for a certificate.
+    /// This only applies to the connections started afterwards.
+    ///
+    /// \param enabled True to verify the peer, false to accept any peer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPeerVerification(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the sessions kept to resume connections
+    ///
+    /// The next connections of a client context to each server
+    /// then go through a full handshake. This has no effect on
+    /// server contexts, whose sessions are kept by the clients.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearSessionCache();
+
+private:
+    friend class TlsSocket;
+
+    struct TlsContextImpl;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the context from its implementation
+    ///
+    /// \param impl Implementation of the context
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TlsContext(std::shared_ptr<TlsContextImpl> impl);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::shared_ptr<TlsContextImpl> m_impl; //!< Implementation, shared by the copies of the context and their sockets
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TlsContext
+/// \ingroup network
+///
+/// A TLS context holds what the connections of one side have
+/// in common: the certificates, the trusted authorities and
+/// the sessions of the previous connections. Setting it up
+/// is expensive (the system certificate store is parsed, for
+/// example), so a context is meant to be created once and
+/// passed to every sf::TlsSocket.
+///
+/// Client contexts remember the sessions negotiated with each
+/// server, and server contexts issue session tickets, so that
+/// the next connections between the same peers resume the
+/// session with an abbreviated handshake, saving a round trip
+/// and the public key operations.
+///
+/// Copies of a context are cheap and share the same state.
+/// The context can be used by several threads at once.
+///
+/// TLS is implemented with OpenSSL, which SFML must be built
+/// with (see the SFML_USE_OPENSSL CMake option); otherwise
+/// contexts can't be created.
+///
+/// Usage example:
+/// \code
+/// // A client trusting a self-signed server certificate
+/// std::optional<sf::TlsContext> context = sf::TlsContext::createClient();
+/// if (!context || !context->addTrustedCertificates(serverCertificate))
+/// {
+///     // Handle error...
+/// }
+///
+/// sf::TlsSocket socket(*context);
+/// if (socket.connect("localhost", 55001) != sf::Socket::Status::Done)
+/// {
+///     // Handle error...
+/// }
+/// \endcode
+///
+/// \see sf::TlsSocket
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,382 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/TlsContext.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+
+namespace sf
+{
+class IpAddress;
+class Packet;
+class TcpListener;
+class TcpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief TCP socket secured with TLS
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API TlsSocket
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the socket with the context of its connections
+    ///
+    /// \param context Client context to connect, server context to accept
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TlsSocket(const TlsContext& context);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the connection like disconnect, so that its
+    /// session can be resumed by later connections.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TlsSocket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsSocket(const TlsSocket&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsSocket& operator=(const TlsSocket&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsSocket(TlsSocket&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsSocket& operator=(TlsSocket&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect to a remote host and start the handshake
+    ///
+    /// The host name is resolved to its addresses, and is also
+    /// the name that the certificate of the server is checked
+    /// against (or its IP address, if \a remoteHost is one).
+    /// If the underlying socket is in non-blocking mode, the
+    /// function may return Socket::Status::NotReady, the
+    /// handshake then goes on with handshake, send and receive.
+    ///
+    /// \param remoteHost Name or address of the host to connect to
+    /// \param remotePort Port of the host to connect to
+    /// \param timeout    Maximum time to wait for the TCP connection
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect, handshake
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status connect(std::string_view remoteHost,
+                                         unsigned short   remotePort,
+                                         Time             timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect to the first reachable address and start the handshake
+    ///
+    /// This works like the other overload, for a host whose
+    /// addresses are already known. If \a serverName is empty,
+    /// the certificate of the server is checked against the
+    /// address that the connection was established with.
+    ///
+    /// \param remoteAddresses Addresses of the host, in order of preference
+    /// \param remotePort      Port of the host to connect to
+    /// \param serverName      Name of the host, as written in its certificate
+    /// \param timeout         Maximum time to wait for the TCP connection
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect, handshake
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status connect(const std::vector<IpAddress>& remoteAddresses,
+                                         unsigned short                remotePort,
+                                         std::string_view              serverName,
+                                         Time                          timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept a new connection and start the handshake
+    ///
+    /// The socket must have been constructed with a server context.
+    ///
+    /// \param listener Listener to accept the connection from
+    ///
+    /// \return Status code
+    ///
+    /// \see handshake
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status accept(TcpListener& listener);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Perform the handshake, or continue it
+    ///
+    /// connect and accept already perform the handshake, this
+    /// function is only needed to complete it in non-blocking
+    /// mode, before sending or receiving anything. It returns
+    /// Socket::Status::Done once the handshake is complete.
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status handshake();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the connection
+    ///
+    /// The peer is notified that no more data will be sent,
+    /// then the underlying socket is disconnected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data to the remote peer
+    ///
+    /// \param data Pointer to the sequence of bytes to send
+    /// \param size Number of bytes to send
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status send(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data to the remote peer
+    ///
+    /// In non-blocking mode, the function may return
+    /// Socket::Status::Partial after sending a part of the data,
+    /// the rest must then be sent later by passing the same
+    /// remaining bytes again.
+    ///
+    /// \param data Pointer to the sequence of bytes to send
+    /// \param size Number of bytes to send
+    /// \param sent The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status send(const void* data, std::size_t size, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data from the remote peer
+    ///
+    /// A call returns the data of at most one TLS record (up to
+    /// 16 KiB). If \a size is smaller, the rest of the record
+    /// stays in the socket, where SocketSelector can't see it:
+    /// check hasPendingData before waiting for more.
+    ///
+    /// \param data     Pointer to the array to fill with the received bytes
+    /// \param size     Maximum number of bytes that can be received
+    /// \param received This variable is filled with the actual number of bytes received
+    ///
+    /// \return Status code
+    ///
+    /// \see send, hasPendingData
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status receive(void* data, std::size_t size, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a formatted packet of data to the remote peer
+    ///
+    /// The packet is framed like with sf::TcpSocket (without
+    /// compression), so the size and the beginning of the data
+    /// go in the same record while the rest of a large packet is
+    /// encrypted straight from its storage, without being copied.
+    /// In non-blocking mode, if this function returns
+    /// Socket::Status::Partial, you \em must retry sending the
+    /// same unmodified packet before sending anything else.
+    ///
+    /// \param packet Packet to send
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status send(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a formatted packet of data from the remote peer
+    ///
+    /// The data is decrypted directly into the storage of the
+    /// packet. In non-blocking mode, the function returns
+    /// Socket::Status::NotReady until the whole packet is there.
+    ///
+    /// \param packet Packet to fill with the received data
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status receive(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether received data is waiting in the socket
+    ///
+    /// This is data that was decrypted but not returned by
+    /// receive yet; it can be received without blocking.
+    ///
+    /// \return True if there is data to receive without waiting for the network
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool hasPendingData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the connection resumed a previous session
+    ///
+    /// Resumed sessions skip the expensive part of the handshake.
+    ///
+    /// \return True if the session of a previous connection was resumed
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isSessionResumed() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying TCP socket
+    ///
+    /// It can be used to change the blocking mode, to add the
+    /// connection to a SocketSelector, or to get its addresses
+    /// and statistics. Data must not be sent or received with
+    /// it directly.
+    ///
+    /// \return Socket carrying the encrypted data
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] TcpSocket& getTcpSocket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying TCP socket
+    ///
+    /// \return Socket carrying the encrypted data
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const TcpSocket& getTcpSocket() const;
+
+private:
+    struct TlsSocketImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<TlsSocketImpl> m_impl; //!< Opaque pointer to the implementation
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TlsSocket
+/// \ingroup network
+///
+/// sf::TlsSocket encrypts and authenticates a TCP connection
+/// with TLS, the protocol securing HTTPS among others. It owns
+/// an sf::TcpSocket, through which the encrypted data goes,
+/// and sends and receives raw data and packets like it does.
+///
+/// Each socket is created with an sf::TlsContext, which holds
+/// the certificates and the sessions of the previous
+/// connections. A client socket connects to a server with
+/// connect, a server socket accepts a client with accept; both
+/// then go through the TLS handshake, which authenticates the
+/// server and agrees on the keys of the connection.
+///
+/// Non-blocking mode is supported: set it on the underlying
+/// socket (see getTcpSocket). The handshake then goes on with
+/// each call to handshake, send or receive, which return
+/// Socket::Status::NotReady until it is complete.
+///
+/// Usage example:
+/// \code
+/// // ----- The server -----
+///
+/// std::optional<sf::TlsContext> serverContext = sf::TlsContext::createServer(certificate, privateKey);
+///
+/// sf::TcpListener listener;
+/// if (listener.listen(55001) != sf::Socket::Status::Done)
+/// {
+///     // Handle error...
+/// }
+///
+/// sf::TlsSocket client(*serverContext);
+/// if (client.accept(listener) == sf::Socket::Status::Done)
+/// {
+///     sf::Packet packet;
+///     packet << "Hello, secure world";
+///     if (client.send(packet) != sf::Socket::Status::Done)
+///     {
+///         // Handle error...
+///     }
+/// }
+///
+/// // ----- The client -----
+///
+/// std::optional<sf::TlsContext> clientContext = sf::TlsContext::createClient();
+///
+/// sf::TlsSocket socket(*clientContext);
+/// if (socket.connect("example.com", 55001) == sf::Socket::Status::Done)
+/// {
+///     sf::Packet  packet;
+///     std::string message;
+///     if ((socket.receive(packet) == sf::Socket::Status::Done) && (packet >> message))
+///         std::cout << message << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::TlsContext, sf::TcpSocket
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <memory>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+class Packet;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Connection to a remote peer with reliable and
+///        ordered delivery on top of a UDP socket
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API UdpConnection
+{
+public:
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    // NOLINTBEGIN(readability-identifier-naming)
+    static constexpr std::size_t MaxChannels{16};                 //!< Number of independent channels
+    static constexpr std::size_t MaxDatagramSize{1200};           //!< Largest datagram sent, below common path MTUs
+    static constexpr std::size_t MaxFragmentSize{1024};           //!< Larger messages are split into fragments
+    static constexpr std::size_t MaxMessageSize{4 * 1024 * 1024}; //!< Largest message that can be sent
+    // NOLINTEND(readability-identifier-naming)
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delivery guarantees of a channel
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class Delivery
+    {
+        Unreliable,        //!< Messages may be lost, but are never duplicated
+        ReliableUnordered, //!< Messages are delivered exactly once, as soon as they arrive
+        ReliableOrdered    //!< Messages are delivered exactly once, in the order they were sent
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Network conditions to simulate on outgoing datagrams
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Simulation
+    {
+        float         packetLoss{}; //!< Probability of dropping a datagram, in range [0, 1]
+        float         duplicates{}; //!< Probability of sending a datagram twice, in range [0, 1]
+        Time          latency;      //!< Delay added to each datagram
+        Time          jitter;       //!< Maximum random delay added on top of the latency, which reorders datagrams
+        std::uint32_t seed{5489};   //!< Seed of the random generator, for reproducible runs
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a connection to a remote peer
+    ///
+    /// The socket must stay alive as long as the connection
+    /// is used. It should be bound to a port, so that the
+    /// remote peer can answer. Several connections may
+    /// share the same socket, see handleDatagram.
+    ///
+    /// All channels are reliable and ordered by default.
+    ///
+    /// \param socket        Socket used to send and receive datagrams
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UdpConnection();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection(const UdpConnection&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection& operator=(const UdpConnection&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection(UdpConnection&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection& operator=(UdpConnection&&) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the remote peer
+    ///
+    /// \return Address of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] IpAddress getRemoteAddress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of the remote peer
+    ///
+    /// \return Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] unsigned short getRemotePort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the delivery guarantees of a channel
+    ///
+    /// The delivery is transmitted with each message, so only
+    /// the sender has to configure its channels. It should not
+    /// be changed once messages were sent on the channel.
+    ///
+    /// \param channel  Index of the channel, in range [0, MaxChannels)
+    /// \param delivery Delivery guarantees of the channel
+    ///
+    /// \see getChannelDelivery
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChannelDelivery(std::size_t channel, Delivery delivery);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the delivery guarantees of a channel
+    ///
+    /// \param channel Index of the channel, in range [0, MaxChannels)
+    ///
+    /// \return Delivery guarantees of the channel
+    ///
+    /// \see setChannelDelivery
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Delivery getChannelDelivery(std::size_t channel) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time after which a silent peer is considered disconnected
+    ///
+    /// The connection sends a small keep-alive datagram when
+    /// it has nothing else to send, so this only triggers if
+    /// the remote peer stops calling update or flush.
+    /// The default timeout is 10 seconds.
+    ///
+    /// \param timeout Maximum time without receiving anything from the peer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTimeout(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Simulate packet loss, duplication and latency
+    ///
+    /// This is meant for testing an application locally under
+    /// the conditions of a real network. The simulation only
+    /// applies to the datagrams sent by this connection, so
+    /// it is usually enabled on both peers.
+    /// Passing a default-constructed Simulation disables it.
+    ///
+    /// \param simulation Network conditions to simulate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSimulation(const Simulation& simulation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a packet to be sent to the remote peer
+    ///
+    /// The packet is copied, so it can be modified or reused
+    /// right after this call. It is actually sent by the next
+    /// call to update or flush, along with the other queued
+    /// messages. Packets larger than MaxFragmentSize are split
+    /// into fragments and reassembled by the remote peer.
+    ///
+    /// \param packet  Packet to send
+    /// \param channel Index of the channel, in range [0, MaxChannels)
+    ///
+    /// \return sf::Socket::Status::Done if the packet was queued,
+    ///         sf::Socket::Status::Error if it is too large or the
+    ///         channel doesn't exist
+    ///
+    /// \see receive, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status send(Packet& packet, std::size_t channel = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next packet delivered by the remote peer
+    ///
+    /// This function never blocks: datagrams are received by
+    /// update or handleDatagram, and this function only returns
+    /// the messages that they completed.
+    ///
+    /// \param packet  Packet to fill with the received data
+    /// \param channel Filled with the channel the packet was sent on
+    ///
+    /// \return sf::Socket::Status::Done if a packet was received,
+    ///         sf::Socket::Status::NotReady if there is none
+    ///
+    /// \see send, update
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status receive(Packet& packet, std::size_t& channel);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive pending datagrams and send queued data
+    ///
+    /// This reads all the datagrams waiting on the socket
+    /// without blocking, handles those that come from the remote
+    /// peer and ignores the others, then calls flush.
+    /// Call it regularly, for example once per frame.
+    ///
+    /// When several connections share the same socket, receive
+    /// the datagrams yourself, pass each one to handleDatagram
+    /// of the matching connection and call flush instead.
+    ///
+    /// \return sf::Socket::Status::Disconnected if the peer timed out,
+    ///         sf::Socket::Status::Error if the socket failed,
+    ///         sf::Socket::Status::Done otherwise
+    ///
+    /// \see flush, handleDatagram
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle a datagram received from the remote peer
+    ///
+    /// Malformed datagrams are ignored.
+    ///
+    /// \param data Pointer to the bytes of the datagram
+    /// \param size Number of bytes in the datagram
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void handleDatagram(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send queued messages, acknowledgements and resends
+    ///
+    /// Messages are packed together into as few datagrams as
+    /// possible. Reliable messages that were not acknowledged
+    /// within the retransmission timeout, which is derived from
+    /// the measured round-trip time, are sent again.
+    ///
+    /// \return sf::Socket::Status::Disconnected if the peer timed out,
+    ///         sf::Socket::Status::Error if the socket failed,
+    ///         sf::Socket::Status::Done otherwise
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Socket::Status flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the smoothed round-trip time to the remote peer
+    ///
+    /// \return Estimated round-trip time
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Time getRoundTripTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of reliable messages not yet acknowledged
+    ///
+    /// \return Number of reliable messages waiting for an acknowledgement, on all channels
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t getPendingReliableCount() const;
+
+private:
+    struct UdpConnectionImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unique_ptr<UdpConnectionImpl> m_impl; //!< Opaque pointer to the implementation
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UdpConnection
+/// \ingroup network
+///
+/// UDP sockets are fast but give no guarantees: datagrams
+/// may be lost, duplicated or reordered, and they can't be
+/// larger than sf::UdpSocket::MaxDatagramSize. TCP sockets
+/// are reliable, but a single lost segment delays all the
+/// data that follows it (head-of-line blocking).
+///
+/// sf::UdpConnection sits in between. It exchanges messages
+/// (sf::Packet) with a remote peer over a sf::UdpSocket, on
+/// up to MaxChannels independent channels. Each channel is
+/// either unreliable, reliable-unordered or reliable-ordered,
+/// and a lost message on one channel never delays another one.
+///
+/// Each datagram carries a sequence number, and the sequence
+/// numbers of the last 33 datagrams received from the peer.
+/// When a datagram is acknowledged, the reliable messages that
+/// it carried are considered delivered; those that remain
+/// unacknowledged for too long are sent again in a later
+/// datagram (selective resend). The round-trip time measured
+/// from these acknowledgements sets the retransmission timeout.
+/// Large messages are split into fragments that are
+/// acknowledged individually and reassembled on arrival.
+///
+/// Both peers must use sf::UdpConnection; there is no
+/// handshake, a connection simply talks to the address and
+/// port it was constructed with.
+///
+/// The simulation (see setSimulation) drops, duplicates and
+/// delays outgoing datagrams, which makes it easy to test an
+/// application against a bad network on a single machine.
+///
+/// Usage example:
+/// \code
+/// sf::UdpSocket socket;
+/// if (socket.bind(54000) != sf::Socket::Status::Done)
+/// {
+///     // error...
+/// }
+///
+/// sf::UdpConnection connection(socket, serverAddress, 54000);
+/// connection.setChannelDelivery(1, sf::UdpConnection::Delivery::Unreliable);
+///
+/// while (running)
+/// {
+///     // Player actions must arrive, in order
+///     sf::Packet action;
+///     action << "jump";
+///     if (connection.send(action, 0) != sf::Socket::Status::Done)
+///     {
+///         // error...
+///     }
+///
+///     // Positions are sent every frame, losing one doesn't matter
+///     sf::Packet position;
+///     position << x << y;
+///     (void)connection.send(position, 1);
+///
+///     if (connection.update() == sf::Socket::Status::Disconnected)
+///         break;
+///
+///     sf::Packet  packet;
+///     std::size_t channel = 0;
+///     while (connection.receive(packet, channel) == sf::Socket::Status::Done)
+///     {
+///         // handle the packet...
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
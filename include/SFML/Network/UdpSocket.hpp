@@ -55,6 +55,31 @@ public:
     // NOLINTNEXTLINE(readability-identifier-naming)
     static constexpr std::size_t MaxDatagramSize{65507}; //!< The maximum number of bytes that can be sent in a single UDP datagram
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram to send with sendBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct OutgoingDatagram
+    {
+        const void*    data{};                        //!< Pointer to the sequence of bytes to send
+        std::size_t    size{};                        //!< Number of bytes to send
+        IpAddress      remoteAddress{IpAddress::Any}; //!< Address of the receiver
+        unsigned short remotePort{};                  //!< Port of the receiver to send the data to
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram filled by receiveBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct IncomingDatagram
+    {
+        void*                    data{};        //!< Pointer to the array to fill with the received bytes
+        std::size_t              capacity{};    //!< Maximum number of bytes that can be received
+        std::size_t              size{};        //!< Number of bytes actually received
+        std::optional<IpAddress> remoteAddress; //!< Address of the peer that sent the datagram
+        unsigned short           remotePort{};  //!< Port of the peer that sent the datagram
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -89,6 +114,11 @@ public:
     /// function is called, it will be unbound from the previous
     /// port before being bound to the new one.
     ///
+    /// Binding to an IPv6 address, like sf::IpAddress::AnyV6, lets
+    /// the socket communicate with both IPv6 and IPv4 peers. A
+    /// socket that is not bound uses the version of the first
+    /// address it sends data to.
+    ///
     /// \param port    Port to bind the socket to
     /// \param address Address of the interface to bind to
     ///
@@ -194,11 +224,64 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] Status receive(Packet& packet, std::optional<IpAddress>& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams to remote peers
+    ///
+    /// The datagrams are sent in order, with as few system calls
+    /// as possible: sendmmsg on Linux, which also lets the kernel
+    /// split runs of equally sized datagrams to the same peer
+    /// (UDP segmentation offload). Other systems send the datagrams
+    /// one by one.
+    /// In non-blocking mode, this function may send only the first
+    /// datagrams and return sf::Socket::Status::Partial; \a sent
+    /// then tells where to resume. Each datagram must not be
+    /// larger than UdpSocket::MaxDatagramSize.
+    /// This function doesn't allocate memory.
+    ///
+    /// \param datagrams Pointer to the datagrams to send
+    /// \param count     Number of datagrams to send
+    /// \param sent      The number of datagrams sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see receiveBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status sendBatch(const OutgoingDatagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several datagrams from remote peers
+    ///
+    /// In blocking mode, this function waits until at least one
+    /// datagram is available. It then fills as many of the
+    /// given datagrams as there are datagrams ready, without
+    /// waiting any further, using as few system calls as
+    /// possible: recvmmsg on Linux, one call per datagram on
+    /// other systems.
+    /// The \a data and \a capacity members of each datagram must
+    /// be set by the caller, the other members are filled by
+    /// this function. As with receive, the buffers must be large
+    /// enough for the datagrams that you intend to receive.
+    /// This function doesn't allocate memory.
+    ///
+    /// \param datagrams Pointer to the datagrams to fill
+    /// \param count     Number of datagrams that can be received
+    /// \param received  The number of datagrams received will be written here
+    ///
+    /// \return Status code, sf::Socket::Status::Done if at least one datagram was received
+    ///
+    /// \see sendBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Status receiveBatch(IncomingDatagram* datagrams, std::size_t count, std::size_t& received);
+
 private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     std::vector<std::byte> m_buffer{MaxDatagramSize}; //!< Temporary buffer holding the received data in Receive(Packet)
+    bool                   m_useSegmentation{true};   //!< Whether sendBatch may use UDP segmentation offload
+    IpAddress::Type        m_addressType{};           //!< Version of the addresses used by the socket
 };
 
 } // namespace sf
@@ -249,6 +332,10 @@ private:
 /// function if necessary, to stop receiving messages or
 /// make the port available for other sockets.
 ///
+/// Servers exchanging many datagrams can use sendBatch and
+/// receiveBatch, which process several datagrams per system
+/// call where the operating system allows it.
+///
 /// Usage example:
 /// \code
 /// // ----- The client -----
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Input stream reading ahead of another stream in a background thread
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API PrefetchInputStream : public InputStream
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Buffering state and health of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        std::size_t   windowSize{};   //!< Maximum number of bytes read ahead of the current position
+        std::size_t   bufferedSize{}; //!< Number of bytes ready to be read from the current position
+        std::uint64_t fetchedSize{};  //!< Total number of bytes read from the source stream
+        std::uint64_t stallCount{};   //!< Number of reads that had to wait for the source stream
+        Time          stallTime;      //!< Total time spent waiting for the source stream
+        bool          endOfStream{};  //!< True if the source stream has been read up to its end
+        bool          error{};        //!< True if the source stream reported an error
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the stream and start reading ahead
+    ///
+    /// Reading starts from the current position of \a source.
+    /// From then on, the source stream is only accessed from the
+    /// background thread and must not be used directly until
+    /// this stream is destroyed.
+    ///
+    /// \param source     Stream to read ahead of
+    /// \param windowSize Maximum number of bytes read ahead of the current position
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PrefetchInputStream(InputStream& source, std::size_t windowSize = 256 * 1024);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the background thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PrefetchInputStream() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    PrefetchInputStream(const PrefetchInputStream&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    PrefetchInputStream& operator=(const PrefetchInputStream&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// Data already fetched is copied without touching the source
+    /// stream. If not enough data is ready, this function waits for
+    /// the background thread to fetch it.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or `std::nullopt` on error
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<std::size_t> read(void* data, std::size_t size) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// Seeking within the window of fetched data is free, seeking
+    /// outside of it discards the window and restarts reading
+    /// ahead from the new position.
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or `std::nullopt` on error
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<std::size_t> seek(std::size_t position) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or `std::nullopt` on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::optional<std::size_t> tell() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or `std::nullopt` on error
+    ///
+    ////////////////////////////////////////////////////////////
+    std::optional<std::size_t> getSize() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a read of the given size would complete without waiting
+    ///
+    /// This is the case if enough data has already been fetched,
+    /// or if the source stream has reached its end or failed.
+    ///
+    /// \param size Number of bytes to read
+    ///
+    /// \return True if reading \a size bytes would not wait for the source stream
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isAvailable(std::size_t size) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buffering state and health of the stream
+    ///
+    /// \return Current statistics of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] Statistics getStatistics() const;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the background thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void fetch();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    InputStream&               m_source;         //!< Stream to read ahead of
+    std::optional<std::size_t> m_size;           //!< Size of the source stream
+    std::vector<std::byte>     m_window;         //!< Circular buffer of fetched data
+    std::size_t                m_windowBegin{};  //!< Position of the oldest byte kept in the window
+    std::size_t                m_windowEnd{};    //!< Position following the last fetched byte
+    std::size_t                m_position{};     //!< Current reading position
+    std::uint64_t              m_seekCount{};    //!< Incremented whenever the window is discarded
+    Statistics                 m_statistics;     //!< Buffering statistics
+    bool                       m_stopping{};     //!< Tells the background thread to stop
+    mutable std::mutex         m_mutex;          //!< Mutex protecting the state shared with the background thread
+    std::condition_variable    m_dataCondition;  //!< Signaled when data has been fetched
+    std::condition_variable    m_spaceCondition; //!< Signaled when space is available in the window
+    std::thread                m_thread;         //!< Background thread reading from the source stream
+};
+
+} // namespace sf
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PrefetchInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that wraps
+/// another stream and keeps a window of data read ahead of the
+/// current position, fetched in a background thread.
+///
+/// It is useful when the source stream is slow or has an
+/// unpredictable latency, for example when it decompresses
+/// data from an archive or receives it over a network: reads
+/// are served from memory as long as the background thread
+/// keeps up, and isAvailable() can be used to avoid blocking
+/// on data that is not there yet.
+///
+/// getStatistics() reports how much data is ready, and how
+/// often and how long reads had to wait for the source stream.
+///
+/// Usage example:
+/// \code
+/// ZipStream zipStream("resources.zip");
+/// if (!zipStream.open("musics/msc.ogg"))
+/// {
+///     // Handle error...
+/// }
+///
+/// sf::PrefetchInputStream stream(zipStream, 512 * 1024);
+/// process(stream);
+/// \endcode
+///
+/// \see InputStream, sf::Music::openFromStream
+///
+////////////////////////////////////////////////////////////
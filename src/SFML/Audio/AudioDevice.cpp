@@ -27,12 +27,14 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/PlaybackDevice.hpp>
+#include <SFML/Audio/SoundAnalyzer.hpp>
 
 #include <SFML/System/Err.hpp>
 
 #include <algorithm>
 #include <array>
 #include <ostream>
+#include <thread>
 #include <unordered_map>
 
 #include <cassert>
@@ -40,6 +42,40 @@
 
 namespace sf::priv
 {
+////////////////////////////////////////////////////////////
+void AnalyzerSlot::set(SoundAnalyzer* analyzer)
+{
+    // Sequentially consistent operations: if the audio thread registered itself after the
+    // counter is read below, its load of the pointer is guaranteed to see the new analyzer
+    m_analyzer.store(analyzer);
+
+    while (m_users.load() != 0)
+        std::this_thread::yield();
+}
+
+
+////////////////////////////////////////////////////////////
+bool AnalyzerSlot::isSet() const
+{
+    return m_analyzer.load() != nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyzerSlot::process(const float*  frames,
+                           unsigned int frameCount,
+                           unsigned int channelCount,
+                           unsigned int sampleRate)
+{
+    ++m_users;
+
+    if (auto* analyzer = m_analyzer.load())
+        analyzer->process(frames, frameCount, channelCount, sampleRate);
+
+    --m_users;
+}
+
+
 namespace
 {
 // Instead of a variable in an anonymous namespace,
@@ -53,6 +89,15 @@ std::optional<std::string>& getCurrentDevice()
     static std::optional<std::string> currentDevice;
     return currentDevice;
 }
+
+
+////////////////////////////////////////////////////////////
+void applySpatialUpdate(const AudioDevice::SpatialUpdate& update)
+{
+    ma_sound_set_position(update.sound, update.position.x, update.position.y, update.position.z);
+    ma_sound_set_velocity(update.sound, update.velocity.x, update.velocity.y, update.velocity.z);
+    ma_sound_set_direction(update.sound, update.direction.x, update.direction.y, update.direction.z);
+}
 } // namespace
 
 
@@ -452,6 +497,187 @@ Vector3f AudioDevice::getUpVector()
 }
 
 
+////////////////////////////////////////////////////////////
+void AudioDevice::queueSpatialUpdates(const SpatialUpdate* updates, std::size_t count)
+{
+    auto* instance = getInstance();
+
+    // Without a running engine there is no audio thread to race with, apply the updates right away
+    if (!instance || !instance->m_engine)
+    {
+        std::for_each(updates, updates + count, applySpatialUpdate);
+
+        return;
+    }
+
+    const std::lock_guard lock(instance->m_spatialUpdatesMutex);
+    auto&                 spatialUpdates = instance->m_spatialUpdates;
+
+    // Replace the pending update of a sound rather than piling them up while the audio thread is busy
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const SpatialUpdate& update = updates[i];
+        SpatialUpdateSlot&   slot   = instance->m_spatialUpdateSlots[update.sound];
+
+        if (slot.batch == instance->m_spatialUpdateBatch)
+        {
+            spatialUpdates[slot.index] = update;
+        }
+        else
+        {
+            slot = {instance->m_spatialUpdateBatch, spatialUpdates.size()};
+            spatialUpdates.push_back(update);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::discardSpatialUpdates(const ma_sound* sound)
+{
+    auto* instance = getInstance();
+
+    if (!instance)
+        return;
+
+    const std::lock_guard lock(instance->m_spatialUpdatesMutex);
+    auto&                 spatialUpdates = instance->m_spatialUpdates;
+    spatialUpdates.erase(std::remove_if(spatialUpdates.begin(),
+                                        spatialUpdates.end(),
+                                        [sound](const SpatialUpdate& update) { return update.sound == sound; }),
+                         spatialUpdates.end());
+
+    // The remaining updates may have moved
+    instance->m_spatialUpdateSlots.erase(sound);
+    for (std::size_t i = 0; i < spatialUpdates.size(); ++i)
+        instance->m_spatialUpdateSlots[spatialUpdates[i].sound].index = i;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::applySpatialUpdates()
+{
+    // Never block the audio thread, if the game thread is currently
+    // submitting a batch we will pick it up during the next period
+    const std::unique_lock lock(m_spatialUpdatesMutex, std::try_to_lock);
+
+    if (!lock.owns_lock() || m_spatialUpdates.empty())
+        return;
+
+    std::for_each(m_spatialUpdates.begin(), m_spatialUpdates.end(), applySpatialUpdate);
+
+    // Keep the capacity and the slots around so that submitting the next batch doesn't allocate
+    m_spatialUpdates.clear();
+    ++m_spatialUpdateBatch;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::setAnalyzer(SoundAnalyzer* analyzer)
+{
+    getAnalyzer().set(analyzer);
+}
+
+
+////////////////////////////////////////////////////////////
+PlaybackDevice::Statistics AudioDevice::getStatistics()
+{
+    const auto& statistics = getCallbackStatistics();
+
+    PlaybackDevice::Statistics result;
+    result.periodCount          = statistics.periodCount.load(std::memory_order_relaxed);
+    result.deadlineMissCount    = statistics.deadlineMissCount.load(std::memory_order_relaxed);
+    result.underrunCount        = statistics.underrunCount.load(std::memory_order_relaxed);
+    result.activeVoiceCount     = statistics.activeVoiceCount.load(std::memory_order_relaxed);
+    result.periodDuration       = microseconds(statistics.periodDuration.load(std::memory_order_relaxed));
+    result.lastCallbackDuration = microseconds(statistics.lastCallbackDuration.load(std::memory_order_relaxed));
+    result.maxCallbackDuration  = microseconds(statistics.maxCallbackDuration.load(std::memory_order_relaxed));
+
+    for (std::size_t i = 0; i < result.callbackLoadHistogram.size(); ++i)
+        result.callbackLoadHistogram[i] = statistics.callbackLoadHistogram[i].load(std::memory_order_relaxed);
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::resetStatistics()
+{
+    auto& statistics = getCallbackStatistics();
+
+    statistics.periodCount.store(0, std::memory_order_relaxed);
+    statistics.deadlineMissCount.store(0, std::memory_order_relaxed);
+    statistics.underrunCount.store(0, std::memory_order_relaxed);
+    statistics.activeVoiceCount.store(0, std::memory_order_relaxed);
+    statistics.periodDuration.store(0, std::memory_order_relaxed);
+    statistics.lastCallbackDuration.store(0, std::memory_order_relaxed);
+    statistics.maxCallbackDuration.store(0, std::memory_order_relaxed);
+
+    for (auto& bucket : statistics.callbackLoadHistogram)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+std::uint64_t AudioDevice::getPeriodIndex()
+{
+    return getCallbackStatistics().periodIndex.load(std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::countActiveVoice()
+{
+    getCallbackStatistics().currentVoiceCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::countUnderrun()
+{
+    getCallbackStatistics().underrunCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::beginPeriod()
+{
+    auto& statistics = getCallbackStatistics();
+
+    statistics.periodIndex.fetch_add(1, std::memory_order_relaxed);
+    statistics.currentVoiceCount.store(0, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::endPeriod(std::chrono::steady_clock::time_point start, ma_uint32 frameCount, ma_uint32 sampleRate)
+{
+    auto& statistics = getCallbackStatistics();
+
+    const auto elapsed  = std::chrono::steady_clock::now() - start;
+    const auto duration = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    const auto period   = sampleRate ? static_cast<std::int64_t>(frameCount) * 1'000'000 / sampleRate : std::int64_t{0};
+
+    statistics.periodCount.fetch_add(1, std::memory_order_relaxed);
+    statistics.activeVoiceCount.store(statistics.currentVoiceCount.load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+    statistics.periodDuration.store(period, std::memory_order_relaxed);
+    statistics.lastCallbackDuration.store(duration, std::memory_order_relaxed);
+
+    // Only the audio thread writes the maximum, a plain comparison is enough
+    if (duration > statistics.maxCallbackDuration.load(std::memory_order_relaxed))
+        statistics.maxCallbackDuration.store(duration, std::memory_order_relaxed);
+
+    // Sort the period into the load histogram, by steps of 10% of the period duration
+    const auto bucket = getLoadHistogramBucket(duration, period);
+    statistics.callbackLoadHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    if (duration > period)
+        statistics.deadlineMissCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+
 ////////////////////////////////////////////////////////////
 std::optional<ma_device_id> AudioDevice::getSelectedDeviceId() const
 {
@@ -488,9 +714,22 @@ bool AudioDevice::initialize()
 
         if (audioDevice.m_engine)
         {
+            const auto start = std::chrono::steady_clock::now();
+            beginPeriod();
+
+            // Apply the spatial updates submitted since the last period before mixing
+            audioDevice.applySpatialUpdates();
+
             if (const auto result = ma_engine_read_pcm_frames(&*audioDevice.m_engine, output, frameCount, nullptr);
                 result != MA_SUCCESS)
                 err() << "Failed to read PCM frames from audio engine: " << ma_result_description(result) << std::endl;
+
+            getAnalyzer().process(static_cast<const float*>(output),
+                                  frameCount,
+                                  device->playback.channels,
+                                  device->sampleRate);
+
+            endPeriod(start, frameCount, device->sampleRate);
         }
     };
     playbackDeviceConfig.pUserData          = this;
@@ -587,4 +826,20 @@ AudioDevice::ListenerProperties& AudioDevice::getListenerProperties()
     return properties;
 }
 
+
+////////////////////////////////////////////////////////////
+AnalyzerSlot& AudioDevice::getAnalyzer()
+{
+    static AnalyzerSlot analyzer;
+    return analyzer;
+}
+
+
+////////////////////////////////////////////////////////////
+AudioDevice::CallbackStatistics& AudioDevice::getCallbackStatistics()
+{
+    static CallbackStatistics statistics;
+    return statistics;
+}
+
 } // namespace sf::priv
@@ -28,20 +28,90 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/PlaybackDevice.hpp>
 
 #include <SFML/System/Vector3.hpp>
 
 #include <miniaudio.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+
+
+////////////////////////////////////////////////////////////
+// Forward declarations
+////////////////////////////////////////////////////////////
+namespace sf
+{
+class SoundAnalyzer;
+} // namespace sf
 
 namespace sf::priv
 {
+////////////////////////////////////////////////////////////
+/// \brief Analyzer attachment shared with the audio thread
+///
+/// The audio thread marks the slot as in use while it feeds
+/// the analyzer, so that detaching it can wait for the
+/// current period to be processed before the analyzer is
+/// destroyed.
+///
+////////////////////////////////////////////////////////////
+class AnalyzerSlot
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach an analyzer, or detach the current one
+    ///
+    /// Returns once the audio thread no longer uses the
+    /// previous analyzer. Must not be called from the audio
+    /// thread.
+    ///
+    /// \param analyzer The analyzer to attach, or a null pointer to detach the current one
+    ///
+    ////////////////////////////////////////////////////////////
+    void set(SoundAnalyzer* analyzer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether an analyzer is attached
+    ///
+    /// \return True if an analyzer is attached
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isSet() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Feed the attached analyzer, if any
+    ///
+    /// Called by the audio thread.
+    ///
+    /// \param frames       Interleaved audio frames
+    /// \param frameCount   Number of frames
+    /// \param channelCount Number of channels of the frames
+    /// \param sampleRate   Sample rate of the frames
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(const float* frames, unsigned int frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+private:
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::atomic<SoundAnalyzer*> m_analyzer{}; //!< The attached analyzer
+    std::atomic<unsigned int>   m_users{};    //!< Number of audio threads feeding the analyzer
+};
+
 ////////////////////////////////////////////////////////////
 /// \brief High-level wrapper around the audio API, it manages
 ///        the creation and destruction of the audio device and
@@ -324,6 +394,111 @@ public:
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
 
+    struct SpatialUpdate
+    {
+        ma_sound* sound{};
+        Vector3f  position;
+        Vector3f  velocity;
+        Vector3f  direction;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue spatial updates to be applied by the audio thread
+    ///
+    /// The updates are applied all at once at the beginning of
+    /// the next audio period, before any sound is mixed. If no
+    /// engine is running, they are applied immediately.
+    /// Only the latest update of each sound is kept, so the
+    /// queue never holds more updates than there are sounds.
+    ///
+    /// \param updates Pointer to the array of updates to queue
+    /// \param count   Number of updates in the array
+    ///
+    /// \see discardSpatialUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void queueSpatialUpdates(const SpatialUpdate* updates, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard all queued spatial updates targeting a sound
+    ///
+    /// This must be called before a sound that might have
+    /// pending updates is uninitialized.
+    ///
+    /// \param sound The sound whose pending updates should be discarded
+    ///
+    /// \see queueSpatialUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void discardSpatialUpdates(const ma_sound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the analyzer fed with the final mix
+    ///
+    /// The analyzer is fed by the audio thread right after
+    /// the engine has mixed each period. Detaching waits for
+    /// the audio thread to be done with the previous analyzer.
+    ///
+    /// \param analyzer The analyzer to attach, or a null pointer to detach it
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setAnalyzer(SoundAnalyzer* analyzer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the audio thread
+    ///
+    /// \return Statistics accumulated since the last reset
+    ///
+    ////////////////////////////////////////////////////////////
+    static PlaybackDevice::Statistics getStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the timing statistics of the audio thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the load histogram bucket of a period
+    ///
+    /// A period that takes exactly its own duration still meets
+    /// its deadline and goes to the bucket just before the last.
+    ///
+    /// \param callbackDuration Processing time of the period, in microseconds
+    /// \param periodDuration   Duration of the audio produced by the period, in microseconds
+    ///
+    /// \return Index of the bucket in PlaybackDevice::Statistics::callbackLoadHistogram
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::size_t getLoadHistogramBucket(std::int64_t callbackDuration, std::int64_t periodDuration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the period currently being processed
+    ///
+    /// Unlike the statistics, the index is never reset, which
+    /// makes it suitable to detect the first time a sound is
+    /// processed during a period.
+    ///
+    /// \return Index of the current period
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::uint64_t getPeriodIndex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a sound as active during the current period
+    ///
+    /// This function must only be called by the audio thread,
+    /// once per sound and per period.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void countActiveVoice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a stream that had no data ready while playing
+    ///
+    ////////////////////////////////////////////////////////////
+    static void countUnderrun();
+
 private:
     ////////////////////////////////////////////////////////////
     /// \brief Get the device ID of the currently selected device
@@ -367,15 +542,106 @@ private:
     ////////////////////////////////////////////////////////////
     static ListenerProperties& getListenerProperties();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the analyzer fed with the final mix
+    ///
+    /// \return The analyzer slot
+    ///
+    ////////////////////////////////////////////////////////////
+    static AnalyzerSlot& getAnalyzer();
+
+    struct CallbackStatistics
+    {
+        std::atomic<std::uint64_t> periodIndex{};
+        std::atomic<std::uint64_t> periodCount{};
+        std::atomic<std::uint64_t> deadlineMissCount{};
+        std::atomic<std::uint64_t> underrunCount{};
+        std::atomic<unsigned int>  currentVoiceCount{};
+        std::atomic<unsigned int>  activeVoiceCount{};
+        std::atomic<std::int64_t>  periodDuration{};
+        std::atomic<std::int64_t>  lastCallbackDuration{};
+        std::atomic<std::int64_t>  maxCallbackDuration{};
+        std::array<std::atomic<std::uint64_t>, PlaybackDevice::Statistics::HistogramSize> callbackLoadHistogram{};
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics updated by the audio thread
+    ///
+    /// Durations are stored in microseconds.
+    ///
+    /// \return The timing statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static CallbackStatistics& getCallbackStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the timing statistics at the beginning of a period
+    ///
+    ////////////////////////////////////////////////////////////
+    static void beginPeriod();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the timing statistics at the end of a period
+    ///
+    /// \param start      Time point at which the period began
+    /// \param frameCount Number of frames produced during the period
+    /// \param sampleRate Sample rate of the playback device
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endPeriod(std::chrono::steady_clock::time_point start, ma_uint32 frameCount, ma_uint32 sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Position of the queued update of a sound
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SpatialUpdateSlot
+    {
+        std::uint64_t batch{}; //!< Batch in which the update was queued
+        std::size_t   index{}; //!< Index of the update in the queue
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the queued spatial updates
+    ///
+    /// This function is called by the audio thread at the
+    /// beginning of each period. It never blocks: if the queue
+    /// is currently being written to, the updates are applied
+    /// during the next period instead.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applySpatialUpdates();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::optional<ma_log>     m_log;            //!< The miniaudio log
-    std::optional<ma_context> m_context;        //!< The miniaudio context
-    std::optional<ma_device>  m_playbackDevice; //!< The miniaudio playback device
-    std::optional<ma_engine>  m_engine;         //!< The miniaudio engine (used for effects and spatialisation)
-    ResourceEntryList         m_resources;      //!< Registered resources
-    std::mutex                m_resourcesMutex; //!< The mutex guarding the registered resources
+    std::optional<ma_log>                                  m_log;                   //!< The miniaudio log
+    std::optional<ma_context>                              m_context;               //!< The miniaudio context
+    std::optional<ma_device>                               m_playbackDevice;        //!< The miniaudio playback device
+    std::optional<ma_engine>                               m_engine;                //!< The miniaudio engine (used for effects and spatialisation)
+    ResourceEntryList                                      m_resources;             //!< Registered resources
+    std::mutex                                             m_resourcesMutex;        //!< The mutex guarding the registered resources
+    std::vector<SpatialUpdate>                             m_spatialUpdates;        //!< Spatial updates waiting to be applied by the audio thread
+    std::unordered_map<const ma_sound*, SpatialUpdateSlot> m_spatialUpdateSlots;    //!< Position of the update of each sound in the queue
+    std::uint64_t                                          m_spatialUpdateBatch{1}; //!< Number of the batch being queued, slots of older batches are stale
+    std::mutex                                             m_spatialUpdatesMutex;   //!< The mutex guarding the queued spatial updates
 };
 
+////////////////////////////////////////////////////////////
+// Defined in the header so that the tests can check the bucket edges
+////////////////////////////////////////////////////////////
+inline std::size_t AudioDevice::getLoadHistogramBucket(std::int64_t callbackDuration, std::int64_t periodDuration)
+{
+    constexpr std::size_t lastBucket = PlaybackDevice::Statistics::HistogramSize - 1;
+
+    // The last bucket holds exactly the periods that missed their deadline
+    if (callbackDuration > periodDuration)
+        return lastBucket;
+
+    if (periodDuration <= 0)
+        return 0;
+
+    const auto bucket = callbackDuration * 10 / periodDuration;
+    return std::min(static_cast<std::size_t>(std::max(bucket, std::int64_t{0})), lastBucket - 1);
+}
+
 } // namespace sf::priv
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct CompressedSound::Impl
+{
+    explicit Impl(const CompressedSoundBuffer& theBuffer) :
+    buffer(&theBuffer),
+    file(InputSoundFile::openFromMemory(theBuffer.getData(), theBuffer.getDataSize())),
+
+    // Decode a tenth of a second at a time, to keep the state of each voice small
+    samples(theBuffer.getSampleRate() * theBuffer.getChannelCount() / 10)
+    {
+        if (!file.has_value())
+            err() << "Failed to open compressed sound buffer decoder" << std::endl;
+    }
+
+    const CompressedSoundBuffer*  buffer;  //!< Compressed sound buffer being played
+    std::optional<InputSoundFile> file;    //!< Decoder reading from the buffer
+    std::vector<std::int16_t>     samples; //!< Decoded samples of the current chunk
+    std::mutex                    mutex;   //!< Mutex protecting the decoder
+};
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::CompressedSound(const CompressedSoundBuffer& buffer) : m_impl(std::make_unique<Impl>(buffer))
+{
+    SoundStream::initialize(buffer.getChannelCount(), buffer.getSampleRate(), buffer.getChannelMap());
+    buffer.attachSound(this);
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::~CompressedSound()
+{
+    // We must stop before destroying the decoder
+    if (m_impl != nullptr)
+    {
+        stop();
+        if (m_impl->buffer)
+            m_impl->buffer->detachSound(this);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::CompressedSound(CompressedSound&& right) noexcept :
+SoundStream(std::move(right)),
+m_impl(std::move(right.m_impl))
+{
+    // The buffer keeps track of the sound by address
+    if (m_impl && m_impl->buffer)
+    {
+        m_impl->buffer->detachSound(&right);
+        m_impl->buffer->attachSound(this);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound& CompressedSound::operator=(CompressedSound&& right) noexcept
+{
+    if (this == &right)
+        return *this;
+
+    // Detach the sound instance from the previous buffer (if any)
+    if (m_impl && m_impl->buffer)
+    {
+        stop();
+        m_impl->buffer->detachSound(this);
+    }
+
+    SoundStream::operator=(std::move(right));
+    m_impl = std::move(right.m_impl);
+
+    if (m_impl && m_impl->buffer)
+    {
+        m_impl->buffer->detachSound(&right);
+        m_impl->buffer->attachSound(this);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+const CompressedSoundBuffer& CompressedSound::getBuffer() const
+{
+    assert(m_impl->buffer && "CompressedSound::getBuffer() Cannot return reference to null buffer");
+    return *m_impl->buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::rebindBuffer(const CompressedSoundBuffer& buffer)
+{
+    m_impl->buffer = &buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::detachBuffer()
+{
+    // First stop the sound, so that the decoder is no longer used
+    stop();
+
+    const std::lock_guard lock(m_impl->mutex);
+    m_impl->file.reset();
+    m_impl->buffer = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSound::onGetData(SoundStream::Chunk& data)
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    if (!m_impl->file.has_value())
+        return false;
+
+    data.samples     = m_impl->samples.data();
+    data.sampleCount = static_cast<std::size_t>(m_impl->file->read(m_impl->samples.data(), m_impl->samples.size()));
+
+    // Check if we have stopped obtaining samples or reached the end of the sound
+    return (data.sampleCount != 0) && (m_impl->file->getSampleOffset() < m_impl->file->getSampleCount());
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::onSeek(Time timeOffset)
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    if (m_impl->file.has_value())
+        m_impl->file->seek(timeOffset);
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::uint64_t> CompressedSound::onLoop()
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    if (!getLoop() || !m_impl->file.has_value())
+        return std::nullopt;
+
+    m_impl->file->seek(0);
+    return 0;
+}
+
+} // namespace sf
@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+
+#include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/InputStream.hpp>
+
+#include <ostream>
+#include <utility>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::CompressedSoundBuffer(const CompressedSoundBuffer& copy) :
+m_data(copy.m_data),
+m_sampleCount(copy.m_sampleCount),
+m_sampleRate(copy.m_sampleRate),
+m_channelMap(copy.m_channelMap),
+m_duration(copy.m_duration)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::CompressedSoundBuffer(CompressedSoundBuffer&& right) noexcept :
+m_data(std::move(right.m_data)),
+m_sampleCount(right.m_sampleCount),
+m_sampleRate(right.m_sampleRate),
+m_channelMap(std::move(right.m_channelMap)),
+m_duration(right.m_duration),
+m_sounds(std::move(right.m_sounds))
+{
+    // Moving the vector keeps its storage, so the decoders of the
+    // sounds can keep reading from it: only the owner changes
+    right.m_sounds.clear();
+    for (CompressedSound* soundPtr : m_sounds)
+        soundPtr->rebindBuffer(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::~CompressedSoundBuffer()
+{
+    // To prevent the iterator from becoming invalid, move the entire buffer to another
+    // container. Otherwise calling detachBuffer would result in detachSound being
+    // called which removes the sound from the internal list.
+    SoundList sounds;
+    sounds.swap(m_sounds);
+
+    // Detach the buffer from the sounds that use it
+    for (CompressedSound* soundPtr : sounds)
+        soundPtr->detachBuffer();
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<CompressedSoundBuffer> CompressedSoundBuffer::loadFromFile(const std::filesystem::path& filename)
+{
+    if (auto stream = FileInputStream::open(filename))
+        return loadFromStream(*stream);
+
+    err() << "Failed to open compressed sound buffer from file" << std::endl;
+    return std::nullopt;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<CompressedSoundBuffer> CompressedSoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes == 0)
+    {
+        err() << "Failed to open compressed sound buffer from memory (no data)" << std::endl;
+        return std::nullopt;
+    }
+
+    const auto* bytes = static_cast<const std::byte*>(data);
+    return initialize(std::vector<std::byte>(bytes, bytes + sizeInBytes), "memory");
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<CompressedSoundBuffer> CompressedSoundBuffer::loadFromStream(InputStream& stream)
+{
+    if (stream.seek(0) != 0)
+    {
+        err() << "Failed to open compressed sound buffer from stream (cannot restart stream)" << std::endl;
+        return std::nullopt;
+    }
+
+    // Read the whole stream, in one go if its size is known
+    std::vector<std::byte> data(stream.getSize().value_or(64 * 1024));
+    std::size_t            size = 0;
+
+    while (true)
+    {
+        if (size == data.size())
+            data.resize(data.size() * 2);
+
+        const std::optional<std::size_t> count = stream.read(data.data() + size, data.size() - size);
+        if (!count.has_value())
+        {
+            err() << "Failed to open compressed sound buffer from stream (read error)" << std::endl;
+            return std::nullopt;
+        }
+
+        if (*count == 0)
+            break;
+
+        size += *count;
+    }
+
+    data.resize(size);
+    data.shrink_to_fit();
+
+    return initialize(std::move(data), "stream");
+}
+
+
+////////////////////////////////////////////////////////////
+const void* CompressedSoundBuffer::getData() const
+{
+    return m_data.data();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedSoundBuffer::getDataSize() const
+{
+    return m_data.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::uint64_t CompressedSoundBuffer::getSampleCount() const
+{
+    return m_sampleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getChannelCount() const
+{
+    return static_cast<unsigned int>(m_channelMap.size());
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<SoundChannel> CompressedSoundBuffer::getChannelMap() const
+{
+    return m_channelMap;
+}
+
+
+////////////////////////////////////////////////////////////
+Time CompressedSoundBuffer::getDuration() const
+{
+    return m_duration;
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::CompressedSoundBuffer(std::vector<std::byte>&& data) : m_data(std::move(data))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<CompressedSoundBuffer> CompressedSoundBuffer::initialize(std::vector<std::byte>&& data,
+                                                                      const char*              errorContext)
+{
+    if (data.empty())
+    {
+        err() << "Failed to open compressed sound buffer from " << errorContext << " (no data)" << std::endl;
+        return std::nullopt;
+    }
+
+    // Open the data once to make sure it can be decoded and to retrieve the sound parameters
+    const auto file = InputSoundFile::openFromMemory(data.data(), data.size());
+    if (!file.has_value())
+    {
+        err() << "Failed to open compressed sound buffer from " << errorContext << std::endl;
+        return std::nullopt;
+    }
+
+    if (file->getChannelCount() == 0 || file->getSampleRate() == 0)
+    {
+        err() << "Failed to open compressed sound buffer from " << errorContext << " (invalid sound parameters)"
+              << std::endl;
+        return std::nullopt;
+    }
+
+    CompressedSoundBuffer buffer(std::move(data));
+    buffer.m_sampleCount = file->getSampleCount();
+    buffer.m_sampleRate  = file->getSampleRate();
+    buffer.m_channelMap  = file->getChannelMap();
+    buffer.m_duration    = file->getDuration();
+    return buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::attachSound(CompressedSound* sound) const
+{
+    m_sounds.insert(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::detachSound(CompressedSound* sound) const
+{
+    m_sounds.erase(sound);
+}
+
+} // namespace sf
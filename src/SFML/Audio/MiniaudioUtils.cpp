@@ -132,6 +132,7 @@ MiniaudioUtils::SoundBase::SoundBase(const ma_data_source_vtable&     dataSource
 MiniaudioUtils::SoundBase::~SoundBase()
 {
     priv::AudioDevice::unregisterResource(resourceEntryIter);
+    priv::AudioDevice::discardSpatialUpdates(&sound);
     ma_sound_uninit(&sound);
     ma_node_uninit(&effectNode, nullptr);
     ma_data_source_uninit(&dataSourceBase);
@@ -187,9 +188,10 @@ void MiniaudioUtils::SoundBase::initialize(ma_sound_end_proc endCallback)
 
     effectNode.impl         = this;
     effectNode.channelCount = nodeChannelCount;
+    effectNode.sampleRate   = ma_engine_get_sample_rate(engine);
 
-    // Route the sound through the effect node depending on whether an effect processor is set
-    connectEffect(bool{effectProcessor});
+    // Route the sound through the effect node depending on whether an effect processor or an analyzer is set
+    connectEffect(bool{effectProcessor} || analyzer.isSet());
 
     applySettings(sound, savedSettings);
 }
@@ -198,6 +200,7 @@ void MiniaudioUtils::SoundBase::initialize(ma_sound_end_proc endCallback)
 ////////////////////////////////////////////////////////////
 void MiniaudioUtils::SoundBase::deinitialize()
 {
+    AudioDevice::discardSpatialUpdates(&sound);
     savedSettings = saveSettings(sound);
     ma_sound_uninit(&sound);
     ma_node_uninit(&effectNode, nullptr);
@@ -208,8 +211,10 @@ void MiniaudioUtils::SoundBase::deinitialize()
 void MiniaudioUtils::SoundBase::processEffect(const float** framesIn,
                                               ma_uint32&    frameCountIn,
                                               float**       framesOut,
-                                              ma_uint32&    frameCountOut) const
+                                              ma_uint32&    frameCountOut)
 {
+    const ProcessingTimer timer(*this);
+
     // If a processor is set, call it
     if (effectProcessor)
     {
@@ -217,21 +222,23 @@ void MiniaudioUtils::SoundBase::processEffect(const float** framesIn,
             frameCountIn = 0;
 
         effectProcessor(framesIn ? framesIn[0] : nullptr, frameCountIn, framesOut[0], frameCountOut, effectNode.channelCount);
-        return;
     }
-
     // Otherwise just pass the data through 1:1
-    if (framesIn == nullptr)
+    else if (framesIn == nullptr)
     {
         frameCountIn  = 0;
         frameCountOut = 0;
-        return;
+    }
+    else
+    {
+        const auto toProcess = std::min(frameCountIn, frameCountOut);
+        std::memcpy(framesOut[0], framesIn[0], toProcess * effectNode.channelCount * sizeof(float));
+        frameCountIn  = toProcess;
+        frameCountOut = toProcess;
     }
 
-    const auto toProcess = std::min(frameCountIn, frameCountOut);
-    std::memcpy(framesOut[0], framesIn[0], toProcess * effectNode.channelCount * sizeof(float));
-    frameCountIn  = toProcess;
-    frameCountOut = toProcess;
+    // Feed the analyzer with the processed data
+    analyzer.process(framesOut[0], frameCountOut, effectNode.channelCount, effectNode.sampleRate);
 }
 
 
@@ -276,6 +283,54 @@ void MiniaudioUtils::SoundBase::connectEffect(bool connect)
 }
 
 
+////////////////////////////////////////////////////////////
+void MiniaudioUtils::SoundBase::countUnderrun()
+{
+    underrunCount.fetch_add(1, std::memory_order_relaxed);
+    AudioDevice::countUnderrun();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundSource::Statistics MiniaudioUtils::SoundBase::getStatistics() const
+{
+    SoundSource::Statistics statistics;
+    statistics.processingTime    = microseconds(processingTime.load(std::memory_order_relaxed) / 1000);
+    statistics.maxProcessingTime = microseconds(maxProcessingTime.load(std::memory_order_relaxed) / 1000);
+    statistics.underrunCount     = underrunCount.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+MiniaudioUtils::SoundBase::ProcessingTimer::ProcessingTimer(SoundBase& soundBase) :
+m_soundBase(soundBase),
+m_start(std::chrono::steady_clock::now())
+{
+    // Count the sound as active the first time it is processed during a period
+    if (const auto periodIndex = AudioDevice::getPeriodIndex(); m_soundBase.lastPeriodIndex != periodIndex)
+    {
+        m_soundBase.lastPeriodIndex = periodIndex;
+        AudioDevice::countActiveVoice();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+MiniaudioUtils::SoundBase::ProcessingTimer::~ProcessingTimer()
+{
+    const auto elapsed  = std::chrono::steady_clock::now() - m_start;
+    const auto duration = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    m_soundBase.processingTime.fetch_add(duration, std::memory_order_relaxed);
+
+    // Only the audio thread writes the maximum, a plain comparison is enough
+    if (duration > m_soundBase.maxProcessingTime.load(std::memory_order_relaxed))
+        m_soundBase.maxProcessingTime.store(duration, std::memory_order_relaxed);
+}
+
+
 ////////////////////////////////////////////////////////////
 ma_channel MiniaudioUtils::soundChannelToMiniaudioChannel(SoundChannel soundChannel)
 {
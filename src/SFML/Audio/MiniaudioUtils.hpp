@@ -35,6 +35,8 @@
 
 #include <miniaudio.h>
 
+#include <atomic>
+#include <chrono>
 #include <limits>
 
 
@@ -78,8 +80,27 @@ struct SoundBase
     ~SoundBase();
     void initialize(ma_sound_end_proc endCallback);
     void deinitialize();
-    void processEffect(const float** framesIn, ma_uint32& frameCountIn, float** framesOut, ma_uint32& frameCountOut) const;
+    void processEffect(const float** framesIn, ma_uint32& frameCountIn, float** framesOut, ma_uint32& frameCountOut);
     void connectEffect(bool connect);
+    void countUnderrun();
+    [[nodiscard]] SoundSource::Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Measures the time spent processing a block of the sound on the audio thread
+    ///
+    ////////////////////////////////////////////////////////////
+    class ProcessingTimer
+    {
+    public:
+        explicit ProcessingTimer(SoundBase& soundBase);
+        ~ProcessingTimer();
+        ProcessingTimer(const ProcessingTimer&)            = delete;
+        ProcessingTimer& operator=(const ProcessingTimer&) = delete;
+
+    private:
+        SoundBase&                            m_soundBase; //!< Sound being processed
+        std::chrono::steady_clock::time_point m_start;     //!< Time point at which processing started
+    };
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -89,6 +110,7 @@ struct SoundBase
         ma_node_base base{};
         SoundBase*   impl{};
         ma_uint32    channelCount{};
+        ma_uint32    sampleRate{};
     };
 
     ma_data_source_base dataSourceBase{}; //!< The struct that makes this object a miniaudio data source (must be first member)
@@ -98,6 +120,11 @@ struct SoundBase
     ma_sound                sound{};         //!< The sound
     SoundSource::Status     status{SoundSource::Status::Stopped}; //!< The status
     SoundSource::EffectProcessor         effectProcessor;         //!< The effect processor
+    AnalyzerSlot                         analyzer;                //!< The analyzer fed with the processed data
+    std::atomic<std::int64_t>            processingTime{};        //!< Total processing time, in nanoseconds
+    std::atomic<std::int64_t>            maxProcessingTime{};     //!< Longest processing of a block, in nanoseconds
+    std::atomic<std::uint64_t>           underrunCount{};         //!< Number of times no data was ready while playing
+    std::uint64_t                        lastPeriodIndex{};       //!< Last period in which the sound was processed
     priv::AudioDevice::ResourceEntryIter resourceEntryIter; //!< Iterator to the resource entry registered with the AudioDevice
     priv::MiniaudioUtils::SavedSettings savedSettings; //!< Saved settings used to restore ma_sound state in case we need to recreate it
 };
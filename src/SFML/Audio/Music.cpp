@@ -32,6 +32,7 @@
 #include <SFML/System/Time.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <ostream>
 
@@ -41,10 +42,12 @@ namespace sf
 ////////////////////////////////////////////////////////////
 struct Music::Impl
 {
-    InputSoundFile            file;     //!< The streamed music file
-    std::vector<std::int16_t> samples;  //!< Temporary buffer of samples
-    std::recursive_mutex      mutex;    //!< Mutex protecting the data
-    Span<std::uint64_t>       loopSpan; //!< Loop Range Specifier
+    std::unique_ptr<PrefetchInputStream> prefetchStream; //!< Stream reading ahead of the file, if enabled
+    InputSoundFile                       file;           //!< The streamed music file
+    std::vector<std::int16_t>            samples;        //!< Temporary buffer of samples
+    std::recursive_mutex                 mutex;          //!< Mutex protecting the data
+    Span<std::uint64_t>                  loopSpan;       //!< Loop Range Specifier
+    std::atomic<bool>                    buffering{};    //!< True if the last chunk was not ready to be decoded
 
     explicit Impl(InputSoundFile&& theFile) :
     file(std::move(theFile)),
@@ -113,6 +116,19 @@ std::optional<Music> Music::openFromStream(InputStream& stream)
 }
 
 
+////////////////////////////////////////////////////////////
+std::optional<Music> Music::openFromStream(InputStream& stream, std::size_t readAheadSize)
+{
+    auto prefetchStream = std::make_unique<PrefetchInputStream>(stream, readAheadSize);
+
+    auto music = tryOpenFromInputSoundFile(InputSoundFile::openFromStream(*prefetchStream), "stream");
+    if (music)
+        music->m_impl->prefetchStream = std::move(prefetchStream);
+
+    return music;
+}
+
+
 ////////////////////////////////////////////////////////////
 Time Music::getDuration() const
 {
@@ -187,6 +203,23 @@ void Music::setLoopPoints(TimeSpan timePoints)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Music::isBuffering() const
+{
+    return m_impl->buffering;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<PrefetchInputStream::Statistics> Music::getReadAheadStatistics() const
+{
+    if (!m_impl->prefetchStream)
+        return std::nullopt;
+
+    return m_impl->prefetchStream->getStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Music::onGetData(SoundStream::Chunk& data)
 {
@@ -202,6 +235,23 @@ bool Music::onGetData(SoundStream::Chunk& data)
     if (getLoop() && (m_impl->loopSpan.length != 0) && (currentOffset <= loopEnd) && (currentOffset + toFill > loopEnd))
         toFill = static_cast<std::size_t>(loopEnd - currentOffset);
 
+    // When reading ahead, only decode once the encoded data is ready so that the audio thread never waits for
+    // the stream; the required size is estimated from the average size of an encoded sample, with some margin
+    if (auto& prefetchStream = m_impl->prefetchStream)
+    {
+        const std::uint64_t streamSize   = prefetchStream->getSize().value_or(0);
+        const std::uint64_t sampleCount  = std::max(m_impl->file.getSampleCount(), std::uint64_t{1});
+        const auto          requiredSize = static_cast<std::size_t>(toFill * streamSize * 5 / (sampleCount * 4) + 4096);
+
+        m_impl->buffering = !prefetchStream->isAvailable(requiredSize);
+        if (m_impl->buffering)
+        {
+            data.samples     = nullptr;
+            data.sampleCount = 0;
+            return true;
+        }
+    }
+
     // Fill the chunk parameters
     data.samples     = m_impl->samples.data();
     data.sampleCount = static_cast<std::size_t>(m_impl->file.read(m_impl->samples.data(), toFill));
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/OpusDecoder.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#ifdef SFML_USE_OPUS
+#include <opus.h>
+#endif
+
+#include <algorithm>
+#include <ostream>
+
+#include <cassert>
+#include <climits>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct OpusDecoder::Impl
+{
+#ifdef SFML_USE_OPUS
+    ~Impl()
+    {
+        if (decoder)
+            opus_decoder_destroy(decoder);
+    }
+
+    ::OpusDecoder* decoder{};      //!< Opus decoder state
+#endif
+    unsigned int sampleRate{};   //!< Sample rate of the decoded samples
+    unsigned int channelCount{}; //!< Channel count of the decoded samples
+};
+
+
+////////////////////////////////////////////////////////////
+std::optional<OpusDecoder> OpusDecoder::create(unsigned int sampleRate, unsigned int channelCount)
+{
+#ifdef SFML_USE_OPUS
+    if (sampleRate != 8000 && sampleRate != 12000 && sampleRate != 16000 && sampleRate != 24000 && sampleRate != 48000)
+    {
+        err() << "Failed to create Opus decoder: unsupported sample rate (" << sampleRate << " Hz)" << std::endl;
+        return std::nullopt;
+    }
+
+    if (channelCount != 1 && channelCount != 2)
+    {
+        err() << "Failed to create Opus decoder: unsupported channel count (" << channelCount << ")" << std::endl;
+        return std::nullopt;
+    }
+
+    auto impl          = std::make_unique<Impl>();
+    impl->sampleRate   = sampleRate;
+    impl->channelCount = channelCount;
+
+    int error = OPUS_OK;
+    impl->decoder = opus_decoder_create(static_cast<opus_int32>(sampleRate), static_cast<int>(channelCount), &error);
+    if (error != OPUS_OK)
+    {
+        err() << "Failed to create Opus decoder: " << opus_strerror(error) << std::endl;
+        return std::nullopt;
+    }
+
+    return OpusDecoder(std::move(impl));
+#else
+    static_cast<void>(sampleRate);
+    static_cast<void>(channelCount);
+
+    err() << "Failed to create Opus decoder: SFML was built without Opus support" << std::endl;
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+OpusDecoder::OpusDecoder(std::unique_ptr<Impl>&& impl) : m_impl(std::move(impl))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+OpusDecoder::~OpusDecoder() = default;
+
+
+////////////////////////////////////////////////////////////
+OpusDecoder::OpusDecoder(OpusDecoder&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+OpusDecoder& OpusDecoder::operator=(OpusDecoder&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> OpusDecoder::decode(const void*   packet,
+                                               std::size_t   packetSize,
+                                               std::int16_t* samples,
+                                               std::size_t   maxFrameCount)
+{
+    assert(samples && "OpusDecoder::decode() samples must not be null");
+
+#ifdef SFML_USE_OPUS
+    if (packetSize > INT_MAX)
+    {
+        err() << "Failed to decode Opus packet: packet too large" << std::endl;
+        return std::nullopt;
+    }
+
+    // A null packet triggers the packet loss concealment
+    const int frameCount = opus_decode(m_impl->decoder,
+                                       static_cast<const unsigned char*>(packet),
+                                       packet ? static_cast<opus_int32>(packetSize) : 0,
+                                       samples,
+                                       static_cast<int>(std::min(maxFrameCount, std::size_t{INT_MAX})),
+                                       0);
+    if (frameCount < 0)
+    {
+        err() << "Failed to decode Opus packet: " << opus_strerror(frameCount) << std::endl;
+        return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(frameCount);
+#else
+    static_cast<void>(packet);
+    static_cast<void>(packetSize);
+    static_cast<void>(samples);
+    static_cast<void>(maxFrameCount);
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusDecoder::getSampleRate() const
+{
+    return m_impl->sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusDecoder::getChannelCount() const
+{
+    return m_impl->channelCount;
+}
+
+} // namespace sf
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/OpusEncoder.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#ifdef SFML_USE_OPUS
+#include <opus.h>
+#endif
+
+#include <algorithm>
+#include <ostream>
+
+#include <cassert>
+#include <climits>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct OpusEncoder::Impl
+{
+#ifdef SFML_USE_OPUS
+    ~Impl()
+    {
+        if (encoder)
+            opus_encoder_destroy(encoder);
+    }
+
+    ::OpusEncoder* encoder{};      //!< Opus encoder state
+#endif
+    unsigned int sampleRate{};   //!< Sample rate of the encoded samples
+    unsigned int channelCount{}; //!< Channel count of the encoded samples
+};
+
+
+////////////////////////////////////////////////////////////
+std::optional<OpusEncoder> OpusEncoder::create(unsigned int sampleRate,
+                                               unsigned int channelCount,
+                                               Application  application)
+{
+#ifdef SFML_USE_OPUS
+    if (sampleRate != 8000 && sampleRate != 12000 && sampleRate != 16000 && sampleRate != 24000 && sampleRate != 48000)
+    {
+        err() << "Failed to create Opus encoder: unsupported sample rate (" << sampleRate << " Hz)" << std::endl;
+        return std::nullopt;
+    }
+
+    if (channelCount != 1 && channelCount != 2)
+    {
+        err() << "Failed to create Opus encoder: unsupported channel count (" << channelCount << ")" << std::endl;
+        return std::nullopt;
+    }
+
+    int opusApplication = OPUS_APPLICATION_VOIP;
+    switch (application)
+    {
+        case Application::Voip:
+            opusApplication = OPUS_APPLICATION_VOIP;
+            break;
+        case Application::Audio:
+            opusApplication = OPUS_APPLICATION_AUDIO;
+            break;
+        case Application::LowDelay:
+            opusApplication = OPUS_APPLICATION_RESTRICTED_LOWDELAY;
+            break;
+    }
+
+    auto impl          = std::make_unique<Impl>();
+    impl->sampleRate   = sampleRate;
+    impl->channelCount = channelCount;
+
+    int error = OPUS_OK;
+    impl->encoder = opus_encoder_create(static_cast<opus_int32>(sampleRate),
+                                        static_cast<int>(channelCount),
+                                        opusApplication,
+                                        &error);
+    if (error != OPUS_OK)
+    {
+        err() << "Failed to create Opus encoder: " << opus_strerror(error) << std::endl;
+        return std::nullopt;
+    }
+
+    return OpusEncoder(std::move(impl));
+#else
+    static_cast<void>(sampleRate);
+    static_cast<void>(channelCount);
+    static_cast<void>(application);
+
+    err() << "Failed to create Opus encoder: SFML was built without Opus support" << std::endl;
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+OpusEncoder::OpusEncoder(std::unique_ptr<Impl>&& impl) : m_impl(std::move(impl))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+OpusEncoder::~OpusEncoder() = default;
+
+
+////////////////////////////////////////////////////////////
+OpusEncoder::OpusEncoder(OpusEncoder&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+OpusEncoder& OpusEncoder::operator=(OpusEncoder&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+bool OpusEncoder::setBitrate(std::int32_t bitsPerSecond)
+{
+#ifdef SFML_USE_OPUS
+    if (const int result = opus_encoder_ctl(m_impl->encoder, OPUS_SET_BITRATE(bitsPerSecond)); result != OPUS_OK)
+    {
+        err() << "Failed to set Opus encoder bitrate: " << opus_strerror(result) << std::endl;
+        return false;
+    }
+
+    return true;
+#else
+    static_cast<void>(bitsPerSecond);
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> OpusEncoder::encode(const std::int16_t* samples,
+                                               std::size_t         frameCount,
+                                               void*               packet,
+                                               std::size_t         maxPacketSize)
+{
+    assert(samples && "OpusEncoder::encode() samples must not be null");
+    assert(packet && "OpusEncoder::encode() packet must not be null");
+
+#ifdef SFML_USE_OPUS
+    if (frameCount > INT_MAX)
+    {
+        err() << "Failed to encode Opus packet: too many frames" << std::endl;
+        return std::nullopt;
+    }
+
+    const opus_int32 size = opus_encode(m_impl->encoder,
+                                        samples,
+                                        static_cast<int>(frameCount),
+                                        static_cast<unsigned char*>(packet),
+                                        static_cast<opus_int32>(std::min(maxPacketSize, std::size_t{INT_MAX})));
+    if (size < 0)
+    {
+        err() << "Failed to encode Opus packet: " << opus_strerror(size) << std::endl;
+        return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(size);
+#else
+    static_cast<void>(samples);
+    static_cast<void>(frameCount);
+    static_cast<void>(packet);
+    static_cast<void>(maxPacketSize);
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusEncoder::getSampleRate() const
+{
+    return m_impl->sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusEncoder::getChannelCount() const
+{
+    return m_impl->channelCount;
+}
+
+} // namespace sf
@@ -80,4 +80,25 @@ std::optional<std::string> getDevice()
     return priv::AudioDevice::getDevice();
 }
 
+
+////////////////////////////////////////////////////////////
+void setAnalyzer(SoundAnalyzer* analyzer)
+{
+    priv::AudioDevice::setAnalyzer(analyzer);
+}
+
+
+////////////////////////////////////////////////////////////
+Statistics getStatistics()
+{
+    return priv::AudioDevice::getStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void resetStatistics()
+{
+    priv::AudioDevice::resetStatistics();
+}
+
 } // namespace sf::PlaybackDevice
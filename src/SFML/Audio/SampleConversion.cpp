@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
+
+#include <cstring>
+
+// SSE2 is part of the baseline of every x86-64 target, so it can be used without runtime detection
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SFML_SAMPLE_CONVERSION_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+////////////////////////////////////////////////////////////
+bool isIdentity(const std::size_t* remapTable, unsigned int channelCount)
+{
+    for (auto i = 0u; i < channelCount; ++i)
+    {
+        if (remapTable[i] != i)
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::int16_t shiftToInt16(std::int32_t sample, int shift)
+{
+    return static_cast<std::int16_t>(shift >= 0 ? sample >> shift : sample * (1 << -shift));
+}
+
+#ifdef SFML_SAMPLE_CONVERSION_SSE2
+////////////////////////////////////////////////////////////
+bool isStereoSwap(const std::size_t* remapTable, unsigned int channelCount)
+{
+    return channelCount == 2 && remapTable[0] == 1 && remapTable[1] == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+__m128i load(const void* data)
+{
+    return _mm_loadu_si128(static_cast<const __m128i*>(data));
+}
+
+
+////////////////////////////////////////////////////////////
+void store(void* data, __m128i value)
+{
+    _mm_storeu_si128(static_cast<__m128i*>(data), value);
+}
+
+
+////////////////////////////////////////////////////////////
+__m128i shiftToInt16(__m128i samples, int shift)
+{
+    // Shift, then keep the low 16 bits sign-extended so that packing truncates like the scalar cast
+    const __m128i shifted = shift >= 0 ? _mm_sra_epi32(samples, _mm_cvtsi32_si128(shift))
+                                       : _mm_sll_epi32(samples, _mm_cvtsi32_si128(-shift));
+    return _mm_srai_epi32(_mm_slli_epi32(shifted, 16), 16);
+}
+
+
+////////////////////////////////////////////////////////////
+__m128i swapStereo(__m128i samples)
+{
+    return _mm_or_si128(_mm_slli_epi32(samples, 16), _mm_srli_epi32(samples, 16));
+}
+#endif
+} // namespace
+
+
+namespace sf::priv::SampleConversion
+{
+////////////////////////////////////////////////////////////
+void interleaveToInt16(const std::int32_t* const* planes,
+                       unsigned int               channelCount,
+                       std::size_t                frameCount,
+                       unsigned int               bitsPerSample,
+                       std::int16_t*              output)
+{
+    const int   shift = static_cast<int>(bitsPerSample) - 16;
+    std::size_t frame = 0;
+
+#ifdef SFML_SAMPLE_CONVERSION_SSE2
+    if (channelCount == 1)
+    {
+        for (; frame + 8 <= frameCount; frame += 8)
+        {
+            const __m128i first  = shiftToInt16(load(planes[0] + frame), shift);
+            const __m128i second = shiftToInt16(load(planes[0] + frame + 4), shift);
+            store(output + frame, _mm_packs_epi32(first, second));
+        }
+    }
+    else if (channelCount == 2)
+    {
+        for (; frame + 4 <= frameCount; frame += 4)
+        {
+            const __m128i left  = shiftToInt16(load(planes[0] + frame), shift);
+            const __m128i right = shiftToInt16(load(planes[1] + frame), shift);
+            store(output + frame * 2,
+                  _mm_packs_epi32(_mm_unpacklo_epi32(left, right), _mm_unpackhi_epi32(left, right)));
+        }
+    }
+#endif
+
+    for (; frame < frameCount; ++frame)
+    {
+        for (auto channel = 0u; channel < channelCount; ++channel)
+            output[frame * channelCount + channel] = shiftToInt16(planes[channel][frame], shift);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void remap(const std::int16_t* input,
+           std::size_t         frameCount,
+           const std::size_t*  remapTable,
+           unsigned int        channelCount,
+           std::int16_t*       output)
+{
+    if (isIdentity(remapTable, channelCount))
+    {
+        std::memcpy(output, input, frameCount * channelCount * sizeof(std::int16_t));
+        return;
+    }
+
+    std::size_t frame = 0;
+
+#ifdef SFML_SAMPLE_CONVERSION_SSE2
+    if (isStereoSwap(remapTable, channelCount))
+    {
+        for (; frame + 4 <= frameCount; frame += 4)
+            store(output + frame * 2, swapStereo(load(input + frame * 2)));
+    }
+#endif
+
+    for (; frame < frameCount; ++frame)
+    {
+        for (auto channel = 0u; channel < channelCount; ++channel)
+            output[frame * channelCount + channel] = input[frame * channelCount + remapTable[channel]];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void remapToInt32(const std::int16_t* input,
+                  std::size_t         frameCount,
+                  const std::size_t*  remapTable,
+                  unsigned int        channelCount,
+                  std::int32_t*       output)
+{
+    std::size_t frame = 0;
+
+#ifdef SFML_SAMPLE_CONVERSION_SSE2
+    const bool identity = isIdentity(remapTable, channelCount);
+    const bool swap     = isStereoSwap(remapTable, channelCount);
+    if (channelCount > 0 && (identity || swap))
+    {
+        // Process 8 samples at a time, sign-extending them by unpacking each one into the high half of a 32-bit lane
+        const std::size_t sampleCount = frameCount * channelCount;
+        std::size_t       sample      = 0;
+        for (; sample + 8 <= sampleCount; sample += 8)
+        {
+            const __m128i samples = swap ? swapStereo(load(input + sample)) : load(input + sample);
+            store(output + sample, _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+            store(output + sample + 4, _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+        }
+
+        frame = sample / channelCount;
+    }
+#endif
+
+    for (; frame < frameCount; ++frame)
+    {
+        for (auto channel = 0u; channel < channelCount; ++channel)
+            output[frame * channelCount + channel] = input[frame * channelCount + remapTable[channel]];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void remapToPlanarFloat(const std::int16_t* input,
+                        std::size_t         frameCount,
+                        const std::size_t*  remapTable,
+                        unsigned int        channelCount,
+                        float* const*       planes)
+{
+    std::size_t frame = 0;
+
+#ifdef SFML_SAMPLE_CONVERSION_SSE2
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    if (channelCount == 1)
+    {
+        for (; frame + 8 <= frameCount; frame += 8)
+        {
+            const __m128i samples = load(input + frame);
+            const __m128  first   = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+            const __m128  second  = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+            _mm_storeu_ps(planes[0] + frame, _mm_div_ps(first, scale));
+            _mm_storeu_ps(planes[0] + frame + 4, _mm_div_ps(second, scale));
+        }
+    }
+    else if (channelCount == 2)
+    {
+        for (; frame + 4 <= frameCount; frame += 4)
+        {
+            // Widen 4 frames to floats (L0 R0 L1 R1, L2 R2 L3 R3), then gather each channel
+            const __m128i samples = load(input + frame * 2);
+            const __m128  first   = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+            const __m128  second  = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+            const __m128  left    = _mm_div_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)), scale);
+            const __m128  right   = _mm_div_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)), scale);
+            _mm_storeu_ps(planes[0] + frame, remapTable[0] == 0 ? left : right);
+            _mm_storeu_ps(planes[1] + frame, remapTable[1] == 0 ? left : right);
+        }
+    }
+#endif
+
+    for (; frame < frameCount; ++frame)
+    {
+        for (auto channel = 0u; channel < channelCount; ++channel)
+            planes[channel][frame] = input[frame * channelCount + remapTable[channel]] / 32767.0f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void toLittleEndian(const std::int16_t* input, std::size_t count, std::byte* output)
+{
+#ifdef SFML_SAMPLE_CONVERSION_SSE2
+    // x86 is little-endian, the samples can be copied as is
+    std::memcpy(output, input, count * sizeof(std::int16_t));
+#else
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto value  = static_cast<std::uint16_t>(input[i]);
+        output[i * 2]     = static_cast<std::byte>(value & 0xFF);
+        output[i * 2 + 1] = static_cast<std::byte>(value >> 8);
+    }
+#endif
+}
+
+} // namespace sf::priv::SampleConversion
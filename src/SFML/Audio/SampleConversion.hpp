@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sf::priv::SampleConversion
+{
+////////////////////////////////////////////////////////////
+/// \brief Convert planar integer samples to interleaved 16-bit samples
+///
+/// \param planes        One array of samples per channel
+/// \param channelCount  Number of channels
+/// \param frameCount    Number of samples in each channel
+/// \param bitsPerSample Bit depth of the input samples, between 8 and 32
+/// \param output        Array receiving `frameCount * channelCount` interleaved samples
+///
+////////////////////////////////////////////////////////////
+void interleaveToInt16(const std::int32_t* const* planes,
+                       unsigned int               channelCount,
+                       std::size_t                frameCount,
+                       unsigned int               bitsPerSample,
+                       std::int16_t*              output);
+
+////////////////////////////////////////////////////////////
+/// \brief Reorder the channels of interleaved 16-bit samples
+///
+/// Channel `i` of each output frame is channel `remapTable[i]`
+/// of the corresponding input frame.
+///
+/// \param input        Interleaved input samples
+/// \param frameCount   Number of frames to convert
+/// \param remapTable   Input channel of each output channel
+/// \param channelCount Number of channels
+/// \param output       Array receiving `frameCount * channelCount` interleaved samples
+///
+////////////////////////////////////////////////////////////
+void remap(const std::int16_t* input,
+           std::size_t         frameCount,
+           const std::size_t*  remapTable,
+           unsigned int        channelCount,
+           std::int16_t*       output);
+
+////////////////////////////////////////////////////////////
+/// \brief Reorder the channels of interleaved 16-bit samples and widen them to 32 bits
+///
+/// \param input        Interleaved input samples
+/// \param frameCount   Number of frames to convert
+/// \param remapTable   Input channel of each output channel
+/// \param channelCount Number of channels
+/// \param output       Array receiving `frameCount * channelCount` interleaved samples
+///
+////////////////////////////////////////////////////////////
+void remapToInt32(const std::int16_t* input,
+                  std::size_t         frameCount,
+                  const std::size_t*  remapTable,
+                  unsigned int        channelCount,
+                  std::int32_t*       output);
+
+////////////////////////////////////////////////////////////
+/// \brief Reorder the channels of interleaved 16-bit samples and convert them to planar floats
+///
+/// Samples are scaled so that 32767 maps to 1.
+///
+/// \param input        Interleaved input samples
+/// \param frameCount   Number of frames to convert
+/// \param remapTable   Input channel of each output channel
+/// \param channelCount Number of channels
+/// \param planes       One array per output channel, each receiving `frameCount` samples
+///
+////////////////////////////////////////////////////////////
+void remapToPlanarFloat(const std::int16_t* input,
+                        std::size_t         frameCount,
+                        const std::size_t*  remapTable,
+                        unsigned int        channelCount,
+                        float* const*       planes);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode 16-bit samples as little-endian bytes
+///
+/// \param input  Input samples
+/// \param count  Number of samples to encode
+/// \param output Array receiving `count * 2` bytes
+///
+////////////////////////////////////////////////////////////
+void toLittleEndian(const std::int16_t* input, std::size_t count, std::byte* output);
+
+} // namespace sf::priv::SampleConversion
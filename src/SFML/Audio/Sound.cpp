@@ -91,6 +91,8 @@ struct Sound::Impl : priv::MiniaudioUtils::SoundBase
         if (buffer == nullptr)
             return MA_NO_DATA_AVAILABLE;
 
+        const ProcessingTimer timer(impl);
+
         // Determine how many frames we can read
         *framesRead = std::min<ma_uint64>(frameCount, (buffer->getSampleCount() - impl.cursor) / buffer->getChannelCount());
 
@@ -306,7 +308,16 @@ void Sound::setPlayingOffset(Time timeOffset)
 void Sound::setEffectProcessor(EffectProcessor effectProcessor)
 {
     m_impl->effectProcessor = std::move(effectProcessor);
-    m_impl->connectEffect(bool{m_impl->effectProcessor});
+    m_impl->connectEffect(bool{m_impl->effectProcessor} || m_impl->analyzer.isSet());
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setAnalyzer(SoundAnalyzer* analyzer)
+{
+    // Waits until the audio thread is done with the previous analyzer, so that it can be destroyed
+    m_impl->analyzer.set(analyzer);
+    m_impl->connectEffect(bool{m_impl->effectProcessor} || analyzer != nullptr);
 }
 
 
@@ -342,6 +353,13 @@ Sound::Status Sound::getStatus() const
 }
 
 
+////////////////////////////////////////////////////////////
+Sound::Statistics Sound::getStatistics() const
+{
+    return m_impl->getStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 Sound& Sound::operator=(const Sound& right)
 {
@@ -0,0 +1,367 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundAnalyzer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+
+namespace
+{
+constexpr std::size_t  minFftSize     = 64;
+constexpr std::size_t  maxFftSize     = 16384;
+constexpr unsigned int maxChannels    = 8; // Channels taken into account for loudness measurement
+constexpr std::size_t  loudnessBlocks = 4; // Number of 100 ms blocks in the momentary loudness window
+constexpr unsigned int dirtyBit       = 4; // Set in the shared triple buffer index when it holds unread results
+constexpr double       pi             = 3.14159265358979323846;
+
+
+////////////////////////////////////////////////////////////
+// Biquad filter coefficients, normalized so that a0 == 1
+struct Biquad
+{
+    double b0{}, b1{}, b2{}, a1{}, a2{};
+};
+
+
+////////////////////////////////////////////////////////////
+// Transposed direct form II filter state
+struct BiquadState
+{
+    double z1{}, z2{};
+};
+
+
+////////////////////////////////////////////////////////////
+double filter(const Biquad& biquad, BiquadState& state, double input)
+{
+    const double output = biquad.b0 * input + state.z1;
+    state.z1            = biquad.b1 * input - biquad.a1 * output + state.z2;
+    state.z2            = biquad.b2 * input - biquad.a2 * output;
+    return output;
+}
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SoundAnalyzer::Impl
+{
+    explicit Impl(std::size_t theFftSize) : fftSize(theFftSize)
+    {
+        window.resize(fftSize);
+        cosTable.resize(fftSize / 2);
+        sinTable.resize(fftSize / 2);
+        bitReverse.resize(fftSize);
+        collected.resize(fftSize);
+        real.resize(fftSize);
+        imag.resize(fftSize);
+        spectrum.resize(fftSize / 2);
+
+        for (auto& result : results)
+            result.spectrum.resize(fftSize / 2);
+
+        // Periodic Hann window
+        for (std::size_t i = 0; i < fftSize; ++i)
+            window[i] = static_cast<float>(
+                0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / static_cast<double>(fftSize)));
+
+        for (std::size_t i = 0; i < fftSize / 2; ++i)
+        {
+            const double angle = 2.0 * pi * static_cast<double>(i) / static_cast<double>(fftSize);
+            cosTable[i]        = static_cast<float>(std::cos(angle));
+            sinTable[i]        = static_cast<float>(-std::sin(angle));
+        }
+
+        std::size_t bits = 0;
+        while ((std::size_t{1} << bits) < fftSize)
+            ++bits;
+
+        for (std::size_t i = 0; i < fftSize; ++i)
+        {
+            std::size_t reversed = 0;
+            for (std::size_t bit = 0; bit < bits; ++bit)
+                reversed |= ((i >> bit) & 1u) << (bits - 1 - bit);
+            bitReverse[i] = reversed;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void configure(unsigned int newChannelCount, unsigned int newSampleRate)
+    {
+        channelCount = newChannelCount;
+        sampleRate   = newSampleRate;
+
+        // K-weighting filter (ITU-R BS.1770), first stage: high shelf modelling the acoustic effects of the head
+        const double shelfK  = std::tan(pi * 1681.974450955533 / static_cast<double>(sampleRate));
+        const double shelfQ  = 0.7071752369554196;
+        const double vh      = std::pow(10.0, 3.999843853973347 / 20.0);
+        const double vb      = std::pow(vh, 0.4996667741545416);
+        const double shelfA0 = 1.0 + shelfK / shelfQ + shelfK * shelfK;
+        shelf.b0             = (vh + vb * shelfK / shelfQ + shelfK * shelfK) / shelfA0;
+        shelf.b1             = 2.0 * (shelfK * shelfK - vh) / shelfA0;
+        shelf.b2             = (vh - vb * shelfK / shelfQ + shelfK * shelfK) / shelfA0;
+        shelf.a1             = 2.0 * (shelfK * shelfK - 1.0) / shelfA0;
+        shelf.a2             = (1.0 - shelfK / shelfQ + shelfK * shelfK) / shelfA0;
+
+        // Second stage: RLB high-pass filter
+        const double highPassK  = std::tan(pi * 38.13547087602444 / static_cast<double>(sampleRate));
+        const double highPassQ  = 0.5003270373238773;
+        const double highPassA0 = 1.0 + highPassK / highPassQ + highPassK * highPassK;
+        highPass.b0             = 1.0;
+        highPass.b1             = -2.0;
+        highPass.b2             = 1.0;
+        highPass.a1             = 2.0 * (highPassK * highPassK - 1.0) / highPassA0;
+        highPass.a2             = (1.0 - highPassK / highPassQ + highPassK * highPassK) / highPassA0;
+
+        shelfStates.fill({});
+        highPassStates.fill({});
+        blockEnergies.fill(0.0);
+        blockLength    = std::max(sampleRate / 10, 1u);
+        blockFrames    = 0;
+        blockEnergy    = 0.0;
+        blockIndex     = 0;
+        blocksFilled   = 0;
+        collectedCount = 0;
+        sumSquares     = 0.0;
+        peak           = 0.f;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void analyzeWindow()
+    {
+        // Apply the window and store the samples in bit-reversed order
+        for (std::size_t i = 0; i < fftSize; ++i)
+        {
+            real[bitReverse[i]] = collected[i] * window[i];
+            imag[i]             = 0.f;
+        }
+
+        // Iterative radix-2 decimation-in-time FFT
+        for (std::size_t length = 2; length <= fftSize; length <<= 1)
+        {
+            const std::size_t half   = length / 2;
+            const std::size_t stride = fftSize / length;
+
+            for (std::size_t start = 0; start < fftSize; start += length)
+            {
+                for (std::size_t j = 0; j < half; ++j)
+                {
+                    const float       wr = cosTable[j * stride];
+                    const float       wi = sinTable[j * stride];
+                    const std::size_t a  = start + j;
+                    const std::size_t b  = a + half;
+                    const float       tr = real[b] * wr - imag[b] * wi;
+                    const float       ti = real[b] * wi + imag[b] * wr;
+                    real[b]              = real[a] - tr;
+                    imag[b]              = imag[a] - ti;
+                    real[a] += tr;
+                    imag[a] += ti;
+                }
+            }
+        }
+
+        // Scale so that a full-scale sine wave has a magnitude of 1 (the Hann window sums to fftSize / 2)
+        const float scale = 4.f / static_cast<float>(fftSize);
+
+        for (std::size_t i = 0; i < fftSize / 2; ++i)
+            spectrum[i] = std::sqrt(real[i] * real[i] + imag[i] * imag[i]) * scale;
+
+        const double sampleCount = static_cast<double>(fftSize) * static_cast<double>(channelCount);
+        rms                      = static_cast<float>(std::sqrt(sumSquares / sampleCount));
+        windowPeak               = peak;
+        collectedCount           = 0;
+        sumSquares               = 0.0;
+        peak                     = 0.f;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void finishLoudnessBlock()
+    {
+        blockEnergies[blockIndex] = blockEnergy;
+        blockIndex                = (blockIndex + 1) % loudnessBlocks;
+        blocksFilled              = std::min(blocksFilled + 1, loudnessBlocks);
+        blockFrames               = 0;
+        blockEnergy               = 0.0;
+
+        double energy = 0.0;
+        for (std::size_t i = 0; i < blocksFilled; ++i)
+            energy += blockEnergies[i];
+
+        const double meanSquare = energy / static_cast<double>(blocksFilled * blockLength);
+        loudness = meanSquare > 0.0 ? std::max(static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)), -70.f)
+                                    : -70.f;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void publish()
+    {
+        Result& result    = results[writeIndex];
+        result.rms        = rms;
+        result.peak       = windowPeak;
+        result.loudness   = loudness;
+        result.sampleRate = sampleRate;
+        std::copy(spectrum.begin(), spectrum.end(), result.spectrum.begin());
+
+        // Swap the freshly written buffer with the shared one, and flag it as unread
+        writeIndex = shared.exchange(writeIndex | dirtyBit, std::memory_order_acq_rel) & ~dirtyBit;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t                          fftSize;          //!< Number of samples per analysis window
+    std::vector<float>                   window;           //!< Hann window coefficients
+    std::vector<float>                   cosTable;         //!< Real part of the FFT twiddle factors
+    std::vector<float>                   sinTable;         //!< Imaginary part of the FFT twiddle factors
+    std::vector<std::size_t>             bitReverse;       //!< Bit-reversed index of each sample
+    std::vector<float>                   collected;        //!< Mono downmix of the current analysis window
+    std::vector<float>                   real;             //!< Real part of the FFT work buffer
+    std::vector<float>                   imag;             //!< Imaginary part of the FFT work buffer
+    std::vector<float>                   spectrum;         //!< Latest spectrum
+    std::size_t                          collectedCount{}; //!< Number of samples in the current analysis window
+    double                               sumSquares{};     //!< Sum of squared samples in the current analysis window
+    float                                peak{};           //!< Peak level in the current analysis window
+    float                                rms{};            //!< RMS level of the last complete analysis window
+    float                                windowPeak{};     //!< Peak level of the last complete analysis window
+    unsigned int                         channelCount{};   //!< Channel count of the analyzed data
+    unsigned int                         sampleRate{};     //!< Sample rate of the analyzed data
+    Biquad                               shelf;            //!< K-weighting high shelf filter
+    Biquad                               highPass;         //!< K-weighting high-pass filter
+    std::array<BiquadState, maxChannels> shelfStates;      //!< Per channel high shelf filter state
+    std::array<BiquadState, maxChannels> highPassStates;   //!< Per channel high-pass filter state
+    std::array<double, loudnessBlocks>   blockEnergies{};  //!< Energy of the last 100 ms blocks
+    double                               blockEnergy{};    //!< Energy accumulated in the current 100 ms block
+    unsigned int                         blockLength{};    //!< Number of frames in a 100 ms block
+    unsigned int                         blockFrames{};    //!< Number of frames accumulated in the current 100 ms block
+    std::size_t                          blockIndex{};     //!< Index of the next block to write in blockEnergies
+    std::size_t                          blocksFilled{};   //!< Number of valid entries in blockEnergies
+    float                                loudness{-70.f};  //!< Latest momentary loudness
+    std::array<Result, 3>                results;          //!< Triple buffer of published results
+    unsigned int                         writeIndex{0};    //!< Buffer owned by the audio thread
+    unsigned int                         readIndex{1};     //!< Buffer owned by the reading thread
+    std::atomic<unsigned int>            shared{2};        //!< Buffer waiting to be exchanged, with the dirty bit set when unread
+};
+
+
+////////////////////////////////////////////////////////////
+SoundAnalyzer::SoundAnalyzer(std::size_t fftSize)
+{
+    std::size_t size = minFftSize;
+    while (size < fftSize && size < maxFftSize)
+        size <<= 1;
+
+    m_impl = std::make_unique<Impl>(size);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundAnalyzer::~SoundAnalyzer() = default;
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundAnalyzer::getFftSize() const
+{
+    return m_impl->fftSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundAnalyzer::process(const float*  frames,
+                            unsigned int frameCount,
+                            unsigned int channelCount,
+                            unsigned int sampleRate)
+{
+    if (!frames || frameCount == 0 || channelCount == 0 || sampleRate == 0)
+        return;
+
+    Impl& impl = *m_impl;
+
+    // Restart the measurements from scratch if the format changes
+    if (channelCount != impl.channelCount || sampleRate != impl.sampleRate)
+        impl.configure(channelCount, sampleRate);
+
+    const unsigned int loudnessChannels = std::min(channelCount, maxChannels);
+    const float        downmixScale     = 1.f / static_cast<float>(channelCount);
+    bool               updated          = false;
+
+    for (unsigned int frame = 0; frame < frameCount; ++frame)
+    {
+        const float* samples = frames + static_cast<std::size_t>(frame) * channelCount;
+        float        mono    = 0.f;
+
+        for (unsigned int channel = 0; channel < channelCount; ++channel)
+        {
+            const float sample = samples[channel];
+            mono += sample;
+            impl.sumSquares += static_cast<double>(sample * sample);
+            impl.peak = std::max(impl.peak, std::abs(sample));
+        }
+
+        for (unsigned int channel = 0; channel < loudnessChannels; ++channel)
+        {
+            const double shelved  = filter(impl.shelf, impl.shelfStates[channel], static_cast<double>(samples[channel]));
+            const double weighted = filter(impl.highPass, impl.highPassStates[channel], shelved);
+            impl.blockEnergy += weighted * weighted;
+        }
+
+        impl.collected[impl.collectedCount++] = mono * downmixScale;
+
+        if (impl.collectedCount == impl.fftSize)
+        {
+            impl.analyzeWindow();
+            updated = true;
+        }
+
+        if (++impl.blockFrames == impl.blockLength)
+        {
+            impl.finishLoudnessBlock();
+            updated = true;
+        }
+    }
+
+    if (updated)
+        impl.publish();
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundAnalyzer::Result& SoundAnalyzer::getResult()
+{
+    Impl& impl = *m_impl;
+
+    if (impl.shared.load(std::memory_order_relaxed) & dirtyBit)
+        impl.readIndex = impl.shared.exchange(impl.readIndex, std::memory_order_acq_rel) & ~dirtyBit;
+
+    return impl.results[impl.readIndex];
+}
+
+} // namespace sf
@@ -34,6 +34,11 @@
 #include <SFML/Audio/SoundFileWriterOgg.hpp>
 #include <SFML/Audio/SoundFileWriterWav.hpp>
 
+#ifdef SFML_USE_OPUS
+#include <SFML/Audio/SoundFileReaderOpus.hpp>
+#include <SFML/Audio/SoundFileWriterOpus.hpp>
+#endif
+
 #include <SFML/System/Err.hpp>
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
@@ -144,6 +149,9 @@ SoundFileFactory::ReaderFactoryMap& SoundFileFactory::getReaderFactoryMap()
     static ReaderFactoryMap result{{&priv::createReader<priv::SoundFileReaderFlac>, &priv::SoundFileReaderFlac::check},
                                    {&priv::createReader<priv::SoundFileReaderMp3>, &priv::SoundFileReaderMp3::check},
                                    {&priv::createReader<priv::SoundFileReaderOgg>, &priv::SoundFileReaderOgg::check},
+#ifdef SFML_USE_OPUS
+                                   {&priv::createReader<priv::SoundFileReaderOpus>, &priv::SoundFileReaderOpus::check},
+#endif
                                    {&priv::createReader<priv::SoundFileReaderWav>, &priv::SoundFileReaderWav::check}};
 
     return result;
@@ -156,6 +164,9 @@ SoundFileFactory::WriterFactoryMap& SoundFileFactory::getWriterFactoryMap()
     // The map is pre-populated with default writers on construction
     static WriterFactoryMap result{{&priv::createWriter<priv::SoundFileWriterFlac>, &priv::SoundFileWriterFlac::check},
                                    {&priv::createWriter<priv::SoundFileWriterOgg>, &priv::SoundFileWriterOgg::check},
+#ifdef SFML_USE_OPUS
+                                   {&priv::createWriter<priv::SoundFileWriterOpus>, &priv::SoundFileWriterOpus::check},
+#endif
                                    {&priv::createWriter<priv::SoundFileWriterWav>, &priv::SoundFileWriterWav::check}};
 
     return result;
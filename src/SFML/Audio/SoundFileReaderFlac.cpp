@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 
 #include <SFML/System/Err.hpp>
@@ -36,6 +37,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 
 namespace
@@ -116,52 +118,44 @@ FLAC__StreamDecoderWriteStatus streamWrite(const FLAC__StreamDecoder*,
 {
     auto* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
 
-    // Reserve memory if we're going to use the leftovers buffer
     const unsigned int frameSamples = frame->header.blocksize * frame->header.channels;
-    if (data->remaining < frameSamples)
-        data->leftovers.reserve(static_cast<std::size_t>(frameSamples - data->remaining));
 
-    // Decode the samples
-    for (unsigned i = 0; i < frame->header.blocksize; ++i)
+    // If the whole frame fits in the output buffer, decode it there directly
+    if (data->buffer && data->remaining >= frameSamples)
     {
-        for (unsigned int j = 0; j < frame->header.channels; ++j)
-        {
-            // Decode the current sample
-            std::int16_t sample = 0;
-            switch (frame->header.bits_per_sample)
-            {
-                case 8:
-                    sample = static_cast<std::int16_t>(buffer[j][i] << 8);
-                    break;
-                case 16:
-                    sample = static_cast<std::int16_t>(buffer[j][i]);
-                    break;
-                case 24:
-                    sample = static_cast<std::int16_t>(buffer[j][i] >> 8);
-                    break;
-                case 32:
-                    sample = static_cast<std::int16_t>(buffer[j][i] >> 16);
-                    break;
-                default:
-                    assert(false && "Invalid bits per sample. Must be 8, 16, 24, or 32.");
-                    break;
-            }
-
-            if (data->buffer && data->remaining > 0)
-            {
-                // If there's room in the output buffer, copy the sample there
-                *data->buffer++ = sample;
-                --data->remaining;
-            }
-            else
-            {
-                // We are either seeking (null buffer) or have decoded all the requested samples during a
-                // normal read (0 remaining), so we put the sample in a temporary buffer until next call
-                data->leftovers.push_back(sample);
-            }
-        }
+        sf::priv::SampleConversion::interleaveToInt16(buffer,
+                                                      frame->header.channels,
+                                                      frame->header.blocksize,
+                                                      frame->header.bits_per_sample,
+                                                      data->buffer);
+        data->buffer += frameSamples;
+        data->remaining -= frameSamples;
+        return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+    }
+
+    // Otherwise decode it to a temporary buffer
+    data->decoded.resize(frameSamples);
+    sf::priv::SampleConversion::interleaveToInt16(buffer,
+                                                  frame->header.channels,
+                                                  frame->header.blocksize,
+                                                  frame->header.bits_per_sample,
+                                                  data->decoded.data());
+
+    // Copy what fits in the output buffer. We are either seeking (null buffer) or have decoded all the
+    // requested samples during a normal read (0 remaining), so we keep the rest of the samples until next call
+    std::size_t copied = 0;
+    if (data->buffer && data->remaining > 0)
+    {
+        copied = static_cast<std::size_t>(data->remaining);
+        std::memcpy(data->buffer, data->decoded.data(), copied * sizeof(std::int16_t));
+        data->buffer += copied;
+        data->remaining = 0;
     }
 
+    data->leftovers.insert(data->leftovers.end(),
+                           data->decoded.begin() + static_cast<std::ptrdiff_t>(copied),
+                           data->decoded.end());
+
     return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 }
 
@@ -108,6 +108,7 @@ public:
         std::int16_t*             buffer{};
         std::uint64_t             remaining{};
         std::vector<std::int16_t> leftovers;
+        std::vector<std::int16_t> decoded;
         bool                      error{};
     };
 
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/Audio/SoundFileWriterFlac.hpp>
 
 #include <SFML/System/Err.hpp>
@@ -167,14 +168,8 @@ void SoundFileWriterFlac::write(const std::int16_t* samples, std::uint64_t count
         const unsigned int frames = std::min(static_cast<unsigned int>(count / m_channelCount), 10000u);
 
         // Convert the samples to 32-bits and remap the channels
-        m_samples32.clear();
-        m_samples32.reserve(frames * m_channelCount);
-
-        for (auto frame = 0u; frame < frames; ++frame)
-        {
-            for (auto channel = 0u; channel < m_channelCount; ++channel)
-                m_samples32.push_back(samples[frame * m_channelCount + m_remapTable[channel]]);
-        }
+        m_samples32.resize(frames * m_channelCount);
+        SampleConversion::remapToInt32(samples, frames, m_remapTable, m_channelCount, m_samples32.data());
 
         // Write them to the FLAC stream
         FLAC__stream_encoder_process_interleaved(m_encoder.get(), m_samples32.data(), frames);
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/Audio/SoundFileWriterOgg.hpp>
 
 #include <SFML/System/Err.hpp>
@@ -210,13 +211,9 @@ void SoundFileWriterOgg::write(const std::int16_t* samples, std::uint64_t count)
         assert(buffer && "Vorbis buffer failed to allocate");
 
         // Write the samples to the buffer, converted to float and remapped to target channels
-        for (int i = 0; i < std::min(frameCount, bufferSize); ++i)
-        {
-            for (unsigned int j = 0; j < m_channelCount; ++j)
-                buffer[j][i] = samples[m_remapTable[j]] / 32767.0f;
-
-            samples += m_channelCount;
-        }
+        const auto frames = static_cast<std::size_t>(std::min(frameCount, bufferSize));
+        SampleConversion::remapToPlanarFloat(samples, frames, m_remapTable.data(), m_channelCount, buffer);
+        samples += frames * m_channelCount;
 
         // Tell the library how many samples we've written
         vorbis_analysis_wrote(&m_state, std::min(frameCount, bufferSize));
@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
+#include <SFML/Audio/SoundFileWriterOpus.hpp>
+
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Utils.hpp>
+
+#include <algorithm>
+#include <ostream>
+#include <random>
+
+#include <cassert>
+
+
+namespace
+{
+// Opus always runs at 48 kHz internally, granule positions are expressed at this rate
+constexpr unsigned int opusSampleRate = 48000;
+
+// 20 ms frames, the best compromise between quality and overhead for files
+constexpr std::size_t frameSize = opusSampleRate / 50;
+
+// Large enough for any Opus packet, including multistream ones
+constexpr std::size_t maxPacketSize = 4000 * 8;
+
+void appendLittleEndian(std::vector<unsigned char>& buffer, std::uint32_t value, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        buffer.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+}
+} // namespace
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+bool SoundFileWriterOpus::check(const std::filesystem::path& filename)
+{
+    return toLower(filename.extension().string()) == ".opus";
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileWriterOpus::~SoundFileWriterOpus()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileWriterOpus::open(const std::filesystem::path&     filename,
+                               unsigned int                     sampleRate,
+                               unsigned int                     channelCount,
+                               const std::vector<SoundChannel>& channelMap)
+{
+    std::vector<SoundChannel> targetChannelMap;
+
+    // Opus uses the Vorbis channel mapping: https://www.rfc-editor.org/rfc/rfc7845#section-5.1.1.2
+    switch (channelCount)
+    {
+        case 0:
+            err() << "No channels to write to Opus file" << std::endl;
+            return false;
+        case 1:
+            targetChannelMap = {SoundChannel::Mono};
+            break;
+        case 2:
+            targetChannelMap = {SoundChannel::FrontLeft, SoundChannel::FrontRight};
+            break;
+        case 3:
+            targetChannelMap = {SoundChannel::FrontLeft, SoundChannel::FrontCenter, SoundChannel::FrontRight};
+            break;
+        case 4:
+            targetChannelMap = {SoundChannel::FrontLeft, SoundChannel::FrontRight, SoundChannel::BackLeft, SoundChannel::BackRight};
+            break;
+        case 5:
+            targetChannelMap = {SoundChannel::FrontLeft,
+                                SoundChannel::FrontCenter,
+                                SoundChannel::FrontRight,
+                                SoundChannel::BackLeft,
+                                SoundChannel::BackRight};
+            break;
+        case 6:
+            targetChannelMap = {SoundChannel::FrontLeft,
+                                SoundChannel::FrontCenter,
+                                SoundChannel::FrontRight,
+                                SoundChannel::BackLeft,
+                                SoundChannel::BackRight,
+                                SoundChannel::LowFrequencyEffects};
+            break;
+        case 7:
+            targetChannelMap = {SoundChannel::FrontLeft,
+                                SoundChannel::FrontCenter,
+                                SoundChannel::FrontRight,
+                                SoundChannel::SideLeft,
+                                SoundChannel::SideRight,
+                                SoundChannel::BackCenter,
+                                SoundChannel::LowFrequencyEffects};
+            break;
+        case 8:
+            targetChannelMap = {SoundChannel::FrontLeft,
+                                SoundChannel::FrontCenter,
+                                SoundChannel::FrontRight,
+                                SoundChannel::SideLeft,
+                                SoundChannel::SideRight,
+                                SoundChannel::BackLeft,
+                                SoundChannel::BackRight,
+                                SoundChannel::LowFrequencyEffects};
+            break;
+        default:
+            err() << "Opus files with more than 8 channels not supported" << std::endl;
+            return false;
+    }
+
+    // Check if the channel map contains channels that we cannot remap to a mapping supported by Opus
+    if (!std::is_permutation(channelMap.begin(), channelMap.end(), targetChannelMap.begin()))
+    {
+        err() << "Provided channel map cannot be reordered to a channel map supported by Opus" << std::endl;
+        return false;
+    }
+
+    // Build the remap table
+    for (auto i = 0u; i < channelCount; ++i)
+        m_remapTable[i] = static_cast<std::size_t>(
+            std::find(channelMap.begin(), channelMap.end(), targetChannelMap[i]) - channelMap.begin());
+
+    // Save the channel count and sample rate
+    m_channelCount = channelCount;
+    m_sampleRate   = sampleRate;
+
+    // Create the encoder, mapping family 0 covers mono and stereo, family 1 covers up to 8 channels
+    const int                    mappingFamily = channelCount > 2 ? 1 : 0;
+    int                          streamCount   = 0;
+    int                          coupledCount  = 0;
+    std::array<unsigned char, 8> mapping{};
+    int                          status = OPUS_OK;
+
+    m_encoder = opus_multistream_surround_encoder_create(static_cast<opus_int32>(opusSampleRate),
+                                                         static_cast<int>(channelCount),
+                                                         mappingFamily,
+                                                         &streamCount,
+                                                         &coupledCount,
+                                                         mapping.data(),
+                                                         OPUS_APPLICATION_AUDIO,
+                                                         &status);
+    if (status != OPUS_OK)
+    {
+        err() << "Failed to write Opus file (cannot create the encoder: " << opus_strerror(status) << ")\n"
+              << formatDebugPathInfo(filename) << std::endl;
+        close();
+        return false;
+    }
+
+    opus_int32 lookahead = 0;
+    opus_multistream_encoder_ctl(m_encoder, OPUS_GET_LOOKAHEAD(&lookahead));
+    m_preSkip = lookahead;
+
+    // Opus only encodes a few sample rates, convert everything to 48 kHz
+    m_resampling = sampleRate != opusSampleRate;
+    if (m_resampling)
+    {
+        const ma_resampler_config config = ma_resampler_config_init(ma_format_s16,
+                                                                    channelCount,
+                                                                    sampleRate,
+                                                                    opusSampleRate,
+                                                                    ma_resample_algorithm_linear);
+        if (const ma_result result = ma_resampler_init(&config, nullptr, &m_resampler); result != MA_SUCCESS)
+        {
+            err() << "Failed to write Opus file (cannot convert from " << sampleRate << " Hz: "
+                  << ma_result_description(result) << ")\n"
+                  << formatDebugPathInfo(filename) << std::endl;
+            m_resampling = false;
+            close();
+            return false;
+        }
+    }
+
+    m_frame.assign(frameSize * channelCount, 0);
+    m_frameFill = 0;
+    m_packet.resize(maxPacketSize);
+
+    // Open the file after the opus setup is ok
+    m_file.open(filename, std::ios::binary);
+    if (!m_file)
+    {
+        err() << "Failed to write Opus file (cannot open file)\n" << formatDebugPathInfo(filename) << std::endl;
+        close();
+        return false;
+    }
+
+    // Initialize the ogg stream
+    static std::mt19937 rng(std::random_device{}());
+    ogg_stream_init(&m_ogg, std::uniform_int_distribution(0, std::numeric_limits<int>::max())(rng));
+
+    // Build the identification header, see https://www.rfc-editor.org/rfc/rfc7845#section-5.1
+    std::vector<unsigned char> header{'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1};
+    appendLittleEndian(header, channelCount, 1);
+    appendLittleEndian(header, static_cast<std::uint32_t>(m_preSkip), 2);
+    appendLittleEndian(header, sampleRate, 4);
+    appendLittleEndian(header, 0, 2); // Output gain
+    appendLittleEndian(header, static_cast<std::uint32_t>(mappingFamily), 1);
+    if (mappingFamily != 0)
+    {
+        appendLittleEndian(header, static_cast<std::uint32_t>(streamCount), 1);
+        appendLittleEndian(header, static_cast<std::uint32_t>(coupledCount), 1);
+        header.insert(header.end(), mapping.begin(), mapping.begin() + channelCount);
+    }
+
+    // Build the comment header (leave it empty)
+    constexpr char             vendor[] = "SFML";
+    std::vector<unsigned char> tags{'O', 'p', 'u', 's', 'T', 'a', 'g', 's'};
+    appendLittleEndian(tags, sizeof(vendor) - 1, 4);
+    tags.insert(tags.end(), vendor, vendor + sizeof(vendor) - 1);
+    appendLittleEndian(tags, 0, 4); // User comment count
+
+    // Each header must be on its own page and the audio data must start on a new page, as per spec
+    writePacket(header.data(), header.size(), 0, false, true);
+    writePacket(tags.data(), tags.size(), 0, false, true);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::write(const std::int16_t* samples, std::uint64_t count)
+{
+    // Process the samples by chunks so that the temporary buffers stay small
+    constexpr std::uint64_t chunkSize = 4096;
+
+    // A frame contains a sample from each channel
+    std::uint64_t frameCount = count / m_channelCount;
+
+    while (frameCount > 0)
+    {
+        const std::uint64_t chunkFrames = std::min(frameCount, chunkSize);
+
+        // Remap the samples to the target channels
+        m_input.resize(chunkFrames * m_channelCount);
+        SampleConversion::remap(samples, chunkFrames, m_remapTable.data(), m_channelCount, m_input.data());
+        samples += chunkFrames * m_channelCount;
+
+        feed(m_input.data(), chunkFrames);
+        m_inputCount += chunkFrames;
+
+        frameCount -= chunkFrames;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::feed(const std::int16_t* input, std::uint64_t frameCount)
+{
+    ma_uint64 inputCount = frameCount;
+    while (inputCount > 0)
+    {
+        std::int16_t* output      = m_frame.data() + m_frameFill * m_channelCount;
+        ma_uint64     outputCount = frameSize - m_frameFill;
+
+        if (m_resampling)
+        {
+            ma_uint64 consumed = inputCount;
+            ma_resampler_process_pcm_frames(&m_resampler, input, &consumed, output, &outputCount);
+            input += consumed * m_channelCount;
+            inputCount -= consumed;
+
+            if (consumed == 0 && outputCount == 0)
+                break;
+        }
+        else
+        {
+            outputCount = std::min(outputCount, inputCount);
+            std::copy(input, input + outputCount * m_channelCount, output);
+            input += outputCount * m_channelCount;
+            inputCount -= outputCount;
+        }
+
+        m_frameFill += static_cast<std::size_t>(outputCount);
+        m_frameCount += static_cast<std::int64_t>(outputCount);
+
+        if (m_frameFill == frameSize)
+            encodeFrame(false);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::encodeFrame(bool endOfStream)
+{
+    // Pad the last frame with silence, it will be trimmed by the granule position
+    const auto paddingOffset = static_cast<std::ptrdiff_t>(m_frameFill * m_channelCount);
+    std::fill(m_frame.begin() + paddingOffset, m_frame.end(), std::int16_t{0});
+
+    const opus_int32 size = opus_multistream_encode(m_encoder,
+                                                    m_frame.data(),
+                                                    static_cast<int>(frameSize),
+                                                    m_packet.data(),
+                                                    static_cast<opus_int32>(m_packet.size()));
+    m_frameFill           = 0;
+    m_encodedCount += static_cast<std::int64_t>(frameSize);
+
+    if (size < 0)
+    {
+        err() << "Failed to encode Opus packet: " << opus_strerror(size) << std::endl;
+        return;
+    }
+
+    // The granule position of a page is the number of frames decoded once its last packet is decoded,
+    // the final one only counts the actual frames so that the decoder removes the padding
+    const std::int64_t granulePosition = endOfStream ? m_preSkip + m_frameCount : m_encodedCount;
+    writePacket(m_packet.data(), static_cast<std::size_t>(size), granulePosition, endOfStream, endOfStream);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::writePacket(unsigned char* data,
+                                      std::size_t    size,
+                                      std::int64_t   granulePosition,
+                                      bool           endOfStream,
+                                      bool           flush)
+{
+    ogg_packet packet{};
+    packet.packet     = data;
+    packet.bytes      = static_cast<long>(size);
+    packet.b_o_s      = m_packetNumber == 0 ? 1 : 0;
+    packet.e_o_s      = endOfStream ? 1 : 0;
+    packet.granulepos = granulePosition;
+    packet.packetno   = m_packetNumber++;
+    ogg_stream_packetin(&m_ogg, &packet);
+
+    // If the stream produced new pages, write them to the output file
+    ogg_page page;
+    while ((flush ? ogg_stream_flush(&m_ogg, &page) : ogg_stream_pageout(&m_ogg, &page)) > 0)
+    {
+        m_file.write(reinterpret_cast<const char*>(page.header), page.header_len);
+        m_file.write(reinterpret_cast<const char*>(page.body), page.body_len);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::close()
+{
+    if (m_file.is_open())
+    {
+        // Push the last input frames out of the resampler, then drop the silence that followed them
+        if (m_resampling)
+        {
+            const ma_uint64 latency = ma_resampler_get_input_latency(&m_resampler) + 1;
+            m_input.assign(latency * m_channelCount, 0);
+            feed(m_input.data(), latency);
+
+            const std::uint64_t expectedCount = m_inputCount * opusSampleRate / m_sampleRate;
+            m_frameCount = std::min(m_frameCount, static_cast<std::int64_t>(expectedCount));
+        }
+
+        // Encode the remaining samples, followed by enough silence to flush the encoder's lookahead,
+        // so that the final granule position never exceeds the number of decoded frames
+        const std::int64_t endPosition = m_preSkip + m_frameCount;
+        do
+        {
+            encodeFrame(m_encodedCount + static_cast<std::int64_t>(frameSize) >= endPosition);
+        } while (m_encodedCount < endPosition);
+
+        // Close the file
+        m_file.close();
+    }
+
+    // Clear all the ogg/opus structures
+    ogg_stream_clear(&m_ogg);
+
+    if (m_encoder)
+    {
+        opus_multistream_encoder_destroy(m_encoder);
+        m_encoder = nullptr;
+    }
+
+    if (m_resampling)
+    {
+        ma_resampler_uninit(&m_resampler, nullptr);
+        m_resampling = false;
+    }
+}
+
+} // namespace sf::priv
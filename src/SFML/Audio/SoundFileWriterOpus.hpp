@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileWriter.hpp>
+
+#include <miniaudio.h>
+#include <ogg/ogg.h>
+#include <opus_multistream.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <cstdint>
+
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Implementation of sound file writer that handles OGG/Opus files
+///
+////////////////////////////////////////////////////////////
+class SoundFileWriterOpus : public SoundFileWriter
+{
+public:
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if this writer can handle a file on disk
+    ///
+    /// \param filename Path of the sound file to check
+    ///
+    /// \return True if the file can be written by this writer
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static bool check(const std::filesystem::path& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundFileWriterOpus() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a sound file for writing
+    ///
+    /// \param filename     Path of the file to open
+    /// \param sampleRate   Sample rate of the sound
+    /// \param channelCount Number of channels of the sound
+    /// \param channelMap   Map of position in sample frame to sound channel
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool open(const std::filesystem::path&     filename,
+                            unsigned int                     sampleRate,
+                            unsigned int                     channelCount,
+                            const std::vector<SoundChannel>& channelMap) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write audio samples to the open file
+    ///
+    /// \param samples Pointer to the sample array to write
+    /// \param count   Number of samples to write
+    ///
+    ////////////////////////////////////////////////////////////
+    void write(const std::int16_t* samples, std::uint64_t count) override;
+
+private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Add remapped frames to the pending frame, converting them to 48 kHz
+    ///
+    /// Full frames are encoded as they are completed.
+    ///
+    /// \param input      Pointer to the remapped frames
+    /// \param frameCount Number of frames to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void feed(const std::int16_t* input, std::uint64_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the pending frame and write it to the ogg stream
+    ///
+    /// \param endOfStream True if this is the last packet of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    void encodeFrame(bool endOfStream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a packet to the ogg stream
+    ///
+    /// \param data            Pointer to the packet data
+    /// \param size            Size of the packet, in bytes
+    /// \param granulePosition Granule position of the packet
+    /// \param endOfStream     True if this is the last packet of the stream
+    /// \param flush           True to force the pending pages to be written
+    ///
+    ////////////////////////////////////////////////////////////
+    void writePacket(unsigned char* data, std::size_t size, std::int64_t granulePosition, bool endOfStream, bool flush);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int               m_channelCount{}; //!< Channel count of the sound being written
+    std::array<std::size_t, 8> m_remapTable{};   //!< Table we use to remap source to target channel order
+    std::ofstream              m_file;           //!< Output file
+    ogg_stream_state           m_ogg{};          //!< OGG stream
+    OpusMSEncoder*             m_encoder{};      //!< Opus encoder
+    ma_resampler               m_resampler{};    //!< Resampler converting the input to 48 kHz
+    bool                       m_resampling{};   //!< Whether the input must be resampled
+    std::vector<std::int16_t>  m_input;          //!< Remapped input samples, at the input sample rate
+    std::vector<std::int16_t>  m_frame;          //!< Samples of the frame being filled, at 48 kHz
+    std::size_t                m_frameFill{};    //!< Number of frames already in m_frame
+    std::vector<unsigned char> m_packet;         //!< Buffer receiving the encoded packets
+    std::int64_t               m_preSkip{};      //!< Number of frames to skip at the beginning of the decoded stream
+    std::int64_t               m_frameCount{};   //!< Number of frames submitted to the encoder so far, padding excluded
+    std::int64_t               m_encodedCount{}; //!< Number of frames encoded so far, padding included
+    std::uint64_t              m_inputCount{};   //!< Number of frames written, at the input sample rate
+    unsigned int               m_sampleRate{};   //!< Sample rate of the sound being written
+    std::int64_t               m_packetNumber{}; //!< Sequence number of the next ogg packet
+};
+
+} // namespace sf::priv
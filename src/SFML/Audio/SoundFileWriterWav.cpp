@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/Audio/SoundFileWriterWav.hpp>
 
 #include <SFML/System/Err.hpp>
@@ -229,13 +230,23 @@ void SoundFileWriterWav::write(const std::int16_t* samples, std::uint64_t count)
     if (count % m_channelCount != 0)
         err() << "Writing samples to WAV sound file requires writing full frames at a time" << std::endl;
 
-    while (count >= m_channelCount)
+    // Process the samples by chunks so that the temporary buffers stay small
+    constexpr std::uint64_t chunkSize = 4096;
+
+    std::uint64_t frameCount = count / m_channelCount;
+    while (frameCount > 0)
     {
-        for (auto i = 0u; i < m_channelCount; ++i)
-            encode(m_file, samples[m_remapTable[i]]);
+        const auto frames = static_cast<std::size_t>(std::min(frameCount, chunkSize));
+
+        // Remap the samples to the target channels and encode them as little endian
+        m_samples.resize(frames * m_channelCount);
+        m_bytes.resize(m_samples.size() * sizeof(std::int16_t));
+        SampleConversion::remap(samples, frames, m_remapTable.data(), m_channelCount, m_samples.data());
+        SampleConversion::toLittleEndian(m_samples.data(), m_samples.size(), m_bytes.data());
+        m_file.write(reinterpret_cast<const char*>(m_bytes.data()), static_cast<std::streamsize>(m_bytes.size()));
 
-        samples += m_channelCount;
-        count -= m_channelCount;
+        samples += m_samples.size();
+        frameCount -= frames;
     }
 }
 
@@ -32,7 +32,9 @@
 #include <array>
 #include <filesystem>
 #include <fstream>
+#include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -109,6 +111,8 @@ private:
     std::ofstream               m_file;           //!< File stream to write to
     unsigned int                m_channelCount{}; //!< Channel count of the sound being written
     std::array<std::size_t, 18> m_remapTable{};   //!< Table we use to remap source to target channel order
+    std::vector<std::int16_t>   m_samples;        //!< Remapped samples of the chunk being written
+    std::vector<std::byte>      m_bytes;          //!< Encoded samples of the chunk being written
 };
 
 } // namespace sf::priv
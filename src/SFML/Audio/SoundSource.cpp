@@ -25,11 +25,13 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/SoundSource.hpp>
 
 #include <miniaudio.h>
 
 #include <algorithm>
+#include <vector>
 
 
 namespace sf
@@ -173,6 +175,12 @@ void SoundSource::setEffectProcessor(EffectProcessor)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundSource::setAnalyzer(SoundAnalyzer*)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 float SoundSource::getPitch() const
 {
@@ -372,6 +380,37 @@ SoundSource& SoundSource::operator=(const SoundSource& right)
 
     return *this;
 }
+
+
+////////////////////////////////////////////////////////////
+SoundSource::Statistics SoundSource::getStatistics() const
+{
+    return {};
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundSource::setSpatialStates(const SpatialState* states, std::size_t count)
+{
+    // Reuse the same scratch buffer from one batch to the next to avoid allocating every frame
+    thread_local std::vector<priv::AudioDevice::SpatialUpdate> updates;
+    updates.clear();
+    updates.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto& state = states[i];
+
+        if (!state.source)
+            continue;
+
+        if (auto* sound = static_cast<ma_sound*>(state.source->getSound()))
+            updates.push_back({sound, state.position, state.velocity, state.direction});
+    }
+
+    if (!updates.empty())
+        priv::AudioDevice::queueSpatialUpdates(updates.data(), updates.size());
+}
 // NOLINTEND(readability-make-member-function-const)
 
 } // namespace sf
@@ -91,6 +91,8 @@ struct SoundStream::Impl : priv::MiniaudioUtils::SoundBase
         auto& impl  = *static_cast<Impl*>(dataSource);
         auto* owner = impl.owner;
 
+        const ProcessingTimer timer(impl);
+
         // Try to fill our buffer with new samples if the source is still willing to stream data
         if (impl.sampleBuffer.empty() && impl.streaming)
         {
@@ -138,6 +140,15 @@ struct SoundStream::Impl : priv::MiniaudioUtils::SoundBase
                 }
             }
         }
+        else if (impl.streaming && impl.channelCount > 0)
+        {
+            // The source is still streaming but could not provide any data in time:
+            // play silence instead of ending the sound, and try again during the next period
+            std::memset(framesOut, 0, static_cast<std::size_t>(frameCount * impl.channelCount) * sizeof(std::int16_t));
+            *framesRead = frameCount;
+
+            impl.countUnderrun();
+        }
         else
         {
             *framesRead = 0;
@@ -344,6 +355,13 @@ SoundStream::Status SoundStream::getStatus() const
 }
 
 
+////////////////////////////////////////////////////////////
+SoundStream::Statistics SoundStream::getStatistics() const
+{
+    return m_impl->getStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundStream::setPlayingOffset(Time timeOffset)
 {
@@ -392,7 +410,16 @@ bool SoundStream::getLoop() const
 void SoundStream::setEffectProcessor(EffectProcessor effectProcessor)
 {
     m_impl->effectProcessor = std::move(effectProcessor);
-    m_impl->connectEffect(bool{m_impl->effectProcessor});
+    m_impl->connectEffect(bool{m_impl->effectProcessor} || m_impl->analyzer.isSet());
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setAnalyzer(SoundAnalyzer* analyzer)
+{
+    // Waits until the audio thread is done with the previous analyzer, so that it can be destroyed
+    m_impl->analyzer.set(analyzer);
+    m_impl->connectEffect(bool{m_impl->effectProcessor} || analyzer != nullptr);
 }
 
 
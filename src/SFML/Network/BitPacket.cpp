@@ -0,0 +1,455 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/BitPacket.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+#include <cmath>
+
+
+namespace
+{
+// First byte of the data sent by onSend, telling how the rest is encoded
+enum class Encoding : std::uint8_t
+{
+    Raw,  //!< Bytes of the packet as they are
+    Delta //!< Difference with the baseline
+};
+
+////////////////////////////////////////////////////////////
+// Number of bits needed to represent every value in [0, range]
+unsigned int bitWidth(std::uint64_t range)
+{
+    unsigned int width = 0;
+    while (range != 0)
+    {
+        range >>= 1;
+        ++width;
+    }
+    return width;
+}
+
+
+// Quantized floats are written with at most 32 bits
+constexpr std::uint64_t maxQuantizationSteps = std::numeric_limits<std::uint32_t>::max();
+
+
+// Largest packet that can be delta-encoded; runs of zeros compress without
+// bound, so the decoded size can't be checked against the received size
+constexpr std::uint64_t maxDecodedSize = 16 * 1024 * 1024;
+
+
+////////////////////////////////////////////////////////////
+// Number of quantization steps of a float range, 0 if the parameters are unusable
+std::uint64_t quantizationSteps(float min, float max, float precision)
+{
+    if (!(max > min) || !(precision > 0.f))
+        return 0;
+
+    const double range = static_cast<double>(max) - static_cast<double>(min);
+    const double steps = std::ceil(range / static_cast<double>(precision));
+
+    if (steps > static_cast<double>(maxQuantizationSteps))
+    {
+        const double limit = static_cast<double>(min) +
+                             static_cast<double>(maxQuantizationSteps) * static_cast<double>(precision);
+        sf::err() << "BitPacket float range [" << min << ", " << max << "] has too many steps for a precision of "
+                  << precision << ", values above " << limit << " are clamped" << std::endl;
+        return maxQuantizationSteps;
+    }
+
+    return static_cast<std::uint64_t>(steps);
+}
+
+
+////////////////////////////////////////////////////////////
+void appendVarint(std::vector<std::byte>& bytes, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::byte>(value));
+}
+
+
+////////////////////////////////////////////////////////////
+bool readVarint(const std::byte*& begin, const std::byte* end, std::uint64_t& value)
+{
+    value = 0;
+    for (unsigned int shift = 0; (begin != end) && (shift < 64); shift += 7)
+    {
+        const auto byte = static_cast<std::uint64_t>(*begin++);
+
+        // The tenth byte holds the last bit, anything more doesn't fit in 64 bits
+        if ((shift == 63) && (byte > 1))
+            return false;
+
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeBits(std::uint64_t value, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 64u);
+
+    // Write at most 32 bits at a time so that the pending bits never overflow
+    while (bitCount > 0)
+    {
+        const unsigned int  chunkSize = std::min(bitCount, 32u);
+        const std::uint64_t chunk     = value & ((std::uint64_t{1} << chunkSize) - 1);
+
+        m_pendingBits |= chunk << m_pendingBitCount;
+        m_pendingBitCount += chunkSize;
+
+        // Move complete 32-bit words to the packet data
+        if (m_pendingBitCount >= 32)
+        {
+            const std::array<std::uint8_t, 4> bytes = {static_cast<std::uint8_t>(m_pendingBits),
+                                                       static_cast<std::uint8_t>(m_pendingBits >> 8),
+                                                       static_cast<std::uint8_t>(m_pendingBits >> 16),
+                                                       static_cast<std::uint8_t>(m_pendingBits >> 24)};
+            append(bytes.data(), bytes.size());
+
+            m_pendingBits >>= 32;
+            m_pendingBitCount -= 32;
+        }
+
+        value >>= chunkSize;
+        bitCount -= chunkSize;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeBool(bool value)
+{
+    return writeBits(value ? 1 : 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeInteger(std::int64_t value, std::int64_t min, std::int64_t max)
+{
+    if (max < min)
+        std::swap(min, max);
+
+    value = std::clamp(value, min, max);
+
+    // Unsigned arithmetic wraps around correctly for the full range of std::int64_t
+    const std::uint64_t range  = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min);
+    const std::uint64_t offset = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(min);
+    return writeBits(offset, bitWidth(range));
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::writeFloat(float value, float min, float max, float precision)
+{
+    const std::uint64_t steps = quantizationSteps(min, max, precision);
+    if (steps == 0)
+        return *this;
+
+    // The upper bound gets its own step so that it survives the round trip exactly,
+    // unless the range has too many steps and the last one is below it
+    if (!(value < max))
+        return writeBits(steps, bitWidth(steps));
+
+    const double clamped = std::max(static_cast<double>(value), static_cast<double>(min));
+    const double step    = std::round((clamped - static_cast<double>(min)) / static_cast<double>(precision));
+    return writeBits(std::min(static_cast<std::uint64_t>(step), steps), bitWidth(steps));
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::alignToByte()
+{
+    return writeBits(0, (8 - m_pendingBitCount % 8) % 8);
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readBits(std::uint64_t& value, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 64u);
+
+    if (!*this || (bitCount > getRemainingBits()))
+    {
+        invalidate();
+        return *this;
+    }
+
+    const auto*       data     = static_cast<const std::uint8_t*>(getData());
+    const std::size_t dataSize = getDataSize();
+
+    // Gather the bits byte by byte, the last bytes may still be pending
+    std::uint64_t result = 0;
+    for (unsigned int read = 0; read < bitCount;)
+    {
+        const std::size_t  byteIndex = m_readBit / 8;
+        const unsigned int bitIndex  = static_cast<unsigned int>(m_readBit % 8);
+        const unsigned int count     = std::min(8 - bitIndex, bitCount - read);
+
+        const std::uint64_t byte = (byteIndex < dataSize) ? data[byteIndex]
+                                                          : ((m_pendingBits >> ((byteIndex - dataSize) * 8)) & 0xFF);
+
+        result |= ((byte >> bitIndex) & ((1u << count) - 1)) << read;
+        read += count;
+        m_readBit += count;
+    }
+
+    value = result;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readBool(bool& value)
+{
+    std::uint64_t bit = 0;
+    if (readBits(bit, 1))
+        value = (bit != 0);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readInteger(std::int64_t& value, std::int64_t min, std::int64_t max)
+{
+    if (max < min)
+        std::swap(min, max);
+
+    const std::uint64_t range  = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min);
+    std::uint64_t       offset = 0;
+    if (readBits(offset, bitWidth(range)))
+        value = static_cast<std::int64_t>(static_cast<std::uint64_t>(min) + std::min(offset, range));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+BitPacket& BitPacket::readFloat(float& value, float min, float max, float precision)
+{
+    const std::uint64_t steps = quantizationSteps(min, max, precision);
+    if (steps == 0)
+    {
+        value = min;
+        return *this;
+    }
+
+    std::uint64_t step = 0;
+    if (readBits(step, bitWidth(steps)))
+    {
+        const double result = static_cast<double>(min) + static_cast<double>(step) * static_cast<double>(precision);
+        const bool isMax = (step >= steps) && (steps < maxQuantizationSteps);
+        value            = isMax ? max : static_cast<float>(std::min(result, static_cast<double>(max)));
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitPacket::getBitSize() const
+{
+    return getDataSize() * 8 + m_pendingBitCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitPacket::getRemainingBits() const
+{
+    return getBitSize() - std::min(m_readBit, getBitSize());
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::setBaseline(const BitPacket& baseline)
+{
+    m_baseline.clear();
+    baseline.copyBytes(m_baseline);
+    m_hasBaseline = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::clearBaseline()
+{
+    m_baseline.clear();
+    m_hasBaseline = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* BitPacket::onSend(std::size_t& size)
+{
+    m_sendBuffer.clear();
+    m_sendBuffer.push_back(static_cast<std::byte>(Encoding::Raw));
+    copyBytes(m_sendBuffer);
+
+    if (m_hasBaseline && (m_sendBuffer.size() - 1 <= maxDecodedSize))
+    {
+        // XOR with the baseline, so that unchanged bytes become zeros, then
+        // encode the result as alternating runs of zeros and literal bytes
+        const std::size_t      byteCount = m_sendBuffer.size() - 1;
+        std::vector<std::byte> delta;
+        delta.reserve(byteCount / 4 + 16);
+        delta.push_back(static_cast<std::byte>(Encoding::Delta));
+        appendVarint(delta, byteCount);
+
+        const auto difference = [&](std::size_t i)
+        { return m_sendBuffer[i + 1] ^ (i < m_baseline.size() ? m_baseline[i] : std::byte{0}); };
+
+        for (std::size_t i = 0; i < byteCount;)
+        {
+            const std::size_t zeroBegin = i;
+            while ((i < byteCount) && (difference(i) == std::byte{0}))
+                ++i;
+
+            // Literals run until two consecutive zeros, a single zero is cheaper to keep as a literal
+            const std::size_t literalBegin = i;
+            while ((i < byteCount) &&
+                   ((difference(i) != std::byte{0}) || ((i + 1 < byteCount) && (difference(i + 1) != std::byte{0}))))
+                ++i;
+
+            appendVarint(delta, literalBegin - zeroBegin);
+            appendVarint(delta, i - literalBegin);
+            for (std::size_t j = literalBegin; j < i; ++j)
+                delta.push_back(difference(j));
+        }
+
+        // Keep the raw encoding if the packet has nothing in common with the baseline
+        if (delta.size() < m_sendBuffer.size())
+            m_sendBuffer.swap(delta);
+    }
+
+    size = m_sendBuffer.size();
+    return m_sendBuffer.data();
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::onClear()
+{
+    m_pendingBits     = 0;
+    m_pendingBitCount = 0;
+    m_readBit         = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::onReceive(const void* data, std::size_t size)
+{
+    clear();
+
+    const auto* begin = static_cast<const std::byte*>(data);
+    const auto* end   = begin + size;
+    if (begin == end)
+        return;
+
+    const auto encoding = static_cast<Encoding>(*begin++);
+    if (encoding == Encoding::Raw)
+    {
+        append(begin, static_cast<std::size_t>(end - begin));
+        return;
+    }
+
+    // Rebuild the bytes of the packet from the baseline and the runs of differences
+    std::uint64_t byteCount = 0;
+    if ((encoding != Encoding::Delta) || !m_hasBaseline || !readVarint(begin, end, byteCount) ||
+        (byteCount > maxDecodedSize))
+    {
+        invalidate();
+        return;
+    }
+
+    m_sendBuffer.assign(static_cast<std::size_t>(byteCount), std::byte{0});
+    std::copy_n(m_baseline.begin(), std::min(m_baseline.size(), m_sendBuffer.size()), m_sendBuffer.begin());
+
+    for (std::size_t i = 0; i < m_sendBuffer.size();)
+    {
+        std::uint64_t zeroCount    = 0;
+        std::uint64_t literalCount = 0;
+        if (!readVarint(begin, end, zeroCount) || !readVarint(begin, end, literalCount) ||
+            (zeroCount > m_sendBuffer.size() - i) || (literalCount > m_sendBuffer.size() - i - zeroCount) ||
+            (literalCount > static_cast<std::uint64_t>(end - begin)))
+        {
+            invalidate();
+            m_sendBuffer.clear();
+            return;
+        }
+
+        i += static_cast<std::size_t>(zeroCount);
+        for (std::uint64_t j = 0; j < literalCount; ++j)
+            m_sendBuffer[i++] ^= *begin++;
+
+        // An empty run can't make progress, the data is corrupted
+        if (zeroCount + literalCount == 0)
+        {
+            invalidate();
+            m_sendBuffer.clear();
+            return;
+        }
+    }
+
+    append(m_sendBuffer.data(), m_sendBuffer.size());
+    m_sendBuffer.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void BitPacket::copyBytes(std::vector<std::byte>& bytes) const
+{
+    const auto* data = static_cast<const std::byte*>(getData());
+    bytes.insert(bytes.end(), data, data + getDataSize());
+
+    for (unsigned int i = 0; i < m_pendingBitCount; i += 8)
+        bytes.push_back(static_cast<std::byte>((m_pendingBits >> i) & 0xFF));
+}
+
+} // namespace sf
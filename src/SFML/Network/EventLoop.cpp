@@ -0,0 +1,573 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/EventLoop.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct EventLoop::EventLoopImpl
+{
+    // Handler call, bound to the result of its operation
+    using Completion = std::function<void()>;
+
+    struct Operation
+    {
+        std::function<Completion()> attempt;   //!< Try to perform the operation, return its completion when it is over
+        Completion                  cancelled; //!< Completion to call if the operation is cancelled
+    };
+
+    struct Request
+    {
+        Socket*   socket{};  //!< Socket of the operation
+        bool      isSend{};  //!< Does the operation wait for the socket to be ready to send?
+        Operation operation; //!< The operation itself
+    };
+
+    struct Entry
+    {
+        std::optional<Operation> receive; //!< Pending receive-like operation
+        std::optional<Operation> send;    //!< Pending send-like operation
+    };
+
+    explicit EventLoopImpl(std::size_t threadCount)
+    {
+        // The loop wakes itself up by sending a datagram to this socket
+        if (wakeupSocket.bind(Socket::AnyPort, IpAddress::LocalHost) != Socket::Status::Done)
+            err() << "Failed to bind the wake-up socket of the event loop" << std::endl;
+
+        wakeupSocket.setBlocking(false);
+        wakeupPort = wakeupSocket.getLocalPort();
+        selector.add(wakeupSocket, SocketSelector::Interest::Receive);
+
+        workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            workers.emplace_back([this] { work(); });
+    }
+
+    ~EventLoopImpl()
+    {
+        {
+            const std::lock_guard lock(mutex);
+            shuttingDown = true;
+        }
+
+        workAvailable.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wakeUp()
+    {
+        if (wakeupPending.exchange(true))
+            return;
+
+        const char byte = 0;
+        static_cast<void>(wakeupSocket.send(&byte, 1, IpAddress::LocalHost, wakeupPort));
+    }
+
+    ////////////////////////////////////////////////////////////
+    void submit(Socket& socket, bool isSend, Operation operation)
+    {
+        {
+            const std::lock_guard lock(mutex);
+            requests.push_back({&socket, isSend, std::move(operation)});
+            ++outstanding;
+        }
+
+        wakeUp();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Run the completion handlers on the thread pool
+    void work()
+    {
+        std::unique_lock lock(mutex);
+        for (;;)
+        {
+            workAvailable.wait(lock, [this] { return shuttingDown || !workQueue.empty(); });
+            if (workQueue.empty())
+                return;
+
+            const Completion completion = std::move(workQueue.front());
+            workQueue.pop_front();
+
+            lock.unlock();
+            completion();
+            lock.lock();
+
+            // Let run know when the last piece of work is done
+            if (--outstanding == 0)
+                wakeUp();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Watch a socket for the operations that it still has
+    void updateInterest(Socket& socket, const Entry& entry)
+    {
+        if (entry.receive && entry.send)
+            selector.add(socket, SocketSelector::Interest::ReceiveAndSend);
+        else if (entry.receive)
+            selector.add(socket, SocketSelector::Interest::Receive);
+        else if (entry.send)
+            selector.add(socket, SocketSelector::Interest::Send);
+        else
+        {
+            selector.remove(socket);
+            entries.erase(&socket);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Attempt an operation, keep it pending if it can't complete yet
+    void attempt(std::optional<Operation>& operation)
+    {
+        if (Completion completion = operation->attempt())
+        {
+            completions.push_back(std::move(completion));
+            operation.reset();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Take the requests made by other threads into account
+    void applyRequests()
+    {
+        std::vector<Request>    newRequests;
+        std::vector<Socket*>    newCancellations;
+        std::vector<Completion> newTasks;
+        {
+            const std::lock_guard lock(mutex);
+            newRequests.swap(requests);
+            newCancellations.swap(cancellations);
+            newTasks.swap(tasks);
+        }
+
+        for (Completion& task : newTasks)
+            completions.push_back(std::move(task));
+
+        for (Request& request : newRequests)
+        {
+            Entry&                    entry = entries[request.socket];
+            std::optional<Operation>& slot  = request.isSend ? entry.send : entry.receive;
+            if (slot)
+            {
+                err() << "Cannot start an asynchronous operation on a socket that already has one pending in the "
+                         "same direction"
+                      << std::endl;
+                completions.push_back(std::move(request.operation.cancelled));
+                continue;
+            }
+
+            // Sockets are only touched by this thread, the handlers may be running on other ones
+            if (request.socket->isBlocking())
+                request.socket->setBlocking(false);
+
+            // The operation may complete right away, for example when the data is already buffered
+            slot = std::move(request.operation);
+            attempt(slot);
+            updateInterest(*request.socket, entry);
+        }
+
+        for (Socket* socket : newCancellations)
+        {
+            const auto it = entries.find(socket);
+            if (it == entries.end())
+                continue;
+
+            for (std::optional<Operation>* operation : {&it->second.receive, &it->second.send})
+            {
+                if (*operation)
+                    completions.push_back(std::move((*operation)->cancelled));
+            }
+
+            selector.remove(*socket);
+            entries.erase(it);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Run the completions, or hand them to the thread pool
+    std::size_t dispatch()
+    {
+        const std::size_t count = completions.size();
+        if (count == 0)
+            return 0;
+
+        if (!workers.empty())
+        {
+            {
+                const std::lock_guard lock(mutex);
+                for (Completion& completion : completions)
+                    workQueue.push_back(std::move(completion));
+            }
+
+            completions.clear();
+            workAvailable.notify_all();
+            return count;
+        }
+
+        std::vector<Completion> running;
+        running.swap(completions);
+        for (const Completion& completion : running)
+        {
+            completion();
+
+            const std::lock_guard lock(mutex);
+            --outstanding;
+        }
+
+        return count;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t runOnce(Time timeout)
+    {
+        applyRequests();
+
+        // Don't wait if there are already handlers to run
+        if (completions.empty() && selector.wait(timeout))
+        {
+            for (const SocketSelector::ReadySocket& ready : selector.getReadySockets())
+            {
+                if (ready.socket == &wakeupSocket)
+                {
+                    std::array<char, 64>     buffer{};
+                    std::size_t              received = 0;
+                    std::optional<IpAddress> address;
+                    unsigned short           port = 0;
+                    while (wakeupSocket.receive(buffer.data(), buffer.size(), received, address, port) ==
+                           Socket::Status::Done)
+                    {
+                    }
+
+                    // Only clear the flag once the datagrams are drained: a wake-up requested
+                    // from now on sends a new one, so it can't be lost while waiting
+                    wakeupPending = false;
+                    continue;
+                }
+
+                const auto it = entries.find(ready.socket);
+                if (it == entries.end())
+                    continue;
+
+                Entry&     entry   = it->second;
+                const bool receive = entry.receive.has_value();
+                const bool send    = entry.send.has_value();
+                if (ready.receive && receive)
+                    attempt(entry.receive);
+                if (ready.send && send)
+                    attempt(entry.send);
+
+                if ((entry.receive.has_value() != receive) || (entry.send.has_value() != send))
+                    updateInterest(*ready.socket, entry);
+            }
+        }
+
+        return dispatch();
+    }
+
+    ////////////////////////////////////////////////////////////
+    SocketSelector                     selector;        //!< Waits for the sockets of the pending operations
+    UdpSocket                          wakeupSocket;    //!< Interrupts the wait when it receives a datagram
+    unsigned short                     wakeupPort{};    //!< Port of the wake-up socket
+    std::atomic<bool>                  wakeupPending{}; //!< Was a wake-up datagram sent and not consumed yet?
+    std::unordered_map<Socket*, Entry> entries;         //!< Pending operations, by socket (loop thread only)
+    std::vector<Completion>            completions;     //!< Completions to dispatch (loop thread only)
+    std::mutex                         mutex;           //!< Protects the members below
+    std::vector<Request>               requests;        //!< Operations started since the last iteration
+    std::vector<Socket*>               cancellations;   //!< Sockets cancelled since the last iteration
+    std::vector<Completion>            tasks;           //!< Tasks posted since the last iteration
+    std::deque<Completion>             workQueue;       //!< Completions waiting for a thread of the pool
+    std::condition_variable            workAvailable;   //!< Wakes the pool up when there is work
+    std::size_t                        outstanding{};   //!< Operations and tasks whose handler hasn't returned
+    bool                               stopped{};       //!< Was stop called?
+    bool                               shuttingDown{};  //!< Is the pool being destroyed?
+    std::vector<std::thread>           workers;         //!< Threads of the pool
+};
+
+
+////////////////////////////////////////////////////////////
+EventLoop::EventLoop(std::size_t threadCount) : m_impl(std::make_unique<EventLoopImpl>(threadCount))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+EventLoop::~EventLoop() = default;
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncAccept(TcpListener& listener, TcpSocket& socket, Handler handler)
+{
+    auto attempt = [&listener, &socket, handler]() -> EventLoopImpl::Completion
+    {
+        const Socket::Status status = listener.accept(socket);
+        if (status == Socket::Status::NotReady)
+            return {};
+
+        // The new connection is used with the loop as well
+        socket.setBlocking(false);
+        return [handler, status] { handler(status); };
+    };
+
+    m_impl->submit(listener, false, {std::move(attempt), [handler] { handler(Socket::Status::Error); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncConnect(TcpSocket&       socket,
+                             const IpAddress& remoteAddress,
+                             unsigned short   remotePort,
+                             Handler          handler)
+{
+    socket.setBlocking(false);
+
+    // The first attempt starts the connection, the next ones check whether it was established
+    auto attempt = [&socket, remoteAddress, remotePort, handler, started = false]() mutable -> EventLoopImpl::Completion
+    {
+        Socket::Status status = Socket::Status::Done;
+        if (!started)
+        {
+            started = true;
+            status  = socket.connect(remoteAddress, remotePort);
+            if (status == Socket::Status::NotReady)
+                return {};
+        }
+        else if (!socket.getRemoteAddress().has_value())
+        {
+            status = Socket::Status::Error;
+        }
+
+        return [handler, status] { handler(status); };
+    };
+
+    m_impl->submit(socket, true, {std::move(attempt), [handler] { handler(Socket::Status::Error); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncSend(TcpSocket& socket, const void* data, std::size_t size, SizeHandler handler)
+{
+    auto attempt = [&socket, data, size, handler, total = std::size_t{0}]() mutable -> EventLoopImpl::Completion
+    {
+        std::size_t          sent   = 0;
+        const Socket::Status status = socket.send(static_cast<const char*>(data) + total, size - total, sent);
+        total += sent;
+
+        if ((status == Socket::Status::NotReady) || (status == Socket::Status::Partial))
+            return {};
+
+        return [handler, status, total] { handler(status, total); };
+    };
+
+    m_impl->submit(socket, true, {std::move(attempt), [handler] { handler(Socket::Status::Error, 0); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncSend(TcpSocket& socket, Packet& packet, Handler handler)
+{
+    auto attempt = [&socket, &packet, handler]() -> EventLoopImpl::Completion
+    {
+        const Socket::Status status = socket.send(packet);
+        if ((status == Socket::Status::NotReady) || (status == Socket::Status::Partial))
+            return {};
+
+        return [handler, status] { handler(status); };
+    };
+
+    m_impl->submit(socket, true, {std::move(attempt), [handler] { handler(Socket::Status::Error); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncReceive(TcpSocket& socket, void* data, std::size_t size, SizeHandler handler)
+{
+    auto attempt = [&socket, data, size, handler]() -> EventLoopImpl::Completion
+    {
+        std::size_t          received = 0;
+        const Socket::Status status   = socket.receive(data, size, received);
+        if (status == Socket::Status::NotReady)
+            return {};
+
+        return [handler, status, received] { handler(status, received); };
+    };
+
+    m_impl->submit(socket, false, {std::move(attempt), [handler] { handler(Socket::Status::Error, 0); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncReceive(TcpSocket& socket, Packet& packet, Handler handler)
+{
+    auto attempt = [&socket, &packet, handler]() -> EventLoopImpl::Completion
+    {
+        const Socket::Status status = socket.receive(packet);
+        if (status == Socket::Status::NotReady)
+            return {};
+
+        return [handler, status] { handler(status); };
+    };
+
+    m_impl->submit(socket, false, {std::move(attempt), [handler] { handler(Socket::Status::Error); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncSend(UdpSocket&       socket,
+                          const void*      data,
+                          std::size_t      size,
+                          const IpAddress& remoteAddress,
+                          unsigned short   remotePort,
+                          Handler          handler)
+{
+    auto attempt = [&socket, data, size, remoteAddress, remotePort, handler]() -> EventLoopImpl::Completion
+    {
+        const Socket::Status status = socket.send(data, size, remoteAddress, remotePort);
+        if (status == Socket::Status::NotReady)
+            return {};
+
+        return [handler, status] { handler(status); };
+    };
+
+    m_impl->submit(socket, true, {std::move(attempt), [handler] { handler(Socket::Status::Error); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::asyncReceive(UdpSocket& socket, void* data, std::size_t size, DatagramHandler handler)
+{
+    auto attempt = [&socket, data, size, handler]() -> EventLoopImpl::Completion
+    {
+        std::size_t              received = 0;
+        std::optional<IpAddress> remoteAddress;
+        unsigned short           remotePort = 0;
+        const Socket::Status     status     = socket.receive(data, size, received, remoteAddress, remotePort);
+        if (status == Socket::Status::NotReady)
+            return {};
+
+        return [handler, status, received, remoteAddress, remotePort]
+        { handler(status, received, remoteAddress, remotePort); };
+    };
+
+    m_impl->submit(socket,
+                   false,
+                   {std::move(attempt),
+                    [handler] { handler(Socket::Status::Error, 0, std::nullopt, 0); }});
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::post(Task task)
+{
+    {
+        const std::lock_guard lock(m_impl->mutex);
+        m_impl->tasks.push_back(std::move(task));
+        ++m_impl->outstanding;
+    }
+
+    m_impl->wakeUp();
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::cancel(Socket& socket)
+{
+    {
+        const std::lock_guard lock(m_impl->mutex);
+        m_impl->cancellations.push_back(&socket);
+    }
+
+    m_impl->wakeUp();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventLoop::run()
+{
+    std::size_t count = 0;
+    for (;;)
+    {
+        {
+            const std::lock_guard lock(m_impl->mutex);
+            if (m_impl->stopped || (m_impl->outstanding == 0))
+            {
+                m_impl->stopped = false;
+                return count;
+            }
+        }
+
+        count += m_impl->runOnce(Time::Zero);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventLoop::runOnce(Time timeout)
+{
+    const std::size_t count = m_impl->runOnce(timeout);
+
+    const std::lock_guard lock(m_impl->mutex);
+    m_impl->stopped = false;
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::stop()
+{
+    {
+        const std::lock_guard lock(m_impl->mutex);
+        m_impl->stopped = true;
+    }
+
+    m_impl->wakeUp();
+}
+
+} // namespace sf
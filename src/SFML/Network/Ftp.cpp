@@ -27,18 +27,78 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Resolver.hpp>
 
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace
+{
+// Size of the blocks in which files are received
+constexpr std::size_t receiveBlockSize = 256 * 1024;
+
+// Size of the blocks in which files are sent, between two progress reports
+constexpr std::size_t sendBlockSize = 4 * 1024 * 1024;
+
+// Close the files of downloads
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+// Keep track of a file transfer and report it to the progress callback
+class TransferTracker
+{
+public:
+    TransferTracker(const sf::Ftp::ProgressCallback& callback, std::uint64_t position, std::uint64_t size) :
+    m_callback(callback)
+    {
+        m_progress.position = position;
+        m_progress.size     = size;
+    }
+
+    // Record transferred bytes, return false if the transfer must be aborted
+    bool advance(std::size_t count)
+    {
+        m_progress.position += count;
+        m_transferred += count;
+        if (!m_callback)
+            return true;
+
+        m_progress.elapsed = m_clock.getElapsedTime();
+        if (const float seconds = m_progress.elapsed.asSeconds(); seconds > 0.f)
+            m_progress.bytesPerSecond = static_cast<double>(m_transferred) / static_cast<double>(seconds);
+        return m_callback(m_progress);
+    }
+
+private:
+    const sf::Ftp::ProgressCallback& m_callback;      //!< Function to report the progress to
+    sf::Ftp::TransferProgress        m_progress;      //!< Progress reported to the callback
+    std::uint64_t                    m_transferred{}; //!< Number of bytes transferred since the start
+    sf::Clock                        m_clock;         //!< Time since the start
+};
+} // namespace
 
 
 namespace sf
@@ -66,10 +126,13 @@ public:
     Ftp::Response open(Ftp::TransferMode mode);
 
     ////////////////////////////////////////////////////////////
-    void send(std::istream& stream);
+    void receive(std::ostream& stream);
 
     ////////////////////////////////////////////////////////////
-    void receive(std::ostream& stream);
+    bool receive(std::FILE* file, TransferTracker& tracker);
+
+    ////////////////////////////////////////////////////////////
+    bool send(const std::filesystem::path& path, std::uint64_t offset, std::uint64_t size, TransferTracker& tracker);
 
 private:
     ////////////////////////////////////////////////////////////
@@ -169,6 +232,18 @@ Ftp::Response Ftp::connect(const IpAddress& server, unsigned short port, Time ti
 }
 
 
+////////////////////////////////////////////////////////////
+Ftp::Response Ftp::connect(std::string_view host, unsigned short port, Time timeout)
+{
+    // Connect to the server
+    if (m_commandSocket.connect(Resolver::getDefault().resolve(host), port, timeout) != Socket::Status::Done)
+        return Response(Response::Status::ConnectionFailed);
+
+    // Get the response to the connection
+    return getResponse();
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::Response Ftp::login()
 {
@@ -285,34 +360,61 @@ Ftp::Response Ftp::deleteFile(const std::filesystem::path& name)
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::download(const std::filesystem::path& remoteFile, const std::filesystem::path& localPath, TransferMode mode)
+Ftp::Response Ftp::download(const std::filesystem::path& remoteFile,
+                            const std::filesystem::path& localPath,
+                            TransferMode                 mode,
+                            bool                         resume,
+                            const ProgressCallback&      onProgress)
 {
     // Open a data channel using the given transfer mode
     DataChannel data(*this);
     Response    response = data.open(mode);
     if (response.isOk())
     {
+        const std::filesystem::path filepath = localPath / remoteFile.filename();
+        const std::uint64_t         size     = getRemoteFileSize(remoteFile);
+
+        // Continue after the bytes of the local file, if the server can skip them
+        std::uint64_t offset = 0;
+        if (resume)
+        {
+            std::error_code      error;
+            const std::uintmax_t localSize = std::filesystem::file_size(filepath, error);
+            if (!error && (localSize > 0) && ((size == 0) || (localSize <= size)) &&
+                sendCommand("REST", std::to_string(localSize)).isOk())
+                offset = localSize;
+        }
+
         // Tell the server to start the transfer
         response = sendCommand("RETR", remoteFile.string());
         if (response.isOk())
         {
-            // Create the file and truncate it if necessary
-            const std::filesystem::path filepath = localPath / remoteFile.filename();
-            std::ofstream               file(filepath, std::ios_base::binary | std::ios_base::trunc);
+            // Create the file and truncate it if necessary, or append to it when resuming
+#ifdef SFML_SYSTEM_WINDOWS
+            std::unique_ptr<std::FILE, FileCloser> file(_wfopen(filepath.c_str(), (offset > 0) ? L"ab" : L"wb"));
+#else
+            std::unique_ptr<std::FILE, FileCloser> file(std::fopen(filepath.c_str(), (offset > 0) ? "ab" : "wb"));
+#endif
             if (!file)
                 return Response(Response::Status::InvalidFile);
 
+            // The data is written in large blocks, so the file doesn't need its own buffer
+            std::setvbuf(file.get(), nullptr, _IONBF, 0);
+
             // Receive the file data
-            data.receive(file);
+            TransferTracker tracker(onProgress, offset, size);
+            const bool      complete = data.receive(file.get(), tracker);
 
             // Close the file
-            file.close();
+            file.reset();
 
             // Get the response from the server
             response = getResponse();
+            if (!complete && response.isOk())
+                response = Response(Response::Status::TransferAborted);
 
-            // If the download was unsuccessful, delete the partial file
-            if (!response.isOk())
+            // If the download was unsuccessful, delete the partial file unless it is meant to be resumed
+            if (!response.isOk() && !resume)
                 std::filesystem::remove(filepath);
         }
     }
@@ -325,11 +427,14 @@ Ftp::Response Ftp::download(const std::filesystem::path& remoteFile, const std::
 Ftp::Response Ftp::upload(const std::filesystem::path& localFile,
                           const std::filesystem::path& remotePath,
                           TransferMode                 mode,
-                          bool                         append)
-{
-    // Get the contents of the file to send
-    std::ifstream file(localFile, std::ios_base::binary);
-    if (!file)
+                          bool                         append,
+                          bool                         resume,
+                          const ProgressCallback&      onProgress)
+{
+    // Check the file to send
+    std::error_code      error;
+    const std::uintmax_t size = std::filesystem::file_size(localFile, error);
+    if (error || !std::ifstream(localFile, std::ios_base::binary))
         return Response(Response::Status::InvalidFile);
 
     // Open a data channel using the given transfer mode
@@ -337,15 +442,29 @@ Ftp::Response Ftp::upload(const std::filesystem::path& localFile,
     Response    response = data.open(mode);
     if (response.isOk())
     {
+        const std::string remoteFile = (remotePath / localFile.filename()).string();
+
+        // Skip the bytes that the server already has, if it can continue the file
+        std::uint64_t offset = 0;
+        if (resume)
+        {
+            const std::uint64_t remoteSize = getRemoteFileSize(remoteFile);
+            if ((remoteSize > 0) && (remoteSize <= size) && sendCommand("REST", std::to_string(remoteSize)).isOk())
+                offset = remoteSize;
+        }
+
         // Tell the server to start the transfer
-        response = sendCommand(append ? "APPE" : "STOR", (remotePath / localFile.filename()).string());
+        response = sendCommand((append && !resume) ? "APPE" : "STOR", remoteFile);
         if (response.isOk())
         {
             // Send the file data
-            data.send(file);
+            TransferTracker tracker(onProgress, offset, size);
+            const bool      complete = data.send(localFile, offset, size - offset, tracker);
 
             // Get the response from the server
             response = getResponse();
+            if (!complete && response.isOk())
+                response = Response(Response::Status::TransferAborted);
         }
     }
 
@@ -511,6 +630,19 @@ Ftp::Response Ftp::getResponse()
 }
 
 
+////////////////////////////////////////////////////////////
+std::uint64_t Ftp::getRemoteFileSize(const std::filesystem::path& remoteFile)
+{
+    const Response response = sendCommand("SIZE", remoteFile.string());
+    if (response.getStatus() != Response::Status::FileStatus)
+        return 0;
+
+    std::istringstream in(response.getMessage());
+    std::uint64_t      size = 0;
+    return (in >> size) ? size : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::DataChannel::DataChannel(Ftp& owner) : m_ftp(owner)
 {
@@ -520,61 +652,84 @@ Ftp::DataChannel::DataChannel(Ftp& owner) : m_ftp(owner)
 ////////////////////////////////////////////////////////////
 Ftp::Response Ftp::DataChannel::open(Ftp::TransferMode mode)
 {
-    // Open a data connection in active mode (we connect to the server)
-    Ftp::Response response = m_ftp.sendCommand("PASV");
-    if (response.isOk())
+    Ftp::Response            response;
+    std::optional<IpAddress> address;
+    unsigned short           port = 0;
+
+    // IPv6 servers only support the extended passive mode, which gives a port on the same address (RFC 2428)
+    const std::optional<IpAddress> server = m_ftp.m_commandSocket.getRemoteAddress();
+    if (server && (server->getType() == IpAddress::Type::IpV6))
     {
-        // Extract the connection address and port from the response
-        const std::string::size_type begin = response.getMessage().find_first_of("0123456789");
-        if (begin != std::string::npos)
+        // The port is enclosed in delimiters, as in "229 Entering Extended Passive Mode (|||6446|)"
+        response                           = m_ftp.sendCommand("EPSV");
+        const std::string::size_type begin = response.getMessage().find("|||");
+        if (response.isOk() && (begin != std::string::npos))
         {
-            std::uint8_t data[6] = {0, 0, 0, 0, 0, 0};
-            std::string  str     = response.getMessage().substr(begin);
-            std::size_t  index   = 0;
-            for (unsigned char& datum : data)
+            address = server;
+            port    = static_cast<unsigned short>(std::strtoul(response.getMessage().c_str() + begin + 3, nullptr, 10));
+        }
+    }
+    else
+    {
+        // Open a data connection in active mode (we connect to the server)
+        response = m_ftp.sendCommand("PASV");
+        if (response.isOk())
+        {
+            // Extract the connection address and port from the response
+            const std::string::size_type begin = response.getMessage().find_first_of("0123456789");
+            if (begin != std::string::npos)
             {
-                // Extract the current number
-                while (std::isdigit(str[index]))
+                std::uint8_t data[6] = {0, 0, 0, 0, 0, 0};
+                std::string  str     = response.getMessage().substr(begin);
+                std::size_t  index   = 0;
+                for (unsigned char& datum : data)
                 {
-                    datum = static_cast<std::uint8_t>(
-                        static_cast<std::uint8_t>(datum * 10) + static_cast<std::uint8_t>(str[index] - '0'));
+                    // Extract the current number
+                    while (std::isdigit(str[index]))
+                    {
+                        datum = static_cast<std::uint8_t>(
+                            static_cast<std::uint8_t>(datum * 10) + static_cast<std::uint8_t>(str[index] - '0'));
+                        ++index;
+                    }
+
+                    // Skip separator
                     ++index;
                 }
 
-                // Skip separator
-                ++index;
+                // Reconstruct connection port and address
+                port    = static_cast<std::uint16_t>(data[4] * 256 + data[5]);
+                address = IpAddress(data[0], data[1], data[2], data[3]);
             }
+        }
+    }
 
-            // Reconstruct connection port and address
-            const auto      port = static_cast<std::uint16_t>(data[4] * 256 + data[5]);
-            const IpAddress address(data[0], data[1], data[2], data[3]);
-
-            // Connect the data channel to the server
-            if (m_dataSocket.connect(address, port) == Socket::Status::Done)
-            {
-                // Translate the transfer mode to the corresponding FTP parameter
-                std::string modeStr;
-                switch (mode)
-                {
-                    case Ftp::TransferMode::Binary:
-                        modeStr = "I";
-                        break;
-                    case Ftp::TransferMode::Ascii:
-                        modeStr = "A";
-                        break;
-                    case Ftp::TransferMode::Ebcdic:
-                        modeStr = "E";
-                        break;
-                }
-
-                // Set the transfer mode
-                response = m_ftp.sendCommand("TYPE", modeStr);
-            }
-            else
+    if (address)
+    {
+        // Connect the data channel to the server
+        if (m_dataSocket.connect(*address, port) == Socket::Status::Done)
+        {
+            // Translate the transfer mode to the corresponding FTP parameter
+            std::string modeStr;
+            switch (mode)
             {
-                // Failed to connect to the server
-                response = Ftp::Response(Ftp::Response::Status::ConnectionFailed);
+                case Ftp::TransferMode::Binary:
+                    modeStr = "I";
+                    break;
+                case Ftp::TransferMode::Ascii:
+                    modeStr = "A";
+                    break;
+                case Ftp::TransferMode::Ebcdic:
+                    modeStr = "E";
+                    break;
             }
+
+            // Set the transfer mode
+            response = m_ftp.sendCommand("TYPE", modeStr);
+        }
+        else
+        {
+            // Failed to connect to the server
+            response = Ftp::Response(Ftp::Response::Status::ConnectionFailed);
         }
     }
 
@@ -605,40 +760,72 @@ void Ftp::DataChannel::receive(std::ostream& stream)
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::send(std::istream& stream)
+bool Ftp::DataChannel::receive(std::FILE* file, TransferTracker& tracker)
 {
-    // Send data
-    char        buffer[1024];
-    std::size_t count = 0;
-
-    for (;;)
+    // Receive the data straight into the file, in large blocks
+    std::vector<char> buffer(receiveBlockSize);
+    std::size_t       received = 0;
+    Socket::Status    status   = Socket::Status::Done;
+    while ((status = m_dataSocket.receive(buffer.data(), buffer.size(), received)) == Socket::Status::Done)
     {
-        // read some data from the stream
-        stream.read(buffer, sizeof(buffer));
-
-        if (!stream.good() && !stream.eof())
+        if (std::fwrite(buffer.data(), 1, received, file) != received)
         {
-            err() << "FTP Error: Reading from the file has failed" << std::endl;
+            err() << "FTP Error: Writing to the file has failed" << std::endl;
             break;
         }
 
-        count = static_cast<std::size_t>(stream.gcount());
+        if (!tracker.advance(received))
+            break;
+    }
+
+    // Close the data socket
+    m_dataSocket.disconnect();
 
-        if (count > 0)
+    // The server closes the connection at the end of the file
+    return status == Socket::Status::Disconnected;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Ftp::DataChannel::send(const std::filesystem::path& path,
+                            std::uint64_t                offset,
+                            std::uint64_t                size,
+                            TransferTracker&             tracker)
+{
+    // Open the file once for all the blocks
+#ifdef SFML_SYSTEM_WINDOWS
+    const std::unique_ptr<std::FILE, FileCloser> file(_wfopen(path.c_str(), L"rb"));
+#else
+    const std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path.c_str(), "rb"));
+#endif
+    if (!file)
+        err() << "FTP Error: Failed to open the file to send" << std::endl;
+
+    // Send the file in large blocks, without copying its data when the system allows it
+    bool complete = file != nullptr;
+    for (std::uint64_t done = 0; complete && (done < size);)
+    {
+        const auto  blockSize = static_cast<std::size_t>(std::min<std::uint64_t>(size - done, sendBlockSize));
+        std::size_t sent      = 0;
+        if (m_dataSocket.sendFile(*file, offset + done, blockSize, sent) != Socket::Status::Done)
         {
-            // we could read more data from the stream: send them
-            if (m_dataSocket.send(buffer, count) != Socket::Status::Done)
-                break;
+            err() << "FTP Error: Sending the file has failed" << std::endl;
+            complete = false;
+            break;
         }
-        else
+
+        done += blockSize;
+        if (!tracker.advance(blockSize))
         {
-            // no more data: exit the loop
+            complete = done == size;
             break;
         }
     }
 
     // Close the data socket
     m_dataSocket.disconnect();
+
+    return complete;
 }
 
 } // namespace sf
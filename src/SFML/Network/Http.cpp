@@ -26,11 +26,14 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/Resolver.hpp>
+#include <SFML/Network/TlsSocket.hpp>
 
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Utils.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <iterator>
 #include <limits>
 #include <ostream>
@@ -41,6 +44,37 @@
 #include <cstddef>
 
 
+namespace
+{
+// Bytes requested from the socket at once
+constexpr std::size_t receiveSize = 16 * 1024;
+
+// Longest header or chunk line accepted, to stop a broken server from exhausting memory
+constexpr std::size_t maxHeaderSize = 64 * 1024;
+
+// Requests written ahead of their responses; writing them all at once can fill both socket buffers and deadlock
+constexpr std::size_t maxPipelinedRequests = 32;
+
+
+////////////////////////////////////////////////////////////
+// Parse a number written in the given base, ignoring what follows it
+bool parseNumber(const std::string& text, std::size_t& value, int base)
+{
+    const char* const begin  = text.data();
+    const auto        result = std::from_chars(begin, begin + text.size(), value, base);
+    return (result.ec == std::errc()) && (result.ptr != begin);
+}
+
+
+////////////////////////////////////////////////////////////
+// Only requests without side effects are sent again after a failure, since the server may have handled them
+bool canRetry(sf::Http::Request::Method method)
+{
+    return (method == sf::Http::Request::Method::Get) || (method == sf::Http::Request::Method::Head);
+}
+} // namespace
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -289,6 +323,227 @@ void Http::Response::parseFields(std::istream& in)
 }
 
 
+////////////////////////////////////////////////////////////
+struct Http::Connection
+{
+    ////////////////////////////////////////////////////////////
+    // Send bytes to the host, encrypted for HTTPS hosts
+    Socket::Status send(const void* data, std::size_t size)
+    {
+        return tlsSocket ? tlsSocket->send(data, size) : socket.send(data, size);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Receive bytes from the host, decrypted for HTTPS hosts
+    Socket::Status receive(void* data, std::size_t size, std::size_t& received)
+    {
+        return tlsSocket ? tlsSocket->receive(data, size, received) : socket.receive(data, size, received);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Receive more bytes into the buffer
+    bool fill()
+    {
+        // Drop the bytes that were consumed before growing the buffer
+        if (position > 0)
+        {
+            buffer.erase(0, position);
+            position = 0;
+        }
+
+        const std::size_t size     = buffer.size();
+        std::size_t       received = 0;
+        buffer.resize(size + receiveSize);
+        const Socket::Status status = receive(buffer.data() + size, receiveSize, received);
+        buffer.resize(size + received);
+
+        return status == Socket::Status::Done;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Read everything up to the given delimiter, which is consumed but not returned
+    bool readUntil(const char* delimiter, std::string& text)
+    {
+        std::size_t searchFrom = position;
+        for (;;)
+        {
+            const std::size_t found = buffer.find(delimiter, searchFrom);
+            if (found != std::string::npos)
+            {
+                text.assign(buffer, position, found - position);
+                position = found + std::char_traits<char>::length(delimiter);
+                return true;
+            }
+
+            if (buffer.size() - position > maxHeaderSize)
+                return false;
+
+            // The delimiter may start at the end of the data already received
+            const std::size_t searched = buffer.size() - position;
+            if (!fill())
+                return false;
+
+            searchFrom = position + searched - std::min(searched, std::char_traits<char>::length(delimiter) - 1);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Pass the next bytes to the body callback
+    bool readBody(std::size_t size, const BodyCallback& onBody, bool& aborted)
+    {
+        while (size > 0)
+        {
+            if ((position == buffer.size()) && !fill())
+                return false;
+
+            const std::size_t count = std::min(size, buffer.size() - position);
+            if (!onBody(buffer.data() + position, count))
+            {
+                aborted = true;
+                return true;
+            }
+
+            position += count;
+            size -= count;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Pass all the bytes to the body callback until the server closes the connection
+    bool readBodyUntilClose(const BodyCallback& onBody)
+    {
+        do
+        {
+            if ((position < buffer.size()) && !onBody(buffer.data() + position, buffer.size() - position))
+                return true;
+
+            position = buffer.size();
+        } while (fill());
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Read a chunked body
+    bool readChunkedBody(Response& response, const BodyCallback& onBody, bool& aborted)
+    {
+        std::string line;
+        std::size_t size = 0;
+        while (readUntil("\r\n", line) && parseNumber(line, size, 16))
+        {
+            if (size == 0)
+            {
+                // Parse the trailers, up to the empty line that ends the response
+                std::string trailers;
+                while (readUntil("\r\n", line))
+                {
+                    if (line.empty())
+                    {
+                        std::istringstream in(trailers + "\r\n");
+                        response.parseFields(in);
+                        return true;
+                    }
+
+                    trailers += line + "\r\n";
+                }
+
+                return false;
+            }
+
+            if (!readBody(size, onBody, aborted) || aborted || !readUntil("\r\n", line) || !line.empty())
+                return aborted;
+        }
+
+        return false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Read the next response
+    bool receiveResponse(Request::Method     method,
+                         const BodyCallback& onBody,
+                         Response&           response,
+                         bool&               keepAlive,
+                         bool&               started)
+    {
+        keepAlive = false;
+        started   = false;
+
+        // Skip the interim responses (1xx), they are followed by the actual one
+        std::string header;
+        int         status = 0;
+        do
+        {
+            if (!readUntil("\r\n\r\n", header))
+                return false;
+
+            started  = true;
+            response = Response();
+            response.parse(header + "\r\n\r\n");
+            status = static_cast<int>(response.getStatus());
+        } while ((status >= 100) && (status < 200));
+
+        if (response.getStatus() == Response::Status::InvalidResponse)
+            return false;
+
+        // HTTP/1.1 connections are persistent unless told otherwise, HTTP/1.0 ones are not
+        const std::string connection = toLower(response.getField("connection"));
+        const bool isHttp11          = (response.getMajorHttpVersion() * 10 + response.getMinorHttpVersion()) >= 11;
+        keepAlive                    = isHttp11 ? (connection != "close") : (connection == "keep-alive");
+
+        // Store the body in the response, unless it is streamed
+        const BodyCallback store = [&response](const void* data, std::size_t size)
+        {
+            response.m_body.append(static_cast<const char*>(data), size);
+            return true;
+        };
+        const BodyCallback& sink = onBody ? onBody : store;
+
+        bool aborted  = false;
+        bool complete = true;
+        if ((method == Request::Method::Head) || (status == 204) || (status == 304))
+        {
+            // No body
+        }
+        else if (toLower(response.getField("transfer-encoding")) == "chunked")
+        {
+            complete = readChunkedBody(response, sink, aborted);
+        }
+        else if (const std::string& length = response.getField("content-length"); !length.empty())
+        {
+            std::size_t size = 0;
+            complete         = parseNumber(length, size, 10) && readBody(size, sink, aborted);
+        }
+        else
+        {
+            // The body ends when the server closes the connection
+            keepAlive = false;
+            complete  = readBodyUntilClose(sink);
+        }
+
+        // An aborted transfer leaves the rest of the body on the connection
+        if (aborted || !complete)
+            keepAlive = false;
+
+        if (!complete)
+            response.m_status = Response::Status::InvalidResponse;
+
+        return complete;
+    }
+
+    ////////////////////////////////////////////////////////////
+    TcpSocket                socket;     //!< Socket connected to the host
+    std::optional<TlsSocket> tlsSocket;  //!< Socket connected to the host, for HTTPS hosts
+    std::string              buffer;     //!< Bytes received from the host
+    std::size_t              position{}; //!< Number of bytes of the buffer that were consumed
+};
+
+
+////////////////////////////////////////////////////////////
+Http::Http() = default;
+
+
 ////////////////////////////////////////////////////////////
 Http::Http(const std::string& host, unsigned short port)
 {
@@ -296,6 +551,10 @@ Http::Http(const std::string& host, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+Http::~Http() = default;
+
+
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
 {
@@ -305,33 +564,218 @@ void Http::setHost(const std::string& host, unsigned short port)
         // HTTP protocol
         m_hostName = host.substr(7);
         m_port     = (port != 0 ? port : 80);
+        m_secure   = false;
     }
     else if (toLower(host.substr(0, 8)) == "https://")
     {
-        // HTTPS protocol -- unsupported (requires encryption and certificates and stuff...)
-        err() << "HTTPS protocol is not supported by sf::Http" << std::endl;
-        m_hostName.clear();
-        m_port = 0;
+        // HTTPS protocol -- the server is verified against the certificates trusted by the system by default
+        bool hasTlsContext = false;
+        {
+            const std::lock_guard lock(m_mutex);
+            if (!m_tlsContext)
+                m_tlsContext = TlsContext::createClient();
+
+            hasTlsContext = m_tlsContext.has_value();
+        }
+
+        if (hasTlsContext)
+        {
+            m_hostName = host.substr(8);
+            m_port     = (port != 0 ? port : 443);
+            m_secure   = true;
+        }
+        else
+        {
+            err() << "HTTPS protocol is not supported by sf::Http" << std::endl;
+            m_hostName.clear();
+            m_port   = 0;
+            m_secure = false;
+        }
     }
     else
     {
         // Undefined protocol - use HTTP
         m_hostName = host;
         m_port     = (port != 0 ? port : 80);
+        m_secure   = false;
     }
 
     // Remove any trailing '/' from the host name
     if (!m_hostName.empty() && (*m_hostName.rbegin() == '/'))
         m_hostName.erase(m_hostName.size() - 1);
 
-    m_host = IpAddress::resolve(m_hostName);
+    // Start resolving the name, so that it is ready by the time the first request is sent
+    if (!m_hostName.empty())
+        Resolver::getDefault().resolveAsync(m_hostName, nullptr);
+
+    // The connections to the previous host can't be used anymore
+    const std::lock_guard lock(m_mutex);
+    m_idleConnections.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setTlsContext(const TlsContext& context)
+{
+    // Requests sent concurrently copy the context under the same lock
+    const std::lock_guard lock(m_mutex);
+    m_tlsContext = context;
+
+    // The connections made with the previous context can't be used anymore
+    m_idleConnections.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
 {
-    // First make sure that the request is valid -- add missing mandatory fields
+    return sendRequest(request, nullptr, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, const BodyCallback& onBody, Time timeout)
+{
+    if (m_hostName.empty())
+        return {};
+
+    const Request     toSend     = completeRequest(request);
+    const std::string requestStr = toSend.prepare();
+
+    // A connection that was idle may have been closed by the server in the meantime,
+    // in which case a GET or HEAD request is sent again on a new connection
+    Response  response;
+    bool      reused   = true;
+    bool      started  = false;
+    const int attempts = canRetry(toSend.m_method) ? 2 : 1;
+    for (int attempt = 0; (attempt < attempts) && reused && !started; ++attempt)
+    {
+        std::unique_ptr<Connection> connection = acquireConnection(timeout, reused);
+        if (!connection)
+            return {};
+
+        bool keepAlive = false;
+        if ((connection->send(requestStr.data(), requestStr.size()) == Socket::Status::Done) &&
+            connection->receiveResponse(toSend.m_method, onBody, response, keepAlive, started))
+        {
+            if (keepAlive)
+                releaseConnection(std::move(connection));
+
+            return response;
+        }
+    }
+
+    return started ? response : Response();
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Http::Response> Http::sendRequests(const std::vector<Request>& requests, Time timeout)
+{
+    std::vector<Response> responses(requests.size());
+    if (m_hostName.empty())
+        return responses;
+
+    std::vector<Request>     toSend;
+    std::vector<std::string> requestStrs;
+    toSend.reserve(requests.size());
+    requestStrs.reserve(requests.size());
+    for (const Request& request : requests)
+    {
+        toSend.push_back(completeRequest(request));
+        requestStrs.push_back(toSend.back().prepare());
+    }
+
+    std::size_t next    = 0;
+    bool        retried = false;
+    while (next < requests.size())
+    {
+        bool                        reused     = false;
+        std::unique_ptr<Connection> connection = acquireConnection(timeout, reused);
+        if (!connection)
+            break;
+
+        // Read the responses in order, writing the next requests in batches while fewer than
+        // half of the pipeline is in flight, so that neither side waits for the other to read
+        std::size_t answered  = next;
+        std::size_t written   = next;
+        bool        keepAlive = true;
+        bool        failed    = false;
+        std::string batch;
+        while ((answered < requests.size()) && keepAlive)
+        {
+            if ((written < requests.size()) && (written - answered <= maxPipelinedRequests / 2))
+            {
+                batch.clear();
+                for (const std::size_t end = std::min(answered + maxPipelinedRequests, requests.size()); written < end;)
+                    batch += requestStrs[written++];
+
+                if (connection->send(batch.data(), batch.size()) != Socket::Status::Done)
+                {
+                    keepAlive = false;
+                    failed    = true;
+                    break;
+                }
+            }
+
+            bool      started  = false;
+            Response& response = responses[answered];
+            if (!connection->receiveResponse(toSend[answered].m_method, nullptr, response, keepAlive, started))
+            {
+                // A broken response is not requested again, the connection is unusable
+                answered += started ? 1 : 0;
+                keepAlive = false;
+                failed    = true;
+            }
+            else
+            {
+                ++answered;
+            }
+        }
+
+        if (keepAlive)
+            releaseConnection(std::move(connection));
+
+        // Requests written on a connection that failed may have been handled, only repeat them if it's safe
+        if (failed && !std::all_of(toSend.begin() + static_cast<std::ptrdiff_t>(answered),
+                                   toSend.begin() + static_cast<std::ptrdiff_t>(written),
+                                   [](const Request& request) { return canRetry(request.m_method); }))
+            break;
+
+        // Retry once on a new connection if a reused one didn't answer anything
+        if (answered == next)
+        {
+            if (!reused || retried)
+                break;
+
+            retried = true;
+        }
+        else
+        {
+            retried = false;
+        }
+
+        next = answered;
+    }
+
+    return responses;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setMaxIdleConnections(std::size_t count)
+{
+    const std::lock_guard lock(m_mutex);
+    m_maxIdleConnections = count;
+    if (m_idleConnections.size() > count)
+        m_idleConnections.resize(count);
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Request Http::completeRequest(const Request& request) const
+{
+    // Make sure that the request is valid -- add missing mandatory fields
     Request toSend(request);
     if (!toSend.hasField("From"))
     {
@@ -355,44 +799,59 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     {
         toSend.setField("Content-Type", "application/x-www-form-urlencoded");
     }
-    if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
+    if (!toSend.hasField("Connection"))
     {
-        toSend.setField("Connection", "close");
+        toSend.setField("Connection", m_maxIdleConnections > 0 ? "keep-alive" : "close");
     }
 
-    // Prepare the response
-    Response received;
+    return toSend;
+}
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host.value(), m_port, timeout) == Socket::Status::Done)
-    {
-        // Convert the request to string and send it through the connected socket
-        const std::string requestStr = toSend.prepare();
 
-        if (!requestStr.empty())
+////////////////////////////////////////////////////////////
+std::unique_ptr<Http::Connection> Http::acquireConnection(Time timeout, bool& reused)
+{
+    std::optional<TlsContext> tlsContext;
+    {
+        const std::lock_guard lock(m_mutex);
+        if (!m_idleConnections.empty())
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Status::Done)
-            {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char        buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Status::Done)
-                {
-                    receivedStr.append(buffer, buffer + size);
-                }
-
-                // Build the Response object from the received data
-                received.parse(receivedStr);
-            }
+            std::unique_ptr<Connection> connection = std::move(m_idleConnections.back());
+            m_idleConnections.pop_back();
+            reused = true;
+            return connection;
         }
 
-        // Close the connection
-        m_connection.disconnect();
+        // The context may be replaced by another thread while connecting, keep the current one alive
+        tlsContext = m_tlsContext;
+    }
+
+    reused = false;
+
+    const std::vector<IpAddress> remoteAddresses = Resolver::getDefault().resolve(m_hostName);
+    auto                         connection      = std::make_unique<Connection>();
+    if (m_secure)
+    {
+        // The name of the host identifies it in the TLS handshake
+        connection->tlsSocket.emplace(*tlsContext);
+        if (connection->tlsSocket->connect(remoteAddresses, m_port, m_hostName, timeout) != Socket::Status::Done)
+            return nullptr;
+    }
+    else if (connection->socket.connect(remoteAddresses, m_port, timeout) != Socket::Status::Done)
+    {
+        return nullptr;
     }
 
-    return received;
+    return connection;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::releaseConnection(std::unique_ptr<Connection> connection)
+{
+    const std::lock_guard lock(m_mutex);
+    if (m_idleConnections.size() < m_maxIdleConnections)
+        m_idleConnections.push_back(std::move(connection));
 }
 
 } // namespace sf
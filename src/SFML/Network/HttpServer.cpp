@@ -0,0 +1,804 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/HttpServer.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Utils.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+
+
+namespace
+{
+// Close the files sent as responses
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+// Bytes requested from a socket at once
+constexpr std::size_t receiveSize = 16 * 1024;
+
+// Largest request header accepted
+constexpr std::size_t maxHeaderSize = 64 * 1024;
+
+// Status codes that sf::Http::Response::Status doesn't name
+constexpr int lengthRequired       = 411;
+constexpr int contentTooLarge      = 413;
+constexpr int headerFieldsTooLarge = 431;
+
+
+////////////////////////////////////////////////////////////
+const char* getReasonPhrase(int status)
+{
+    // clang-format off
+    switch (status)
+    {
+        case 100: return "Continue";
+        case 200: return "OK";
+        case 201: return "Created";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 205: return "Reset Content";
+        case 206: return "Partial Content";
+        case 300: return "Multiple Choices";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 411: return "Length Required";
+        case 413: return "Content Too Large";
+        case 416: return "Range Not Satisfiable";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        case 505: return "HTTP Version Not Supported";
+        default:  return "Unknown";
+    }
+    // clang-format on
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<sf::Http::Request::Method> parseMethod(const std::string& method)
+{
+    // clang-format off
+    if (method == "GET")    return sf::Http::Request::Method::Get;
+    if (method == "POST")   return sf::Http::Request::Method::Post;
+    if (method == "HEAD")   return sf::Http::Request::Method::Head;
+    if (method == "PUT")    return sf::Http::Request::Method::Put;
+    if (method == "DELETE") return sf::Http::Request::Method::Delete;
+    // clang-format on
+
+    return std::nullopt;
+}
+
+
+////////////////////////////////////////////////////////////
+// Decode the %XX escape sequences of a path
+std::optional<std::string> decodePath(const std::string& path)
+{
+    std::string decoded;
+    decoded.reserve(path.size());
+    for (std::size_t i = 0; i < path.size(); ++i)
+    {
+        if (path[i] != '%')
+        {
+            decoded += path[i];
+            continue;
+        }
+
+        unsigned int value = 0;
+        const char*  begin = path.data() + i + 1;
+        if ((i + 2 >= path.size()) || (std::from_chars(begin, begin + 2, value, 16).ptr != begin + 2) || (value == 0))
+            return std::nullopt;
+
+        decoded += static_cast<char>(value);
+        i += 2;
+    }
+
+    return decoded;
+}
+
+
+////////////////////////////////////////////////////////////
+// Remove the spaces and tabs surrounding a string
+std::string trim(const std::string& str)
+{
+    const auto first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return {};
+
+    return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+const char* getContentType(const std::filesystem::path& file)
+{
+    const std::string extension = sf::toLower(file.extension().string());
+
+    // clang-format off
+    if ((extension == ".html") || (extension == ".htm")) return "text/html; charset=utf-8";
+    if (extension == ".css")                             return "text/css";
+    if (extension == ".js")                              return "text/javascript";
+    if (extension == ".json")                            return "application/json";
+    if (extension == ".txt")                             return "text/plain; charset=utf-8";
+    if (extension == ".csv")                             return "text/csv";
+    if (extension == ".xml")                             return "application/xml";
+    if (extension == ".png")                             return "image/png";
+    if ((extension == ".jpg") || (extension == ".jpeg")) return "image/jpeg";
+    if (extension == ".gif")                             return "image/gif";
+    if (extension == ".svg")                             return "image/svg+xml";
+    if (extension == ".wasm")                            return "application/wasm";
+    // clang-format on
+
+    return "application/octet-stream";
+}
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const std::string& HttpServer::Request::getField(const std::string& field) const
+{
+    if (const auto it = fields.find(toLower(field)); it != fields.end())
+        return it->second;
+
+    static const std::string empty;
+    return empty;
+}
+
+
+////////////////////////////////////////////////////////////
+struct HttpServer::HttpServerImpl
+{
+    static constexpr std::size_t noRoute = std::numeric_limits<std::size_t>::max();
+
+    struct Route
+    {
+        Http::Request::Method method;  //!< Method of the requests to handle
+        std::string           path;    //!< Path, or path prefix if it ends with '/'
+        Handler               handler; //!< Function filling the responses
+        BodyHandler           onBody;  //!< Function receiving the bodies, if they are not buffered
+    };
+
+    struct Output
+    {
+        std::string                            data;     //!< Bytes to send first
+        std::unique_ptr<std::FILE, FileCloser> file;     //!< File to send after the bytes, open until it is sent
+        std::uint64_t                          offset{}; //!< Position of the next byte to send in the file
+        std::size_t                            size{};   //!< Number of bytes of the file left to send
+    };
+
+    struct Connection
+    {
+        TcpSocket          socket;
+        std::string        input;              //!< Bytes received and not parsed yet
+        std::size_t        inputPosition{};    //!< Number of bytes of the input already parsed
+        Request            request;            //!< Request being received
+        std::size_t        route{noRoute};     //!< Route handling the request being received
+        bool               readingBody{};      //!< Is the body of the request being received?
+        std::size_t        bodyLeft{};         //!< Number of bytes of the body left to receive
+        bool               keepAlive{};        //!< Is the connection kept open after the response?
+        std::deque<Output> output;             //!< Responses waiting to be sent, in order
+        std::size_t        outputPosition{};   //!< Number of bytes of the first output already sent
+        bool               closing{};          //!< Close the connection once the output is sent
+        bool               closed{};           //!< Destroy the connection as soon as possible
+        Clock              lastActivity;       //!< Time since the last activity on the connection
+    };
+
+    ////////////////////////////////////////////////////////////
+    std::size_t findRoute(Http::Request::Method method, const std::string& uri) const
+    {
+        std::size_t best       = noRoute;
+        std::size_t bestLength = 0;
+        for (std::size_t i = 0; i < routes.size(); ++i)
+        {
+            const std::string& path = routes[i].path;
+            if ((routes[i].method != method) || (path.size() < bestLength))
+                continue;
+
+            if ((path == uri) || (!path.empty() && (path.back() == '/') && (uri.compare(0, path.size(), path) == 0)))
+            {
+                best       = i;
+                bestLength = path.size();
+            }
+        }
+
+        return best;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Answer a request that can't be handled, and close the connection
+    void reject(Connection& connection, int status)
+    {
+        Response response;
+        response.status      = static_cast<Http::Response::Status>(status);
+        connection.keepAlive = false;
+        queueResponse(connection, response, false);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parse a request header, return false if the request was rejected
+    bool startRequest(Connection& connection, const std::string& header)
+    {
+        std::istringstream in(header);
+        std::string        method;
+        std::string        target;
+        std::string        version;
+        in >> method >> target >> version;
+        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        Request& request = connection.request;
+        request          = Request();
+
+        if ((version.size() != 8) || (version.compare(0, 5, "HTTP/") != 0) || !std::isdigit(version[5]) ||
+            (version[6] != '.') || !std::isdigit(version[7]))
+        {
+            reject(connection, static_cast<int>(Http::Response::Status::BadRequest));
+            return false;
+        }
+
+        request.majorVersion = static_cast<unsigned int>(version[5] - '0');
+        request.minorVersion = static_cast<unsigned int>(version[7] - '0');
+        if (request.majorVersion != 1)
+        {
+            reject(connection, static_cast<int>(Http::Response::Status::VersionNotSupported));
+            return false;
+        }
+
+        const std::optional<Http::Request::Method> parsedMethod = parseMethod(method);
+        if (!parsedMethod)
+        {
+            reject(connection, static_cast<int>(Http::Response::Status::NotImplemented));
+            return false;
+        }
+
+        request.method = *parsedMethod;
+
+        const std::string::size_type     queryBegin = target.find('?');
+        const std::optional<std::string> uri        = decodePath(target.substr(0, queryBegin));
+        if (!uri || uri->empty() || ((*uri)[0] != '/'))
+        {
+            reject(connection, static_cast<int>(Http::Response::Status::BadRequest));
+            return false;
+        }
+
+        request.uri = *uri;
+        if (queryBegin != std::string::npos)
+            request.query = target.substr(queryBegin + 1);
+
+        // Parse the fields
+        std::string line;
+        while (std::getline(in, line))
+        {
+            const std::string::size_type colon = line.find(':');
+            if ((colon == std::string::npos) || (colon == 0))
+            {
+                reject(connection, static_cast<int>(Http::Response::Status::BadRequest));
+                return false;
+            }
+
+            request.fields[toLower(line.substr(0, colon))] = trim(line.substr(colon + 1));
+        }
+
+        // HTTP/1.1 connections are persistent unless told otherwise, HTTP/1.0 ones are not
+        const std::string connectionField = toLower(request.getField("connection"));
+        const bool        isHttp11        = request.minorVersion >= 1;
+        connection.keepAlive = isHttp11 ? (connectionField != "close") : (connectionField == "keep-alive");
+
+        // Chunked request bodies are not supported
+        if (!request.getField("transfer-encoding").empty())
+        {
+            reject(connection, static_cast<int>(Http::Response::Status::NotImplemented));
+            return false;
+        }
+
+        std::size_t        length      = 0;
+        const std::string& lengthField = request.getField("content-length");
+        const char* const  lengthEnd   = lengthField.data() + lengthField.size();
+        if (!lengthField.empty() && (std::from_chars(lengthField.data(), lengthEnd, length).ptr != lengthEnd))
+        {
+            reject(connection, lengthRequired);
+            return false;
+        }
+
+        // HEAD requests fall back to the GET route
+        connection.route = findRoute(request.method, request.uri);
+        if ((connection.route == noRoute) && (request.method == Http::Request::Method::Head))
+            connection.route = findRoute(Http::Request::Method::Get, request.uri);
+
+        const bool bufferBody = (connection.route != noRoute) && !routes[connection.route].onBody;
+        if (bufferBody && (length > maxBodySize))
+        {
+            reject(connection, contentTooLarge);
+            return false;
+        }
+
+        if (toLower(request.getField("expect")) == "100-continue")
+            connection.output.push_back({"HTTP/1.1 100 Continue\r\n\r\n", {}, 0, 0});
+
+        if (bufferBody)
+            request.body.reserve(length);
+
+        connection.readingBody = true;
+        connection.bodyLeft    = length;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Queue a response, and try to send it right away
+    void queueResponse(Connection& connection, Response& response, bool isHead)
+    {
+        Output output;
+        if (!response.file.empty())
+        {
+            // The file is opened once here, and stays open across all the partial sends
+            std::error_code      error;
+            const std::uintmax_t fileSize = std::filesystem::file_size(response.file, error);
+            if (!error)
+            {
+#ifdef SFML_SYSTEM_WINDOWS
+                output.file.reset(_wfopen(response.file.c_str(), L"rb"));
+#else
+                output.file.reset(std::fopen(response.file.c_str(), "rb"));
+#endif
+            }
+
+            if (!output.file)
+            {
+                response        = Response();
+                response.status = Http::Response::Status::NotFound;
+            }
+            else
+            {
+                output.size = static_cast<std::size_t>(fileSize);
+            }
+        }
+
+        const int  status  = static_cast<int>(response.status);
+        const bool hasBody = (status >= 200) && (status != 204) && (status != 304);
+
+        std::ostringstream out;
+        out << "HTTP/1.1 " << status << " " << getReasonPhrase(status) << "\r\n";
+        for (const auto& [field, value] : response.fields)
+        {
+            const std::string name = toLower(field);
+            if ((name != "content-length") && (name != "connection"))
+                out << field << ": " << value << "\r\n";
+        }
+
+        if (hasBody)
+            out << "Content-Length: " << (output.file ? output.size : response.body.size()) << "\r\n";
+
+        out << "Connection: " << (connection.keepAlive ? "keep-alive" : "close") << "\r\n\r\n";
+
+        output.data = out.str();
+        if (!hasBody || isHead)
+        {
+            output.file.reset();
+            output.size = 0;
+        }
+        else if (!output.file)
+        {
+            output.data += response.body;
+        }
+
+        connection.output.push_back(std::move(output));
+        if (!connection.keepAlive)
+            connection.closing = true;
+
+        flush(connection);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Send as much of the pending output as possible without blocking
+    void flush(Connection& connection)
+    {
+        while (!connection.output.empty())
+        {
+            Output&     output = connection.output.front();
+            std::size_t sent   = 0;
+
+            Socket::Status status = Socket::Status::Done;
+            if (connection.outputPosition < output.data.size())
+            {
+                const std::size_t size = output.data.size() - connection.outputPosition;
+                status = connection.socket.send(output.data.data() + connection.outputPosition, size, sent);
+                connection.outputPosition += sent;
+            }
+            else if (output.size > 0)
+            {
+                status = connection.socket.sendFile(*output.file, output.offset, output.size, sent);
+                output.offset += sent;
+                output.size -= sent;
+            }
+            else
+            {
+                connection.output.pop_front();
+                connection.outputPosition = 0;
+                continue;
+            }
+
+            if ((status == Socket::Status::NotReady) || (status == Socket::Status::Partial))
+                return;
+
+            if (status != Socket::Status::Done)
+            {
+                connection.closed = true;
+                return;
+            }
+        }
+
+        if (connection.closing)
+            connection.closed = true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Handle the requests received on a connection, return the number of requests handled
+    std::size_t processInput(Connection& connection)
+    {
+        // Pipelined requests are answered one at a time, so that a client that
+        // doesn't read its responses can't make the server buffer all of them
+        std::size_t handled = 0;
+        while (!connection.closing && !connection.closed && connection.output.empty())
+        {
+            std::string& input = connection.input;
+            if (!connection.readingBody)
+            {
+                const std::string::size_type end = input.find("\r\n\r\n", connection.inputPosition);
+                if (end == std::string::npos)
+                {
+                    if (input.size() - connection.inputPosition > maxHeaderSize)
+                        reject(connection, headerFieldsTooLarge);
+                    break;
+                }
+
+                const std::string header = input.substr(connection.inputPosition, end + 2 - connection.inputPosition);
+                connection.inputPosition = end + 4;
+                if (!startRequest(connection, header))
+                    continue;
+
+                // Send the interim response, if any, before reading the body
+                flush(connection);
+                if (!connection.output.empty())
+                    break;
+            }
+
+            // Pass the part of the body that was received to the route
+            const std::size_t count = std::min(connection.bodyLeft, input.size() - connection.inputPosition);
+            if (count > 0 && connection.route != noRoute)
+            {
+                const Route& route = routes[connection.route];
+                const char*  data  = input.data() + connection.inputPosition;
+                if (!route.onBody)
+                {
+                    connection.request.body.append(data, count);
+                }
+                else if (!route.onBody(connection.request, data, count))
+                {
+                    reject(connection, static_cast<int>(Http::Response::Status::BadRequest));
+                    break;
+                }
+            }
+
+            connection.inputPosition += count;
+            connection.bodyLeft -= count;
+            if (connection.bodyLeft > 0)
+                break;
+
+            // The request is complete
+            Response response;
+            if (connection.route == noRoute)
+                response.status = Http::Response::Status::NotFound;
+            else
+                routes[connection.route].handler(connection.request, response);
+
+            connection.readingBody = false;
+            queueResponse(connection, response, connection.request.method == Http::Request::Method::Head);
+            connection.request = Request();
+            ++handled;
+        }
+
+        // Drop the input that was parsed
+        if (connection.inputPosition == connection.input.size())
+        {
+            connection.input.clear();
+            connection.inputPosition = 0;
+        }
+        else if (connection.inputPosition >= receiveSize)
+        {
+            connection.input.erase(0, connection.inputPosition);
+            connection.inputPosition = 0;
+        }
+
+        return handled;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t receive(Connection& connection)
+    {
+        std::string&      input    = connection.input;
+        const std::size_t size     = input.size();
+        std::size_t       received = 0;
+        input.resize(size + receiveSize);
+        const Socket::Status status = connection.socket.receive(input.data() + size, receiveSize, received);
+        input.resize(size + received);
+
+        if (status == Socket::Status::NotReady)
+            return 0;
+
+        if (status != Socket::Status::Done)
+        {
+            connection.closed = true;
+            return 0;
+        }
+
+        return processInput(connection);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void acceptConnections()
+    {
+        for (;;)
+        {
+            auto connection = std::make_unique<Connection>();
+            if (listener.accept(connection->socket) != Socket::Status::Done)
+                return;
+
+            connection->socket.setBlocking(false);
+            selector.add(connection->socket, SocketSelector::Interest::Receive);
+            Socket* const socket = &connection->socket;
+            connections.emplace(socket, std::move(connection));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    TcpListener                                              listener;
+    bool                                                     listening{};
+    SocketSelector                                           selector;
+    std::vector<Route>                                       routes;
+    std::unordered_map<Socket*, std::unique_ptr<Connection>> connections;
+    std::size_t                                              maxBodySize{1024 * 1024};
+    Time                                                     idleTimeout{seconds(30)};
+    Clock                                                    idleCheckClock;
+};
+
+
+////////////////////////////////////////////////////////////
+HttpServer::HttpServer() : m_impl(std::make_unique<HttpServerImpl>())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+HttpServer::~HttpServer() = default;
+
+
+////////////////////////////////////////////////////////////
+Socket::Status HttpServer::listen(unsigned short port, const IpAddress& address)
+{
+    close();
+
+    const Socket::Status status = m_impl->listener.listen(port, address);
+    if (status != Socket::Status::Done)
+        return status;
+
+    m_impl->listener.setBlocking(false);
+    m_impl->selector.add(m_impl->listener, SocketSelector::Interest::Receive);
+    m_impl->listening = true;
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short HttpServer::getLocalPort() const
+{
+    return m_impl->listener.getLocalPort();
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpServer::close()
+{
+    m_impl->selector.clear();
+    m_impl->connections.clear();
+    m_impl->listener.close();
+    m_impl->listening = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpServer::addRoute(Http::Request::Method method, const std::string& path, Handler handler, BodyHandler onBody)
+{
+    if (!handler)
+    {
+        err() << "Cannot add a route without handler to the HTTP server" << std::endl;
+        return;
+    }
+
+    m_impl->routes.push_back({method, path, std::move(handler), std::move(onBody)});
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpServer::addStaticFiles(const std::string& path, const std::filesystem::path& directory)
+{
+    std::string prefix = path;
+    if (prefix.empty() || (prefix.back() != '/'))
+        prefix += '/';
+
+    addRoute(Http::Request::Method::Get,
+             prefix,
+             [prefix, directory](const Request& request, Response& response)
+             {
+                 // Reject the paths that would escape the directory
+                 const std::filesystem::path relative = std::filesystem::path(request.uri.substr(prefix.size()))
+                                                            .lexically_normal();
+                 if (relative.has_root_path() || (!relative.empty() && (*relative.begin() == "..")))
+                 {
+                     response.status = Http::Response::Status::NotFound;
+                     return;
+                 }
+
+                 std::filesystem::path file = directory / relative;
+                 std::error_code       error;
+                 if (std::filesystem::is_directory(file, error))
+                     file /= "index.html";
+
+                 if (!std::filesystem::is_regular_file(file, error))
+                 {
+                     response.status = Http::Response::Status::NotFound;
+                     return;
+                 }
+
+                 response.fields["Content-Type"] = getContentType(file);
+                 response.file                   = file;
+             });
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpServer::setMaxBodySize(std::size_t size)
+{
+    m_impl->maxBodySize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpServer::setIdleTimeout(Time timeout)
+{
+    m_impl->idleTimeout = timeout;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t HttpServer::getConnectionCount() const
+{
+    return m_impl->connections.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t HttpServer::update(Time timeout)
+{
+    HttpServerImpl& impl = *m_impl;
+    if (!impl.listening)
+        return 0;
+
+    std::size_t          handled = 0;
+    std::vector<Socket*> closed;
+    if (impl.selector.wait(timeout))
+    {
+        for (const SocketSelector::ReadySocket& ready : impl.selector.getReadySockets())
+        {
+            if (ready.socket == &impl.listener)
+            {
+                impl.acceptConnections();
+                continue;
+            }
+
+            const auto it = impl.connections.find(ready.socket);
+            if (it == impl.connections.end())
+                continue;
+
+            HttpServerImpl::Connection& connection = *it->second;
+            connection.lastActivity.restart();
+
+            // Resume the requests that were waiting for the previous responses to be sent
+            if (ready.send && !connection.output.empty())
+            {
+                impl.flush(connection);
+                if (connection.output.empty())
+                    handled += impl.processInput(connection);
+            }
+
+            if (ready.receive && connection.output.empty() && !connection.closed)
+                handled += impl.receive(connection);
+
+            // Stop reading from clients that don't read their responses
+            if (connection.closed)
+                closed.push_back(&connection.socket);
+            else if (connection.output.empty())
+                impl.selector.add(connection.socket, SocketSelector::Interest::Receive);
+            else
+                impl.selector.add(connection.socket, SocketSelector::Interest::Send);
+        }
+    }
+
+    // Look for inactive connections at most once per second
+    if ((impl.idleTimeout != Time::Zero) && (impl.idleCheckClock.getElapsedTime() >= seconds(1)))
+    {
+        impl.idleCheckClock.restart();
+        for (const auto& [socket, connection] : impl.connections)
+        {
+            if (!connection->closed && (connection->lastActivity.getElapsedTime() >= impl.idleTimeout))
+                closed.push_back(socket);
+        }
+    }
+
+    // Sockets are destroyed once all the ready sockets were handled, so that their address can't be reused meanwhile
+    for (Socket* socket : closed)
+    {
+        impl.selector.remove(*socket);
+        impl.connections.erase(socket);
+    }
+
+    return handled;
+}
+
+} // namespace sf
@@ -31,6 +31,7 @@
 
 #include <SFML/System/Err.hpp>
 
+#include <algorithm>
 #include <istream>
 #include <ostream>
 
@@ -43,6 +44,8 @@ namespace sf
 const IpAddress IpAddress::Any(0, 0, 0, 0);
 const IpAddress IpAddress::LocalHost(127, 0, 0, 1);
 const IpAddress IpAddress::Broadcast(255, 255, 255, 255);
+const IpAddress IpAddress::AnyV6(std::array<std::uint8_t, 16>{});
+const IpAddress IpAddress::LocalHostV6(std::array<std::uint8_t, 16>{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1});
 
 
 ////////////////////////////////////////////////////////////
@@ -70,24 +73,68 @@ std::optional<IpAddress> IpAddress::resolve(std::string_view address)
     if (const std::uint32_t ip = inet_addr(address.data()); ip != INADDR_NONE)
         return IpAddress(ntohl(ip));
 
-    // Not a valid address, try to convert it as a host name
+    // Not a valid address, try to convert it as a host name, preferring IPv4 when the host has both
+    const std::vector<IpAddress> addresses = resolveAll(address);
+    if (addresses.empty())
+    {
+        // Not generating en error message here as resolution failure is a valid outcome.
+        return std::nullopt;
+    }
+
+    const auto isIpV4 = [](const IpAddress& ip) { return ip.getType() == Type::IpV4; };
+    if (const auto it = std::find_if(addresses.begin(), addresses.end(), isIpV4); it != addresses.end())
+        return *it;
+
+    return addresses.front();
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<IpAddress> IpAddress::resolveAll(std::string_view address)
+{
+    std::vector<IpAddress> addresses;
+
+    if (address.empty())
+        return addresses;
+
+    // IPv6 addresses may be enclosed in brackets, as in URLs
+    std::string name(address);
+    if ((name.size() > 2) && (name.front() == '[') && (name.back() == ']'))
+        name = name.substr(1, name.size() - 2);
+
+    // Numeric addresses of both versions are converted without any lookup
     addrinfo hints{}; // Zero-initialize
-    hints.ai_family = AF_INET;
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = AI_NUMERICHOST;
 
     addrinfo* result = nullptr;
-    if (getaddrinfo(address.data(), nullptr, &hints, &result) == 0 && result != nullptr)
+    if (getaddrinfo(name.c_str(), nullptr, &hints, &result) != 0)
     {
-        sockaddr_in sin{};
-        std::memcpy(&sin, result->ai_addr, sizeof(*result->ai_addr));
+        // Names only resolve to the families that the computer has an address for
+        hints.ai_flags = AI_ADDRCONFIG;
+        if (getaddrinfo(name.c_str(), nullptr, &hints, &result) != 0)
+            return addresses;
+    }
 
-        const std::uint32_t ip = sin.sin_addr.s_addr;
-        freeaddrinfo(result);
+    for (const addrinfo* info = result; info != nullptr; info = info->ai_next)
+    {
+        if (((info->ai_family != AF_INET) && (info->ai_family != AF_INET6)) ||
+            (static_cast<std::size_t>(info->ai_addrlen) > sizeof(sockaddr_storage)))
+            continue;
 
-        return IpAddress(ntohl(ip));
+        sockaddr_storage storage{};
+        std::memcpy(&storage, info->ai_addr, static_cast<std::size_t>(info->ai_addrlen));
+
+        // Some systems list an address several times
+        const IpAddress ip = priv::SocketImpl::getAddress(storage);
+        if (std::find(addresses.begin(), addresses.end(), ip) == addresses.end())
+            addresses.push_back(ip);
     }
 
-    // Not generating en error message here as resolution failure is a valid outcome.
-    return std::nullopt;
+    freeaddrinfo(result);
+
+    return addresses;
 }
 
 
@@ -104,20 +151,76 @@ IpAddress::IpAddress(std::uint32_t address) : m_address(htonl(address))
 }
 
 
+////////////////////////////////////////////////////////////
+IpAddress::IpAddress(const std::array<std::uint8_t, 16>& bytes)
+{
+    // IPv4-mapped addresses are made of 80 zero bits, 16 one bits and the IPv4 address
+    constexpr std::array<std::uint8_t, 12> mappedPrefix{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+
+    if (std::equal(mappedPrefix.begin(), mappedPrefix.end(), bytes.begin()))
+    {
+        std::memcpy(&m_address, &bytes[mappedPrefix.size()], sizeof(m_address));
+    }
+    else
+    {
+        m_addressV6 = bytes;
+        m_type      = Type::IpV6;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::Type IpAddress::getType() const
+{
+    return m_type;
+}
+
+
 ////////////////////////////////////////////////////////////
 std::string IpAddress::toString() const
 {
-    in_addr address{};
-    address.s_addr = m_address;
+    if (m_type == Type::IpV4)
+    {
+        in_addr address{};
+        address.s_addr = m_address;
+
+        return inet_ntoa(address);
+    }
 
-    return inet_ntoa(address);
+    // getnameinfo is available on more systems than inet_ntop
+    sockaddr_storage                   address{};
+    const priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(*this, 0, address);
+
+    std::array<char, NI_MAXHOST> buffer{};
+    if (getnameinfo(reinterpret_cast<sockaddr*>(&address),
+                    length,
+                    buffer.data(),
+                    sizeof(buffer),
+                    nullptr,
+                    0,
+                    NI_NUMERICHOST) != 0)
+        return "";
+
+    return buffer.data();
 }
 
 
 ////////////////////////////////////////////////////////////
 std::uint32_t IpAddress::toInteger() const
 {
-    return ntohl(m_address);
+    return (m_type == Type::IpV4) ? ntohl(m_address) : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::array<std::uint8_t, 16> IpAddress::toBytes() const
+{
+    if (m_type == Type::IpV6)
+        return m_addressV6;
+
+    std::array<std::uint8_t, 16> bytes{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    std::memcpy(&bytes[12], &m_address, sizeof(m_address));
+    return bytes;
 }
 
 
@@ -137,8 +240,9 @@ std::optional<IpAddress> IpAddress::getLocalAddress()
     }
 
     // Connect the socket to localhost on any port
-    sockaddr_in address = priv::SocketImpl::createAddress(ntohl(INADDR_LOOPBACK), 9);
-    if (connect(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage                   address{};
+    const priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(LocalHost, 9, address);
+    if (connect(sock, reinterpret_cast<sockaddr*>(&address), length) == -1)
     {
         priv::SocketImpl::close(sock);
 
@@ -160,7 +264,7 @@ std::optional<IpAddress> IpAddress::getLocalAddress()
     priv::SocketImpl::close(sock);
 
     // Finally build the IP address
-    return IpAddress(ntohl(address.sin_addr.s_addr));
+    return priv::SocketImpl::getAddress(address);
 }
 
 
@@ -206,7 +310,13 @@ bool operator!=(const IpAddress& left, const IpAddress& right)
 ////////////////////////////////////////////////////////////
 bool operator<(const IpAddress& left, const IpAddress& right)
 {
-    return left.m_address < right.m_address;
+    if (left.m_type != right.m_type)
+        return left.m_type < right.m_type;
+
+    if (left.m_type == IpAddress::Type::IpV4)
+        return left.m_address < right.m_address;
+
+    return left.m_addressV6 < right.m_addressV6;
 }
 
 
@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Lz4.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace
+{
+// Parameters of the LZ4 block format
+constexpr std::size_t minMatch       = 4;     // Shortest match that can be encoded
+constexpr std::size_t lastLiterals   = 5;     // Number of bytes at the end of a block that must be literals
+constexpr std::size_t matchFindLimit = 12;    // Matches must start at least this far from the end of a block
+constexpr std::size_t maxOffset      = 65535; // Farthest distance a match can refer to
+
+// Parameters of the compressor
+constexpr unsigned int hashLog   = 12; // Number of bits of the hash table index
+constexpr unsigned int skipShift = 6;  // Data without matches is skipped faster after every 2^skipShift misses
+
+// Parameters of the decompressor
+constexpr std::size_t wildCopySize = 16; // Literals up to this length are copied with a fixed size
+
+std::uint32_t read32(const std::byte* data)
+{
+    std::uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::uint64_t read64(const std::byte* data)
+{
+    std::uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Hash 5 of the 8 bytes read at a position (the first ones on little-endian targets), which finds
+// better matches than hashing only the 4 bytes that a match needs
+std::size_t hash(std::uint64_t sequence)
+{
+    return static_cast<std::size_t>(((sequence << 24) * 889523592379ull) >> (64 - hashLog));
+}
+
+// Write the bytes that extend a length that doesn't fit in its token nibble
+std::byte* writeLength(std::byte* output, std::size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *output++ = std::byte{255};
+
+    *output++ = static_cast<std::byte>(length);
+    return output;
+}
+
+// Write a sequence: literals followed by an optional match
+std::byte* writeSequence(std::byte*       output,
+                         const std::byte* literals,
+                         std::size_t      literalCount,
+                         std::size_t      offset,
+                         std::size_t      matchLength)
+{
+    std::byte* const token = output++;
+
+    if (literalCount >= 15)
+        output = writeLength(output, literalCount - 15);
+
+    if (literalCount > 0)
+        std::memcpy(output, literals, literalCount);
+
+    output += literalCount;
+
+    std::size_t matchCode = 0;
+    if (matchLength > 0)
+    {
+        *output++ = static_cast<std::byte>(offset & 0xFF);
+        *output++ = static_cast<std::byte>(offset >> 8);
+
+        matchCode = matchLength - minMatch;
+        if (matchCode >= 15)
+            output = writeLength(output, matchCode - 15);
+    }
+
+    *token = static_cast<std::byte>((std::min<std::size_t>(literalCount, 15) << 4) |
+                                    std::min<std::size_t>(matchCode, 15));
+    return output;
+}
+
+// Get the largest size of a sequence
+std::size_t sequenceBound(std::size_t literalCount, std::size_t matchLength)
+{
+    return 1 + literalCount / 255 + 1 + literalCount + 2 + matchLength / 255 + 1;
+}
+} // namespace
+
+
+namespace sf::priv::Lz4
+{
+////////////////////////////////////////////////////////////
+std::size_t compressBound(std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t compress(const std::byte* data,
+                     std::size_t      prefixSize,
+                     std::size_t      size,
+                     std::byte*       output,
+                     std::size_t      capacity)
+{
+    std::byte* const  outputEnd = output + capacity;
+    std::byte*        current   = output;
+    const std::size_t end       = prefixSize + size;
+    std::size_t       anchor    = prefixSize;
+
+    // Blocks too short to contain a match are made of literals only
+    if (size > matchFindLimit)
+    {
+        // Positions of the last occurrences of 4-byte sequences
+        std::array<std::uint32_t, std::size_t{1} << hashLog> table{};
+
+        // Index the end of the dictionary, within reach of the first matches
+        for (std::size_t pos = prefixSize > maxOffset ? prefixSize - maxOffset : 0; pos < prefixSize; ++pos)
+            table[hash(read64(data + pos))] = static_cast<std::uint32_t>(pos);
+
+        const std::size_t matchLimit  = end - lastLiterals;
+        const std::size_t searchLimit = end - matchFindLimit;
+
+        std::size_t pos    = prefixSize;
+        std::size_t misses = 0;
+        while (pos <= searchLimit)
+        {
+            const std::uint32_t sequence  = read32(data + pos);
+            std::uint32_t&      entry     = table[hash(read64(data + pos))];
+            std::size_t         candidate = entry;
+            entry                         = static_cast<std::uint32_t>(pos);
+
+            if ((candidate >= pos) || (pos - candidate > maxOffset) || (read32(data + candidate) != sequence))
+            {
+                // Move faster through data that doesn't compress
+                pos += 1 + (misses++ >> skipShift);
+                continue;
+            }
+
+            // Extend the match backwards over the pending literals, then forwards
+            while ((pos > anchor) && (candidate > 0) && (data[pos - 1] == data[candidate - 1]))
+            {
+                --pos;
+                --candidate;
+            }
+
+            std::size_t length = minMatch;
+            while ((pos + length + 8 <= matchLimit) &&
+                   (read64(data + pos + length) == read64(data + candidate + length)))
+                length += 8;
+            while ((pos + length < matchLimit) && (data[pos + length] == data[candidate + length]))
+                ++length;
+
+            const std::size_t literalCount = pos - anchor;
+            if (sequenceBound(literalCount, length) > static_cast<std::size_t>(outputEnd - current))
+                return 0;
+
+            current = writeSequence(current, data + anchor, literalCount, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+            misses = 0;
+
+            // Index a position inside the match, which often starts the next one
+            if (pos + 6 <= end)
+                table[hash(read64(data + pos - 2))] = static_cast<std::uint32_t>(pos - 2);
+        }
+    }
+
+    // The block ends with the remaining literals
+    const std::size_t literalCount = end - anchor;
+    if (sequenceBound(literalCount, 0) > static_cast<std::size_t>(outputEnd - current))
+        return 0;
+
+    current = writeSequence(current, data + anchor, literalCount, 0, 0);
+
+    return static_cast<std::size_t>(current - output);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decompress(const std::byte* input,
+                std::size_t      inputSize,
+                std::byte*       output,
+                std::size_t      prefixSize,
+                std::size_t      size)
+{
+    const std::byte* const inputEnd  = input + inputSize;
+    std::byte*             current   = output + prefixSize;
+    std::byte* const       outputEnd = current + size;
+
+    // Read the bytes that extend a length that doesn't fit in its token nibble
+    const auto readLength = [&input, inputEnd](std::size_t& length)
+    {
+        std::uint8_t byte = 255;
+        while (byte == 255)
+        {
+            if (input == inputEnd)
+                return false;
+
+            byte = static_cast<std::uint8_t>(*input++);
+            length += byte;
+        }
+
+        return true;
+    };
+
+    while (input < inputEnd)
+    {
+        const auto token = static_cast<std::uint8_t>(*input++);
+
+        // Copy the literals
+        std::size_t literalCount = token >> 4;
+        if ((literalCount == 15) && !readLength(literalCount))
+            return false;
+
+        const auto inputLeft  = static_cast<std::size_t>(inputEnd - input);
+        const auto outputLeft = static_cast<std::size_t>(outputEnd - current);
+        if ((literalCount > inputLeft) || (literalCount > outputLeft))
+            return false;
+
+        // Short runs are copied with a fixed size when there's room, which is much faster
+        if ((literalCount <= wildCopySize) && (inputLeft >= wildCopySize) && (outputLeft >= wildCopySize))
+            std::memcpy(current, input, wildCopySize);
+        else if (literalCount > 0)
+            std::memcpy(current, input, literalCount);
+
+        input += literalCount;
+        current += literalCount;
+
+        // The last sequence has no match
+        if (input == inputEnd)
+            break;
+
+        // Copy the match
+        if (inputEnd - input < 2)
+            return false;
+
+        const std::size_t offset = static_cast<std::size_t>(input[0]) | (static_cast<std::size_t>(input[1]) << 8);
+        input += 2;
+
+        std::size_t length = token & 15u;
+        if ((length == 15) && !readLength(length))
+            return false;
+
+        length += minMatch;
+
+        if ((offset == 0) || (offset > static_cast<std::size_t>(current - output)) ||
+            (length > static_cast<std::size_t>(outputEnd - current)))
+            return false;
+
+        // A match can overlap the data it produces, which repeats with a period of its offset
+        const std::byte* const match = current - offset;
+        if ((offset >= 8) && (static_cast<std::size_t>(outputEnd - current) >= length + wildCopySize))
+        {
+            // Copy 8 bytes at a time, possibly a few more than needed, that the next sequences overwrite;
+            // most matches are short enough for the first two copies
+            std::memcpy(current, match, 8);
+            std::memcpy(current + 8, match + 8, 8);
+            for (std::size_t copied = 16; copied < length; copied += 8)
+                std::memcpy(current + copied, match + copied, 8);
+        }
+        else
+        {
+            // Copy chunks that double in size, each one taken from the start of the match
+            std::size_t copied = 0;
+            while (copied < length)
+            {
+                const std::size_t count = std::min(offset + copied, length - copied);
+                std::memcpy(current + copied, match, count);
+                copied += count;
+            }
+        }
+
+        current += length;
+    }
+
+    return current == outputEnd;
+}
+
+} // namespace sf::priv::Lz4
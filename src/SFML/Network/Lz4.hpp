@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
+
+namespace sf::priv::Lz4
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the largest possible size of compressed data
+///
+/// \param size Size of the data to compress
+///
+/// \return Size of the compressed data in the worst case
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] std::size_t compressBound(std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Compress data to the LZ4 block format
+///
+/// The `prefixSize` bytes before the data to compress act
+/// as a dictionary: they are not part of the output, but
+/// the compressed data can refer to them, which makes small
+/// inputs similar to the dictionary compress much better.
+///
+/// \param data       Dictionary, followed by the data to compress
+/// \param prefixSize Size of the dictionary
+/// \param size       Size of the data to compress
+/// \param output     Buffer receiving the compressed data
+/// \param capacity   Size of the output buffer
+///
+/// \return Size of the compressed data, or 0 if it doesn't fit in the output buffer
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] std::size_t compress(const std::byte* data,
+                                   std::size_t      prefixSize,
+                                   std::size_t      size,
+                                   std::byte*       output,
+                                   std::size_t      capacity);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress data in the LZ4 block format
+///
+/// The input is fully validated, so that corrupted or
+/// malicious data never reads or writes out of bounds.
+///
+/// \param input      Compressed data
+/// \param inputSize  Size of the compressed data
+/// \param output     Buffer starting with the dictionary used for compression, followed by room for the data
+/// \param prefixSize Size of the dictionary
+/// \param size       Size of the data once decompressed
+///
+/// \return True if the input decompressed to exactly \a size bytes
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] bool decompress(const std::byte* input,
+                              std::size_t      inputSize,
+                              std::byte*       output,
+                              std::size_t      prefixSize,
+                              std::size_t      size);
+
+} // namespace sf::priv::Lz4
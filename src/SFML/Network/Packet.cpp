@@ -32,10 +32,131 @@
 #include <SFML/System/Utils.hpp>
 
 #include <array>
+#include <string>
+#include <utility>
 
+#include <cstdint>
 #include <cstring>
 #include <cwchar>
 
+// SSE2 is part of the baseline of every x86-64 target, so it can be used without runtime detection
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SFML_PACKET_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+constexpr bool isBigEndian = true;
+#else
+constexpr bool isBigEndian = false;
+#endif
+
+////////////////////////////////////////////////////////////
+constexpr std::uint16_t byteSwap(std::uint16_t value)
+{
+    return static_cast<std::uint16_t>((value >> 8) | (value << 8));
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr std::uint32_t byteSwap(std::uint32_t value)
+{
+    return ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8) | ((value & 0x00FF0000u) >> 8) |
+           ((value & 0xFF000000u) >> 24);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr std::uint64_t byteSwap(std::uint64_t value)
+{
+    return (std::uint64_t{byteSwap(static_cast<std::uint32_t>(value))} << 32) |
+           byteSwap(static_cast<std::uint32_t>(value >> 32));
+}
+
+
+////////////////////////////////////////////////////////////
+// Convert between host and network (big endian) byte order; the conversion is its own inverse
+template <typename T>
+constexpr T toNetworkOrder(T value)
+{
+    if constexpr (isBigEndian)
+        return value;
+    else
+        return byteSwap(value);
+}
+
+
+#ifdef SFML_PACKET_SSE2
+////////////////////////////////////////////////////////////
+// Reverse the bytes of every 16, 32 or 64-bit lane of a vector
+template <typename Unsigned>
+__m128i byteSwap(__m128i value)
+{
+    // First reverse the order of the 16-bit words in each lane, then the bytes of each word
+    if constexpr (sizeof(Unsigned) == 4)
+        value = _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+    else if constexpr (sizeof(Unsigned) == 8)
+        value = _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+
+    return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+}
+#endif
+
+
+////////////////////////////////////////////////////////////
+// Copy values, converting them between host and network byte order
+template <typename Unsigned>
+void copyNetworkOrder(void* destination, const void* source, std::size_t count)
+{
+    auto*       out = static_cast<std::byte*>(destination);
+    const auto* in  = static_cast<const std::byte*>(source);
+    std::size_t i   = 0;
+
+#ifdef SFML_PACKET_SSE2
+    constexpr std::size_t valuesPerVector = sizeof(__m128i) / sizeof(Unsigned);
+    for (; i + valuesPerVector <= count; i += valuesPerVector)
+    {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * sizeof(Unsigned)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * sizeof(Unsigned)), byteSwap<Unsigned>(values));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        Unsigned value{};
+        std::memcpy(&value, in + i * sizeof(value), sizeof(value));
+        value = toNetworkOrder(value);
+        std::memcpy(out + i * sizeof(value), &value, sizeof(value));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Write characters as 32-bit values in network byte order
+template <typename Iterator>
+void storeCharacters(std::byte* destination, Iterator begin, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, ++begin)
+    {
+        const std::uint32_t character = toNetworkOrder(static_cast<std::uint32_t>(*begin));
+        std::memcpy(destination + i * sizeof(character), &character, sizeof(character));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Read a character written by storeCharacters
+std::uint32_t loadCharacter(const std::byte* source)
+{
+    std::uint32_t character = 0;
+    std::memcpy(&character, source, sizeof(character));
+    return toNetworkOrder(character);
+}
+} // namespace
+
 
 namespace sf
 {
@@ -51,6 +172,13 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t capacity)
+{
+    m_data.reserve(capacity);
+}
+
+
 ////////////////////////////////////////////////////////////
 std::size_t Packet::getReadPosition() const
 {
@@ -63,7 +191,10 @@ void Packet::clear()
 {
     m_data.clear();
     m_readPos = 0;
+    m_sendPos = 0;
     m_isValid = true;
+
+    onClear();
 }
 
 
@@ -95,6 +226,15 @@ Packet::operator bool() const
 }
 
 
+////////////////////////////////////////////////////////////
+std::byte* Packet::grow(std::size_t size)
+{
+    const std::size_t offset = m_data.size();
+    m_data.resize(offset + size);
+    return m_data.data() + offset;
+}
+
+
 ////////////////////////////////////////////////////////////
 Packet& Packet::operator>>(bool& data)
 {
@@ -301,16 +441,15 @@ Packet& Packet::operator>>(wchar_t* data)
     std::uint32_t length = 0;
     *this >> length;
 
-    if ((length > 0) && checkSize(length * sizeof(std::uint32_t)))
+    if ((length > 0) && checkCount(length, sizeof(std::uint32_t)))
     {
         // Then extract characters
         for (std::uint32_t i = 0; i < length; ++i)
-        {
-            std::uint32_t character = 0;
-            *this >> character;
-            data[i] = static_cast<wchar_t>(character);
-        }
+            data[i] = static_cast<wchar_t>(loadCharacter(&m_data[m_readPos + i * sizeof(std::uint32_t)]));
         data[length] = L'\0';
+
+        // Update reading position
+        m_readPos += length * sizeof(std::uint32_t);
     }
 
     return *this;
@@ -325,15 +464,15 @@ Packet& Packet::operator>>(std::wstring& data)
     *this >> length;
 
     data.clear();
-    if ((length > 0) && checkSize(length * sizeof(std::uint32_t)))
+    if ((length > 0) && checkCount(length, sizeof(std::uint32_t)))
     {
         // Then extract characters
+        data.resize(length);
         for (std::uint32_t i = 0; i < length; ++i)
-        {
-            std::uint32_t character = 0;
-            *this >> character;
-            data += static_cast<wchar_t>(character);
-        }
+            data[i] = static_cast<wchar_t>(loadCharacter(&m_data[m_readPos + i * sizeof(std::uint32_t)]));
+
+        // Update reading position
+        m_readPos += length * sizeof(std::uint32_t);
     }
 
     return *this;
@@ -348,15 +487,16 @@ Packet& Packet::operator>>(String& data)
     *this >> length;
 
     data.clear();
-    if ((length > 0) && checkSize(length * sizeof(std::uint32_t)))
+    if ((length > 0) && checkCount(length, sizeof(std::uint32_t)))
     {
         // Then extract characters
+        std::u32string characters(length, U'\0');
         for (std::uint32_t i = 0; i < length; ++i)
-        {
-            std::uint32_t character = 0;
-            *this >> character;
-            data += static_cast<char32_t>(character);
-        }
+            characters[i] = static_cast<char32_t>(loadCharacter(&m_data[m_readPos + i * sizeof(std::uint32_t)]));
+        data = String(std::move(characters));
+
+        // Update reading position
+        m_readPos += length * sizeof(std::uint32_t);
     }
 
     return *this;
@@ -516,8 +656,7 @@ Packet& Packet::operator<<(const wchar_t* data)
     *this << length;
 
     // Then insert characters
-    for (const wchar_t* c = data; *c != L'\0'; ++c)
-        *this << static_cast<std::uint32_t>(*c);
+    storeCharacters(grow(length * sizeof(std::uint32_t)), data, length);
 
     return *this;
 }
@@ -532,10 +671,7 @@ Packet& Packet::operator<<(const std::wstring& data)
 
     // Then insert characters
     if (length > 0)
-    {
-        for (const wchar_t c : data)
-            *this << static_cast<std::uint32_t>(c);
-    }
+        storeCharacters(grow(length * sizeof(std::uint32_t)), data.begin(), length);
 
     return *this;
 }
@@ -550,15 +686,301 @@ Packet& Packet::operator<<(const String& data)
 
     // Then insert characters
     if (length > 0)
+        storeCharacters(grow(length * sizeof(std::uint32_t)), data.begin(), length);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::int8_t* data, std::size_t count)
+{
+    append(data, count * sizeof(*data));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::uint8_t* data, std::size_t count)
+{
+    append(data, count * sizeof(*data));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::int16_t* data, std::size_t count)
+{
+    if (count > 0)
+        copyNetworkOrder<std::uint16_t>(grow(count * sizeof(*data)), data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::uint16_t* data, std::size_t count)
+{
+    if (count > 0)
+        copyNetworkOrder<std::uint16_t>(grow(count * sizeof(*data)), data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::int32_t* data, std::size_t count)
+{
+    if (count > 0)
+        copyNetworkOrder<std::uint32_t>(grow(count * sizeof(*data)), data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::uint32_t* data, std::size_t count)
+{
+    if (count > 0)
+        copyNetworkOrder<std::uint32_t>(grow(count * sizeof(*data)), data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::int64_t* data, std::size_t count)
+{
+    if (count > 0)
+        copyNetworkOrder<std::uint64_t>(grow(count * sizeof(*data)), data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const std::uint64_t* data, std::size_t count)
+{
+    if (count > 0)
+        copyNetworkOrder<std::uint64_t>(grow(count * sizeof(*data)), data, count);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const float* data, std::size_t count)
+{
+    append(data, count * sizeof(*data));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const double* data, std::size_t count)
+{
+    append(data, count * sizeof(*data));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::int8_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(*data));
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::uint8_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(*data));
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::int16_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        copyNetworkOrder<std::uint16_t>(data, &m_data[m_readPos], count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::uint16_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        copyNetworkOrder<std::uint16_t>(data, &m_data[m_readPos], count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::int32_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        copyNetworkOrder<std::uint32_t>(data, &m_data[m_readPos], count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::uint32_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        copyNetworkOrder<std::uint32_t>(data, &m_data[m_readPos], count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::int64_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        copyNetworkOrder<std::uint64_t>(data, &m_data[m_readPos], count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(std::uint64_t* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
     {
-        for (const unsigned int datum : data)
-            *this << datum;
+        copyNetworkOrder<std::uint64_t>(data, &m_data[m_readPos], count);
+        m_readPos += count * sizeof(*data);
     }
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(float* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(*data));
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(double* data, std::size_t count)
+{
+    if ((count > 0) && checkCount(count, sizeof(*data)))
+    {
+        std::memcpy(data, &m_data[m_readPos], count * sizeof(*data));
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarUint(std::uint64_t data)
+{
+    // 7 bits per byte, the most significant bit tells whether more bytes follow
+    std::array<std::byte, 10> bytes{};
+    std::size_t               size = 0;
+    while (data >= 0x80)
+    {
+        bytes[size++] = static_cast<std::byte>((data & 0x7F) | 0x80);
+        data >>= 7;
+    }
+    bytes[size++] = static_cast<std::byte>(data);
+
+    append(bytes.data(), size);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarInt(std::int64_t data)
+{
+    // Zigzag encoding: the sign goes to the least significant bit
+    const auto value = static_cast<std::uint64_t>(data);
+    return writeVarUint((value << 1) ^ (data < 0 ? ~std::uint64_t{0} : std::uint64_t{0}));
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarUint(std::uint64_t& data)
+{
+    std::uint64_t value = 0;
+    for (unsigned int shift = 0; m_isValid; shift += 7)
+    {
+        if (!checkSize(1))
+            break;
+
+        // The 10th byte can only hold the last bit of a 64-bit value, anything else is invalid
+        const auto byte = static_cast<std::uint64_t>(m_data[m_readPos++]);
+        if ((shift == 63) && (byte > 1))
+        {
+            m_isValid = false;
+            break;
+        }
+
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            data = value;
+            break;
+        }
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarInt(std::int64_t& data)
+{
+    std::uint64_t value = 0;
+    if (readVarUint(value))
+        data = static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
@@ -568,6 +990,16 @@ bool Packet::checkSize(std::size_t size)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Packet::checkCount(std::size_t count, std::size_t elementSize)
+{
+    // Divide the remaining size instead of multiplying the count, which could overflow
+    m_isValid = m_isValid && (count <= (m_data.size() - m_readPos) / elementSize);
+
+    return m_isValid;
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
@@ -582,4 +1014,17 @@ void Packet::onReceive(const void* data, std::size_t size)
     append(data, size);
 }
 
+
+////////////////////////////////////////////////////////////
+void Packet::onClear()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::invalidate()
+{
+    m_isValid = false;
+}
+
 } // namespace sf
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+
+#include <utility>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool(std::size_t maxPackets) : m_maxPackets(maxPackets)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Packet PacketPool::acquire()
+{
+    if (m_packets.empty())
+        return {};
+
+    Packet packet = std::move(m_packets.back());
+    m_packets.pop_back();
+    return packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::release(Packet&& packet)
+{
+    if (m_packets.size() >= m_maxPackets)
+        return;
+
+    // Clearing keeps the storage allocated
+    packet.clear();
+    m_packets.push_back(std::move(packet));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketPool::getSize() const
+{
+    return m_packets.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::clear()
+{
+    m_packets.clear();
+}
+
+} // namespace sf
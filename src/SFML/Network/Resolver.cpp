@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Resolver.hpp>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Utils.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+
+namespace
+{
+// Number of cached names above which the expired ones are removed
+constexpr std::size_t cacheCleanupThreshold = 1024;
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct Resolver::ResolverImpl
+{
+    struct Entry
+    {
+        std::vector<IpAddress> addresses;   //!< Addresses of the host
+        Time                   expiry;      //!< Time after which the name must be resolved again
+        bool                   isStatic{};  //!< Was the entry set with addHost?
+        bool                   isPending{}; //!< Is the name being resolved?
+        std::vector<Callback>  callbacks;   //!< Functions waiting for the resolution in progress
+    };
+
+    explicit ResolverImpl(std::size_t count) : threadCount(std::max<std::size_t>(count, 1))
+    {
+    }
+
+    ~ResolverImpl()
+    {
+        std::deque<std::string> abandoned;
+
+        {
+            const std::lock_guard lock(mutex);
+            shuttingDown = true;
+            abandoned.swap(queue);
+        }
+
+        workAvailable.notify_all();
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        // The names that were never resolved complete with no address
+        for (const std::string& name : abandoned)
+            complete(name, {});
+    }
+
+    // Cache keys are case insensitive, like host names
+    static std::string normalize(std::string_view host)
+    {
+        return toLower(std::string(host));
+    }
+
+    // Check whether an entry can be returned as is; the mutex must be locked
+    [[nodiscard]] bool isFresh(const Entry& entry) const
+    {
+        return entry.isStatic || (!entry.isPending && (clock.getElapsedTime() < entry.expiry));
+    }
+
+    // Remove the entries that are neither valid nor in use; the mutex must be locked
+    void removeExpired()
+    {
+        const Time now = clock.getElapsedTime();
+
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (!it->second.isStatic && !it->second.isPending && (it->second.expiry <= now))
+                it = entries.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    // Store the result of a resolution and call the functions that were waiting for it
+    std::vector<IpAddress> complete(const std::string& name, std::vector<IpAddress> addresses)
+    {
+        std::vector<Callback> callbacks;
+
+        {
+            const std::lock_guard lock(mutex);
+
+            Entry& entry = entries[name];
+            entry.isPending = false;
+            callbacks.swap(entry.callbacks);
+
+            // A name set with addHost while it was being resolved keeps its static addresses
+            if (entry.isStatic)
+            {
+                addresses = entry.addresses;
+            }
+            else
+            {
+                entry.expiry    = clock.getElapsedTime() + (addresses.empty() ? negativeTimeToLive : timeToLive);
+                entry.addresses = addresses;
+            }
+
+            if (entries.size() > cacheCleanupThreshold)
+                removeExpired();
+        }
+
+        for (const Callback& callback : callbacks)
+        {
+            if (callback)
+                callback(addresses);
+        }
+
+        return addresses;
+    }
+
+    // Queue a name, and start a thread if none is available to resolve it; the mutex must be locked
+    void enqueue(const std::string& name)
+    {
+        queue.push_back(name);
+
+        if ((idleWorkers == 0) && (workers.size() < threadCount))
+            workers.emplace_back(&ResolverImpl::work, this);
+    }
+
+    // Body of the threads: resolve the queued names until the resolver is destroyed
+    void work()
+    {
+        std::unique_lock lock(mutex);
+
+        while (true)
+        {
+            ++idleWorkers;
+            workAvailable.wait(lock, [this] { return shuttingDown || !queue.empty(); });
+            --idleWorkers;
+
+            if (shuttingDown)
+                return;
+
+            const std::string name = std::move(queue.front());
+            queue.pop_front();
+
+            lock.unlock();
+            complete(name, IpAddress::resolveAll(name));
+            lock.lock();
+        }
+    }
+
+    const std::size_t                      threadCount;                    //!< Maximum number of threads
+    std::mutex                             mutex;                          //!< Protects all the members below
+    std::condition_variable                workAvailable;                  //!< Signals that a name was queued
+    std::unordered_map<std::string, Entry> entries;                        //!< Cached names, by lowercase name
+    std::deque<std::string>                queue;                          //!< Names waiting for a thread
+    std::vector<std::thread>               workers;                        //!< Threads started so far
+    std::size_t                            idleWorkers{};                  //!< Number of threads waiting for a name
+    bool                                   shuttingDown{};                 //!< Is the resolver being destroyed?
+    Clock                                  clock;                          //!< Reference for the expiry of the entries
+    Time                                   timeToLive{seconds(60)};        //!< Lifetime of the resolved names
+    Time                                   negativeTimeToLive{seconds(5)}; //!< Lifetime of the unresolvable names
+};
+
+
+////////////////////////////////////////////////////////////
+Resolver::Resolver(std::size_t threadCount) : m_impl(std::make_unique<ResolverImpl>(threadCount))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::~Resolver() = default;
+
+
+////////////////////////////////////////////////////////////
+Resolver& Resolver::getDefault()
+{
+    // Intentionally leaked: destroying it at exit would join threads that may be blocked on a slow DNS server
+    static auto* resolver = new Resolver;
+    return *resolver;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<IpAddress> Resolver::resolve(std::string_view host)
+{
+    const std::string name = ResolverImpl::normalize(host);
+
+    {
+        std::unique_lock lock(m_impl->mutex);
+
+        ResolverImpl::Entry& entry = m_impl->entries[name];
+        if (m_impl->isFresh(entry))
+            return entry.addresses;
+
+        // Nobody is resolving this name: do it in the calling thread rather than waiting for a free one
+        if (!entry.isPending)
+        {
+            entry.isPending = true;
+            lock.unlock();
+            return m_impl->complete(name, IpAddress::resolveAll(name));
+        }
+    }
+
+    // Share the resolution in progress
+    return resolveAsync(host).get();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::resolveAsync(std::string_view host, Callback callback)
+{
+    const std::string      name = ResolverImpl::normalize(host);
+    std::vector<IpAddress> addresses;
+
+    {
+        std::unique_lock lock(m_impl->mutex);
+
+        ResolverImpl::Entry& entry = m_impl->entries[name];
+        if (!m_impl->isFresh(entry))
+        {
+            entry.callbacks.push_back(std::move(callback));
+
+            if (!entry.isPending)
+            {
+                entry.isPending = true;
+                m_impl->enqueue(name);
+                lock.unlock();
+                m_impl->workAvailable.notify_one();
+            }
+
+            return;
+        }
+
+        addresses = entry.addresses;
+    }
+
+    if (callback)
+        callback(addresses);
+}
+
+
+////////////////////////////////////////////////////////////
+std::future<std::vector<IpAddress>> Resolver::resolveAsync(std::string_view host)
+{
+    auto promise = std::make_shared<std::promise<std::vector<IpAddress>>>();
+    auto future  = promise->get_future();
+
+    resolveAsync(host, [promise](const std::vector<IpAddress>& addresses) { promise->set_value(addresses); });
+
+    return future;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::setTimeToLive(Time timeToLive, Time negativeTimeToLive)
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    m_impl->timeToLive         = timeToLive;
+    m_impl->negativeTimeToLive = negativeTimeToLive;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::addHost(std::string_view host, std::vector<IpAddress> addresses)
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    ResolverImpl::Entry& entry = m_impl->entries[ResolverImpl::normalize(host)];
+    entry.isStatic             = true;
+    entry.addresses            = std::move(addresses);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::removeHost(std::string_view host)
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    const auto it = m_impl->entries.find(ResolverImpl::normalize(host));
+    if ((it == m_impl->entries.end()) || !it->second.isStatic)
+        return;
+
+    // Keep the entries that have callbacks waiting, but make them expired
+    if (it->second.isPending)
+    {
+        it->second.isStatic = false;
+        it->second.expiry   = Time::Zero;
+    }
+    else
+    {
+        m_impl->entries.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::clearCache()
+{
+    const std::lock_guard lock(m_impl->mutex);
+
+    for (auto it = m_impl->entries.begin(); it != m_impl->entries.end();)
+    {
+        if (!it->second.isStatic && !it->second.isPending)
+            it = m_impl->entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+} // namespace sf
@@ -33,6 +33,23 @@
 #include <ostream>
 #include <utility>
 
+#include <cassert>
+
+
+namespace
+{
+////////////////////////////////////////////////////////////
+std::size_t getSizeBucket(std::size_t size)
+{
+    // Bucket i holds the sizes in [2^(i+5), 2^(i+6)), clamped to the histogram
+    std::size_t bucket = 0;
+    for (size >>= 6; size > 0 && bucket < 15; size >>= 1)
+        ++bucket;
+
+    return bucket;
+}
+} // namespace
+
 
 namespace sf
 {
@@ -54,7 +71,8 @@ Socket::~Socket()
 Socket::Socket(Socket&& socket) noexcept :
 m_type(socket.m_type),
 m_socket(std::exchange(socket.m_socket, priv::SocketImpl::invalidSocket())),
-m_isBlocking(socket.m_isBlocking)
+m_isBlocking(socket.m_isBlocking),
+m_statistics(std::move(socket.m_statistics))
 {
 }
 
@@ -70,6 +88,7 @@ Socket& Socket::operator=(Socket&& socket) noexcept
     m_type       = socket.m_type;
     m_socket     = std::exchange(socket.m_socket, priv::SocketImpl::invalidSocket());
     m_isBlocking = socket.m_isBlocking;
+    m_statistics = std::move(socket.m_statistics);
     return *this;
 }
 
@@ -92,6 +111,38 @@ bool Socket::isBlocking() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Socket::setStatisticsEnabled(bool enabled)
+{
+    if (!enabled)
+        m_statistics.reset();
+    else if (!m_statistics)
+        m_statistics = std::make_unique<Statistics>();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Socket::isStatisticsEnabled() const
+{
+    return m_statistics != nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Statistics Socket::getStatistics() const
+{
+    return m_statistics ? *m_statistics : Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetStatistics()
+{
+    if (m_statistics)
+        *m_statistics = Statistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle Socket::getNativeHandle() const
 {
@@ -101,11 +152,19 @@ SocketHandle Socket::getNativeHandle() const
 
 ////////////////////////////////////////////////////////////
 void Socket::create()
+{
+    create(IpAddress::Type::IpV4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::create(IpAddress::Type addressType)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
     {
-        const SocketHandle handle = socket(PF_INET, m_type == Type::Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+        const int          family = (addressType == IpAddress::Type::IpV6) ? PF_INET6 : PF_INET;
+        const SocketHandle handle = socket(family, m_type == Type::Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
 
         if (handle == priv::SocketImpl::invalidSocket())
         {
@@ -113,13 +172,24 @@ void Socket::create()
             return;
         }
 
+        // Accept IPv4 addresses too, which is not the default on all systems
+        if (addressType == IpAddress::Type::IpV6)
+        {
+            int no = 0;
+            if (setsockopt(handle, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&no), sizeof(no)) == -1)
+            {
+                err() << "Failed to set socket option \"IPV6_V6ONLY\" ; "
+                      << "the socket will only communicate with IPv6 addresses" << std::endl;
+            }
+        }
+
         create(handle);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Socket::create(SocketHandle handle)
+void Socket::create(SocketHandle handle, bool blockingSet)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
@@ -128,7 +198,8 @@ void Socket::create(SocketHandle handle)
         m_socket = handle;
 
         // Set the current blocking state
-        setBlocking(m_isBlocking);
+        if (!blockingSet)
+            setBlocking(m_isBlocking);
 
         if (m_type == Type::Tcp)
         {
@@ -172,4 +243,71 @@ void Socket::close()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Socket::takeHandle(Socket& socket)
+{
+    assert(socket.m_type == m_type && "Cannot take over the handle of a socket of another type");
+
+    close();
+    m_socket = std::exchange(socket.m_socket, priv::SocketImpl::invalidSocket());
+    setBlocking(m_isBlocking);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordSend(Status status, std::size_t requested, std::size_t sent)
+{
+    if (!m_statistics)
+        return;
+
+    ++m_statistics->sendCalls;
+    m_statistics->bytesSent += sent;
+
+    if (status == Status::NotReady)
+        ++m_statistics->notReady;
+    else if (status == Status::Error)
+        ++m_statistics->errors;
+    else if (sent < requested)
+        ++m_statistics->partialSends;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordReceive(Status status, std::size_t received)
+{
+    if (!m_statistics)
+        return;
+
+    ++m_statistics->receiveCalls;
+    m_statistics->bytesReceived += received;
+
+    if (status == Status::NotReady)
+        ++m_statistics->notReady;
+    else if (status == Status::Error)
+        ++m_statistics->errors;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordPacketSent(std::size_t size)
+{
+    if (!m_statistics)
+        return;
+
+    ++m_statistics->packetsSent;
+    ++m_statistics->sentSizes[getSizeBucket(size)];
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordPacketReceived(std::size_t size)
+{
+    if (!m_statistics)
+        return;
+
+    ++m_statistics->packetsReceived;
+    ++m_statistics->receivedSizes[getSizeBucket(size)];
+}
+
 } // namespace sf
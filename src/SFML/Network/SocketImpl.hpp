@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 
@@ -47,11 +48,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#include <cstddef>
-
 #endif
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 
 
 namespace sf::priv
@@ -76,15 +77,53 @@ public:
 #endif
 
     ////////////////////////////////////////////////////////////
-    /// \brief Create an internal sockaddr_in address
+    /// \brief Contiguous block of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
+    {
+        const void* data{}; //!< Pointer to the first byte of the block
+        std::size_t size{}; //!< Size of the block, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an internal socket address
+    ///
+    /// \param address   Target address
+    /// \param port      Target port
+    /// \param result    Socket address to fill
+    /// \param mapToIpV6 Convert IPv4 addresses to their IPv4-mapped
+    ///                  IPv6 form, for use with IPv6 sockets
+    ///
+    /// \return Size of the socket address, to pass to socket functions with \a result
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createAddress(const IpAddress&  address,
+                                    unsigned short    port,
+                                    sockaddr_storage& result,
+                                    bool              mapToIpV6 = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the IP address of an internal socket address
+    ///
+    /// IPv4-mapped IPv6 addresses are converted back to IPv4.
+    ///
+    /// \param address IPv4 or IPv6 socket address
+    ///
+    /// \return IP address
+    ///
+    ////////////////////////////////////////////////////////////
+    static IpAddress getAddress(const sockaddr_storage& address);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of an internal socket address
     ///
-    /// \param address Target address
-    /// \param port    Target port
+    /// \param address IPv4 or IPv6 socket address
     ///
-    /// \return sockaddr_in ready to be used by socket functions
+    /// \return Port
     ///
     ////////////////////////////////////////////////////////////
-    static sockaddr_in createAddress(std::uint32_t address, unsigned short port);
+    static unsigned short getPort(const sockaddr_storage& address);
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the value of the invalid socket
@@ -111,6 +150,21 @@ public:
     ////////////////////////////////////////////////////////////
     static void setBlocking(SocketHandle sock, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept a pending connection on a listening socket
+    ///
+    /// The new socket is not inherited by child processes, and
+    /// is already in the requested blocking state.
+    ///
+    /// \param listener Handle of the listening socket
+    /// \param block    Blocking state of the new socket
+    ///
+    /// \return Handle of the new socket, or the invalid socket
+    ///         on error (see getErrorStatus)
+    ///
+    ////////////////////////////////////////////////////////////
+    static SocketHandle accept(SocketHandle listener, bool block);
+
     ////////////////////////////////////////////////////////////
     /// Get the last socket error status
     ///
@@ -118,6 +172,50 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether data can be received without blocking
+    ///
+    /// \param sock Handle of the socket
+    ///
+    /// \return True if data, or an error, is waiting on the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isReadable(SocketHandle sock);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several blocks of bytes with a single system call
+    ///
+    /// The blocks are sent in order, as if they were contiguous.
+    /// Like a regular send, this may send only part of the data.
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Pointer to the blocks to send
+    /// \param count   Number of blocks
+    /// \param flags   Flags passed to the system send function
+    ///
+    /// \return Number of bytes sent, or -1 on error (see getErrorStatus)
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::int64_t sendBuffers(SocketHandle sock, const Buffer* buffers, std::size_t count, int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send bytes read from a file
+    ///
+    /// Like a regular send, this may send only part of the data.
+    /// The position of the file may be changed.
+    ///
+    /// \param sock   Handle of the socket
+    /// \param file   File to read the bytes from
+    /// \param offset Position of the first byte to send in the file
+    /// \param size   Number of bytes to send
+    /// \param flags  Flags passed to the system send function
+    ///
+    /// \return Number of bytes sent, 0 at the end of the file,
+    ///         or -1 on error (see getErrorStatus)
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::int64_t sendFile(SocketHandle sock, std::FILE* file, std::uint64_t offset, std::size_t size, int flags);
 };
 
 } // namespace sf::priv
@@ -22,6 +22,13 @@
 //
 ////////////////////////////////////////////////////////////
 
+
+#ifdef _WIN32
+// WSAPoll is only declared for Windows Vista and later
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600 // NOLINT(bugprone-reserved-identifier)
+#endif
+
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
@@ -29,33 +36,424 @@
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/Network/SocketSelector.hpp>
 
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <ostream>
+#include <unordered_map>
 #include <utility>
 
-#ifdef _MSC_VER
+#include <cerrno>
+#include <cstdint>
+
+#if defined(SFML_NETWORK_USE_SELECT)
+#define SFML_SOCKET_SELECTOR_SELECT
+#elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+#define SFML_SOCKET_SELECTOR_EPOLL
+#include <sys/epoll.h>
+#elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS) || defined(SFML_SYSTEM_FREEBSD) || \
+    defined(SFML_SYSTEM_OPENBSD) || defined(SFML_SYSTEM_NETBSD)
+#define SFML_SOCKET_SELECTOR_KQUEUE
+#include <sys/event.h>
+#include <sys/time.h>
+#elif defined(SFML_SYSTEM_WINDOWS)
+#define SFML_SOCKET_SELECTOR_WSAPOLL
+#else
+#define SFML_SOCKET_SELECTOR_SELECT
+#endif
+
+#if defined(_MSC_VER) && defined(SFML_SOCKET_SELECTOR_SELECT)
 #pragma warning(disable : 4127) // "conditional expression is constant" generated by the FD_SET macro
 #endif
 
 
+namespace
+{
+////////////////////////////////////////////////////////////
+bool wantsReceive(sf::SocketSelector::Interest interest)
+{
+    return interest != sf::SocketSelector::Interest::Send;
+}
+
+
+////////////////////////////////////////////////////////////
+bool wantsSend(sf::SocketSelector::Interest interest)
+{
+    return interest != sf::SocketSelector::Interest::Receive;
+}
+
+
+////////////////////////////////////////////////////////////
+[[maybe_unused]] int toMilliseconds(sf::Time timeout)
+{
+    // Time::Zero means waiting forever, other timeouts are rounded up so that they don't turn into polling
+    if (timeout == sf::Time::Zero)
+        return -1;
+
+    const std::int64_t milliseconds = (std::max(timeout.asMicroseconds(), std::int64_t{0}) + 999) / 1000;
+    return static_cast<int>(std::min(milliseconds, std::int64_t{std::numeric_limits<int>::max()}));
+}
+} // namespace
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set allSockets{};   //!< Set containing all the sockets handles
-    fd_set socketsReady{}; //!< Set containing handles of the sockets that are ready
-    int    maxSocket{};    //!< Maximum socket handle
-    int    socketCount{};  //!< Number of socket handles
+    struct Entry
+    {
+        Socket*       socket{};          //!< Socket passed to add()
+        Interest      interest{};        //!< Readiness the socket is observed for
+        std::uint64_t readyGeneration{}; //!< Value of generation the last time the socket was found ready
+        std::size_t   readyIndex{};      //!< Index of the socket in readySockets, when it is ready
+#if defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+        std::size_t pollIndex{}; //!< Index of the socket in descriptors
+#endif
+    };
+
+    SocketSelectorImpl()
+    {
+        open();
+    }
+
+    SocketSelectorImpl(const SocketSelectorImpl& copy) :
+    entries(copy.entries),
+    readySockets(copy.readySockets),
+    generation(copy.generation),
+    statistics(copy.statistics)
+#if defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+    ,
+    descriptors(copy.descriptors)
+#elif defined(SFML_SOCKET_SELECTOR_SELECT)
+    ,
+    receiveSockets(copy.receiveSockets),
+    sendSockets(copy.sendSockets),
+    maxSocket(copy.maxSocket)
+#endif
+    {
+#if defined(SFML_SOCKET_SELECTOR_EPOLL) || defined(SFML_SOCKET_SELECTOR_KQUEUE)
+        // The kernel object can't be shared, create a new one observing the same sockets
+        open();
+        for (auto& [handle, entry] : entries)
+            static_cast<void>(registerSocket(handle, entry, true));
+#endif
+    }
+
+    SocketSelectorImpl& operator=(const SocketSelectorImpl&) = delete;
+
+    ~SocketSelectorImpl()
+    {
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void open()
+    {
+#if defined(SFML_SOCKET_SELECTOR_EPOLL)
+        descriptor = epoll_create1(EPOLL_CLOEXEC);
+        if (descriptor < 0)
+            err() << "Failed to create the epoll instance of the selector: " << errno << std::endl;
+#elif defined(SFML_SOCKET_SELECTOR_KQUEUE)
+        descriptor = kqueue();
+        if (descriptor < 0)
+            err() << "Failed to create the kqueue instance of the selector: " << errno << std::endl;
+#elif defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+        descriptors.clear();
+#else
+        FD_ZERO(&receiveSockets);
+        FD_ZERO(&sendSockets);
+        maxSocket = 0;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close()
+    {
+#if defined(SFML_SOCKET_SELECTOR_EPOLL) || defined(SFML_SOCKET_SELECTOR_KQUEUE)
+        if (descriptor >= 0)
+            ::close(descriptor);
+
+        descriptor = -1;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start observing a socket, or update its interest
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool registerSocket(SocketHandle handle, Entry& entry, bool added)
+    {
+        const bool receive = wantsReceive(entry.interest);
+        const bool send    = wantsSend(entry.interest);
+
+#if defined(SFML_SOCKET_SELECTOR_EPOLL)
+        epoll_event event{};
+        event.events  = (receive ? EPOLLIN : 0u) | (send ? EPOLLOUT : 0u);
+        event.data.fd = handle;
+
+        // A closed socket is dropped by the kernel and its handle may have been reused since, so retry the other way
+        const int operation = added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+        if (epoll_ctl(descriptor, operation, handle, &event) == 0 ||
+            epoll_ctl(descriptor, added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, handle, &event) == 0)
+            return true;
+
+        err() << "Failed to add the socket to the selector: " << errno << std::endl;
+        return false;
+#elif defined(SFML_SOCKET_SELECTOR_KQUEUE)
+        static_cast<void>(added);
+
+        // Read and write readiness are separate filters; removing a filter that isn't there is not an error
+        const auto changeFilter = [&](short filter, bool enable)
+        {
+            struct kevent change = {};
+            const auto flags = static_cast<unsigned short>(enable ? EV_ADD : EV_DELETE);
+            EV_SET(&change, static_cast<uintptr_t>(handle), filter, flags, 0, 0, 0);
+            return kevent(descriptor, &change, 1, nullptr, 0, nullptr) == 0 || !enable;
+        };
+
+        if (changeFilter(EVFILT_READ, receive) && changeFilter(EVFILT_WRITE, send))
+            return true;
+
+        err() << "Failed to add the socket to the selector: " << errno << std::endl;
+        return false;
+#elif defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+        if (added)
+        {
+            entry.pollIndex = descriptors.size();
+            descriptors.push_back(WSAPOLLFD{handle, 0, 0});
+        }
+
+        descriptors[entry.pollIndex].events = static_cast<SHORT>((receive ? POLLRDNORM : 0) | (send ? POLLWRNORM : 0));
+        return true;
+#else
+        static_cast<void>(added);
+
+#if defined(SFML_SYSTEM_WINDOWS)
+        if (entries.size() > FD_SETSIZE)
+        {
+            err() << "The socket can't be added to the selector because the "
+                  << "selector is full. This is a limitation of your operating "
+                  << "system's FD_SETSIZE setting." << std::endl;
+            return false;
+        }
+#else
+        if (handle >= FD_SETSIZE)
+        {
+            err() << "The socket can't be added to the selector because its "
+                  << "ID is too high. This is a limitation of your operating "
+                  << "system's FD_SETSIZE setting." << std::endl;
+            return false;
+        }
+
+        // SocketHandle is an int in POSIX
+        maxSocket = std::max(maxSocket, handle);
+#endif
+
+        FD_CLR(handle, &receiveSockets);
+        FD_CLR(handle, &sendSockets);
+
+        if (receive)
+            FD_SET(handle, &receiveSockets);
+
+        if (send)
+            FD_SET(handle, &sendSockets);
+
+        return true;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop observing a socket
+    ///
+    ////////////////////////////////////////////////////////////
+    void unregisterSocket(SocketHandle handle, const Entry& entry)
+    {
+#if defined(SFML_SOCKET_SELECTOR_EPOLL)
+        static_cast<void>(entry);
+
+        // Fails harmlessly if the socket was closed meanwhile
+        epoll_ctl(descriptor, EPOLL_CTL_DEL, handle, nullptr);
+#elif defined(SFML_SOCKET_SELECTOR_KQUEUE)
+        std::array<struct kevent, 2> changes{};
+        EV_SET(&changes[0], static_cast<uintptr_t>(handle), EVFILT_READ, EV_DELETE, 0, 0, 0);
+        EV_SET(&changes[1], static_cast<uintptr_t>(handle), EVFILT_WRITE, EV_DELETE, 0, 0, 0);
+        for (auto& change : changes)
+            kevent(descriptor, &change, 1, nullptr, 0, nullptr);
+#elif defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+        static_cast<void>(handle);
+
+        // Move the last descriptor in place of the removed one
+        const std::size_t index = entry.pollIndex;
+        descriptors[index]      = descriptors.back();
+        descriptors.pop_back();
+
+        if (index < descriptors.size())
+            entries[descriptors[index].fd].pollIndex = index;
+#else
+        static_cast<void>(entry);
+
+#if !defined(SFML_SYSTEM_WINDOWS)
+        if (handle >= FD_SETSIZE)
+            return;
+#endif
+
+        FD_CLR(handle, &receiveSockets);
+        FD_CLR(handle, &sendSockets);
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record that a socket is ready
+    ///
+    ////////////////////////////////////////////////////////////
+    void markReady(SocketHandle handle, bool receive, bool send)
+    {
+        const auto it = entries.find(handle);
+        if (it == entries.end())
+            return;
+
+        Entry& entry = it->second;
+        receive      = receive && wantsReceive(entry.interest);
+        send         = send && wantsSend(entry.interest);
+
+        if (!receive && !send)
+            return;
+
+        if (entry.readyGeneration != generation)
+        {
+            entry.readyGeneration = generation;
+            entry.readyIndex      = readySockets.size();
+            readySockets.push_back({entry.socket, false, false});
+        }
+
+        ReadySocket& readySocket = readySockets[entry.readyIndex];
+        readySocket.receive      = readySocket.receive || receive;
+        readySocket.send         = readySocket.send || send;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for sockets to be ready and record them
+    ///
+    ////////////////////////////////////////////////////////////
+    void poll(Time timeout)
+    {
+        ++generation;
+        readySockets.clear();
+
+#if defined(SFML_SOCKET_SELECTOR_EPOLL)
+        events.resize(std::max(entries.size(), std::size_t{1}));
+
+        const int eventCount = static_cast<int>(events.size());
+        const int count      = epoll_wait(descriptor, events.data(), eventCount, toMilliseconds(timeout));
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& event  = events[static_cast<std::size_t>(i)];
+            const bool  failed = (event.events & (EPOLLERR | EPOLLHUP)) != 0;
+            markReady(event.data.fd, failed || (event.events & EPOLLIN) != 0, failed || (event.events & EPOLLOUT) != 0);
+        }
+#elif defined(SFML_SOCKET_SELECTOR_KQUEUE)
+        events.resize(std::max(entries.size() * 2, std::size_t{1}));
+
+        timespec time{};
+        time.tv_sec  = static_cast<time_t>(timeout.asMicroseconds() / 1000000);
+        time.tv_nsec = static_cast<long>(timeout.asMicroseconds() % 1000000) * 1000;
+
+        const int count = kevent(descriptor,
+                                 nullptr,
+                                 0,
+                                 events.data(),
+                                 static_cast<int>(events.size()),
+                                 timeout != Time::Zero ? &time : nullptr);
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& event  = events[static_cast<std::size_t>(i)];
+            const bool  failed = (event.flags & EV_ERROR) != 0;
+            markReady(static_cast<SocketHandle>(event.ident),
+                      failed || event.filter == EVFILT_READ,
+                      failed || event.filter == EVFILT_WRITE);
+        }
+#elif defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+        // WSAPoll fails on an empty set, like select does on Windows
+        if (descriptors.empty())
+            return;
+
+        if (WSAPoll(descriptors.data(), static_cast<ULONG>(descriptors.size()), toMilliseconds(timeout)) <= 0)
+            return;
+
+        for (const WSAPOLLFD& descriptor : descriptors)
+        {
+            if (descriptor.revents == 0)
+                continue;
+
+            const bool failed = (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+            markReady(descriptor.fd,
+                      failed || (descriptor.revents & POLLRDNORM) != 0,
+                      failed || (descriptor.revents & POLLWRNORM) != 0);
+        }
+#else
+        timeval time{};
+        time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
+        time.tv_usec = static_cast<int>(timeout.asMicroseconds() % 1000000);
+
+        fd_set receiveReady = receiveSockets;
+        fd_set sendReady    = sendSockets;
+
+        // The first parameter is ignored on Windows
+        timeval*  limit = timeout != Time::Zero ? &time : nullptr;
+        const int count = select(maxSocket + 1, &receiveReady, &sendReady, nullptr, limit);
+        if (count <= 0)
+            return;
+
+        for (const auto& [handle, entry] : entries)
+            markReady(handle, FD_ISSET(handle, &receiveReady) != 0, FD_ISSET(handle, &sendReady) != 0);
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the readiness of a socket after the last wait
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const ReadySocket* findReady(SocketHandle handle) const
+    {
+        const auto it = entries.find(handle);
+        if (it == entries.end() || it->second.readyGeneration != generation)
+            return nullptr;
+
+        return &readySockets[it->second.readyIndex];
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::unordered_map<SocketHandle, Entry> entries;       //!< Sockets in the selector
+    std::vector<ReadySocket>                readySockets;  //!< Sockets found ready by the last wait
+    std::uint64_t                           generation{1}; //!< Incremented by each wait
+    std::optional<Statistics>               statistics;    //!< Statistics of the calls to wait, when they are enabled
+#if defined(SFML_SOCKET_SELECTOR_EPOLL)
+    int                      descriptor{-1}; //!< epoll instance
+    std::vector<epoll_event> events;         //!< Events returned by epoll_wait
+#elif defined(SFML_SOCKET_SELECTOR_KQUEUE)
+    int                        descriptor{-1}; //!< kqueue instance
+    std::vector<struct kevent> events;         //!< Events returned by kevent
+#elif defined(SFML_SOCKET_SELECTOR_WSAPOLL)
+    std::vector<WSAPOLLFD> descriptors; //!< Sockets and requested events passed to WSAPoll
+#else
+    fd_set receiveSockets{}; //!< Set containing handles of the sockets observed for receiving
+    fd_set sendSockets{};    //!< Set containing handles of the sockets observed for sending
+    int    maxSocket{};      //!< Maximum socket handle
+#endif
 };
 
 
 ////////////////////////////////////////////////////////////
 SocketSelector::SocketSelector() : m_impl(std::make_unique<SocketSelectorImpl>())
 {
-    clear();
 }
 
 
@@ -82,128 +480,139 @@ SocketSelector& SocketSelector::operator=(const SocketSelector& right)
 SocketSelector::SocketSelector(SocketSelector&&) noexcept = default;
 
 
-////////////////////////////////////////////////////////////]
+////////////////////////////////////////////////////////////
 SocketSelector& SocketSelector::operator=(SocketSelector&&) noexcept = default;
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::add(Socket& socket)
+void SocketSelector::add(Socket& socket, Interest interest)
 {
     const SocketHandle handle = socket.getNativeHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
-    {
+    if (handle == priv::SocketImpl::invalidSocket())
+        return;
 
-#if defined(SFML_SYSTEM_WINDOWS)
+    const auto [it, added] = m_impl->entries.try_emplace(handle);
+    it->second.socket      = &socket;
+    it->second.interest    = interest;
 
-        if (m_impl->socketCount >= FD_SETSIZE)
-        {
-            err() << "The socket can't be added to the selector because the "
-                  << "selector is full. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
-        }
+    if (!m_impl->registerSocket(handle, it->second, added) && added)
+        m_impl->entries.erase(it);
+}
 
-        if (FD_ISSET(handle, &m_impl->allSockets))
-            return;
 
-        ++m_impl->socketCount;
+////////////////////////////////////////////////////////////
+void SocketSelector::remove(Socket& socket)
+{
+    const SocketHandle handle = socket.getNativeHandle();
+    if (handle == priv::SocketImpl::invalidSocket())
+        return;
 
-#else
+    const auto it = m_impl->entries.find(handle);
+    if (it == m_impl->entries.end())
+        return;
 
-        if (handle >= FD_SETSIZE)
-        {
-            err() << "The socket can't be added to the selector because its "
-                  << "ID is too high. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
-        }
-
-        // SocketHandle is an int in POSIX
-        if (m_impl->maxSocket < handle)
-            m_impl->maxSocket = handle;
+    m_impl->unregisterSocket(handle, it->second);
+    m_impl->entries.erase(it);
+}
 
-#endif
 
-        FD_SET(handle, &m_impl->allSockets);
-    }
+////////////////////////////////////////////////////////////
+void SocketSelector::clear()
+{
+    // Recreating the kernel object is cheaper than removing the sockets one by one
+    m_impl->close();
+    m_impl->open();
+    m_impl->entries.clear();
+    m_impl->readySockets.clear();
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::remove(Socket& socket)
+bool SocketSelector::wait(Time timeout)
 {
-    const SocketHandle handle = socket.getNativeHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
+    if (!m_impl->statistics)
     {
+        m_impl->poll(timeout);
+        return !m_impl->readySockets.empty();
+    }
 
-#if defined(SFML_SYSTEM_WINDOWS)
+    const Clock clock;
+    m_impl->poll(timeout);
+    const Time elapsed = clock.getElapsedTime();
 
-        if (!FD_ISSET(handle, &m_impl->allSockets))
-            return;
+    Statistics& statistics = *m_impl->statistics;
+    statistics.maxWaitTime = std::max(statistics.maxWaitTime, elapsed);
+    statistics.waitTime += elapsed;
+    statistics.readySockets += m_impl->readySockets.size();
+    ++statistics.waitCalls;
 
-        --m_impl->socketCount;
+    if (m_impl->readySockets.empty())
+        ++statistics.timeouts;
 
-#else
+    return !m_impl->readySockets.empty();
+}
 
-        if (handle >= FD_SETSIZE)
-            return;
 
-#endif
+////////////////////////////////////////////////////////////
+bool SocketSelector::isReady(Socket& socket) const
+{
+    const SocketHandle handle = socket.getNativeHandle();
+    if (handle == priv::SocketImpl::invalidSocket())
+        return false;
 
-        FD_CLR(handle, &m_impl->allSockets);
-        FD_CLR(handle, &m_impl->socketsReady);
-    }
+    const ReadySocket* readySocket = m_impl->findReady(handle);
+    return readySocket && readySocket->receive;
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::clear()
+bool SocketSelector::isReadyToSend(Socket& socket) const
 {
-    FD_ZERO(&m_impl->allSockets);
-    FD_ZERO(&m_impl->socketsReady);
+    const SocketHandle handle = socket.getNativeHandle();
+    if (handle == priv::SocketImpl::invalidSocket())
+        return false;
 
-    m_impl->maxSocket   = 0;
-    m_impl->socketCount = 0;
+    const ReadySocket* readySocket = m_impl->findReady(handle);
+    return readySocket && readySocket->send;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool SocketSelector::wait(Time timeout)
+const std::vector<SocketSelector::ReadySocket>& SocketSelector::getReadySockets() const
 {
-    // Setup the timeout
-    timeval time{};
-    time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
-    time.tv_usec = static_cast<int>(timeout.asMicroseconds() % 1000000);
-
-    // Initialize the set that will contain the sockets that are ready
-    m_impl->socketsReady = m_impl->allSockets;
+    return m_impl->readySockets;
+}
 
-    // Wait until one of the sockets is ready for reading, or timeout is reached
-    // The first parameter is ignored on Windows
-    const int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, nullptr, nullptr, timeout != Time::Zero ? &time : nullptr);
 
-    return count > 0;
+////////////////////////////////////////////////////////////
+void SocketSelector::setStatisticsEnabled(bool enabled)
+{
+    if (!enabled)
+        m_impl->statistics.reset();
+    else if (!m_impl->statistics)
+        m_impl->statistics.emplace();
 }
 
 
 ////////////////////////////////////////////////////////////
-bool SocketSelector::isReady(Socket& socket) const
+bool SocketSelector::isStatisticsEnabled() const
 {
-    const SocketHandle handle = socket.getNativeHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
-    {
-
-#if !defined(SFML_SYSTEM_WINDOWS)
+    return m_impl->statistics.has_value();
+}
 
-        if (handle >= FD_SETSIZE)
-            return false;
 
-#endif
+////////////////////////////////////////////////////////////
+SocketSelector::Statistics SocketSelector::getStatistics() const
+{
+    return m_impl->statistics.value_or(Statistics());
+}
 
-        return FD_ISSET(handle, &m_impl->socketsReady) != 0;
-    }
 
-    return false;
+////////////////////////////////////////////////////////////
+void SocketSelector::resetStatistics()
+{
+    if (m_impl->statistics)
+        *m_impl->statistics = Statistics();
 }
 
 } // namespace sf
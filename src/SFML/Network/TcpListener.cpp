@@ -48,11 +48,11 @@ unsigned short TcpListener::getLocalPort() const
     if (getNativeHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve information about the local end of the socket
-        sockaddr_in                  address{};
+        sockaddr_storage             address{};
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -63,20 +63,59 @@ unsigned short TcpListener::getLocalPort() const
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpListener::listen(unsigned short port, const IpAddress& address)
+{
+    return listen(port, address, ListenOptions());
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListener::listen(unsigned short port, const IpAddress& address, const ListenOptions& options)
 {
     // Close the socket if it is already bound
     close();
 
     // Create the internal socket if it doesn't exist
-    create();
+    create(address.getType());
 
     // Check if the address is valid
     if (address == IpAddress::Broadcast)
         return Status::Error;
 
+    // IPv6 listeners accept IPv4 connections too, unless disabled
+    if ((address.getType() == IpAddress::Type::IpV6) && options.ipV6Only)
+    {
+        int yes = 1;
+        if (setsockopt(getNativeHandle(), IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
+        {
+            err() << "Failed to restrict listener socket to IPv6" << std::endl;
+            return Status::Error;
+        }
+    }
+
+    // Share the port with the other listeners, before binding
+    if (options.reusePort)
+    {
+#if defined(SO_REUSEPORT_LB)
+        // FreeBSD only balances connections between the sockets with this variant
+        const int option = SO_REUSEPORT_LB;
+#elif defined(SO_REUSEPORT)
+        const int option = SO_REUSEPORT;
+#else
+        const int option = -1;
+#endif
+        int yes = 1;
+        if ((option == -1) ||
+            (setsockopt(getNativeHandle(), SOL_SOCKET, option, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1))
+        {
+            err() << "Failed to share port " << port << " with other listeners" << std::endl;
+            return Status::Error;
+        }
+    }
+
     // Bind the socket to the specified port
-    sockaddr_in addr = priv::SocketImpl::createAddress(address.toInteger(), port);
-    if (bind(getNativeHandle(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1)
+    sockaddr_storage                   addr{};
+    const priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(address, port, addr);
+    if (bind(getNativeHandle(), reinterpret_cast<sockaddr*>(&addr), length) == -1)
     {
         // Not likely to happen, but...
         err() << "Failed to bind listener socket to port " << port << std::endl;
@@ -84,7 +123,7 @@ Socket::Status TcpListener::listen(unsigned short port, const IpAddress& address
     }
 
     // Listen to the bound port
-    if (::listen(getNativeHandle(), SOMAXCONN) == -1)
+    if (::listen(getNativeHandle(), options.backlog > 0 ? options.backlog : SOMAXCONN) == -1)
     {
         // Oops, socket is deaf
         err() << "Failed to listen to port " << port << std::endl;
@@ -113,20 +152,47 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
         return Status::Error;
     }
 
-    // Accept a new connection
-    sockaddr_in                  address{};
-    priv::SocketImpl::AddrLength length = sizeof(address);
-    const SocketHandle           remote = ::accept(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &length);
+    // Accept a new connection, already in the blocking state of the socket
+    const SocketHandle remote = priv::SocketImpl::accept(getNativeHandle(), socket.isBlocking());
 
     // Check for errors
     if (remote == priv::SocketImpl::invalidSocket())
         return priv::SocketImpl::getErrorStatus();
 
-    // Initialize the new connected socket
-    socket.close();
-    socket.create(remote);
+    // Initialize the new connected socket, forgetting any data left from a previous connection
+    socket.disconnect();
+    socket.create(remote, true);
 
     return Status::Done;
 }
 
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListener::acceptAll(std::vector<TcpSocket>& sockets, std::size_t maxCount, bool blocking)
+{
+    Status      status = Status::Done;
+    std::size_t count  = 0;
+
+    while (count < maxCount)
+    {
+        // After the first connection, only take the ones that are already pending
+        if ((count > 0) && isBlocking() && !priv::SocketImpl::isReadable(getNativeHandle()))
+            break;
+
+        TcpSocket& socket = sockets.emplace_back();
+        socket.setBlocking(blocking);
+
+        status = accept(socket);
+        if (status != Status::Done)
+        {
+            sockets.pop_back();
+            break;
+        }
+
+        ++count;
+    }
+
+    return (count > 0) ? Status::Done : status;
+}
+
 } // namespace sf
@@ -26,16 +26,26 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Lz4.hpp>
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpSocket.hpp>
 
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Utils.hpp>
 
 #include <algorithm>
 #include <array>
+#include <memory>
 #include <ostream>
+#include <typeinfo>
+#include <utility>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 
 #ifdef _MSC_VER
@@ -51,6 +61,36 @@ const int flags = MSG_NOSIGNAL;
 #else
 const int flags = 0;
 #endif
+
+// Largest amount of memory allocated for an incoming packet before its data has actually arrived
+constexpr std::size_t maxBlindAllocation = 1024 * 1024;
+
+// Close the files opened by sendFile
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+// Size of the buffer that data is received into when reading packets
+constexpr std::size_t receiveBufferSize = 64 * 1024;
+
+// Time given to a connection attempt before starting the next one, recommended by RFC 8305
+constexpr sf::Time connectionAttemptDelay = sf::milliseconds(250);
+
+// Highest bit of the size prefix of a packet, set when compression is enabled and the packet is compressed
+constexpr std::uint32_t compressedFlag = 0x80000000;
+
+// Size of the header of compressed packets, which holds their original size
+constexpr std::size_t compressedHeaderSize = sizeof(std::uint32_t);
+
+// Largest part of the dictionary that compressed data can refer to
+constexpr std::size_t maxDictionarySize = 64 * 1024;
+
+// Largest compression ratio of the LZ4 block format, which bounds the size announced by compressed packets
+constexpr std::size_t maxCompressionRatio = 255;
 } // namespace
 
 namespace sf
@@ -67,11 +107,11 @@ unsigned short TcpSocket::getLocalPort() const
     if (getNativeHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve information about the local end of the socket
-        sockaddr_in                  address{};
+        sockaddr_storage             address{};
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -86,11 +126,11 @@ std::optional<IpAddress> TcpSocket::getRemoteAddress() const
     if (getNativeHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve information about the remote end of the socket
-        sockaddr_in                  address{};
+        sockaddr_storage             address{};
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return IpAddress(ntohl(address.sin_addr.s_addr));
+            return priv::SocketImpl::getAddress(address);
         }
     }
 
@@ -105,11 +145,11 @@ unsigned short TcpSocket::getRemotePort() const
     if (getNativeHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve information about the remote end of the socket
-        sockaddr_in                  address{};
+        sockaddr_storage             address{};
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -125,17 +165,18 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
     disconnect();
 
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress.getType());
 
     // Create the remote address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage                   address{};
+    const priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(remoteAddress, remotePort, address);
 
     if (timeout <= Time::Zero)
     {
         // ----- We're not using a timeout: just try to connect -----
 
         // Connect the socket
-        if (::connect(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+        if (::connect(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
             return priv::SocketImpl::getErrorStatus();
 
         // Connection succeeded
@@ -153,7 +194,7 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
             setBlocking(false);
 
         // Try to connect to the remote address
-        if (::connect(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) >= 0)
+        if (::connect(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), length) >= 0)
         {
             // We got instantly connected! (it may no happen a lot...)
             setBlocking(blocking);
@@ -211,14 +252,134 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::connect(const std::vector<IpAddress>& remoteAddresses,
+                                  unsigned short                remotePort,
+                                  Time                          timeout)
+{
+    // Disconnect the socket if it is already connected
+    disconnect();
+
+    if (remoteAddresses.empty())
+        return Status::Error;
+
+    // Alternate between the two versions, starting with the version of the first address
+    std::vector<IpAddress> preferred;
+    std::vector<IpAddress> others;
+    for (const IpAddress& address : remoteAddresses)
+        (address.getType() == remoteAddresses.front().getType() ? preferred : others).push_back(address);
+
+    std::vector<IpAddress> addresses;
+    for (std::size_t i = 0; i < std::max(preferred.size(), others.size()); ++i)
+    {
+        if (i < preferred.size())
+            addresses.push_back(preferred[i]);
+        if (i < others.size())
+            addresses.push_back(others[i]);
+    }
+
+    // Race the attempts: the sockets must not move while they are in the selector
+    std::vector<TcpSocket> attempts;
+    attempts.reserve(addresses.size());
+    SocketSelector selector;
+    const Clock    clock;
+    TcpSocket*     connected = nullptr;
+    std::size_t    next      = 0;
+    std::size_t    pending   = 0;
+    Status         status    = Status::Error;
+
+    while (!connected && ((next < addresses.size()) || (pending > 0)))
+    {
+        // Start the next attempt, after the previous one failed or took too long
+        if (next < addresses.size())
+        {
+            TcpSocket& attempt = attempts.emplace_back();
+            attempt.setBlocking(false);
+
+            status = attempt.connect(addresses[next++], remotePort);
+            if (status == Status::Done)
+            {
+                connected = &attempt;
+                break;
+            }
+
+            if (status == Status::NotReady)
+            {
+                selector.add(attempt, SocketSelector::Interest::Send);
+                ++pending;
+            }
+        }
+
+        if (pending == 0)
+            continue;
+
+        // Wait for an attempt to complete, or for the time to start the next one
+        Time wait = (next < addresses.size()) ? connectionAttemptDelay : Time::Zero;
+        if (timeout > Time::Zero)
+        {
+            const Time remaining = timeout - clock.getElapsedTime();
+            if (remaining <= Time::Zero)
+            {
+                status = Status::NotReady;
+                break;
+            }
+
+            wait = (wait == Time::Zero) ? remaining : std::min(wait, remaining);
+        }
+
+        if (!selector.wait(wait))
+            continue;
+
+        for (TcpSocket& attempt : attempts)
+        {
+            if ((attempt.getNativeHandle() == priv::SocketImpl::invalidSocket()) || !selector.isReadyToSend(attempt))
+                continue;
+
+            selector.remove(attempt);
+            --pending;
+
+            // The attempt succeeded if the socket has a peer
+            if (attempt.getRemoteAddress().has_value())
+            {
+                connected = &attempt;
+                break;
+            }
+
+            status = priv::SocketImpl::getErrorStatus();
+            attempt.disconnect();
+        }
+    }
+
+    if (!connected)
+        return status;
+
+    // Take over the connection of the successful attempt, the other attempts are closed with their socket.
+    // Only the handle moves: the options of this socket, such as packet compression, and its statistics are kept
+    takeHandle(*connected);
+
+    return Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::connect(std::string_view remoteHost, unsigned short remotePort, Time timeout)
+{
+    return connect(IpAddress::resolveAll(remoteHost), remotePort, timeout);
+}
+
+
 ////////////////////////////////////////////////////////////
 void TcpSocket::disconnect()
 {
     // Close the socket
     close();
 
-    // Reset the pending packet data
+    // Reset the pending packet data and the buffered data
     m_pendingPacket = PendingPacket();
+    m_receiveBegin  = 0;
+    m_receiveEnd    = 0;
+    m_sendQueue.clear();
+    m_sendQueueSent = 0;
 }
 
 
@@ -261,12 +422,78 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t&
         if (result < 0)
         {
             const Status status = priv::SocketImpl::getErrorStatus();
+            recordSend(status, size - sent, 0);
 
             if ((status == Status::NotReady) && sent)
                 return Status::Partial;
 
             return status;
         }
+
+        recordSend(Status::Done, size - sent, static_cast<std::size_t>(result));
+    }
+
+    return Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::sendFile(const std::filesystem::path& filename,
+                                   std::uint64_t                offset,
+                                   std::size_t                  size,
+                                   std::size_t&                 sent)
+{
+    sent = 0;
+
+#ifdef SFML_SYSTEM_WINDOWS
+    const std::unique_ptr<std::FILE, FileCloser> file(_wfopen(filename.c_str(), L"rb"));
+#else
+    const std::unique_ptr<std::FILE, FileCloser> file(std::fopen(filename.c_str(), "rb"));
+#endif
+    if (!file)
+    {
+        err() << "Failed to open file for sending\n" << formatDebugPathInfo(filename) << std::endl;
+        return Status::Error;
+    }
+
+    return sendFile(*file, offset, size, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::sendFile(std::FILE& file, std::uint64_t offset, std::size_t size, std::size_t& sent)
+{
+    sent = 0;
+
+    // Loop until every byte has been sent
+    while (sent < size)
+    {
+        const std::int64_t result = priv::SocketImpl::sendFile(getNativeHandle(),
+                                                               &file,
+                                                               offset + sent,
+                                                               size - sent,
+                                                               flags);
+
+        // Check for errors
+        if (result < 0)
+        {
+            const Status status = priv::SocketImpl::getErrorStatus();
+            recordSend(status, size - sent, 0);
+
+            if ((status == Status::NotReady) && sent)
+                return Status::Partial;
+
+            return status;
+        }
+
+        if (result == 0)
+        {
+            err() << "Failed to send file (the file is shorter than the range to send)" << std::endl;
+            return Status::Error;
+        }
+
+        recordSend(Status::Done, size - sent, static_cast<std::size_t>(result));
+        sent += static_cast<std::size_t>(result);
     }
 
     return Status::Done;
@@ -286,6 +513,13 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Status::Error;
     }
 
+    // Hand out the data already buffered by a packet reception first
+    if (m_receiveBegin < m_receiveEnd)
+    {
+        received = readReceiveBuffer(data, size);
+        return Status::Done;
+    }
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wuseless-cast"
     // Receive a chunk of bytes
@@ -297,15 +531,19 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
     if (sizeReceived > 0)
     {
         received = static_cast<std::size_t>(sizeReceived);
+        recordReceive(Status::Done, received);
         return Status::Done;
     }
     else if (sizeReceived == 0)
     {
+        recordReceive(Status::Disconnected, 0);
         return Socket::Status::Disconnected;
     }
     else
     {
-        return priv::SocketImpl::getErrorStatus();
+        const Status status = priv::SocketImpl::getErrorStatus();
+        recordReceive(status, 0);
+        return status;
     }
 }
 
@@ -317,117 +555,434 @@ Socket::Status TcpSocket::send(Packet& packet)
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size and the data are handed to the system together in a single
+    // gather write, which avoids copying the packet into a temporary block
+    // while still sending everything with as few calls as possible.
 
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    // Get the data to send from the packet, with its size in network byte order
+    const void*   data       = nullptr;
+    std::size_t   size       = 0;
+    std::uint32_t packetSize = 0;
+    if (!preparePacket(packet, data, size, packetSize))
+        return Status::Error;
 
-    // First convert the packet size to network byte order
-    std::uint32_t packetSize = htonl(static_cast<std::uint32_t>(size));
+    const std::size_t totalSize = sizeof(packetSize) + size;
 
-    // Allocate memory for the data block to send
-    m_blockToSendBuffer.resize(sizeof(packetSize) + size);
+    // Loop until every byte has been sent, resuming after what a previous partial send managed to send
+    std::size_t sent = 0;
+    while (packet.m_sendPos < totalSize)
+    {
+        std::array<priv::SocketImpl::Buffer, 2> buffers{};
+        std::size_t                             count = 0;
 
-// Copy the packet size and data into the block to send
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wnull-dereference" // False positive.
-    std::memcpy(m_blockToSendBuffer.data(), &packetSize, sizeof(packetSize));
-#pragma GCC diagnostic pop
-    if (size > 0)
-        std::memcpy(m_blockToSendBuffer.data() + sizeof(packetSize), data, size);
+        const std::size_t sizeSent = std::min(packet.m_sendPos, sizeof(packetSize));
+        if (sizeSent < sizeof(packetSize))
+            buffers[count++] = {reinterpret_cast<const char*>(&packetSize) + sizeSent, sizeof(packetSize) - sizeSent};
 
-// These warnings are ignored here for portability, as even on Windows the
-// signature of `send` might change depending on whether Win32 or MinGW is
-// being used.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuseless-cast"
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsign-conversion"
-    // Send the data block
-    std::size_t  sent   = 0;
-    const Status status = send(m_blockToSendBuffer.data() + packet.m_sendPos,
-                               static_cast<priv::SocketImpl::Size>(m_blockToSendBuffer.size() - packet.m_sendPos),
-                               sent);
-#pragma GCC diagnostic pop
-#pragma GCC diagnostic pop
+        const std::size_t dataSent = packet.m_sendPos - sizeSent;
+        if (dataSent < size)
+            buffers[count++] = {static_cast<const char*>(data) + dataSent, size - dataSent};
 
-    // In the case of a partial send, record the location to resume from
-    if (status == Status::Partial)
-    {
-        packet.m_sendPos += sent;
-    }
-    else if (status == Status::Done)
-    {
-        packet.m_sendPos = 0;
+        const std::int64_t result = priv::SocketImpl::sendBuffers(getNativeHandle(), buffers.data(), count, flags);
+
+        // Check for errors, recording the location to resume from in the case of a partial send
+        if (result < 0)
+        {
+            const Status status = priv::SocketImpl::getErrorStatus();
+            recordSend(status, totalSize - packet.m_sendPos, 0);
+
+            if ((status == Status::NotReady) && sent)
+                return Status::Partial;
+
+            return status;
+        }
+
+        recordSend(Status::Done, totalSize - packet.m_sendPos, static_cast<std::size_t>(result));
+        sent += static_cast<std::size_t>(result);
+        packet.m_sendPos += static_cast<std::size_t>(result);
     }
 
-    return status;
+    packet.m_sendPos = 0;
+    recordPacketSent(size);
+
+    return Status::Done;
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::receive(Packet& packet)
+{
+    // Data read ahead of the packet would be invisible to the selectors, so only receivePackets buffers
+    return receivePacket(packet, false);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receivePacket(Packet& packet, bool buffered)
 {
     // First clear the variables to fill
     packet.clear();
 
     // We start by getting the size of the incoming packet
-    std::uint32_t packetSize = 0;
-    std::size_t   received   = 0;
-    if (m_pendingPacket.sizeReceived < sizeof(m_pendingPacket.size))
+    // (even a 4 byte variable may be received in more than one call)
+    while (m_pendingPacket.sizeReceived < sizeof(m_pendingPacket.size))
     {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.sizeReceived < sizeof(m_pendingPacket.size))
+        if (buffered && (m_receiveBegin == m_receiveEnd))
         {
-            char*        data   = reinterpret_cast<char*>(&m_pendingPacket.size) + m_pendingPacket.sizeReceived;
-            const Status status = receive(data, sizeof(m_pendingPacket.size) - m_pendingPacket.sizeReceived, received);
-            m_pendingPacket.sizeReceived += received;
-
+            const Status status = fillReceiveBuffer();
             if (status != Status::Done)
                 return status;
         }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.size);
+        // Bytes left in the buffer by receivePackets are taken first
+        char*             data      = reinterpret_cast<char*>(&m_pendingPacket.size) + m_pendingPacket.sizeReceived;
+        const std::size_t sizeToGet = sizeof(m_pendingPacket.size) - m_pendingPacket.sizeReceived;
+        std::size_t       received  = 0;
+        const Status      status    = receive(data, sizeToGet, received);
+        m_pendingPacket.sizeReceived += received;
+
+        if (status != Status::Done)
+            return status;
     }
-    else
+
+    std::size_t packetSize = ntohl(m_pendingPacket.size);
+    bool        compressed = false;
+    if (m_compression.options.enabled)
     {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.size);
+        compressed = (packetSize & compressedFlag) != 0;
+        packetSize &= ~std::size_t{compressedFlag};
     }
 
     // Loop until we receive all the packet data
-    std::array<char, 1024> buffer{};
-    while (m_pendingPacket.data.size() < packetSize)
+    std::vector<std::byte>& storage = m_pendingPacket.data;
+    while (m_pendingPacket.dataReceived < packetSize)
     {
-        // Receive a chunk of data
-        const std::size_t sizeToGet = std::min(packetSize - m_pendingPacket.data.size(), sizeof(buffer));
-        const Status      status    = receive(buffer.data(), sizeToGet, received);
+        // Grow the storage in large steps, without trusting the announced size
+        // for allocations much larger than what the peer actually sent
+        if (storage.size() == m_pendingPacket.dataReceived)
+            storage.resize(std::min(packetSize, std::max(m_pendingPacket.dataReceived * 2, maxBlindAllocation)));
+
+        std::byte* const  data      = storage.data() + m_pendingPacket.dataReceived;
+        const std::size_t sizeToGet = storage.size() - m_pendingPacket.dataReceived;
+
+        // The rest of a small packet is received through the buffer, which also catches
+        // the packets that follow it, while a large one is read directly into its storage
+        if (buffered && (m_receiveBegin == m_receiveEnd) &&
+            (packetSize - m_pendingPacket.dataReceived < receiveBufferSize))
+        {
+            const Status status = fillReceiveBuffer();
+            if (status != Status::Done)
+                return status;
+        }
+
+        std::size_t  received = 0;
+        const Status status   = receive(data, sizeToGet, received);
+        m_pendingPacket.dataReceived += received;
+
         if (status != Status::Done)
             return status;
+    }
 
-        // Append it into the packet
-        if (received > 0)
+    // We have received all the packet data: a plain packet takes the storage over, while
+    // derived packets get the data through onReceive so that they can transform it
+    if (compressed)
+    {
+        if (!decompressPendingPacket())
         {
-            m_pendingPacket.data.resize(m_pendingPacket.data.size() + received);
-            std::byte* begin = m_pendingPacket.data.data() + m_pendingPacket.data.size() - received;
-            std::memcpy(begin, buffer.data(), received);
+            err() << "Failed to decompress a packet received over TCP (corrupted data or different dictionary)"
+                  << std::endl;
+
+            m_pendingPacket.size         = 0;
+            m_pendingPacket.sizeReceived = 0;
+            m_pendingPacket.dataReceived = 0;
+            storage.clear();
+            return Status::Error;
         }
+
+        // The decompressed data follows the dictionary
+        std::vector<std::byte>& decompressed   = m_compression.decompressed;
+        const std::size_t       dictionarySize = m_compression.options.dictionary.size();
+        if ((typeid(packet) == typeid(Packet)) && (dictionarySize == 0))
+            std::swap(packet.m_data, decompressed);
+        else if (decompressed.size() > dictionarySize)
+            packet.onReceive(decompressed.data() + dictionarySize, decompressed.size() - dictionarySize);
+    }
+    else if (typeid(packet) == typeid(Packet))
+    {
+        std::swap(packet.m_data, storage);
+    }
+    else if (!storage.empty())
+    {
+        packet.onReceive(storage.data(), storage.size());
     }
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.data.empty())
-        packet.onReceive(m_pendingPacket.data.data(), m_pendingPacket.data.size());
+    recordPacketReceived(packetSize);
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Clear the pending packet, keeping its storage allocated for the next one
+    m_pendingPacket.size         = 0;
+    m_pendingPacket.sizeReceived = 0;
+    m_pendingPacket.dataReceived = 0;
+    storage.clear();
 
     return Status::Done;
 }
 
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receivePackets(std::vector<Packet>& packets)
+{
+    // The first packet may require waiting for the system
+    Packet       packet;
+    const Status status = receivePacket(packet, true);
+    if (status != Status::Done)
+        return status;
+
+    packets.push_back(std::move(packet));
+
+    // The next ones are taken as long as they are complete in the receive buffer
+    std::uint32_t packetSize = 0;
+    while (m_receiveEnd - m_receiveBegin >= sizeof(packetSize))
+    {
+        std::memcpy(&packetSize, m_receiveBuffer.data() + m_receiveBegin, sizeof(packetSize));
+        std::size_t size = ntohl(packetSize);
+        if (m_compression.options.enabled)
+            size &= ~std::size_t{compressedFlag};
+
+        if (m_receiveEnd - m_receiveBegin - sizeof(packetSize) < size)
+            break;
+
+        // This can't block since the whole packet is buffered, and only fails if it can't be decompressed
+        if (receivePacket(packet, true) != Status::Done)
+            return Status::Error;
+
+        packets.push_back(std::move(packet));
+    }
+
+    return Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::queue(Packet& packet)
+{
+    // Get the data to send from the packet, with its size in network byte order
+    const void*   data       = nullptr;
+    std::size_t   size       = 0;
+    std::uint32_t packetSize = 0;
+    if (!preparePacket(packet, data, size, packetSize))
+        return;
+
+    // Forget what was already sent before it makes up most of the queue
+    if (m_sendQueueSent > m_sendQueue.size() / 2)
+    {
+        m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + static_cast<std::ptrdiff_t>(m_sendQueueSent));
+        m_sendQueueSent = 0;
+    }
+
+    // Append the size, then the data
+    const auto* sizeBytes = reinterpret_cast<const std::byte*>(&packetSize);
+    m_sendQueue.insert(m_sendQueue.end(), sizeBytes, sizeBytes + sizeof(packetSize));
+
+    if (size > 0)
+    {
+        const auto* dataBytes = static_cast<const std::byte*>(data);
+        m_sendQueue.insert(m_sendQueue.end(), dataBytes, dataBytes + size);
+    }
+
+    recordPacketSent(size);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::flush()
+{
+    if (m_sendQueueSent == m_sendQueue.size())
+        return Status::Done;
+
+    // Send the whole queue at once
+    std::size_t  sent   = 0;
+    const Status status = send(m_sendQueue.data() + m_sendQueueSent, m_sendQueue.size() - m_sendQueueSent, sent);
+    m_sendQueueSent += sent;
+
+    if (status == Status::Done)
+    {
+        m_sendQueue.clear();
+        m_sendQueueSent = 0;
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getSendQueueSize() const
+{
+    return m_sendQueue.size() - m_sendQueueSent;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::setPacketCompression(PacketCompression compression)
+{
+    std::vector<std::byte>& dictionary = compression.dictionary;
+    if (dictionary.size() > maxDictionarySize)
+        dictionary.erase(dictionary.begin(), dictionary.end() - static_cast<std::ptrdiff_t>(maxDictionarySize));
+
+    // The buffers always start with the dictionary, which compressed data refers to
+    m_compression.options      = std::move(compression);
+    m_compression.input        = m_compression.options.dictionary;
+    m_compression.decompressed = m_compression.options.dictionary;
+    m_compression.sending      = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+const TcpSocket::PacketCompression& TcpSocket::getPacketCompression() const
+{
+    return m_compression.options;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<Time> TcpSocket::getRoundTripTime() const
+{
+#if defined(TCP_INFO) && (defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID) || defined(SFML_SYSTEM_FREEBSD))
+    tcp_info                     info{};
+    priv::SocketImpl::AddrLength size = sizeof(info);
+    if (getsockopt(getNativeHandle(), IPPROTO_TCP, TCP_INFO, &info, &size) == -1)
+        return std::nullopt;
+
+    // The estimate is reported in microseconds, and stays at zero until the first acknowledgment
+    if (info.tcpi_rtt == 0)
+        return std::nullopt;
+
+    return microseconds(static_cast<std::int64_t>(info.tcpi_rtt));
+#else
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::fillReceiveBuffer()
+{
+    // The buffer is allocated on first use, sockets that never receive packets don't pay for it
+    if (m_receiveBuffer.empty())
+        m_receiveBuffer.resize(receiveBufferSize);
+
+    m_receiveBegin = 0;
+    m_receiveEnd   = 0;
+
+    std::size_t  received = 0;
+    const Status status   = receive(m_receiveBuffer.data(), m_receiveBuffer.size(), received);
+    m_receiveEnd          = received;
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::readReceiveBuffer(void* data, std::size_t size)
+{
+    const std::size_t count = std::min(size, m_receiveEnd - m_receiveBegin);
+    if (count > 0)
+        std::memcpy(data, m_receiveBuffer.data() + m_receiveBegin, count);
+
+    m_receiveBegin += count;
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::preparePacket(Packet& packet, const void*& data, std::size_t& size, std::uint32_t& packetSize)
+{
+    CompressionState& compression = m_compression;
+
+    // A compressed packet partially sent is resumed from its compressed data, rather than compressed again
+    if (compression.options.enabled && (packet.m_sendPos > 0) && (compression.sending == &packet))
+    {
+        data       = compression.output.data();
+        size       = compression.output.size();
+        packetSize = htonl(static_cast<std::uint32_t>(size) | compressedFlag);
+        return true;
+    }
+
+    data       = packet.onSend(size);
+    packetSize = htonl(static_cast<std::uint32_t>(size));
+
+    if (!compression.options.enabled)
+        return true;
+
+    if (size >= compressedFlag)
+    {
+        err() << "Cannot send packet with compression enabled: packet size (" << size
+              << " bytes) is greater than the maximum allowed (" << compressedFlag - 1 << " bytes)" << std::endl;
+        return false;
+    }
+
+    if ((size < compression.options.threshold) || (size <= compressedHeaderSize + 1))
+        return true;
+
+    // The output buffer is about to be overwritten
+    compression.sending = nullptr;
+
+    // With a dictionary, the data must follow it in memory
+    const auto*       input          = static_cast<const std::byte*>(data);
+    const std::size_t dictionarySize = compression.options.dictionary.size();
+    if (dictionarySize > 0)
+    {
+        compression.input.resize(dictionarySize);
+        compression.input.insert(compression.input.end(), input, input + size);
+        input = compression.input.data();
+    }
+
+    // Keep the packet uncompressed unless compression makes it smaller, header included
+    const std::size_t capacity = size - compressedHeaderSize - 1;
+    compression.output.resize(compressedHeaderSize + capacity);
+    const std::size_t compressedSize = priv::Lz4::compress(input,
+                                                           dictionarySize,
+                                                           size,
+                                                           compression.output.data() + compressedHeaderSize,
+                                                           capacity);
+    if (compressedSize == 0)
+        return true;
+
+    const std::uint32_t originalSize = htonl(static_cast<std::uint32_t>(size));
+    std::memcpy(compression.output.data(), &originalSize, sizeof(originalSize));
+    compression.output.resize(compressedHeaderSize + compressedSize);
+    compression.sending = &packet;
+
+    data       = compression.output.data();
+    size       = compression.output.size();
+    packetSize = htonl(static_cast<std::uint32_t>(size) | compressedFlag);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::decompressPendingPacket()
+{
+    const std::vector<std::byte>& storage = m_pendingPacket.data;
+    if (storage.size() < compressedHeaderSize)
+        return false;
+
+    std::uint32_t originalSize = 0;
+    std::memcpy(&originalSize, storage.data(), sizeof(originalSize));
+    originalSize = ntohl(originalSize);
+
+    // Don't trust sizes that the data can't decompress to
+    const std::size_t compressedSize = storage.size() - compressedHeaderSize;
+    if (originalSize > compressedSize * maxCompressionRatio)
+        return false;
+
+    const std::size_t dictionarySize = m_compression.options.dictionary.size();
+    m_compression.decompressed.resize(dictionarySize + originalSize);
+
+    return priv::Lz4::decompress(storage.data() + compressedHeaderSize,
+                                 compressedSize,
+                                 m_compression.decompressed.data(),
+                                 dictionarySize,
+                                 originalSize);
+}
+
 } // namespace sf
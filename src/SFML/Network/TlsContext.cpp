@@ -0,0 +1,337 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TlsContext.hpp>
+#include <SFML/Network/TlsContextImpl.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#ifdef SFML_USE_OPENSSL
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+#include <climits>
+
+
+namespace
+{
+#ifdef SFML_USE_OPENSSL
+// Number of servers whose last session is kept by a client context
+constexpr std::size_t maxCachedSessions = 256;
+
+
+////////////////////////////////////////////////////////////
+// Read PEM data from memory
+std::unique_ptr<BIO, decltype(&BIO_free)> openPem(std::string_view pem)
+{
+    return {BIO_new_mem_buf(pem.data(), static_cast<int>(std::min(pem.size(), std::size_t{INT_MAX}))), &BIO_free};
+}
+
+
+////////////////////////////////////////////////////////////
+// Create an OpenSSL context with the settings common to both sides
+SSL_CTX* createContext(const SSL_METHOD* method)
+{
+    SSL_CTX* context = SSL_CTX_new(method);
+    if (!context)
+        return nullptr;
+
+    // Older versions of the protocol are deprecated
+    SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION);
+
+    // Let writes return after each record, and be resumed from a buffer that moved meanwhile
+    SSL_CTX_set_mode(context, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+    return context;
+}
+#endif
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TlsContext::TlsContextImpl::~TlsContextImpl()
+{
+#ifdef SFML_USE_OPENSSL
+    for (auto& [key, session] : sessions)
+        SSL_SESSION_free(session);
+
+    SSL_CTX_free(context);
+#endif
+}
+
+
+#ifdef SFML_USE_OPENSSL
+////////////////////////////////////////////////////////////
+void TlsContext::TlsContextImpl::storeSession(const std::string& key, SSL_SESSION* session)
+{
+    const std::lock_guard lock(mutex);
+
+    const auto [it, added] = sessions.try_emplace(key, session);
+    if (!added)
+    {
+        SSL_SESSION_free(it->second);
+        it->second = session;
+    }
+    else if (sessions.size() > maxCachedSessions)
+    {
+        // Make room by forgetting another server
+        const auto victim = (sessions.begin() != it) ? sessions.begin() : std::next(sessions.begin());
+        SSL_SESSION_free(victim->second);
+        sessions.erase(victim);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsContext::TlsContextImpl::resumeSession(SSL* ssl, const std::string& key)
+{
+    const std::lock_guard lock(mutex);
+
+    const auto it = sessions.find(key);
+    if ((it != sessions.end()) && SSL_SESSION_is_resumable(it->second))
+        SSL_set_session(ssl, it->second);
+}
+
+
+////////////////////////////////////////////////////////////
+int TlsContext::TlsContextImpl::storeNewSession(SSL* ssl, SSL_SESSION* session)
+{
+    // The sockets point their connection to the key of their server
+    auto*       impl = static_cast<TlsContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    const auto* key  = static_cast<const std::string*>(SSL_get_app_data(ssl));
+    if (!impl || !key || key->empty())
+        return 0;
+
+    impl->storeSession(*key, session);
+    return 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string TlsContext::TlsContextImpl::getLastError()
+{
+    std::string description;
+    while (const unsigned long error = ERR_get_error())
+    {
+        std::array<char, 256> buffer{};
+        ERR_error_string_n(error, buffer.data(), buffer.size());
+
+        if (!description.empty())
+            description += "; ";
+
+        description += buffer.data();
+    }
+
+    return description.empty() ? "unknown error" : description;
+}
+#endif
+
+
+////////////////////////////////////////////////////////////
+std::optional<TlsContext> TlsContext::createClient()
+{
+#ifdef SFML_USE_OPENSSL
+    auto impl     = std::make_shared<TlsContextImpl>();
+    impl->context = createContext(TLS_client_method());
+    if (!impl->context)
+    {
+        err() << "Failed to create TLS client context: " << TlsContextImpl::getLastError() << std::endl;
+        return std::nullopt;
+    }
+
+    // Authenticate the servers with the certificate authorities of the system
+    SSL_CTX_set_verify(impl->context, SSL_VERIFY_PEER, nullptr);
+    if (SSL_CTX_set_default_verify_paths(impl->context) != 1)
+    {
+        err() << "Failed to load the certificate authorities of the system: " << TlsContextImpl::getLastError()
+              << std::endl;
+    }
+
+    // Keep the sessions in our own cache, which is indexed by server rather than by session
+    SSL_CTX_set_app_data(impl->context, impl.get());
+    SSL_CTX_set_session_cache_mode(impl->context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(impl->context, &TlsContextImpl::storeNewSession);
+
+    return TlsContext(std::move(impl));
+#else
+    err() << "Failed to create TLS client context: SFML was built without TLS support" << std::endl;
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<TlsContext> TlsContext::createServer(std::string_view certificateChain, std::string_view privateKey)
+{
+#ifdef SFML_USE_OPENSSL
+    auto impl     = std::make_shared<TlsContextImpl>();
+    impl->context = createContext(TLS_server_method());
+    impl->server  = true;
+    if (!impl->context)
+    {
+        err() << "Failed to create TLS server context: " << TlsContextImpl::getLastError() << std::endl;
+        return std::nullopt;
+    }
+
+    // The first certificate is the one of the server, the next ones lead to a trusted authority
+    const auto certificates = openPem(certificateChain);
+    X509*      certificate  = PEM_read_bio_X509(certificates.get(), nullptr, nullptr, nullptr);
+    const bool used         = certificate && (SSL_CTX_use_certificate(impl->context, certificate) == 1);
+    X509_free(certificate);
+    if (!used)
+    {
+        err() << "Failed to load the TLS server certificate: " << TlsContextImpl::getLastError() << std::endl;
+        return std::nullopt;
+    }
+
+    while (X509* intermediate = PEM_read_bio_X509(certificates.get(), nullptr, nullptr, nullptr))
+    {
+        if (SSL_CTX_add0_chain_cert(impl->context, intermediate) != 1)
+            X509_free(intermediate);
+    }
+
+    // Reading until the end of the chain leaves an error behind
+    ERR_clear_error();
+
+    const auto key     = openPem(privateKey);
+    EVP_PKEY*  pkey    = PEM_read_bio_PrivateKey(key.get(), nullptr, nullptr, nullptr);
+    const bool matches = pkey && (SSL_CTX_use_PrivateKey(impl->context, pkey) == 1) &&
+                         (SSL_CTX_check_private_key(impl->context) == 1);
+    EVP_PKEY_free(pkey);
+    if (!matches)
+    {
+        err() << "Failed to load the TLS server private key: " << TlsContextImpl::getLastError() << std::endl;
+        return std::nullopt;
+    }
+
+    // Sessions are resumed with the tickets issued to the clients, which requires a session context
+    static constexpr std::array<unsigned char, 4> sessionContext{'s', 'f', 'm', 'l'};
+    SSL_CTX_set_session_id_context(impl->context, sessionContext.data(), sessionContext.size());
+
+    return TlsContext(std::move(impl));
+#else
+    static_cast<void>(certificateChain);
+    static_cast<void>(privateKey);
+
+    err() << "Failed to create TLS server context: SFML was built without TLS support" << std::endl;
+    return std::nullopt;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+TlsContext::TlsContext(std::shared_ptr<TlsContextImpl> impl) : m_impl(std::move(impl))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TlsContext::~TlsContext() = default;
+
+
+////////////////////////////////////////////////////////////
+TlsContext::TlsContext(const TlsContext&) = default;
+
+
+////////////////////////////////////////////////////////////
+TlsContext& TlsContext::operator=(const TlsContext&) = default;
+
+
+////////////////////////////////////////////////////////////
+TlsContext::TlsContext(TlsContext&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+TlsContext& TlsContext::operator=(TlsContext&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+bool TlsContext::addTrustedCertificates(std::string_view certificates)
+{
+#ifdef SFML_USE_OPENSSL
+    X509_STORE* const store = SSL_CTX_get_cert_store(m_impl->context);
+    const auto        pem   = openPem(certificates);
+
+    std::size_t added = 0;
+    while (X509* certificate = PEM_read_bio_X509(pem.get(), nullptr, nullptr, nullptr))
+    {
+        if (X509_STORE_add_cert(store, certificate) == 1)
+            ++added;
+
+        X509_free(certificate);
+    }
+
+    // Reading until the end of the certificates leaves an error behind
+    ERR_clear_error();
+
+    if (added == 0)
+        err() << "Failed to add trusted certificates to the TLS context (no valid certificate)" << std::endl;
+
+    return added > 0;
+#else
+    static_cast<void>(certificates);
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsContext::setPeerVerification(bool enabled)
+{
+#ifdef SFML_USE_OPENSSL
+    if (!m_impl->server)
+        SSL_CTX_set_verify(m_impl->context, enabled ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, nullptr);
+#else
+    static_cast<void>(enabled);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsContext::clearSessionCache()
+{
+#ifdef SFML_USE_OPENSSL
+    const std::lock_guard lock(m_impl->mutex);
+    for (auto& [key, session] : m_impl->sessions)
+        SSL_SESSION_free(session);
+
+    m_impl->sessions.clear();
+#endif
+}
+
+} // namespace sf
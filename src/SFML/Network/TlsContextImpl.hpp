@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TlsContext.hpp>
+
+#ifdef SFML_USE_OPENSSL
+#include <openssl/ssl.h>
+#endif
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Implementation of sf::TlsContext, shared with sf::TlsSocket
+///
+////////////////////////////////////////////////////////////
+struct TlsContext::TlsContextImpl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TlsContextImpl();
+
+#ifdef SFML_USE_OPENSSL
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep the session of a connection, to resume it later
+    ///
+    /// \param key     Server that the session was negotiated with
+    /// \param session Session, which the cache takes ownership of
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeSession(const std::string& key, SSL_SESSION* session);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a new connection resume the last session with a server, if any
+    ///
+    /// \param ssl Connection that didn't start its handshake yet
+    /// \param key Server that the connection is established with
+    ///
+    ////////////////////////////////////////////////////////////
+    void resumeSession(SSL* ssl, const std::string& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called by OpenSSL when a client connection gets a session that can be resumed later
+    ///
+    /// \param ssl     Connection that negotiated the session
+    /// \param session New session
+    ///
+    /// \return 1 if the cache took ownership of the session, 0 otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static int storeNewSession(SSL* ssl, SSL_SESSION* session);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Describe the last errors of the calling thread, and clear them
+    ///
+    /// \return Description of the errors
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] static std::string getLastError();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SSL_CTX*                                      context{}; //!< Configuration of the connections
+    bool                                          server{};  //!< Is it the context of the server side?
+    std::mutex                                    mutex;     //!< Protects the sessions
+    std::unordered_map<std::string, SSL_SESSION*> sessions;  //!< Last session negotiated with each server
+#endif
+};
+
+} // namespace sf
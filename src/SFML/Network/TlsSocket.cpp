@@ -0,0 +1,701 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsContextImpl.hpp>
+#include <SFML/Network/TlsSocket.hpp>
+
+#include <SFML/System/Err.hpp>
+
+#ifdef SFML_USE_OPENSSL
+#include <openssl/err.h>
+#include <openssl/x509v3.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace
+{
+// Largest amount of memory allocated for an incoming packet before its data has actually arrived
+constexpr std::size_t maxBlindAllocation = 1024 * 1024;
+
+// Largest amount of data carried by a TLS record
+constexpr std::size_t maxRecordSize = 16 * 1024;
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct TlsSocket::TlsSocketImpl
+{
+    struct PendingPacket
+    {
+        std::uint32_t          size{};         //!< Data of packet size
+        std::size_t            sizeReceived{}; //!< Number of size bytes received so far
+        std::vector<std::byte> data;           //!< Data of the packet
+        std::size_t            dataReceived{}; //!< Number of data bytes received so far
+    };
+
+    explicit TlsSocketImpl(std::shared_ptr<TlsContext::TlsContextImpl> contextImpl) : context(std::move(contextImpl))
+    {
+    }
+
+    TlsSocketImpl(const TlsSocketImpl&)            = delete;
+    TlsSocketImpl& operator=(const TlsSocketImpl&) = delete;
+
+    ~TlsSocketImpl()
+    {
+        // Sessions of connections that were not closed properly can't be resumed
+        shutdown();
+        release();
+    }
+
+#ifdef SFML_USE_OPENSSL
+    ////////////////////////////////////////////////////////////
+    // Send encrypted data through the TCP socket, for OpenSSL
+    static int writeTransport(BIO* bio, const char* data, std::size_t size, std::size_t* written)
+    {
+        TlsSocketImpl& impl = *static_cast<TlsSocketImpl*>(BIO_get_data(bio));
+        BIO_clear_retry_flags(bio);
+
+        std::size_t sent = 0;
+        if (size > 0)
+            impl.transportStatus = impl.socket.send(data, size, sent);
+
+        *written = sent;
+        if ((sent > 0) || (size == 0))
+            return 1;
+
+        if (impl.transportStatus == Socket::Status::NotReady)
+            BIO_set_retry_write(bio);
+
+        return 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Receive encrypted data from the TCP socket, for OpenSSL
+    static int readTransport(BIO* bio, char* data, std::size_t size, std::size_t* read)
+    {
+        TlsSocketImpl& impl = *static_cast<TlsSocketImpl*>(BIO_get_data(bio));
+        BIO_clear_retry_flags(bio);
+
+        std::size_t received = 0;
+        impl.transportStatus = impl.socket.receive(data, size, received);
+
+        *read = received;
+        if (impl.transportStatus == Socket::Status::Done)
+            return 1;
+
+        if (impl.transportStatus == Socket::Status::NotReady)
+            BIO_set_retry_read(bio);
+
+        return 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Answer the requests of OpenSSL about the transport
+    static long controlTransport(BIO* /* bio */, int command, long /* argument */, void* /* pointer */)
+    {
+        // Data is never buffered on our side
+        return (command == BIO_CTRL_FLUSH) ? 1 : 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Get the functions connecting OpenSSL to the TCP socket
+    static BIO_METHOD* getTransportMethod()
+    {
+        static const std::unique_ptr<BIO_METHOD, decltype(&BIO_meth_free)> method(
+            []
+            {
+                BIO_METHOD* created = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "sf::TcpSocket");
+                BIO_meth_set_write_ex(created, writeTransport);
+                BIO_meth_set_read_ex(created, readTransport);
+                BIO_meth_set_ctrl(created, controlTransport);
+                return created;
+            }(),
+            &BIO_meth_free);
+
+        return method.get();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Create the TLS connection over the TCP socket
+    bool start(bool client, const std::string& serverName, unsigned short port)
+    {
+        release();
+
+        ssl                  = SSL_new(context->context);
+        BIO* const transport = ssl ? BIO_new(getTransportMethod()) : nullptr;
+        if (!transport)
+        {
+            err() << "Failed to create TLS connection: " << TlsContext::TlsContextImpl::getLastError() << std::endl;
+            release();
+            return false;
+        }
+
+        BIO_set_data(transport, this);
+        BIO_set_init(transport, 1);
+        SSL_set_bio(ssl, transport, transport);
+
+        pendingPacket = PendingPacket();
+        failed        = false;
+
+        if (!client)
+        {
+            SSL_set_accept_state(ssl);
+            return true;
+        }
+
+        SSL_set_connect_state(ssl);
+
+        // Check the certificate against the address of the server, or else against its name
+        // which also tells the server which certificate to present (SSL_set_tlsext_host_name)
+        X509_VERIFY_PARAM* const parameters = SSL_get0_param(ssl);
+        X509_VERIFY_PARAM_set_hostflags(parameters, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
+        if (!serverName.empty() && (X509_VERIFY_PARAM_set1_ip_asc(parameters, serverName.c_str()) != 1))
+        {
+            auto* const name = const_cast<char*>(serverName.c_str());
+            if ((SSL_set1_host(ssl, name) != 1) ||
+                (SSL_ctrl(ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name, name) != 1))
+            {
+                err() << "Failed to set the TLS server name: " << TlsContext::TlsContextImpl::getLastError()
+                      << std::endl;
+                release();
+                return false;
+            }
+        }
+
+        ERR_clear_error();
+
+        // Resume the last session with the same server, and keep the next one (see storeNewSession)
+        sessionKey = serverName + ':' + std::to_string(port);
+        SSL_set_app_data(ssl, &sessionKey);
+        context->resumeSession(ssl, sessionKey);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Convert the result of an OpenSSL call to a status, reporting errors
+    Socket::Status getStatus(int result, const char* operation)
+    {
+        switch (SSL_get_error(ssl, result))
+        {
+            case SSL_ERROR_WANT_READ:
+            case SSL_ERROR_WANT_WRITE:
+                return Socket::Status::NotReady;
+
+            case SSL_ERROR_ZERO_RETURN:
+                return Socket::Status::Disconnected;
+
+            default:
+                break;
+        }
+
+        // No more data can go through the connection once it failed
+        failed = true;
+
+        if ((transportStatus == Socket::Status::Disconnected) || (transportStatus == Socket::Status::Error))
+        {
+            ERR_clear_error();
+            return transportStatus;
+        }
+
+        if (const long verification = SSL_get_verify_result(ssl); verification != X509_V_OK)
+        {
+            ERR_clear_error();
+            err() << operation << ": certificate verification failed ("
+                  << X509_verify_cert_error_string(verification) << ")" << std::endl;
+        }
+        else
+        {
+            err() << operation << ": " << TlsContext::TlsContextImpl::getLastError() << std::endl;
+        }
+
+        return Socket::Status::Error;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Perform the handshake, or continue it
+    Socket::Status handshake()
+    {
+        if (!ssl)
+        {
+            err() << "Cannot perform TLS handshake (the socket is not connected)" << std::endl;
+            return Socket::Status::Error;
+        }
+
+        if (SSL_is_init_finished(ssl))
+            return Socket::Status::Done;
+
+        ERR_clear_error();
+        transportStatus  = Socket::Status::Done;
+        const int result = SSL_do_handshake(ssl);
+        return (result == 1) ? Socket::Status::Done : getStatus(result, "TLS handshake failed");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Encrypt and send data, up to the end of a record
+    Socket::Status write(const void* data, std::size_t size, std::size_t& written)
+    {
+        written = 0;
+        if (!ssl)
+        {
+            err() << "Cannot send data over TLS (the socket is not connected)" << std::endl;
+            return Socket::Status::Error;
+        }
+
+        ERR_clear_error();
+        transportStatus  = Socket::Status::Done;
+        const int result = SSL_write_ex(ssl, data, size, &written);
+        return (result == 1) ? Socket::Status::Done : getStatus(result, "Failed to send data over TLS");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Receive and decrypt data, up to the end of a record
+    Socket::Status read(void* data, std::size_t size, std::size_t& read)
+    {
+        read = 0;
+        if (!ssl)
+        {
+            err() << "Cannot receive data over TLS (the socket is not connected)" << std::endl;
+            return Socket::Status::Error;
+        }
+
+        ERR_clear_error();
+        transportStatus  = Socket::Status::Done;
+        const int result = SSL_read_ex(ssl, data, size, &read);
+        return (result == 1) ? Socket::Status::Done : getStatus(result, "Failed to receive data over TLS");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Tell the peer that the connection is over
+    void shutdown()
+    {
+        if (ssl && !failed && SSL_is_init_finished(ssl))
+        {
+            ERR_clear_error();
+            SSL_shutdown(ssl);
+            ERR_clear_error();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Destroy the TLS connection, with its transport
+    void release()
+    {
+        SSL_free(ssl);
+        ssl = nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isServer() const
+    {
+        return context->server;
+    }
+
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool hasPendingData() const
+    {
+        return ssl && (SSL_pending(ssl) > 0);
+    }
+
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool isSessionResumed() const
+    {
+        return ssl && (SSL_session_reused(ssl) == 1);
+    }
+#else
+    // Sockets can't be constructed without a context, which can't be created without a TLS library
+    bool start(bool, const std::string&, unsigned short)
+    {
+        return false;
+    }
+
+    Socket::Status handshake()
+    {
+        return Socket::Status::Error;
+    }
+
+    Socket::Status write(const void*, std::size_t, std::size_t& written)
+    {
+        written = 0;
+        return Socket::Status::Error;
+    }
+
+    Socket::Status read(void*, std::size_t, std::size_t& read)
+    {
+        read = 0;
+        return Socket::Status::Error;
+    }
+
+    void shutdown()
+    {
+    }
+
+    void release()
+    {
+    }
+
+    [[nodiscard]] bool isServer() const
+    {
+        return false;
+    }
+
+    [[nodiscard]] bool hasPendingData() const
+    {
+        return false;
+    }
+
+    [[nodiscard]] bool isSessionResumed() const
+    {
+        return false;
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::shared_ptr<TlsContext::TlsContextImpl> context;           //!< Configuration of the connection
+    TcpSocket                                   socket;            //!< Socket carrying the encrypted data
+    Socket::Status                              transportStatus{}; //!< Last status of the TCP socket
+    bool                                        failed{};          //!< Did the connection fail for good?
+    std::string                                 sessionKey;        //!< Server of the connection, for the session cache
+    PendingPacket                               pendingPacket;     //!< Temporary data of the packet being received
+    std::vector<std::byte>                      sendBuffer;        //!< Size and beginning of the packet being sent
+#ifdef SFML_USE_OPENSSL
+    SSL* ssl{}; //!< TLS connection
+#endif
+};
+
+
+////////////////////////////////////////////////////////////
+TlsSocket::TlsSocket(const TlsContext& context) : m_impl(std::make_unique<TlsSocketImpl>(context.m_impl))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TlsSocket::~TlsSocket() = default;
+
+
+////////////////////////////////////////////////////////////
+TlsSocket::TlsSocket(TlsSocket&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+TlsSocket& TlsSocket::operator=(TlsSocket&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::connect(std::string_view remoteHost, unsigned short remotePort, Time timeout)
+{
+    return connect(IpAddress::resolveAll(remoteHost), remotePort, remoteHost, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::connect(const std::vector<IpAddress>& remoteAddresses,
+                                  unsigned short                remotePort,
+                                  std::string_view              serverName,
+                                  Time                          timeout)
+{
+    if (m_impl->isServer())
+    {
+        err() << "Cannot connect a TLS socket created with a server context" << std::endl;
+        return Socket::Status::Error;
+    }
+
+    disconnect();
+
+    // A non-blocking connection goes on during the handshake
+    const Socket::Status status = m_impl->socket.connect(remoteAddresses, remotePort, timeout);
+    if ((status != Socket::Status::Done) && (status != Socket::Status::NotReady))
+        return status;
+
+    // Without a name, the server is identified by the address it was reached at
+    std::string name(serverName);
+    if (name.empty())
+    {
+        if (const std::optional<IpAddress> address = m_impl->socket.getRemoteAddress())
+            name = address->toString();
+        else if (!remoteAddresses.empty())
+            name = remoteAddresses.front().toString();
+    }
+
+    if (!m_impl->start(true, name, remotePort))
+    {
+        m_impl->socket.disconnect();
+        return Socket::Status::Error;
+    }
+
+    return (status == Socket::Status::Done) ? handshake() : status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::accept(TcpListener& listener)
+{
+    if (!m_impl->isServer())
+    {
+        err() << "Cannot accept a connection with a TLS socket created with a client context" << std::endl;
+        return Socket::Status::Error;
+    }
+
+    const Socket::Status status = listener.accept(m_impl->socket);
+    if (status != Socket::Status::Done)
+        return status;
+
+    if (!m_impl->start(false, {}, 0))
+    {
+        m_impl->socket.disconnect();
+        return Socket::Status::Error;
+    }
+
+    return handshake();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::handshake()
+{
+    return m_impl->handshake();
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsSocket::disconnect()
+{
+    m_impl->shutdown();
+    m_impl->release();
+    m_impl->socket.disconnect();
+    m_impl->pendingPacket = TlsSocketImpl::PendingPacket();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::send(const void* data, std::size_t size)
+{
+    if (!m_impl->socket.isBlocking())
+        err() << "Warning: Partial sends might not be handled properly." << std::endl;
+
+    std::size_t sent = 0;
+
+    return send(data, size, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::send(const void* data, std::size_t size, std::size_t& sent)
+{
+    sent = 0;
+
+    // Check the parameters
+    if (!data || (size == 0))
+    {
+        err() << "Cannot send data over the network (no data to send)" << std::endl;
+        return Socket::Status::Error;
+    }
+
+    // Loop until every byte has been sent, each call encrypting at least one record
+    while (sent < size)
+    {
+        std::size_t          written = 0;
+        const Socket::Status status  = m_impl->write(static_cast<const char*>(data) + sent, size - sent, written);
+        if (status != Socket::Status::Done)
+            return ((status == Socket::Status::NotReady) && sent) ? Socket::Status::Partial : status;
+
+        sent += written;
+    }
+
+    return Socket::Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::receive(void* data, std::size_t size, std::size_t& received)
+{
+    received = 0;
+
+    // Check the destination buffer
+    if (!data)
+    {
+        err() << "Cannot receive data from the network (the destination buffer is invalid)" << std::endl;
+        return Socket::Status::Error;
+    }
+
+    return m_impl->read(data, size, received);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::send(Packet& packet)
+{
+    // Packets are framed like over a TcpSocket. The size and the beginning of the data are gathered
+    // into a first record, then the rest of the data is encrypted directly from the packet.
+    std::size_t       size = 0;
+    const auto* const data = static_cast<const std::byte*>(packet.onSend(size));
+
+    const std::size_t prefixSize = sizeof(std::uint32_t);
+    const std::size_t headSize   = prefixSize + std::min(size, maxRecordSize - prefixSize);
+    const std::size_t totalSize  = prefixSize + size;
+
+    // Loop until every byte has been sent, resuming after what a previous partial send managed to send
+    std::size_t sent = 0;
+    while (packet.m_sendPos < totalSize)
+    {
+        const std::byte* chunk = nullptr;
+        if (packet.m_sendPos < headSize)
+        {
+            std::vector<std::byte>& head       = m_impl->sendBuffer;
+            const std::uint32_t     packetSize = htonl(static_cast<std::uint32_t>(size));
+            head.resize(headSize);
+            std::memcpy(head.data(), &packetSize, prefixSize);
+            if (headSize > prefixSize)
+                std::memcpy(head.data() + prefixSize, data, headSize - prefixSize);
+
+            chunk = head.data() + packet.m_sendPos;
+        }
+        else
+        {
+            chunk = data + (packet.m_sendPos - prefixSize);
+        }
+
+        const std::size_t    chunkSize = (packet.m_sendPos < headSize ? headSize : totalSize) - packet.m_sendPos;
+        std::size_t          written   = 0;
+        const Socket::Status status    = m_impl->write(chunk, chunkSize, written);
+        if (status != Socket::Status::Done)
+            return ((status == Socket::Status::NotReady) && sent) ? Socket::Status::Partial : status;
+
+        sent += written;
+        packet.m_sendPos += written;
+    }
+
+    packet.m_sendPos = 0;
+
+    return Socket::Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::receive(Packet& packet)
+{
+    // First clear the variables to fill
+    packet.clear();
+
+    // We start by getting the size of the incoming packet
+    TlsSocketImpl::PendingPacket& pending = m_impl->pendingPacket;
+    while (pending.sizeReceived < sizeof(pending.size))
+    {
+        char* const          data     = reinterpret_cast<char*>(&pending.size) + pending.sizeReceived;
+        std::size_t          received = 0;
+        const Socket::Status status   = m_impl->read(data, sizeof(pending.size) - pending.sizeReceived, received);
+        pending.sizeReceived += received;
+
+        if (status != Socket::Status::Done)
+            return status;
+    }
+
+    // Loop until we receive all the packet data, decrypted straight into its storage
+    const std::size_t       packetSize = ntohl(pending.size);
+    std::vector<std::byte>& storage    = pending.data;
+    while (pending.dataReceived < packetSize)
+    {
+        // Grow the storage in large steps, without trusting the announced size
+        // for allocations much larger than what the peer actually sent
+        if (storage.size() == pending.dataReceived)
+            storage.resize(std::min(packetSize, std::max(pending.dataReceived * 2, maxBlindAllocation)));
+
+        std::byte* const     data     = storage.data() + pending.dataReceived;
+        std::size_t          received = 0;
+        const Socket::Status status   = m_impl->read(data, storage.size() - pending.dataReceived, received);
+        pending.dataReceived += received;
+
+        if (status != Socket::Status::Done)
+            return status;
+    }
+
+    // A plain packet takes the storage over, derived packets get the data through onReceive
+    if (typeid(packet) == typeid(Packet))
+        std::swap(packet.m_data, storage);
+    else if (!storage.empty())
+        packet.onReceive(storage.data(), storage.size());
+
+    // Clear the pending packet, keeping its storage allocated for the next one
+    pending.size         = 0;
+    pending.sizeReceived = 0;
+    pending.dataReceived = 0;
+    storage.clear();
+
+    return Socket::Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::hasPendingData() const
+{
+    return m_impl->hasPendingData();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::isSessionResumed() const
+{
+    return m_impl->isSessionResumed();
+}
+
+
+////////////////////////////////////////////////////////////
+TcpSocket& TlsSocket::getTcpSocket()
+{
+    return m_impl->socket;
+}
+
+
+////////////////////////////////////////////////////////////
+const TcpSocket& TlsSocket::getTcpSocket() const
+{
+    return m_impl->socket;
+}
+
+} // namespace sf
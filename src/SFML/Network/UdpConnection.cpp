@@ -0,0 +1,962 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpConnection.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstring>
+
+
+namespace
+{
+// Datagram header: sequence (16 bits), acknowledged sequence (16 bits), acknowledgement bits (32 bits)
+constexpr std::size_t datagramHeaderSize = 8;
+
+// Message header: flags (8 bits), message id (16 bits), size (16 bits)
+// Fragments insert their index (16 bits) and the fragment count (16 bits) before the size
+constexpr std::size_t  messageHeaderSize  = 5;
+constexpr std::size_t  fragmentHeaderSize = 4;
+constexpr std::uint8_t channelMask        = 0x0F;
+constexpr unsigned int deliveryShift      = 4;
+constexpr std::uint8_t deliveryMask       = 0x03;
+constexpr std::uint8_t fragmentFlag       = 0x80;
+
+constexpr std::size_t   maxFragmentCount     = sf::UdpConnection::MaxMessageSize / sf::UdpConnection::MaxFragmentSize;
+// Bytes of incomplete messages kept per connection, so that forged fragments can't exhaust the memory
+constexpr std::size_t   maxReassemblySize    = 4 * sf::UdpConnection::MaxMessageSize;
+constexpr std::size_t   sentHistorySize      = 256;  // Sent datagrams remembered to match acknowledgements
+constexpr std::size_t   sendWindow           = 64;   // Reliable datagrams in flight, well below sentHistorySize
+constexpr std::uint16_t reliableWindow       = 1024; // Reliable messages in flight per channel
+constexpr std::size_t   maxUnreliablePartial = 64;   // Unreliable messages being reassembled per channel
+constexpr std::size_t   ackThreshold         = 32;   // Datagrams received before an acknowledgement is forced
+constexpr std::size_t   receiveBatchSize     = 16;
+
+constexpr sf::Time initialRoundTripTime     = sf::milliseconds(100);
+constexpr sf::Time initialRoundTripVariance = sf::milliseconds(50);
+constexpr sf::Time minResendTimeout         = sf::milliseconds(20);
+constexpr sf::Time maxResendTimeout         = sf::seconds(1);
+constexpr sf::Time keepAliveInterval        = sf::milliseconds(250);
+constexpr sf::Time reassemblyTimeout        = sf::seconds(2);
+
+
+////////////////////////////////////////////////////////////
+// Compare sequence numbers that wrap around
+bool sequenceGreater(std::uint16_t left, std::uint16_t right)
+{
+    return (left != right) && (static_cast<std::uint16_t>(left - right) < 0x8000);
+}
+
+
+////////////////////////////////////////////////////////////
+void writeUint16(std::vector<std::byte>& bytes, std::uint16_t value)
+{
+    bytes.push_back(static_cast<std::byte>(value >> 8));
+    bytes.push_back(static_cast<std::byte>(value));
+}
+
+
+////////////////////////////////////////////////////////////
+void writeUint32(std::vector<std::byte>& bytes, std::uint32_t value)
+{
+    writeUint16(bytes, static_cast<std::uint16_t>(value >> 16));
+    writeUint16(bytes, static_cast<std::uint16_t>(value));
+}
+
+
+////////////////////////////////////////////////////////////
+std::uint16_t readUint16(const std::byte* bytes)
+{
+    const auto high = std::to_integer<unsigned int>(bytes[0]);
+    const auto low  = std::to_integer<unsigned int>(bytes[1]);
+    return static_cast<std::uint16_t>((high << 8) | low);
+}
+
+
+////////////////////////////////////////////////////////////
+std::uint32_t readUint32(const std::byte* bytes)
+{
+    return (std::uint32_t{readUint16(bytes)} << 16) | readUint16(bytes + 2);
+}
+
+
+////////////////////////////////////////////////////////////
+// Message read from a datagram, pointing into the datagram bytes
+struct MessageView
+{
+    std::size_t                 channel{};
+    sf::UdpConnection::Delivery delivery{};
+    std::uint16_t               id{};
+    std::uint16_t               fragmentIndex{};
+    std::uint16_t               fragmentCount{};
+    const std::byte*            data{};
+    std::size_t                 size{};
+};
+
+
+////////////////////////////////////////////////////////////
+// Parse the next message of a datagram, return false if it is malformed
+bool readMessage(const std::byte*& begin, const std::byte* end, MessageView& message)
+{
+    if (static_cast<std::size_t>(end - begin) < messageHeaderSize)
+        return false;
+
+    const auto flags      = std::to_integer<std::uint8_t>(begin[0]);
+    const auto delivery   = static_cast<std::uint8_t>((flags >> deliveryShift) & deliveryMask);
+    const bool fragmented = (flags & fragmentFlag) != 0;
+    if (delivery > static_cast<std::uint8_t>(sf::UdpConnection::Delivery::ReliableOrdered))
+        return false;
+
+    message.channel       = flags & channelMask;
+    message.delivery      = static_cast<sf::UdpConnection::Delivery>(delivery);
+    message.id            = readUint16(begin + 1);
+    message.fragmentIndex = 0;
+    message.fragmentCount = 1;
+    begin += 3;
+
+    if (fragmented)
+    {
+        if (static_cast<std::size_t>(end - begin) < fragmentHeaderSize + 2)
+            return false;
+
+        message.fragmentIndex = readUint16(begin);
+        message.fragmentCount = readUint16(begin + 2);
+        begin += fragmentHeaderSize;
+
+        if ((message.fragmentCount < 2) || (message.fragmentCount > maxFragmentCount) ||
+            (message.fragmentIndex >= message.fragmentCount))
+            return false;
+    }
+
+    message.size = readUint16(begin);
+    message.data = begin + 2;
+    begin += 2;
+
+    // All the fragments but the last one are full
+    const bool isLast = message.fragmentIndex + 1 == message.fragmentCount;
+    if ((message.size > sf::UdpConnection::MaxFragmentSize) ||
+        (!isLast && (message.size != sf::UdpConnection::MaxFragmentSize)) ||
+        (static_cast<std::size_t>(end - begin) < message.size))
+        return false;
+
+    begin += message.size;
+    return true;
+}
+} // namespace
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct UdpConnection::UdpConnectionImpl
+{
+    struct OutgoingFragment
+    {
+        Time lastSent;       //!< Time of the last transmission
+        bool sent{};         //!< Was the fragment transmitted at least once?
+        bool acknowledged{}; //!< Was the fragment acknowledged by the peer?
+    };
+
+    struct OutgoingMessage
+    {
+        std::uint8_t                  channel{};        //!< Channel of the message
+        Delivery                      delivery{};       //!< Delivery guarantees of the message
+        std::uint16_t                 id{};             //!< Identifier of the message in its channel
+        std::vector<std::byte>        data;             //!< Bytes of the message
+        std::vector<OutgoingFragment> fragments;        //!< State of each fragment
+        std::size_t                   unacknowledged{}; //!< Number of fragments not yet acknowledged
+    };
+
+    struct OutgoingChannel
+    {
+        Delivery                    delivery{Delivery::ReliableOrdered}; //!< Delivery guarantees of the channel
+        std::uint16_t               nextReliableId{};                    //!< Identifier of the next reliable message
+        std::uint16_t               nextUnreliableId{};                  //!< Identifier of the next unreliable message
+        std::deque<OutgoingMessage> reliable;                            //!< Unacknowledged messages, by increasing id
+    };
+
+    struct IncomingMessage
+    {
+        std::vector<std::byte> data;        //!< Bytes of the message, filled as fragments arrive
+        std::vector<bool>      received;    //!< Which fragments were received
+        std::size_t            missing{};   //!< Number of fragments not received yet
+        Time                   lastUpdate;  //!< Time at which the last fragment arrived
+        bool                   delivered{}; //!< Was the message already handed to the user?
+    };
+
+    struct IncomingChannel
+    {
+        std::uint16_t                                      nextReliableId{}; //!< Every earlier message was received
+        std::unordered_map<std::uint16_t, IncomingMessage> reliable;         //!< Reliable messages received early
+        std::unordered_map<std::uint16_t, IncomingMessage> unreliable;       //!< Partial unreliable messages
+    };
+
+    struct FragmentReference
+    {
+        std::uint8_t  channel{};  //!< Channel of the message
+        std::uint16_t id{};       //!< Identifier of the message
+        std::uint16_t fragment{}; //!< Index of the fragment in the message
+    };
+
+    struct SentDatagram
+    {
+        std::uint16_t                  sequence{}; //!< Sequence number of the datagram
+        bool                           pending{};  //!< Is the datagram waiting for an acknowledgement?
+        Time                           sendTime;   //!< Time at which the datagram was sent
+        std::vector<FragmentReference> fragments;  //!< Reliable fragments carried by the datagram
+    };
+
+    using DeliveredMessage = std::pair<std::size_t, std::vector<std::byte>>;
+
+    struct DelayedDatagram
+    {
+        Time                   sendTime; //!< Time at which the simulation lets the datagram go
+        std::vector<std::byte> data;     //!< Bytes of the datagram
+    };
+
+    UdpConnectionImpl(UdpSocket& udpSocket, const IpAddress& address, unsigned short port) :
+    socket(&udpSocket),
+    remoteAddress(address),
+    remotePort(port),
+    timeout(seconds(10)),
+    roundTripTime(initialRoundTripTime),
+    roundTripVariance(initialRoundTripVariance)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    Time getResendTimeout() const
+    {
+        return std::clamp(roundTripTime + roundTripVariance * std::int64_t{4}, minResendTimeout, maxResendTimeout);
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::vector<std::byte>& newReadyDatagram()
+    {
+        if (readyCount == ready.size())
+            ready.emplace_back();
+
+        std::vector<std::byte>& datagram = ready[readyCount++];
+        datagram.clear();
+        return datagram;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void transmit(const std::vector<std::byte>& datagram, Time now)
+    {
+        if (!simulation)
+        {
+            newReadyDatagram() = datagram;
+            return;
+        }
+
+        std::uniform_real_distribution<float> probability(0.f, 1.f);
+        if (probability(random) < simulation->packetLoss)
+            return;
+
+        const int copies = (probability(random) < simulation->duplicates) ? 2 : 1;
+        for (int i = 0; i < copies; ++i)
+        {
+            const float jitter = probability(random) * simulation->jitter.asSeconds();
+            const Time  delay  = simulation->latency + seconds(jitter);
+            if (delay > Time::Zero)
+                delayed.push_back({now + delay, datagram});
+            else
+                newReadyDatagram() = datagram;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void beginDatagram(Time now, bool tracked)
+    {
+        const std::uint16_t sequence = localSequence++;
+
+        building.clear();
+        writeUint16(building, sequence);
+        writeUint16(building, remoteSequence);
+        writeUint32(building, remoteAckBits);
+
+        SentDatagram& sent = sentHistory[sequence % sentHistorySize];
+        sent.sequence      = sequence;
+        sent.pending       = tracked;
+        sent.sendTime      = now;
+        sent.fragments.clear();
+        current = &sent;
+
+        if (tracked)
+            ++inFlight;
+
+        // Every datagram acknowledges what was received so far
+        unacknowledged = 0;
+        lastSend       = now;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void endDatagram(Time now)
+    {
+        transmit(building, now);
+        current = nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Check whether a fragment can be sent without exceeding the send window
+    bool canAddFragment(const OutgoingMessage& message, std::uint16_t fragment) const
+    {
+        const bool fitsCurrent = current && (building.size() + fragmentSize(message, fragment) <= MaxDatagramSize);
+        return fitsCurrent || (inFlight < sendWindow);
+    }
+
+    ////////////////////////////////////////////////////////////
+    static std::size_t fragmentSize(const OutgoingMessage& message, std::uint16_t fragment)
+    {
+        const bool        fragmented = message.fragments.size() > 1;
+        const std::size_t offset     = std::size_t{fragment} * MaxFragmentSize;
+        return messageHeaderSize + (fragmented ? fragmentHeaderSize : 0) +
+               std::min(message.data.size() - offset, MaxFragmentSize);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void addFragment(OutgoingMessage& message, std::uint16_t fragment, Time now)
+    {
+        const bool        fragmented = message.fragments.size() > 1;
+        const std::size_t offset     = std::size_t{fragment} * MaxFragmentSize;
+        const std::size_t size       = std::min(message.data.size() - offset, MaxFragmentSize);
+
+        if (current && (building.size() + fragmentSize(message, fragment) > MaxDatagramSize))
+            endDatagram(now);
+
+        if (!current)
+            beginDatagram(now, true);
+
+        const auto delivery = static_cast<std::uint8_t>(message.delivery);
+        const auto flags    = static_cast<std::uint8_t>(message.channel | (delivery << deliveryShift) |
+                                                      (fragmented ? fragmentFlag : 0));
+        building.push_back(static_cast<std::byte>(flags));
+        writeUint16(building, message.id);
+        if (fragmented)
+        {
+            writeUint16(building, fragment);
+            writeUint16(building, static_cast<std::uint16_t>(message.fragments.size()));
+        }
+        writeUint16(building, static_cast<std::uint16_t>(size));
+        building.insert(building.end(), message.data.begin() + static_cast<std::ptrdiff_t>(offset),
+                        message.data.begin() + static_cast<std::ptrdiff_t>(offset + size));
+
+        if (message.delivery != Delivery::Unreliable)
+            current->fragments.push_back({message.channel, message.id, fragment});
+    }
+
+    ////////////////////////////////////////////////////////////
+    void acknowledge(const FragmentReference& reference)
+    {
+        std::deque<OutgoingMessage>& messages = outgoing[reference.channel].reliable;
+        if (messages.empty())
+            return;
+
+        // Reliable messages are stored by consecutive ids, so the message can be found directly
+        const auto index = static_cast<std::uint16_t>(reference.id - messages.front().id);
+        if (index >= messages.size())
+            return;
+
+        OutgoingMessage&  message  = messages[index];
+        OutgoingFragment& fragment = message.fragments[reference.fragment];
+        if (!fragment.acknowledged)
+        {
+            fragment.acknowledged = true;
+            --message.unacknowledged;
+        }
+
+        while (!messages.empty() && (messages.front().unacknowledged == 0))
+            messages.pop_front();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void addRoundTripSample(Time sample)
+    {
+        // Smoothed estimation of RFC 6298
+        if (!hasRoundTripSample)
+        {
+            roundTripTime      = sample;
+            roundTripVariance  = sample / std::int64_t{2};
+            hasRoundTripSample = true;
+        }
+        else
+        {
+            const Time difference = (sample > roundTripTime) ? sample - roundTripTime : roundTripTime - sample;
+            roundTripVariance     = roundTripVariance + (difference - roundTripVariance) / std::int64_t{4};
+            roundTripTime         = roundTripTime + (sample - roundTripTime) / std::int64_t{8};
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void deliver(std::size_t channel, std::vector<std::byte>&& data)
+    {
+        deliveredMessages.emplace_back(channel, std::move(data));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Store a fragment, return true if it completed its message
+    bool storeFragment(IncomingMessage& message, const MessageView& view, bool expected, Time now)
+    {
+        if (message.received.empty())
+        {
+            message.received.resize(view.fragmentCount);
+            message.missing = view.fragmentCount;
+        }
+
+        message.lastUpdate = now;
+        if ((message.received.size() != view.fragmentCount) || message.received[view.fragmentIndex])
+            return false;
+
+        // The fragment count comes from the peer, so the message grows as its fragments arrive, within a budget.
+        // The next expected reliable message is always accepted, otherwise later ones could block it forever.
+        const std::size_t offset = std::size_t{view.fragmentIndex} * MaxFragmentSize;
+        const std::size_t size   = std::max(message.data.size(), offset + view.size);
+        const std::size_t growth = size - message.data.size();
+        if (!expected && (reassemblySize + growth > maxReassemblySize))
+            return false;
+
+        reassemblySize += growth;
+        message.data.resize(size);
+        std::memcpy(message.data.data() + offset, view.data, view.size);
+        message.received[view.fragmentIndex] = true;
+
+        return --message.missing == 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Stop counting the bytes of a message that is delivered or dropped
+    void forget(const IncomingMessage& message)
+    {
+        reassemblySize -= message.data.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void handleMessage(const MessageView& view, Time now)
+    {
+        IncomingChannel& channel = incoming[view.channel];
+
+        if (view.delivery == Delivery::Unreliable)
+        {
+            if (view.fragmentCount == 1)
+            {
+                deliver(view.channel, std::vector<std::byte>(view.data, view.data + view.size));
+                return;
+            }
+
+            // Forget the oldest partial message rather than growing without bounds
+            if ((channel.unreliable.size() >= maxUnreliablePartial) && (channel.unreliable.count(view.id) == 0))
+            {
+                const auto oldest = std::min_element(channel.unreliable.begin(),
+                                                     channel.unreliable.end(),
+                                                     [](const auto& left, const auto& right)
+                                                     { return left.second.lastUpdate < right.second.lastUpdate; });
+                if (oldest != channel.unreliable.end())
+                {
+                    forget(oldest->second);
+                    channel.unreliable.erase(oldest);
+                }
+            }
+
+            IncomingMessage& message = channel.unreliable[view.id];
+            if (storeFragment(message, view, false, now))
+            {
+                forget(message);
+                deliver(view.channel, std::move(message.data));
+                channel.unreliable.erase(view.id);
+            }
+            return;
+        }
+
+        // Ignore reliable messages that were already received, or that are too far ahead
+        const auto offset = static_cast<std::uint16_t>(view.id - channel.nextReliableId);
+        if (offset >= reliableWindow)
+            return;
+
+        IncomingMessage& message = channel.reliable[view.id];
+        if (storeFragment(message, view, offset == 0, now) && (view.delivery == Delivery::ReliableUnordered))
+        {
+            forget(message);
+            deliver(view.channel, std::move(message.data));
+            message.delivered = true;
+        }
+
+        // Release the messages that are now contiguous
+        for (auto it = channel.reliable.find(channel.nextReliableId);
+             (it != channel.reliable.end()) && (it->second.missing == 0) && !it->second.received.empty();
+             it = channel.reliable.find(channel.nextReliableId))
+        {
+            forget(it->second);
+            if (!it->second.delivered)
+                deliver(view.channel, std::move(it->second.data));
+
+            channel.reliable.erase(it);
+            ++channel.nextReliableId;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Record a received sequence number, return false if it is a duplicate or too old
+    bool recordSequence(std::uint16_t sequence)
+    {
+        if (!hasReceived)
+        {
+            hasReceived    = true;
+            remoteSequence = sequence;
+            remoteAckBits  = 0;
+            return true;
+        }
+
+        if (sequenceGreater(sequence, remoteSequence))
+        {
+            // The previous latest sequence becomes the first acknowledgement bit
+            const auto shift = static_cast<std::uint16_t>(sequence - remoteSequence);
+            remoteAckBits    = (shift < 32) ? ((remoteAckBits << shift) | (1u << (shift - 1)))
+                                            : ((shift == 32) ? (1u << 31) : 0);
+            remoteSequence   = sequence;
+            return true;
+        }
+
+        const auto distance = static_cast<std::uint16_t>(remoteSequence - sequence);
+        if ((distance == 0) || (distance > 32))
+            return false;
+
+        const std::uint32_t bit = 1u << (distance - 1);
+        if (remoteAckBits & bit)
+            return false;
+
+        remoteAckBits |= bit;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    UdpSocket*                               socket;                       //!< Socket used to exchange datagrams
+    IpAddress                                remoteAddress;                //!< Address of the remote peer
+    unsigned short                           remotePort;                   //!< Port of the remote peer
+    Clock                                    clock;                        //!< Time reference
+    Time                                     timeout;                      //!< Silence after which the peer is gone
+    Time                                     lastReceive;                  //!< Time of the last datagram received
+    Time                                     lastSend;                     //!< Time of the last datagram sent
+    std::array<OutgoingChannel, MaxChannels> outgoing;                     //!< Sending state of the channels
+    std::array<IncomingChannel, MaxChannels> incoming;                     //!< Receiving state of the channels
+    std::deque<OutgoingMessage>              unreliable;                   //!< Unreliable messages to send
+    std::deque<DeliveredMessage>             deliveredMessages;            //!< Messages waiting for receive
+    std::vector<SentDatagram>                sentHistory{sentHistorySize}; //!< Recently sent datagrams
+    std::uint16_t                            localSequence{};              //!< Sequence of the next datagram
+    bool                                     hasReceived{};                //!< Was any datagram received?
+    std::uint16_t                            remoteSequence{};             //!< Latest sequence received
+    std::uint32_t                            remoteAckBits{};              //!< Previous 32 sequences received
+    std::size_t                              unacknowledged{};             //!< Datagrams to acknowledge
+    bool                                     hasRoundTripSample{};         //!< Was the round-trip time measured?
+    Time                                     roundTripTime;                //!< Smoothed round-trip time
+    Time                                     roundTripVariance;            //!< Variation of the round-trip time
+    std::vector<std::byte>                   building;                     //!< Datagram being built
+    SentDatagram*                            current{};                    //!< Record of the datagram being built
+    std::vector<std::vector<std::byte>>      ready;                        //!< Datagrams to send
+    std::size_t                              readyCount{};                 //!< Number of datagrams in ready
+    std::vector<DelayedDatagram>             delayed;                      //!< Datagrams held by the simulation
+    std::optional<Simulation>                simulation;                   //!< Network conditions to simulate
+    std::minstd_rand                         random;                       //!< Random generator of the simulation
+    std::vector<std::byte>                   receiveBuffer;                //!< Storage for received datagrams
+    std::size_t                              reassemblySize{};             //!< Bytes of incomplete messages
+    std::size_t                              inFlight{};                   //!< Reliable datagrams not acknowledged
+};
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::UdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort) :
+m_impl(std::make_unique<UdpConnectionImpl>(socket, remoteAddress, remotePort))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::~UdpConnection() = default;
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::UdpConnection(UdpConnection&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+UdpConnection& UdpConnection::operator=(UdpConnection&&) noexcept = default;
+
+
+////////////////////////////////////////////////////////////
+IpAddress UdpConnection::getRemoteAddress() const
+{
+    return m_impl->remoteAddress;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short UdpConnection::getRemotePort() const
+{
+    return m_impl->remotePort;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::setChannelDelivery(std::size_t channel, Delivery delivery)
+{
+    assert(channel < MaxChannels && "Channel index out of range");
+    m_impl->outgoing[channel].delivery = delivery;
+}
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::Delivery UdpConnection::getChannelDelivery(std::size_t channel) const
+{
+    assert(channel < MaxChannels && "Channel index out of range");
+    return m_impl->outgoing[channel].delivery;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::setTimeout(Time timeout)
+{
+    m_impl->timeout = timeout;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::setSimulation(const Simulation& simulation)
+{
+    const bool enabled = (simulation.packetLoss > 0.f) || (simulation.duplicates > 0.f) ||
+                         (simulation.latency > Time::Zero) || (simulation.jitter > Time::Zero);
+
+    m_impl->simulation = enabled ? std::optional<Simulation>(simulation) : std::nullopt;
+    m_impl->random.seed(simulation.seed);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::send(Packet& packet, std::size_t channel)
+{
+    if (channel >= MaxChannels)
+    {
+        err() << "Cannot send packet on channel " << channel << " (there are only " << MaxChannels << " channels)"
+              << std::endl;
+        return Socket::Status::Error;
+    }
+
+    std::size_t       size = 0;
+    const void* const data = packet.onSend(size);
+
+    if (size > MaxMessageSize)
+    {
+        err() << "Cannot send packet over UDP connection: packet size (" << size
+              << " bytes) is greater than the maximum allowed (" << MaxMessageSize << " bytes)" << std::endl;
+        return Socket::Status::Error;
+    }
+
+    UdpConnectionImpl::OutgoingChannel& outgoing = m_impl->outgoing[channel];
+    const auto*                         bytes    = static_cast<const std::byte*>(data);
+    const std::size_t fragmentCount = std::max<std::size_t>(1, (size + MaxFragmentSize - 1) / MaxFragmentSize);
+
+    UdpConnectionImpl::OutgoingMessage message;
+
+    message.channel        = static_cast<std::uint8_t>(channel);
+    message.delivery       = outgoing.delivery;
+    message.data           = std::vector<std::byte>(bytes, bytes + size);
+    message.fragments      = std::vector<UdpConnectionImpl::OutgoingFragment>(fragmentCount);
+    message.unacknowledged = fragmentCount;
+
+    if (message.delivery == Delivery::Unreliable)
+    {
+        message.id = outgoing.nextUnreliableId++;
+        m_impl->unreliable.push_back(std::move(message));
+    }
+    else
+    {
+        message.id = outgoing.nextReliableId++;
+        outgoing.reliable.push_back(std::move(message));
+    }
+
+    return Socket::Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::receive(Packet& packet, std::size_t& channel)
+{
+    packet.clear();
+
+    if (m_impl->deliveredMessages.empty())
+        return Socket::Status::NotReady;
+
+    auto& [messageChannel, data] = m_impl->deliveredMessages.front();
+    channel                      = messageChannel;
+    if (!data.empty())
+        packet.onReceive(data.data(), data.size());
+
+    m_impl->deliveredMessages.pop_front();
+    return Socket::Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::update()
+{
+    UdpSocket& socket   = *m_impl->socket;
+    const bool blocking = socket.isBlocking();
+    socket.setBlocking(false);
+
+    m_impl->receiveBuffer.resize(receiveBatchSize * MaxDatagramSize);
+
+    std::array<UdpSocket::IncomingDatagram, receiveBatchSize> datagrams;
+    for (std::size_t i = 0; i < receiveBatchSize; ++i)
+    {
+        datagrams[i].data     = m_impl->receiveBuffer.data() + i * MaxDatagramSize;
+        datagrams[i].capacity = MaxDatagramSize;
+    }
+
+    // Drain the socket, keeping only the datagrams of the remote peer
+    Socket::Status status   = Socket::Status::Done;
+    std::size_t    received = receiveBatchSize;
+    while ((status == Socket::Status::Done) && (received == receiveBatchSize))
+    {
+        status = socket.receiveBatch(datagrams.data(), datagrams.size(), received);
+
+        for (std::size_t i = 0; (status == Socket::Status::Done) && (i < received); ++i)
+        {
+            const UdpSocket::IncomingDatagram& datagram = datagrams[i];
+            if ((datagram.remoteAddress == m_impl->remoteAddress) && (datagram.remotePort == m_impl->remotePort))
+                handleDatagram(datagram.data, datagram.size);
+        }
+    }
+
+    // Reception errors, such as a peer refusing the datagrams, are detected by the timeout instead
+    socket.setBlocking(blocking);
+    return flush();
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::handleDatagram(const void* data, std::size_t size)
+{
+    if (!data || (size < datagramHeaderSize))
+        return;
+
+    const auto*      begin = static_cast<const std::byte*>(data);
+    const std::byte* end   = begin + size;
+
+    // Validate the whole datagram before changing any state
+    MessageView view;
+    bool        hasMessages = false;
+    for (const std::byte* position = begin + datagramHeaderSize; position != end; hasMessages = true)
+    {
+        if (!readMessage(position, end, view))
+            return;
+    }
+
+    const Time          now      = m_impl->clock.getElapsedTime();
+    const std::uint16_t sequence = readUint16(begin);
+    const std::uint16_t ack      = readUint16(begin + 2);
+    const std::uint32_t ackBits  = readUint32(begin + 4);
+
+    m_impl->lastReceive = now;
+
+    // Process the acknowledgements of the datagrams that we sent
+    for (std::uint16_t i = 0; i <= 32; ++i)
+    {
+        if ((i > 0) && !((ackBits >> (i - 1)) & 1u))
+            continue;
+
+        const auto                       acknowledged = static_cast<std::uint16_t>(ack - i);
+        UdpConnectionImpl::SentDatagram& sent         = m_impl->sentHistory[acknowledged % sentHistorySize];
+        if (!sent.pending || (sent.sequence != acknowledged))
+            continue;
+
+        sent.pending = false;
+        m_impl->addRoundTripSample(now - sent.sendTime);
+        for (const UdpConnectionImpl::FragmentReference& reference : sent.fragments)
+            m_impl->acknowledge(reference);
+    }
+
+    if (!m_impl->recordSequence(sequence))
+        return;
+
+    // Datagrams that carry nothing don't need to be acknowledged
+    if (!hasMessages)
+        return;
+
+    for (const std::byte* position = begin + datagramHeaderSize; position != end;)
+    {
+        readMessage(position, end, view);
+        m_impl->handleMessage(view, now);
+    }
+
+    // Don't let the acknowledgement bits overflow when the peer sends a burst
+    if (++m_impl->unacknowledged >= ackThreshold)
+    {
+        m_impl->beginDatagram(now, false);
+        m_impl->endDatagram(now);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::flush()
+{
+    UdpConnectionImpl& impl = *m_impl;
+    const Time         now  = impl.clock.getElapsedTime();
+
+    // Release the datagrams that the simulation held back
+    const auto due = std::stable_partition(impl.delayed.begin(),
+                                           impl.delayed.end(),
+                                           [now](const UdpConnectionImpl::DelayedDatagram& datagram)
+                                           { return datagram.sendTime > now; });
+    for (auto it = due; it != impl.delayed.end(); ++it)
+        impl.newReadyDatagram() = std::move(it->data);
+    impl.delayed.erase(due, impl.delayed.end());
+
+    // Datagrams that were neither acknowledged nor given up as lost are still in flight
+    const Time resendTimeout = impl.getResendTimeout();
+    impl.inFlight            = static_cast<std::size_t>(
+        std::count_if(impl.sentHistory.begin(),
+                      impl.sentHistory.end(),
+                      [now, resendTimeout](const UdpConnectionImpl::SentDatagram& sent)
+                      { return sent.pending && (now - sent.sendTime < resendTimeout); }));
+
+    // Reliable fragments that were never sent, or not acknowledged in time, as long as the send window allows.
+    // Sending everything at once would overflow the receive buffer of the peer and the history of sent datagrams.
+    bool windowFull = false;
+    for (UdpConnectionImpl::OutgoingChannel& channel : impl.outgoing)
+    {
+        const std::size_t count = std::min(channel.reliable.size(), std::size_t{reliableWindow});
+        for (std::size_t i = 0; (i < count) && !windowFull; ++i)
+        {
+            UdpConnectionImpl::OutgoingMessage& message = channel.reliable[i];
+            for (std::size_t j = 0; j < message.fragments.size(); ++j)
+            {
+                UdpConnectionImpl::OutgoingFragment& fragment = message.fragments[j];
+                if (fragment.acknowledged || (fragment.sent && (now - fragment.lastSent < resendTimeout)))
+                    continue;
+
+                windowFull = !impl.canAddFragment(message, static_cast<std::uint16_t>(j));
+                if (windowFull)
+                    break;
+
+                impl.addFragment(message, static_cast<std::uint16_t>(j), now);
+                fragment.sent     = true;
+                fragment.lastSent = now;
+            }
+        }
+    }
+
+    // Unreliable messages are sent once
+    for (UdpConnectionImpl::OutgoingMessage& message : impl.unreliable)
+    {
+        for (std::size_t j = 0; j < message.fragments.size(); ++j)
+            impl.addFragment(message, static_cast<std::uint16_t>(j), now);
+    }
+    impl.unreliable.clear();
+
+    if (impl.current)
+        impl.endDatagram(now);
+
+    // Acknowledge what was received, and let the peer know that we are still there
+    if ((impl.unacknowledged > 0) || (now - impl.lastSend >= keepAliveInterval))
+    {
+        impl.beginDatagram(now, false);
+        impl.endDatagram(now);
+    }
+
+    // Forget the unreliable messages that will never be complete
+    for (UdpConnectionImpl::IncomingChannel& channel : impl.incoming)
+    {
+        for (auto it = channel.unreliable.begin(); it != channel.unreliable.end();)
+        {
+            if (now - it->second.lastUpdate > reassemblyTimeout)
+            {
+                impl.forget(it->second);
+                it = channel.unreliable.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Send everything with as few system calls as possible
+    Socket::Status status = Socket::Status::Done;
+    if (impl.readyCount > 0)
+    {
+        std::vector<UdpSocket::OutgoingDatagram> datagrams(impl.readyCount);
+        for (std::size_t i = 0; i < impl.readyCount; ++i)
+            datagrams[i] = {impl.ready[i].data(), impl.ready[i].size(), impl.remoteAddress, impl.remotePort};
+
+        // Datagrams that don't fit in the socket buffer are lost like on the network, resends take care of them
+        std::size_t sent = 0;
+        status           = impl.socket->sendBatch(datagrams.data(), datagrams.size(), sent);
+        impl.readyCount  = 0;
+    }
+
+    if (status == Socket::Status::Error)
+        return Socket::Status::Error;
+
+    if (now - impl.lastReceive > impl.timeout)
+        return Socket::Status::Disconnected;
+
+    return Socket::Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Time UdpConnection::getRoundTripTime() const
+{
+    return m_impl->roundTripTime;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UdpConnection::getPendingReliableCount() const
+{
+    std::size_t count = 0;
+    for (const UdpConnectionImpl::OutgoingChannel& channel : m_impl->outgoing)
+        count += channel.reliable.size();
+
+    return count;
+}
+
+} // namespace sf
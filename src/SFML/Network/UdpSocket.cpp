@@ -32,9 +32,35 @@
 
 #include <SFML/System/Err.hpp>
 
+#include <algorithm>
+#include <array>
 #include <ostream>
 
+#include <cerrno>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_LINUX)
+#include <netinet/udp.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
+
+
+namespace
+{
+#if defined(SFML_SYSTEM_LINUX)
+// Number of datagrams handed to the system in a single call
+constexpr std::size_t batchSize = 64;
+
+// Largest datagram grouped with others for segmentation offload, which requires
+// segments to fit in the MTU of the network interface (1500 bytes on most networks)
+constexpr std::size_t maxSegmentSize = 1472;
+#endif
+} // namespace
 
 
 namespace sf
@@ -51,11 +77,11 @@ unsigned short UdpSocket::getLocalPort() const
     if (getNativeHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve information about the local end of the socket
-        sockaddr_in                  address{};
+        sockaddr_storage             address{};
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -71,15 +97,17 @@ Socket::Status UdpSocket::bind(unsigned short port, const IpAddress& address)
     close();
 
     // Create the internal socket if it doesn't exist
-    create();
+    m_addressType = address.getType();
+    create(m_addressType);
 
     // Check if the address is valid
     if (address == IpAddress::Broadcast)
         return Status::Error;
 
     // Bind the socket
-    sockaddr_in addr = priv::SocketImpl::createAddress(address.toInteger(), port);
-    if (::bind(getNativeHandle(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1)
+    sockaddr_storage                   addr{};
+    const priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(address, port, addr);
+    if (::bind(getNativeHandle(), reinterpret_cast<sockaddr*>(&addr), length) == -1)
     {
         err() << "Failed to bind socket to port " << port << std::endl;
         return Status::Error;
@@ -100,8 +128,12 @@ void UdpSocket::unbind()
 ////////////////////////////////////////////////////////////
 Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    // Create the internal socket if it doesn't exist, for the version of the receiver
+    if (getNativeHandle() == priv::SocketImpl::invalidSocket())
+    {
+        m_addressType = remoteAddress.getType();
+        create(m_addressType);
+    }
 
     // Make sure that all the data will fit in one datagram
     if (size > MaxDatagramSize)
@@ -112,7 +144,11 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
     }
 
     // Build the target address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage                   address{};
+    const priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(remoteAddress,
+                                                                                remotePort,
+                                                                                address,
+                                                                                m_addressType == IpAddress::Type::IpV6);
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wuseless-cast"
@@ -123,12 +159,19 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
                static_cast<priv::SocketImpl::Size>(size),
                0,
                reinterpret_cast<sockaddr*>(&address),
-               sizeof(address)));
+               length));
 #pragma GCC diagnostic pop
 
     // Check for errors
     if (sent < 0)
-        return priv::SocketImpl::getErrorStatus();
+    {
+        const Status status = priv::SocketImpl::getErrorStatus();
+        recordSend(status, size, 0);
+        return status;
+    }
+
+    recordSend(Status::Done, size, static_cast<std::size_t>(sent));
+    recordPacketSent(size);
 
     return Status::Done;
 }
@@ -154,7 +197,7 @@ Socket::Status UdpSocket::receive(void*                     data,
     }
 
     // Data that will be filled with the other computer's address
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+    sockaddr_storage address{};
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wuseless-cast"
@@ -171,12 +214,18 @@ Socket::Status UdpSocket::receive(void*                     data,
 
     // Check for errors
     if (sizeReceived < 0)
-        return priv::SocketImpl::getErrorStatus();
+    {
+        const Status status = priv::SocketImpl::getErrorStatus();
+        recordReceive(status, 0);
+        return status;
+    }
 
     // Fill the sender information
     received      = static_cast<std::size_t>(sizeReceived);
-    remoteAddress = IpAddress(ntohl(address.sin_addr.s_addr));
-    remotePort    = ntohs(address.sin_port);
+    recordReceive(Status::Done, received);
+    recordPacketReceived(received);
+    remoteAddress = priv::SocketImpl::getAddress(address);
+    remotePort    = priv::SocketImpl::getPort(address);
 
     return Status::Done;
 }
@@ -220,4 +269,265 @@ Socket::Status UdpSocket::receive(Packet& packet, std::optional<IpAddress>& remo
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::sendBatch(const OutgoingDatagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    // First clear the variables to fill
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist, for the version of the first receiver
+    if ((getNativeHandle() == priv::SocketImpl::invalidSocket()) && (count > 0))
+    {
+        m_addressType = datagrams[0].remoteAddress.getType();
+        create(m_addressType);
+    }
+
+    // Make sure that every datagram is valid before sending anything
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (datagrams[i].size > MaxDatagramSize)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Status::Error;
+        }
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Control data holding the segment size of a message
+    union Control
+    {
+        std::array<char, CMSG_SPACE(sizeof(std::uint16_t))> buffer;
+        cmsghdr                                              header;
+    };
+
+    std::array<mmsghdr, batchSize>          messages{};
+    std::array<iovec, batchSize>            vectors{};
+    std::array<sockaddr_storage, batchSize> addresses{};
+    std::array<Control, batchSize>          controls{};
+    std::array<std::size_t, batchSize>      datagramCounts{};
+    const bool                              mapToIpV6 = (m_addressType == IpAddress::Type::IpV6);
+
+    while (sent < count)
+    {
+        // Each message holds a single datagram, or a run of datagrams to the same peer that the
+        // system splits itself: all the datagrams have the same size, except the last one that can be shorter
+        const std::size_t end          = std::min(count, sent + batchSize);
+        std::size_t       messageCount = 0;
+        std::size_t       batchBytes   = 0;
+        bool              segmented    = false;
+
+        for (std::size_t first = sent; first < end; ++messageCount)
+        {
+            const OutgoingDatagram& datagram = datagrams[first];
+
+            std::size_t last      = first + 1;
+            std::size_t totalSize = datagram.size;
+            if (m_useSegmentation && (datagram.size > 0) && (datagram.size <= maxSegmentSize))
+            {
+                while ((last < end) && (datagrams[last - 1].size == datagram.size) &&
+                       (datagrams[last].size > 0) && (datagrams[last].size <= datagram.size) &&
+                       (totalSize + datagrams[last].size <= MaxDatagramSize) &&
+                       (datagrams[last].remoteAddress == datagram.remoteAddress) &&
+                       (datagrams[last].remotePort == datagram.remotePort))
+                {
+                    totalSize += datagrams[last].size;
+                    ++last;
+                }
+            }
+
+            for (std::size_t i = first; i < last; ++i)
+            {
+                vectors[i - sent].iov_base = const_cast<void*>(datagrams[i].data);
+                vectors[i - sent].iov_len  = datagrams[i].size;
+            }
+
+            msghdr& header     = messages[messageCount].msg_hdr;
+            header             = msghdr();
+            header.msg_name    = &addresses[messageCount];
+            header.msg_namelen = priv::SocketImpl::createAddress(datagram.remoteAddress,
+                                                                 datagram.remotePort,
+                                                                 addresses[messageCount],
+                                                                 mapToIpV6);
+            header.msg_iov     = &vectors[first - sent];
+            header.msg_iovlen  = last - first;
+
+            if (last - first > 1)
+            {
+                header.msg_control    = controls[messageCount].buffer.data();
+                header.msg_controllen = controls[messageCount].buffer.size();
+
+                cmsghdr* control    = CMSG_FIRSTHDR(&header);
+                control->cmsg_level = SOL_UDP;
+                control->cmsg_type  = UDP_SEGMENT;
+                control->cmsg_len   = CMSG_LEN(sizeof(std::uint16_t));
+
+                const auto segmentSize = static_cast<std::uint16_t>(datagram.size);
+                std::memcpy(CMSG_DATA(control), &segmentSize, sizeof(segmentSize));
+                segmented = true;
+            }
+
+            datagramCounts[messageCount] = last - first;
+            first                        = last;
+            batchBytes += totalSize;
+        }
+
+        const int result = sendmmsg(getNativeHandle(), messages.data(), static_cast<unsigned int>(messageCount), 0);
+
+        // Check for errors
+        if (result < 0)
+        {
+            // The system or the network interface may not support segmentation offload, send the datagrams separately
+            if (segmented && ((errno == EINVAL) || (errno == EIO) || (errno == ENOPROTOOPT) || (errno == EOPNOTSUPP)))
+            {
+                m_useSegmentation = false;
+                continue;
+            }
+
+            const Status status = priv::SocketImpl::getErrorStatus();
+            recordSend(status, batchBytes, 0);
+
+            if ((status == Status::NotReady) && sent)
+                return Status::Partial;
+
+            return status;
+        }
+
+        const std::size_t first = sent;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(result); ++i)
+            sent += datagramCounts[i];
+
+        std::size_t sentBytes = 0;
+        for (std::size_t i = first; i < sent; ++i)
+        {
+            sentBytes += datagrams[i].size;
+            recordPacketSent(datagrams[i].size);
+        }
+
+        recordSend(Status::Done, batchBytes, sentBytes);
+    }
+
+#else
+
+    // Send the datagrams one by one
+    for (; sent < count; ++sent)
+    {
+        const OutgoingDatagram& datagram = datagrams[sent];
+        const Status status = send(datagram.data, datagram.size, datagram.remoteAddress, datagram.remotePort);
+
+        if (status != Status::Done)
+        {
+            if ((status == Status::NotReady) && sent)
+                return Status::Partial;
+
+            return status;
+        }
+    }
+
+#endif
+
+    return Status::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receiveBatch(IncomingDatagram* datagrams, std::size_t count, std::size_t& received)
+{
+    // First clear the variables to fill
+    received = 0;
+
+    // Check the destination buffers
+    if (!datagrams || (count == 0))
+    {
+        err() << "Cannot receive data from the network (no datagram to fill)" << std::endl;
+        return Status::Error;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        datagrams[i].size          = 0;
+        datagrams[i].remoteAddress = std::nullopt;
+        datagrams[i].remotePort    = 0;
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    std::array<mmsghdr, batchSize>          messages{};
+    std::array<iovec, batchSize>            vectors{};
+    std::array<sockaddr_storage, batchSize> addresses{};
+
+    while (received < count)
+    {
+        const std::size_t messageCount = std::min(count - received, batchSize);
+        for (std::size_t i = 0; i < messageCount; ++i)
+        {
+            vectors[i].iov_base = datagrams[received + i].data;
+            vectors[i].iov_len  = datagrams[received + i].capacity;
+
+            msghdr& header     = messages[i].msg_hdr;
+            header             = msghdr();
+            header.msg_name    = &addresses[i];
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_iov     = &vectors[i];
+            header.msg_iovlen  = 1;
+        }
+
+        // Only the first datagram may be waited for, the next ones are taken if they are already there
+        const auto size   = static_cast<unsigned int>(messageCount);
+        const int  flags  = (received == 0) ? MSG_WAITFORONE : MSG_DONTWAIT;
+        const int  result = recvmmsg(getNativeHandle(), messages.data(), size, flags, nullptr);
+
+        // Check for errors
+        if (result < 0)
+        {
+            const Status status = priv::SocketImpl::getErrorStatus();
+            recordReceive(status, 0);
+            return received ? Status::Done : status;
+        }
+
+        // Fill the sender information
+        std::size_t receivedBytes = 0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(result); ++i)
+        {
+            IncomingDatagram& datagram = datagrams[received + i];
+            datagram.size              = messages[i].msg_len;
+            datagram.remoteAddress     = priv::SocketImpl::getAddress(addresses[i]);
+            datagram.remotePort        = priv::SocketImpl::getPort(addresses[i]);
+            receivedBytes += datagram.size;
+            recordPacketReceived(datagram.size);
+        }
+
+        recordReceive(Status::Done, receivedBytes);
+
+        received += static_cast<std::size_t>(result);
+
+        if (static_cast<std::size_t>(result) < messageCount)
+            break;
+    }
+
+#else
+
+    // Receive the datagrams one by one, waiting only for the first one
+    for (; received < count; ++received)
+    {
+        if (received && !priv::SocketImpl::isReadable(getNativeHandle()))
+            break;
+
+        IncomingDatagram& datagram = datagrams[received];
+        const Status      status   = receive(datagram.data,
+                                          datagram.capacity,
+                                          datagram.size,
+                                          datagram.remoteAddress,
+                                          datagram.remotePort);
+
+        if (status != Status::Done)
+            return received ? Status::Done : status;
+    }
+
+#endif
+
+    return Status::Done;
+}
+
 } // namespace sf
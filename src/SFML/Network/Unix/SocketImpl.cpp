@@ -29,27 +29,82 @@
 
 #include <SFML/System/Err.hpp>
 
+#include <algorithm>
+#include <array>
 #include <fcntl.h>
 #include <ostream>
+#include <poll.h>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+#include <pthread.h>
+#include <sys/sendfile.h>
+#endif
 
 #include <cerrno>
+#include <csignal>
+#include <cstring>
 
 
 namespace sf::priv
 {
 ////////////////////////////////////////////////////////////
-sockaddr_in SocketImpl::createAddress(std::uint32_t address, unsigned short port)
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress&  address,
+                                                 unsigned short    port,
+                                                 sockaddr_storage& result,
+                                                 bool              mapToIpV6)
 {
-    auto addr            = sockaddr_in();
-    addr.sin_addr.s_addr = htonl(address);
-    addr.sin_family      = AF_INET;
-    addr.sin_port        = htons(port);
+    result = sockaddr_storage();
+
+    if ((address.getType() == IpAddress::Type::IpV4) && !mapToIpV6)
+    {
+        auto& addr           = reinterpret_cast<sockaddr_in&>(result);
+        addr.sin_addr.s_addr = htonl(address.toInteger());
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+
+#if defined(SFML_SYSTEM_MACOS)
+        addr.sin_len = sizeof(addr);
+#endif
+
+        return sizeof(addr);
+    }
+
+    const std::array<std::uint8_t, 16> bytes = address.toBytes();
+
+    auto& addr       = reinterpret_cast<sockaddr_in6&>(result);
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port   = htons(port);
+    std::memcpy(&addr.sin6_addr, bytes.data(), bytes.size());
 
 #if defined(SFML_SYSTEM_MACOS)
-    addr.sin_len = sizeof(addr);
+    addr.sin6_len = sizeof(addr);
 #endif
 
-    return addr;
+    return sizeof(addr);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress SocketImpl::getAddress(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        std::array<std::uint8_t, 16> bytes{};
+        std::memcpy(bytes.data(), &reinterpret_cast<const sockaddr_in6&>(address).sin6_addr, bytes.size());
+        return IpAddress(bytes);
+    }
+
+    return IpAddress(ntohl(reinterpret_cast<const sockaddr_in&>(address).sin_addr.s_addr));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short SocketImpl::getPort(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6&>(address).sin6_port);
+
+    return ntohs(reinterpret_cast<const sockaddr_in&>(address).sin_port);
 }
 
 
@@ -84,6 +139,29 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::accept(SocketHandle listener, bool block)
+{
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID) || defined(SFML_SYSTEM_FREEBSD)
+    // Set the flags of the new socket in the same system call
+    return accept4(listener, nullptr, nullptr, SOCK_CLOEXEC | (block ? 0 : SOCK_NONBLOCK));
+#else
+    const SocketHandle sock = ::accept(listener, nullptr, nullptr);
+
+    // BSD systems copy the blocking state of the listener, so always set it
+    if (sock != invalidSocket())
+    {
+        if (fcntl(sock, F_SETFD, FD_CLOEXEC) == -1)
+            err() << "Failed to set file descriptor flags: " << errno << std::endl;
+
+        setBlocking(sock, block);
+    }
+
+    return sock;
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
@@ -108,4 +186,78 @@ Socket::Status SocketImpl::getErrorStatus()
     // clang-format on
 }
 
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::isReadable(SocketHandle sock)
+{
+    pollfd descriptor{sock, POLLIN, 0};
+    return (poll(&descriptor, 1, 0) > 0) && (descriptor.revents != 0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::int64_t SocketImpl::sendBuffers(SocketHandle sock, const Buffer* buffers, std::size_t count, int flags)
+{
+    // Extra blocks are left for the next call, which is allowed since a partial send can happen anyway
+    std::array<iovec, 4> vectors{};
+    count = std::min(count, vectors.size());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i].iov_base = const_cast<void*>(buffers[i].data);
+        vectors[i].iov_len  = buffers[i].size;
+    }
+
+    msghdr message{};
+    message.msg_iov    = vectors.data();
+    message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+
+    return static_cast<std::int64_t>(sendmsg(sock, &message, flags));
+}
+
+
+////////////////////////////////////////////////////////////
+std::int64_t SocketImpl::sendFile(SocketHandle         sock,
+                                  std::FILE*           file,
+                                  std::uint64_t        offset,
+                                  std::size_t          size,
+                                  [[maybe_unused]] int flags)
+{
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    // sendfile has no equivalent of MSG_NOSIGNAL: block SIGPIPE on this thread during the call,
+    // and discard the signal raised by a broken connection so that only the error is reported
+    sigset_t pipeSignal;
+    sigset_t previousMask;
+    sigset_t pending;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &previousMask);
+    const bool wasPending = (sigpending(&pending) == 0) && (sigismember(&pending, SIGPIPE) == 1);
+
+    auto          position = static_cast<off_t>(offset);
+    const ssize_t result   = sendfile(sock, fileno(file), &position, size);
+    const int     error    = errno;
+
+    if ((result < 0) && (error == EPIPE) && !wasPending)
+    {
+        const timespec noWait{};
+        sigtimedwait(&pipeSignal, nullptr, &noWait);
+    }
+
+    pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+    errno = error;
+
+    return static_cast<std::int64_t>(result);
+#else
+    // Read a block of the file and send it
+    std::array<char, 16 * 1024> buffer{};
+    const std::size_t           blockSize = std::min(size, buffer.size());
+    const ssize_t               count     = pread(fileno(file), buffer.data(), blockSize, static_cast<off_t>(offset));
+    if (count <= 0)
+        return static_cast<std::int64_t>(count);
+
+    return static_cast<std::int64_t>(::send(sock, buffer.data(), static_cast<std::size_t>(count), flags));
+#endif
+}
+
 } // namespace sf::priv
@@ -27,20 +27,69 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/SocketImpl.hpp>
 
+#include <algorithm>
+#include <array>
+
 #include <cstdint>
+#include <cstring>
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4127) // "conditional expression is constant" generated by the FD_SET macro
+#endif
 
 
 namespace sf::priv
 {
 ////////////////////////////////////////////////////////////
-sockaddr_in SocketImpl::createAddress(std::uint32_t address, unsigned short port)
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress&  address,
+                                                 unsigned short    port,
+                                                 sockaddr_storage& result,
+                                                 bool              mapToIpV6)
+{
+    result = sockaddr_storage();
+
+    if ((address.getType() == IpAddress::Type::IpV4) && !mapToIpV6)
+    {
+        auto& addr           = reinterpret_cast<sockaddr_in&>(result);
+        addr.sin_addr.s_addr = htonl(address.toInteger());
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+
+        return sizeof(addr);
+    }
+
+    const std::array<std::uint8_t, 16> bytes = address.toBytes();
+
+    auto& addr       = reinterpret_cast<sockaddr_in6&>(result);
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port   = htons(port);
+    std::memcpy(&addr.sin6_addr, bytes.data(), bytes.size());
+
+    return sizeof(addr);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress SocketImpl::getAddress(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        std::array<std::uint8_t, 16> bytes{};
+        std::memcpy(bytes.data(), &reinterpret_cast<const sockaddr_in6&>(address).sin6_addr, bytes.size());
+        return IpAddress(bytes);
+    }
+
+    return IpAddress(ntohl(reinterpret_cast<const sockaddr_in&>(address).sin_addr.s_addr));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short SocketImpl::getPort(const sockaddr_storage& address)
 {
-    auto addr            = sockaddr_in();
-    addr.sin_addr.s_addr = htonl(address);
-    addr.sin_family      = AF_INET;
-    addr.sin_port        = htons(port);
+    if (address.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6&>(address).sin6_port);
 
-    return addr;
+    return ntohs(reinterpret_cast<const sockaddr_in&>(address).sin_port);
 }
 
 
@@ -66,6 +115,22 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::accept(SocketHandle listener, bool block)
+{
+    const SocketHandle sock = ::accept(listener, nullptr, nullptr);
+
+    // The new socket copies the blocking state of the listener, so always set it
+    if (sock != INVALID_SOCKET)
+    {
+        SetHandleInformation(reinterpret_cast<HANDLE>(sock), HANDLE_FLAG_INHERIT, 0);
+        setBlocking(sock, block);
+    }
+
+    return sock;
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
@@ -86,6 +151,65 @@ Socket::Status SocketImpl::getErrorStatus()
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::isReadable(SocketHandle sock)
+{
+    // Windows sets are arrays of handles, so select has no limit on the handle value
+    fd_set sockets;
+    FD_ZERO(&sockets);
+    FD_SET(sock, &sockets);
+
+    timeval time{};
+    return select(0, &sockets, nullptr, nullptr, &time) > 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::int64_t SocketImpl::sendBuffers(SocketHandle sock, const Buffer* buffers, std::size_t count, int flags)
+{
+    // Extra blocks are left for the next call, which is allowed since a partial send can happen anyway
+    std::array<WSABUF, 4> vectors{};
+    count = std::min(count, vectors.size());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectors[i].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].data));
+        vectors[i].len = static_cast<ULONG>(buffers[i].size);
+    }
+
+    DWORD sent = 0;
+    if (WSASend(sock, vectors.data(), static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), nullptr, nullptr) != 0)
+        return -1;
+
+    return static_cast<std::int64_t>(sent);
+}
+
+
+////////////////////////////////////////////////////////////
+std::int64_t SocketImpl::sendFile(SocketHandle sock, std::FILE* file, std::uint64_t offset, std::size_t size, int flags)
+{
+    // Read a block of the file and send it
+    std::array<char, 16 * 1024> buffer{};
+    if (_fseeki64(file, static_cast<__int64>(offset), SEEK_SET) != 0)
+    {
+        WSASetLastError(WSAEINVAL);
+        return -1;
+    }
+
+    const std::size_t count = std::fread(buffer.data(), 1, std::min(size, buffer.size()), file);
+    if (count == 0)
+    {
+        if (!std::ferror(file))
+            return 0;
+
+        WSASetLastError(WSAEINVAL);
+        return -1;
+    }
+
+    return static_cast<std::int64_t>(::send(sock, buffer.data(), static_cast<int>(count), flags));
+}
+
+
 ////////////////////////////////////////////////////////////
 // Windows needs some initialization and cleanup to get
 // sockets working properly... so let's create a class that will
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2024 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/PrefetchInputStream.hpp>
+
+#include <algorithm>
+
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PrefetchInputStream::PrefetchInputStream(InputStream& source, std::size_t windowSize) :
+m_source(source),
+m_size(source.getSize()),
+m_window(std::max(windowSize, std::size_t{1})),
+m_windowBegin(source.tell().value_or(0)),
+m_windowEnd(m_windowBegin),
+m_position(m_windowBegin)
+{
+    m_statistics.endOfStream = m_size.has_value() && m_position >= *m_size;
+
+    m_thread = std::thread(&PrefetchInputStream::fetch, this);
+}
+
+
+////////////////////////////////////////////////////////////
+PrefetchInputStream::~PrefetchInputStream()
+{
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_spaceCondition.notify_one();
+    m_thread.join();
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> PrefetchInputStream::read(void* data, std::size_t size)
+{
+    auto*       bytes = static_cast<std::byte*>(data);
+    std::size_t count = 0;
+
+    std::unique_lock lock(m_mutex);
+
+    while (count < size)
+    {
+        if (m_position == m_windowEnd)
+        {
+            if (m_statistics.error)
+                return count > 0 ? std::optional(count) : std::nullopt;
+
+            if (m_statistics.endOfStream)
+                break;
+
+            // Nothing is ready yet: wait for the background thread to fetch more data
+            const Clock clock;
+            m_dataCondition.wait(lock,
+                                 [this]
+                                 {
+                                     return m_position != m_windowEnd || m_statistics.endOfStream ||
+                                            m_statistics.error;
+                                 });
+            ++m_statistics.stallCount;
+            m_statistics.stallTime += clock.getElapsedTime();
+            continue;
+        }
+
+        // Copy the contiguous part of the window that follows the current position
+        const std::size_t offset = m_position % m_window.size();
+        const std::size_t length = std::min({size - count, m_windowEnd - m_position, m_window.size() - offset});
+        std::memcpy(bytes + count, m_window.data() + offset, length);
+        count += length;
+        m_position += length;
+
+        m_spaceCondition.notify_one();
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> PrefetchInputStream::seek(std::size_t position)
+{
+    {
+        const std::lock_guard lock(m_mutex);
+
+        if (m_size.has_value())
+            position = std::min(position, *m_size);
+
+        if (position < m_windowBegin || position > m_windowEnd)
+        {
+            // The position is outside of the fetched data: discard it and restart from there
+            m_windowBegin            = position;
+            m_windowEnd              = position;
+            m_statistics.endOfStream = m_size.has_value() && position >= *m_size;
+            ++m_seekCount;
+        }
+
+        m_position         = position;
+        m_statistics.error = false;
+    }
+
+    m_spaceCondition.notify_one();
+    return position;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> PrefetchInputStream::tell()
+{
+    const std::lock_guard lock(m_mutex);
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+std::optional<std::size_t> PrefetchInputStream::getSize()
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PrefetchInputStream::isAvailable(std::size_t size) const
+{
+    const std::lock_guard lock(m_mutex);
+    return m_windowEnd - m_position >= std::min(size, m_window.size()) || m_statistics.endOfStream || m_statistics.error;
+}
+
+
+////////////////////////////////////////////////////////////
+PrefetchInputStream::Statistics PrefetchInputStream::getStatistics() const
+{
+    const std::lock_guard lock(m_mutex);
+
+    Statistics statistics   = m_statistics;
+    statistics.windowSize   = m_window.size();
+    statistics.bufferedSize = m_windowEnd - m_position;
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void PrefetchInputStream::fetch()
+{
+    std::unique_lock lock(m_mutex);
+
+    std::vector<std::byte> chunk(std::min(m_window.size(), std::size_t{16 * 1024}));
+    std::size_t            sourcePosition = m_windowEnd;
+    bool                   sourceInSync   = true;
+
+    while (true)
+    {
+        // Wait until there is room in the window
+        m_spaceCondition.wait(lock,
+                              [this]
+                              {
+                                  return m_stopping || (!m_statistics.endOfStream && !m_statistics.error &&
+                                                        m_windowEnd - m_position < m_window.size());
+                              });
+
+        if (m_stopping)
+            return;
+
+        const std::size_t   position  = m_windowEnd;
+        const std::uint64_t seekCount = m_seekCount;
+        const std::size_t   size      = std::min(chunk.size(), m_window.size() - (m_windowEnd - m_position));
+
+        // Read from the source without holding the lock, so that fetched data can be consumed meanwhile
+        lock.unlock();
+
+        std::optional<std::size_t> count;
+        if ((sourceInSync && sourcePosition == position) || m_source.seek(position) == position)
+            count = m_source.read(chunk.data(), size);
+
+        lock.lock();
+
+        sourcePosition = position + count.value_or(0);
+        sourceInSync   = count.has_value();
+
+        // The window was discarded while reading, the data is stale
+        if (seekCount != m_seekCount)
+            continue;
+
+        if (!count.has_value())
+        {
+            m_statistics.error = true;
+        }
+        else if (*count == 0)
+        {
+            m_statistics.endOfStream = true;
+        }
+        else
+        {
+            // The reader may have sought back within the window meanwhile, don't overwrite what it still needs
+            const std::size_t room = m_window.size() - (m_windowEnd - m_position);
+            if (*count > room)
+            {
+                *count       = room;
+                sourceInSync = false;
+            }
+
+            for (std::size_t copied = 0; copied < *count;)
+            {
+                const std::size_t offset = (m_windowEnd + copied) % m_window.size();
+                const std::size_t length = std::min(*count - copied, m_window.size() - offset);
+                std::memcpy(m_window.data() + offset, chunk.data() + copied, length);
+                copied += length;
+            }
+
+            m_windowEnd += *count;
+            m_windowBegin = std::max(m_windowBegin, m_windowEnd - std::min(m_windowEnd, m_window.size()));
+            m_statistics.fetchedSize += *count;
+            m_statistics.endOfStream = m_size.has_value() && m_windowEnd >= *m_size;
+        }
+
+        m_dataCondition.notify_all();
+    }
+}
+
+} // namespace sf
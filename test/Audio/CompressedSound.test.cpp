@@ -0,0 +1,100 @@
+#include <SFML/Audio/CompressedSound.hpp>
+
+// Other 1st party headers
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <AudioUtil.hpp>
+#include <SystemUtil.hpp>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <type_traits>
+
+TEST_CASE("[Audio] sf::CompressedSound", runAudioDeviceTests())
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_constructible_v<sf::CompressedSound, sf::CompressedSoundBuffer&&>);
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::CompressedSound>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::CompressedSound>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::CompressedSound>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::CompressedSound>);
+        STATIC_CHECK(std::has_virtual_destructor_v<sf::CompressedSound>);
+    }
+
+    const auto buffer = sf::CompressedSoundBuffer::loadFromFile("Audio/doodle_pop.ogg").value();
+
+    SECTION("Construction")
+    {
+        const sf::CompressedSound sound(buffer);
+        CHECK(&sound.getBuffer() == &buffer);
+        CHECK(sound.getChannelCount() == 2);
+        CHECK(sound.getSampleRate() == 44100);
+        CHECK(sound.getStatus() == sf::CompressedSound::Status::Stopped);
+        CHECK(sound.getPlayingOffset() == sf::Time::Zero);
+        CHECK(!sound.getLoop());
+    }
+
+    SECTION("Independent voices")
+    {
+        sf::CompressedSound first(buffer);
+        sf::CompressedSound second(buffer);
+        second.setPlayingOffset(sf::seconds(5));
+        CHECK(first.getPlayingOffset() == sf::Time::Zero);
+        CHECK(&first.getBuffer() == &second.getBuffer());
+    }
+
+    SECTION("play/stop")
+    {
+        sf::CompressedSound sound(buffer);
+
+        // The buffer is decoded while playing
+        sound.play();
+        for (int i = 0; (i < 100) && (sound.getPlayingOffset() == sf::Time::Zero); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(sound.getStatus() == sf::CompressedSound::Status::Playing);
+        CHECK(sound.getPlayingOffset() > sf::Time::Zero);
+        CHECK(sound.getPlayingOffset() < buffer.getDuration());
+
+        sound.stop();
+        while (sound.getStatus() != sf::CompressedSound::Status::Stopped)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(sound.getPlayingOffset() == sf::Time::Zero);
+    }
+
+    SECTION("Move buffer")
+    {
+        std::optional<sf::CompressedSoundBuffer> source = buffer;
+        sf::CompressedSound                      sound(*source);
+        sound.play();
+
+        // The sound follows the buffer and keeps decoding from it
+        const sf::CompressedSoundBuffer moved(std::move(*source));
+        source.reset();
+        CHECK(&sound.getBuffer() == &moved);
+        CHECK(sound.getStatus() == sf::CompressedSound::Status::Playing);
+
+        for (int i = 0; (i < 100) && (sound.getPlayingOffset() == sf::Time::Zero); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(sound.getPlayingOffset() > sf::Time::Zero);
+
+        // Moving the sound keeps it attached to the buffer
+        const sf::CompressedSound movedSound(std::move(sound));
+        CHECK(&movedSound.getBuffer() == &moved);
+    }
+
+    SECTION("Destroy buffer")
+    {
+        std::optional<sf::CompressedSoundBuffer> source = buffer;
+        sf::CompressedSound                      sound(*source);
+        sound.play();
+
+        // The sound is stopped instead of decoding freed data
+        source.reset();
+        CHECK(sound.getStatus() == sf::CompressedSound::Status::Stopped);
+        CHECK(sound.getPlayingOffset() == sf::Time::Zero);
+    }
+}
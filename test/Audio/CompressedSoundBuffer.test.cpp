@@ -0,0 +1,74 @@
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+
+// Other 1st party headers
+#include <SFML/System/FileInputStream.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <AudioUtil.hpp>
+#include <SystemUtil.hpp>
+#include <array>
+#include <filesystem>
+#include <type_traits>
+
+TEST_CASE("[Audio] sf::CompressedSoundBuffer")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_default_constructible_v<sf::CompressedSoundBuffer>);
+        STATIC_CHECK(std::is_copy_constructible_v<sf::CompressedSoundBuffer>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::CompressedSoundBuffer>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::CompressedSoundBuffer>);
+        STATIC_CHECK(!std::is_move_assignable_v<sf::CompressedSoundBuffer>);
+    }
+
+    SECTION("loadFromFile()")
+    {
+        SECTION("Invalid filename")
+        {
+            CHECK(!sf::CompressedSoundBuffer::loadFromFile("does/not/exist.ogg"));
+        }
+
+        SECTION("Valid file")
+        {
+            const auto buffer = sf::CompressedSoundBuffer::loadFromFile("Audio/doodle_pop.ogg").value();
+            CHECK(buffer.getData() != nullptr);
+            CHECK(buffer.getDataSize() == std::filesystem::file_size("Audio/doodle_pop.ogg"));
+            CHECK(buffer.getSampleCount() == 2116992);
+            CHECK(buffer.getSampleRate() == 44100);
+            CHECK(buffer.getChannelCount() == 2);
+            CHECK(buffer.getDuration() == sf::microseconds(24002176));
+        }
+    }
+
+    SECTION("loadFromMemory()")
+    {
+        SECTION("Invalid memory")
+        {
+            constexpr std::array<std::byte, 5> memory{};
+            CHECK(!sf::CompressedSoundBuffer::loadFromMemory(memory.data(), memory.size()));
+        }
+
+        SECTION("Valid memory")
+        {
+            const auto memory = loadIntoMemory("Audio/ding.flac");
+            const auto buffer = sf::CompressedSoundBuffer::loadFromMemory(memory.data(), memory.size()).value();
+            CHECK(buffer.getDataSize() == memory.size());
+            CHECK(buffer.getSampleCount() == 87798);
+            CHECK(buffer.getSampleRate() == 44100);
+            CHECK(buffer.getChannelCount() == 1);
+            CHECK(buffer.getDuration() == sf::microseconds(1990884));
+        }
+    }
+
+    SECTION("loadFromStream()")
+    {
+        auto       stream = sf::FileInputStream::open("Audio/ding.flac").value();
+        const auto buffer = sf::CompressedSoundBuffer::loadFromStream(stream).value();
+        CHECK(buffer.getDataSize() == stream.getSize().value());
+        CHECK(buffer.getSampleCount() == 87798);
+        CHECK(buffer.getSampleRate() == 44100);
+        CHECK(buffer.getChannelCount() == 1);
+        CHECK(buffer.getDuration() == sf::microseconds(1990884));
+    }
+}
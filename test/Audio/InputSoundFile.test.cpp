@@ -1,15 +1,22 @@
 #include <SFML/Audio/InputSoundFile.hpp>
 
 // Other 1st party headers
+#include <SFML/Audio/OutputSoundFile.hpp>
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/Time.hpp>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <SystemUtil.hpp>
+#include <algorithm>
 #include <array>
+#include <filesystem>
 #include <fstream>
 #include <type_traits>
+#include <vector>
+
+#include <cstdint>
 
 TEST_CASE("[Audio] sf::InputSoundFile")
 {
@@ -74,6 +81,44 @@ TEST_CASE("[Audio] sf::InputSoundFile")
                 CHECK(inputSoundFile.getTimeOffset() == sf::Time::Zero);
                 CHECK(inputSoundFile.getSampleOffset() == 0);
             }
+
+            SECTION("opus")
+            {
+                // Encode the FLAC file, then decode it back
+                auto                      flacFile = sf::InputSoundFile::openFromFile("Audio/ding.flac").value();
+                std::vector<std::int16_t> samples(static_cast<std::size_t>(flacFile.getSampleCount()));
+                REQUIRE(flacFile.read(samples.data(), samples.size()) == samples.size());
+
+                const auto filename = std::filesystem::temp_directory_path() / "sfml-ding.opus";
+                auto outputSoundFile = sf::OutputSoundFile::openFromFile(filename, 44'100, 1, {sf::SoundChannel::Mono});
+#ifdef SFML_USE_OPUS
+                REQUIRE(outputSoundFile);
+                outputSoundFile->write(samples.data(), samples.size());
+                outputSoundFile->close();
+
+                {
+                    // Opus always decodes at 48 kHz
+                    auto inputSoundFile = sf::InputSoundFile::openFromFile(filename).value();
+                    CHECK(inputSoundFile.getChannelCount() == 1);
+                    CHECK(inputSoundFile.getSampleRate() == 48'000);
+                    CHECK(inputSoundFile.getDuration() > sf::milliseconds(1'950));
+                    CHECK(inputSoundFile.getDuration() < sf::milliseconds(2'050));
+
+                    // Every input sample is decoded, converted to 48 kHz
+                    CHECK(inputSoundFile.getSampleCount() == samples.size() * 48'000 / 44'100);
+
+                    // Lossy, but the ding is still there
+                    std::vector<std::int16_t> decoded(static_cast<std::size_t>(inputSoundFile.getSampleCount()));
+                    CHECK(inputSoundFile.read(decoded.data(), decoded.size()) == decoded.size());
+                    CHECK(*std::max_element(decoded.begin(), decoded.end()) > 1'000);
+                }
+
+                CHECK(std::filesystem::remove(filename));
+#else
+                // Without Opus support, there is no writer for the format
+                CHECK(!outputSoundFile);
+#endif
+            }
         }
     }
 
@@ -251,3 +296,27 @@ TEST_CASE("[Audio] sf::InputSoundFile")
         CHECK(inputSoundFile.getSampleOffset() == 0);
     }
 }
+
+TEST_CASE("[Audio] sf::InputSoundFile decode benchmark", "[.benchmark]")
+{
+    // Decode whole files from memory, so that only the decoding and sample conversion is measured
+    const auto benchmarkDecode = [](const char* name, const std::filesystem::path& filename)
+    {
+        const auto                memory = loadIntoMemory(filename);
+        std::vector<std::int16_t> samples(4096);
+
+        BENCHMARK(name)
+        {
+            auto          inputSoundFile = sf::InputSoundFile::openFromMemory(memory.data(), memory.size()).value();
+            std::uint64_t total          = 0;
+            while (const std::uint64_t count = inputSoundFile.read(samples.data(), samples.size()))
+                total += count;
+            return total;
+        };
+    };
+
+    benchmarkDecode("flac", "Audio/ding.flac");
+    benchmarkDecode("mp3", "Audio/ding.mp3");
+    benchmarkDecode("ogg", "Audio/doodle_pop.ogg");
+    benchmarkDecode("wav", "Audio/killdeer.wav");
+}
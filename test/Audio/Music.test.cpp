@@ -93,6 +93,24 @@ TEST_CASE("[Audio] sf::Music", runAudioDeviceTests())
         CHECK(music.getStatus() == sf::Music::Status::Stopped);
         CHECK(music.getPlayingOffset() == sf::Time::Zero);
         CHECK(!music.getLoop());
+        CHECK(!music.isBuffering());
+        CHECK(!music.getReadAheadStatistics().has_value());
+    }
+
+    SECTION("openFromStream() with read-ahead")
+    {
+        auto       stream = sf::FileInputStream::open("Audio/doodle_pop.ogg").value();
+        const auto music  = sf::Music::openFromStream(stream, 64 * 1024).value();
+        CHECK(music.getDuration() == sf::microseconds(24002176));
+        CHECK(music.getChannelCount() == 2);
+        CHECK(music.getSampleRate() == 44100);
+        CHECK(music.getStatus() == sf::Music::Status::Stopped);
+        CHECK(!music.isBuffering());
+
+        const auto statistics = music.getReadAheadStatistics().value();
+        CHECK(statistics.windowSize == 64 * 1024);
+        CHECK(statistics.fetchedSize > 0);
+        CHECK(!statistics.error);
     }
 
     SECTION("play/pause/stop")
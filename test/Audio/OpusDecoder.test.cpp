@@ -0,0 +1,65 @@
+#include <SFML/Audio/OpusDecoder.hpp>
+
+// Other 1st party headers
+#include <SFML/Audio/OpusEncoder.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <type_traits>
+
+#include <cmath>
+
+TEST_CASE("[Audio] sf::OpusDecoder")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_default_constructible_v<sf::OpusDecoder>);
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::OpusDecoder>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::OpusDecoder>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::OpusDecoder>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::OpusDecoder>);
+    }
+
+    SECTION("create()")
+    {
+        CHECK(!sf::OpusDecoder::create(22050, 1));
+        CHECK(!sf::OpusDecoder::create(48000, 0));
+        CHECK(!sf::OpusDecoder::create(48000, 3));
+    }
+
+    SECTION("decode()")
+    {
+        auto encoder = sf::OpusEncoder::create(48000, 1);
+        auto decoder = sf::OpusDecoder::create(48000, 1);
+#ifdef SFML_USE_OPUS
+        REQUIRE(encoder);
+        REQUIRE(decoder);
+#else
+        // Without Opus support, creation always fails
+        CHECK(!encoder);
+        CHECK(!decoder);
+        return;
+#endif
+
+        // 20 ms of a 440 Hz sine wave
+        std::array<std::int16_t, 960> samples{};
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            const double time = static_cast<double>(i) / 48000;
+            samples[i]        = static_cast<std::int16_t>(10000 * std::sin(2 * 3.14159265358979323846 * 440 * time));
+        }
+
+        std::array<std::uint8_t, sf::OpusEncoder::MaxPacketSize> packet{};
+        const auto packetSize = encoder->encode(samples.data(), samples.size(), packet.data(), packet.size());
+        REQUIRE(packetSize);
+        CHECK(*packetSize > 0);
+        CHECK(*packetSize < samples.size() * sizeof(std::int16_t) / 10);
+
+        std::array<std::int16_t, 48000 * 120 / 1000> decoded{};
+        CHECK(decoder->decode(packet.data(), *packetSize, decoded.data(), decoded.size()) == 960);
+
+        // Packet loss concealment
+        CHECK(decoder->decode(nullptr, 0, decoded.data(), 960) == 960);
+    }
+}
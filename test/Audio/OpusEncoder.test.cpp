@@ -0,0 +1,41 @@
+#include <SFML/Audio/OpusEncoder.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <type_traits>
+
+TEST_CASE("[Audio] sf::OpusEncoder")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_default_constructible_v<sf::OpusEncoder>);
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::OpusEncoder>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::OpusEncoder>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::OpusEncoder>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::OpusEncoder>);
+    }
+
+    SECTION("create()")
+    {
+        SECTION("Invalid parameters")
+        {
+            CHECK(!sf::OpusEncoder::create(44100, 1));
+            CHECK(!sf::OpusEncoder::create(48000, 0));
+            CHECK(!sf::OpusEncoder::create(48000, 3));
+        }
+
+        SECTION("Valid parameters")
+        {
+            auto encoder = sf::OpusEncoder::create(48000, 2, sf::OpusEncoder::Application::Audio);
+#ifdef SFML_USE_OPUS
+            REQUIRE(encoder);
+            CHECK(encoder->getSampleRate() == 48000);
+            CHECK(encoder->getChannelCount() == 2);
+            CHECK(encoder->setBitrate(64000));
+#else
+            // Without Opus support, creation always fails
+            CHECK(!encoder);
+#endif
+        }
+    }
+}
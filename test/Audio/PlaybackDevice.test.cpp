@@ -0,0 +1,150 @@
+#include <SFML/Audio/PlaybackDevice.hpp>
+
+// Other 1st party headers
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <AudioUtil.hpp>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+namespace
+{
+// Plays a quiet tone, with a hole every other chunk and a chunk that takes longer than any period to produce
+class SlowStream : public sf::SoundStream
+{
+public:
+    SlowStream() : m_samples(441, 100)
+    {
+        initialize(1, 44100, {sf::SoundChannel::Mono});
+    }
+
+    ~SlowStream() override
+    {
+        stop();
+    }
+
+    [[nodiscard]] int getChunkCount() const
+    {
+        return m_chunkCount;
+    }
+
+    static constexpr int slowChunk = 10;
+
+private:
+    [[nodiscard]] bool onGetData(Chunk& data) override
+    {
+        ++m_chunkCount;
+
+        if (m_chunkCount == slowChunk)
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        if (m_chunkCount % 2 == 0)
+            return true;
+
+        data.samples     = m_samples.data();
+        data.sampleCount = m_samples.size();
+        return true;
+    }
+
+    void onSeek(sf::Time /* timeOffset */) override
+    {
+    }
+
+    std::vector<std::int16_t> m_samples;
+    std::atomic<int>          m_chunkCount{};
+};
+} // namespace
+
+TEST_CASE("[Audio] sf::priv::AudioDevice")
+{
+    SECTION("getLoadHistogramBucket()")
+    {
+        using sf::priv::AudioDevice;
+        constexpr std::int64_t period = 10'000;
+        constexpr auto         last   = sf::PlaybackDevice::Statistics::HistogramSize - 1;
+
+        CHECK(AudioDevice::getLoadHistogramBucket(0, period) == 0);
+        CHECK(AudioDevice::getLoadHistogramBucket(999, period) == 0);
+        CHECK(AudioDevice::getLoadHistogramBucket(1000, period) == 1);
+        CHECK(AudioDevice::getLoadHistogramBucket(5500, period) == 5);
+        CHECK(AudioDevice::getLoadHistogramBucket(9999, period) == last - 1);
+
+        // A period that takes exactly its duration meets its deadline
+        CHECK(AudioDevice::getLoadHistogramBucket(period, period) == last - 1);
+        CHECK(AudioDevice::getLoadHistogramBucket(period + 1, period) == last);
+        CHECK(AudioDevice::getLoadHistogramBucket(1'000'000, period) == last);
+
+        // Empty periods
+        CHECK(AudioDevice::getLoadHistogramBucket(0, 0) == 0);
+        CHECK(AudioDevice::getLoadHistogramBucket(1, 0) == last);
+    }
+}
+
+TEST_CASE("[Audio] sf::PlaybackDevice statistics", runAudioDeviceTests())
+{
+    sf::PlaybackDevice::resetStatistics();
+
+    sf::SoundSource::Statistics source;
+    {
+        SlowStream stream;
+        stream.play();
+
+        // Wait until the slow chunk has been produced, however long the machine takes to get there
+        for (int i = 0; (i < 1000) && (stream.getChunkCount() <= SlowStream::slowChunk); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(stream.getChunkCount() > SlowStream::slowChunk);
+
+        stream.stop();
+        source = stream.getStatistics();
+    }
+
+    // The stream was the only audio resource, so the playback device is closed and the statistics are final
+    const sf::PlaybackDevice::Statistics statistics = sf::PlaybackDevice::getStatistics();
+
+    SECTION("Playback device")
+    {
+        CHECK(statistics.periodCount > 0);
+        CHECK(statistics.periodDuration > sf::Time::Zero);
+        CHECK(statistics.activeVoiceCount <= 1);
+        CHECK(statistics.underrunCount > 0);
+
+        // The slow chunk was produced by the audio thread, its period slept longer than any period lasts
+        CHECK(statistics.deadlineMissCount > 0);
+        CHECK(statistics.maxCallbackDuration >= statistics.lastCallbackDuration);
+
+        // Every period lands in exactly one bucket, and the last one holds exactly the missed deadlines
+        const auto& histogram = statistics.callbackLoadHistogram;
+        CHECK(std::accumulate(histogram.begin(), histogram.end(), std::uint64_t{0}) == statistics.periodCount);
+        CHECK(histogram.back() == statistics.deadlineMissCount);
+    }
+
+    SECTION("Sound source")
+    {
+        CHECK(source.underrunCount > 0);
+        CHECK(source.maxProcessingTime > sf::Time::Zero);
+        CHECK(source.processingTime >= source.maxProcessingTime);
+    }
+
+    SECTION("resetStatistics()")
+    {
+        sf::PlaybackDevice::resetStatistics();
+        const sf::PlaybackDevice::Statistics reset = sf::PlaybackDevice::getStatistics();
+        CHECK(reset.periodCount == 0);
+        CHECK(reset.deadlineMissCount == 0);
+        CHECK(reset.underrunCount == 0);
+        CHECK(reset.activeVoiceCount == 0);
+        CHECK(reset.periodDuration == sf::Time::Zero);
+        CHECK(reset.lastCallbackDuration == sf::Time::Zero);
+        CHECK(reset.maxCallbackDuration == sf::Time::Zero);
+        const auto& histogram = reset.callbackLoadHistogram;
+        CHECK(std::accumulate(histogram.begin(), histogram.end(), std::uint64_t{0}) == 0);
+    }
+}
@@ -0,0 +1,240 @@
+#include <SFML/Audio/SampleConversion.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// The x86 kernels convert blocks of 4 or 8 samples and leave the rest to the scalar loop,
+// so every result is compared with a plain scalar conversion, for sizes that leave every possible tail
+namespace
+{
+constexpr std::size_t  maxFrameCount   = 21;
+constexpr unsigned int maxChannelCount = 3;
+
+std::vector<std::int16_t> makeSamples(std::size_t count, std::minstd_rand& random)
+{
+    std::uniform_int_distribution<int> distribution(std::numeric_limits<std::int16_t>::min(),
+                                                    std::numeric_limits<std::int16_t>::max());
+
+    std::vector<std::int16_t> samples(count);
+    for (std::int16_t& sample : samples)
+        sample = static_cast<std::int16_t>(distribution(random));
+
+    // Full scale in both directions, so that short inputs cover them too
+    const std::int16_t extremes[] = {std::numeric_limits<std::int16_t>::max(),
+                                     std::numeric_limits<std::int16_t>::min(),
+                                     -std::numeric_limits<std::int16_t>::max()};
+    for (std::size_t i = 0; (i < count) && (i < std::size(extremes)); ++i)
+        samples[i] = extremes[i];
+
+    return samples;
+}
+
+// Identity, reversed and rotated channels, which take different paths in the kernels
+std::vector<std::vector<std::size_t>> makeRemapTables(unsigned int channelCount)
+{
+    std::vector<std::vector<std::size_t>> tables(channelCount > 2 ? 3 : 2, std::vector<std::size_t>(channelCount));
+    for (std::size_t i = 0; i < channelCount; ++i)
+    {
+        tables[0][i] = i;
+        tables[1][i] = channelCount - 1 - i;
+        if (channelCount > 2)
+            tables[2][i] = (i + 1) % channelCount;
+    }
+
+    return tables;
+}
+} // namespace
+
+TEST_CASE("[Audio] sf::priv::SampleConversion")
+{
+    namespace SampleConversion = sf::priv::SampleConversion;
+
+    std::minstd_rand random(42);
+
+    SECTION("interleaveToInt16()")
+    {
+        for (const unsigned int bitsPerSample : {8u, 16u, 24u, 32u})
+        {
+            const auto max = static_cast<std::int32_t>((std::int64_t{1} << (bitsPerSample - 1)) - 1);
+            std::uniform_int_distribution<std::int32_t> distribution(-max - 1, max);
+            const int                                   shift = static_cast<int>(bitsPerSample) - 16;
+
+            for (unsigned int channelCount = 1; channelCount <= maxChannelCount; ++channelCount)
+            {
+                for (std::size_t frameCount = 1; frameCount <= maxFrameCount; ++frameCount)
+                {
+                    std::vector<std::vector<std::int32_t>> planes(channelCount, std::vector<std::int32_t>(frameCount));
+                    std::vector<const std::int32_t*>       pointers;
+                    for (std::vector<std::int32_t>& plane : planes)
+                    {
+                        for (std::int32_t& sample : plane)
+                            sample = distribution(random);
+
+                        if (frameCount >= 2)
+                        {
+                            plane[0] = max;
+                            plane[1] = -max - 1;
+                        }
+
+                        pointers.push_back(plane.data());
+                    }
+
+                    std::vector<std::int16_t> output(frameCount * channelCount);
+                    SampleConversion::interleaveToInt16(pointers.data(),
+                                                        channelCount,
+                                                        frameCount,
+                                                        bitsPerSample,
+                                                        output.data());
+
+                    for (std::size_t frame = 0; frame < frameCount; ++frame)
+                    {
+                        for (std::size_t channel = 0; channel < channelCount; ++channel)
+                        {
+                            const std::int32_t sample   = planes[channel][frame];
+                            const std::int32_t expected = shift >= 0 ? sample >> shift : sample * (1 << -shift);
+                            CHECK(output[frame * channelCount + channel] == static_cast<std::int16_t>(expected));
+                        }
+                    }
+
+                    // The most negative sample stays at full scale, whatever the bit depth
+                    if (frameCount >= 2)
+                        CHECK(output[channelCount] == std::numeric_limits<std::int16_t>::min());
+                }
+            }
+        }
+    }
+
+    SECTION("remap()")
+    {
+        for (unsigned int channelCount = 1; channelCount <= maxChannelCount; ++channelCount)
+        {
+            for (const std::vector<std::size_t>& remapTable : makeRemapTables(channelCount))
+            {
+                for (std::size_t frameCount = 1; frameCount <= maxFrameCount; ++frameCount)
+                {
+                    const std::vector<std::int16_t> input = makeSamples(frameCount * channelCount, random);
+                    std::vector<std::int16_t>       output(input.size());
+                    SampleConversion::remap(input.data(), frameCount, remapTable.data(), channelCount, output.data());
+
+                    for (std::size_t frame = 0; frame < frameCount; ++frame)
+                    {
+                        for (std::size_t channel = 0; channel < channelCount; ++channel)
+                            CHECK(output[frame * channelCount + channel] ==
+                                  input[frame * channelCount + remapTable[channel]]);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("remapToInt32()")
+    {
+        for (unsigned int channelCount = 1; channelCount <= maxChannelCount; ++channelCount)
+        {
+            for (const std::vector<std::size_t>& remapTable : makeRemapTables(channelCount))
+            {
+                for (std::size_t frameCount = 1; frameCount <= maxFrameCount; ++frameCount)
+                {
+                    const std::vector<std::int16_t> input = makeSamples(frameCount * channelCount, random);
+                    std::vector<std::int32_t>       output(input.size());
+                    SampleConversion::remapToInt32(input.data(),
+                                                   frameCount,
+                                                   remapTable.data(),
+                                                   channelCount,
+                                                   output.data());
+
+                    for (std::size_t frame = 0; frame < frameCount; ++frame)
+                    {
+                        for (std::size_t channel = 0; channel < channelCount; ++channel)
+                            CHECK(output[frame * channelCount + channel] ==
+                                  std::int32_t{input[frame * channelCount + remapTable[channel]]});
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("remapToPlanarFloat()")
+    {
+        for (unsigned int channelCount = 1; channelCount <= maxChannelCount; ++channelCount)
+        {
+            for (const std::vector<std::size_t>& remapTable : makeRemapTables(channelCount))
+            {
+                for (std::size_t frameCount = 1; frameCount <= maxFrameCount; ++frameCount)
+                {
+                    const std::vector<std::int16_t> input = makeSamples(frameCount * channelCount, random);
+                    std::vector<std::vector<float>> planes(channelCount, std::vector<float>(frameCount));
+                    std::vector<float*>             pointers;
+                    for (std::vector<float>& plane : planes)
+                        pointers.push_back(plane.data());
+
+                    SampleConversion::remapToPlanarFloat(input.data(),
+                                                         frameCount,
+                                                         remapTable.data(),
+                                                         channelCount,
+                                                         pointers.data());
+
+                    // Both paths divide by the same value, so the results are exactly equal
+                    for (std::size_t frame = 0; frame < frameCount; ++frame)
+                    {
+                        for (std::size_t channel = 0; channel < channelCount; ++channel)
+                            CHECK(planes[channel][frame] ==
+                                  static_cast<float>(input[frame * channelCount + remapTable[channel]]) / 32767.f);
+                    }
+                }
+            }
+        }
+
+        // Full scale maps exactly to +1 and -1 in the vector loop and in the tail,
+        // only the most negative sample goes slightly below -1
+        for (const std::size_t frameCount : {8u, 9u, 11u})
+        {
+            std::vector<std::int16_t> input(frameCount * 2);
+            for (std::size_t i = 0; i < input.size(); ++i)
+                input[i] = (i % 3 == 0)   ? std::numeric_limits<std::int16_t>::max()
+                           : (i % 3 == 1) ? -std::numeric_limits<std::int16_t>::max()
+                                          : std::numeric_limits<std::int16_t>::min();
+
+            std::vector<float>             left(frameCount);
+            std::vector<float>             right(frameCount);
+            const std::vector<float*>      pointers{left.data(), right.data()};
+            const std::vector<std::size_t> remapTable{0, 1};
+            SampleConversion::remapToPlanarFloat(input.data(), frameCount, remapTable.data(), 2, pointers.data());
+
+            for (std::size_t i = 0; i < input.size(); ++i)
+            {
+                const float value = (i % 2 == 0) ? left[i / 2] : right[i / 2];
+                if (i % 3 == 0)
+                    CHECK(value == 1.f);
+                else if (i % 3 == 1)
+                    CHECK(value == -1.f);
+                else
+                    CHECK(value == -32768.f / 32767.f);
+            }
+        }
+    }
+
+    SECTION("toLittleEndian()")
+    {
+        for (std::size_t count = 1; count <= maxFrameCount; ++count)
+        {
+            const std::vector<std::int16_t> input = makeSamples(count, random);
+            std::vector<std::byte>          output(count * 2);
+            SampleConversion::toLittleEndian(input.data(), count, output.data());
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto value = static_cast<std::uint16_t>(input[i]);
+                CHECK(output[i * 2] == static_cast<std::byte>(value & 0xFF));
+                CHECK(output[i * 2 + 1] == static_cast<std::byte>(value >> 8));
+            }
+        }
+    }
+}
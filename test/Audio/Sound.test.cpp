@@ -5,11 +5,15 @@
 
 #include <SFML/System/Time.hpp>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <AudioUtil.hpp>
 #include <SystemUtil.hpp>
+#include <chrono>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 TEST_CASE("[Audio] sf::Sound", runAudioDeviceTests())
 {
@@ -34,6 +38,8 @@ TEST_CASE("[Audio] sf::Sound", runAudioDeviceTests())
         CHECK(!sound.getLoop());
         CHECK(sound.getPlayingOffset() == sf::Time::Zero);
         CHECK(sound.getStatus() == sf::Sound::Status::Stopped);
+        CHECK(sound.getStatistics().processingTime == sf::Time::Zero);
+        CHECK(sound.getStatistics().underrunCount == 0);
     }
 
     SECTION("Copy semantics")
@@ -82,4 +88,62 @@ TEST_CASE("[Audio] sf::Sound", runAudioDeviceTests())
         sound.setPlayingOffset(sf::seconds(10));
         CHECK(sound.getPlayingOffset() == sf::seconds(10));
     }
+
+    SECTION("setSpatialStates()")
+    {
+        sf::Sound sound(soundBuffer);
+        sound.setPosition({1, 2, 3});
+
+        const sf::SoundSource::SpatialState state{&sound, {4, 5, 6}, {7, 8, 9}, {0, 1, 0}};
+        sf::SoundSource::setSpatialStates(&state, 1);
+
+        // The batch is applied by the audio thread at the start of the next period
+        for (int i = 0; (i < 100) && (sound.getPosition() != state.position); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CHECK(sound.getPosition() == state.position);
+        CHECK(sound.getVelocity() == state.velocity);
+        CHECK(sound.getDirection() == state.direction);
+
+        // Updates that pile up before the audio thread applies them are replaced by the latest one
+        const std::vector<sf::SoundSource::SpatialState> states{{&sound, {1, 1, 1}, {}, {0, 0, -1}},
+                                                               {&sound, {2, 2, 2}, {}, {0, 0, -1}}};
+        sf::SoundSource::setSpatialStates(states.data(), states.size());
+        const sf::SoundSource::SpatialState latest{&sound, {3, 3, 3}, {1, 0, 0}, {1, 0, 0}};
+        sf::SoundSource::setSpatialStates(&latest, 1);
+
+        for (int i = 0; (i < 100) && (sound.getPosition() != latest.position); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CHECK(sound.getPosition() == latest.position);
+        CHECK(sound.getVelocity() == latest.velocity);
+        CHECK(sound.getDirection() == latest.direction);
+    }
+}
+
+TEST_CASE("[Audio] sf::Sound spatial state benchmark", "[.benchmark]")
+{
+    const auto soundBuffer = sf::SoundBuffer::loadFromFile("Audio/ding.flac").value();
+
+    std::vector<sf::Sound> sounds(2000, sf::Sound(soundBuffer));
+
+    std::vector<sf::SoundSource::SpatialState> states;
+    states.reserve(sounds.size());
+    for (auto& sound : sounds)
+        states.push_back({&sound, {1, 2, 3}, {4, 5, 6}, {0, 0, -1}});
+
+    BENCHMARK("2000 emitters, individual setters")
+    {
+        for (auto& state : states)
+        {
+            state.source->setPosition(state.position);
+            state.source->setVelocity(state.velocity);
+            state.source->setDirection(state.direction);
+        }
+    };
+
+    BENCHMARK("2000 emitters, setSpatialStates")
+    {
+        sf::SoundSource::setSpatialStates(states.data(), states.size());
+    };
 }
@@ -0,0 +1,126 @@
+#include <SFML/Audio/SoundAnalyzer.hpp>
+
+// Other 1st party headers
+#include <SFML/Audio/PlaybackDevice.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <AudioUtil.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cmath>
+
+namespace
+{
+std::vector<float> makeSine(double frequency, unsigned int sampleRate, unsigned int channelCount, unsigned int frameCount)
+{
+    std::vector<float> samples(std::size_t{frameCount} * channelCount);
+
+    for (unsigned int frame = 0; frame < frameCount; ++frame)
+    {
+        const auto value = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * frequency * frame / sampleRate));
+        std::fill_n(samples.begin() + static_cast<std::ptrdiff_t>(frame * channelCount), channelCount, value);
+    }
+
+    return samples;
+}
+} // namespace
+
+TEST_CASE("[Audio] sf::SoundAnalyzer")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::SoundAnalyzer>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::SoundAnalyzer>);
+        STATIC_CHECK(!std::is_move_constructible_v<sf::SoundAnalyzer>);
+        STATIC_CHECK(!std::is_move_assignable_v<sf::SoundAnalyzer>);
+    }
+
+    SECTION("Construction")
+    {
+        CHECK(sf::SoundAnalyzer().getFftSize() == 1024);
+        CHECK(sf::SoundAnalyzer(1000).getFftSize() == 1024);
+        CHECK(sf::SoundAnalyzer(1).getFftSize() == 64);
+        CHECK(sf::SoundAnalyzer(1'000'000).getFftSize() == 16384);
+
+        sf::SoundAnalyzer                analyzer(512);
+        const sf::SoundAnalyzer::Result& result = analyzer.getResult();
+        CHECK(result.spectrum.size() == 256);
+        CHECK(result.rms == 0);
+        CHECK(result.peak == 0);
+        CHECK(result.loudness == -70);
+        CHECK(result.sampleRate == 0);
+    }
+
+    SECTION("process()")
+    {
+        sf::SoundAnalyzer analyzer(1024);
+
+        // Full-scale 1 kHz stereo sine wave, fed in 10 ms chunks
+        const auto samples = makeSine(1000, 48000, 2, 48000);
+        for (unsigned int frame = 0; frame < 48000; frame += 480)
+            analyzer.process(samples.data() + frame * 2, 480, 2, 48000);
+
+        const sf::SoundAnalyzer::Result& result = analyzer.getResult();
+        REQUIRE(result.spectrum.size() == 512);
+        CHECK(result.sampleRate == 48000);
+
+        const auto   peakBin       = std::max_element(result.spectrum.begin(), result.spectrum.end());
+        const double peakFrequency = static_cast<double>(peakBin - result.spectrum.begin()) * 48000 / 1024;
+        CHECK(std::abs(peakFrequency - 1000) < 48000.0 / 1024);
+        CHECK(*peakBin > 0.8f);
+        CHECK(std::abs(result.rms - 0.7071f) < 0.01f);
+        CHECK(std::abs(result.peak - 1.f) < 0.01f);
+
+        // A full-scale 1 kHz sine wave measures -3.01 LUFS per channel
+        CHECK(std::abs(result.loudness) < 0.1f);
+
+        // Silence brings the loudness back to its floor
+        const std::vector<float> silence(48000 * 2);
+        analyzer.process(silence.data(), 48000, 2, 48000);
+        CHECK(analyzer.getResult().loudness == -70);
+        CHECK(analyzer.getResult().peak == 0);
+    }
+}
+
+TEST_CASE("[Audio] sf::SoundAnalyzer attachment", runAudioDeviceTests())
+{
+    const auto soundBuffer = sf::SoundBuffer::loadFromFile("Audio/ding.flac").value();
+    sf::Sound  sound(soundBuffer);
+    sound.setLoop(true);
+    sound.play();
+
+    SECTION("Detach from a playing sound")
+    {
+        // Detaching waits for the audio thread, so the analyzer can be destroyed right away
+        for (int i = 0; i < 50; ++i)
+        {
+            auto analyzer = std::make_unique<sf::SoundAnalyzer>(256);
+            sound.setAnalyzer(analyzer.get());
+            std::this_thread::sleep_for(std::chrono::milliseconds(i % 3));
+            sound.setAnalyzer(nullptr);
+            analyzer.reset();
+        }
+    }
+
+    SECTION("Detach from the playback device")
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            auto analyzer = std::make_unique<sf::SoundAnalyzer>(256);
+            sf::PlaybackDevice::setAnalyzer(analyzer.get());
+            std::this_thread::sleep_for(std::chrono::milliseconds(i % 3));
+            sf::PlaybackDevice::setAnalyzer(nullptr);
+            analyzer.reset();
+        }
+    }
+
+    CHECK(sound.getStatus() == sf::Sound::Status::Playing);
+}
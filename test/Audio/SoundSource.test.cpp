@@ -58,6 +58,9 @@ TEST_CASE("[Audio] sf::SoundSource", runAudioDeviceTests())
         CHECK(soundSource.getMinDistance() == 0);
         CHECK(soundSource.getAttenuation() == 0);
         CHECK(soundSource.getStatus() == sf::SoundSource::Status::Stopped);
+        CHECK(soundSource.getStatistics().processingTime == sf::Time::Zero);
+        CHECK(soundSource.getStatistics().maxProcessingTime == sf::Time::Zero);
+        CHECK(soundSource.getStatistics().underrunCount == 0);
     }
 
     SECTION("Copy semantics")
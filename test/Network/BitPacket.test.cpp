@@ -0,0 +1,410 @@
+#include <SFML/Network/BitPacket.hpp>
+
+// Other 1st party headers
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+struct Entity
+{
+    std::int64_t id{};
+    float        x{};
+    float        y{};
+    float        z{};
+    std::int64_t health{};
+    bool         isMoving{};
+};
+
+std::vector<Entity> makeEntities(std::size_t count)
+{
+    std::vector<Entity> entities(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto value = static_cast<float>(i);
+        entities[i]      = {static_cast<std::int64_t>(i), value * 3.5f, -value, value * 0.25f, 100, i % 2 == 0};
+    }
+    return entities;
+}
+
+void write(sf::BitPacket& packet, const std::vector<Entity>& entities)
+{
+    for (const Entity& entity : entities)
+    {
+        packet.writeInteger(entity.id, 0, 1023);
+        packet.writeFloat(entity.x, -1000.f, 1000.f, 0.01f);
+        packet.writeFloat(entity.y, -1000.f, 1000.f, 0.01f);
+        packet.writeFloat(entity.z, -1000.f, 1000.f, 0.01f);
+        packet.writeInteger(entity.health, 0, 100);
+        packet.writeBool(entity.isMoving);
+    }
+}
+
+void read(sf::BitPacket& packet, std::vector<Entity>& entities)
+{
+    for (Entity& entity : entities)
+    {
+        packet.readInteger(entity.id, 0, 1023);
+        packet.readFloat(entity.x, -1000.f, 1000.f, 0.01f);
+        packet.readFloat(entity.y, -1000.f, 1000.f, 0.01f);
+        packet.readFloat(entity.z, -1000.f, 1000.f, 0.01f);
+        packet.readInteger(entity.health, 0, 100);
+        packet.readBool(entity.isMoving);
+    }
+}
+
+// Gives access to the send and receive hooks, like a socket does
+class TestBitPacket : public sf::BitPacket
+{
+public:
+    using sf::BitPacket::onReceive;
+    using sf::BitPacket::onSend;
+};
+} // namespace
+
+TEST_CASE("[Network] sf::BitPacket")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(std::is_base_of_v<sf::Packet, sf::BitPacket>);
+        STATIC_CHECK(std::is_copy_constructible_v<sf::BitPacket>);
+        STATIC_CHECK(std::is_copy_assignable_v<sf::BitPacket>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::BitPacket>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::BitPacket>);
+    }
+
+    SECTION("Default constructor")
+    {
+        const sf::BitPacket packet;
+        CHECK(packet.getBitSize() == 0);
+        CHECK(packet.getRemainingBits() == 0);
+        CHECK(bool{packet});
+    }
+
+    SECTION("Bits")
+    {
+        sf::BitPacket packet;
+        packet.writeBits(0b101, 3);
+        packet.writeBits(0xFFFFFFFFFFFFFFFF, 64);
+        packet.writeBits(0x1234, 13);
+        packet.writeBool(true);
+        CHECK(packet.getBitSize() == 81);
+        CHECK(packet.getDataSize() == 8);
+
+        std::uint64_t value = 0;
+        CHECK(packet.readBits(value, 3));
+        CHECK(value == 0b101);
+        CHECK(packet.readBits(value, 64));
+        CHECK(value == 0xFFFFFFFFFFFFFFFF);
+        CHECK(packet.readBits(value, 13));
+        CHECK(value == 0x1234);
+
+        bool flag = false;
+        CHECK(packet.readBool(flag));
+        CHECK(flag);
+        CHECK(packet.getRemainingBits() == 0);
+
+        // Reading past the end invalidates the packet without changing the value
+        CHECK(!packet.readBits(value, 1));
+        CHECK(value == 0x1234);
+
+        packet.clear();
+        CHECK(packet.getBitSize() == 0);
+        CHECK(bool{packet});
+    }
+
+    SECTION("Through a Packet reference")
+    {
+        sf::BitPacket packet;
+        sf::Packet&   base = packet;
+        packet.writeBits(0b101, 3);
+
+        // The validity and the bit cursors are the same whichever type the packet is used as
+        std::uint64_t value = 0;
+        CHECK(!packet.readBits(value, 4));
+        CHECK(!base);
+
+        base.clear();
+        CHECK(bool{base});
+        CHECK(bool{packet});
+        CHECK(packet.getBitSize() == 0);
+        CHECK(packet.getRemainingBits() == 0);
+
+        packet.writeBits(0b110, 3);
+        CHECK(packet.readBits(value, 3));
+        CHECK(value == 0b110);
+
+        // Failing to extract regular values invalidates bit reads too
+        std::uint32_t integer = 0;
+        CHECK(!(base >> integer));
+        CHECK(!packet.readBits(value, 0));
+    }
+
+    SECTION("Ranged values")
+    {
+        sf::BitPacket packet;
+        packet.writeInteger(42, 0, 100);
+        packet.writeInteger(-5, -8, 7);
+        packet.writeInteger(1000, 0, 100);
+        packet.writeInteger(std::numeric_limits<std::int64_t>::min(),
+                            std::numeric_limits<std::int64_t>::min(),
+                            std::numeric_limits<std::int64_t>::max());
+        packet.writeInteger(3, 3, 3);
+        CHECK(packet.getBitSize() == 7 + 4 + 7 + 64);
+
+        packet.writeFloat(12.345f, -1000.f, 1000.f, 0.01f);
+        packet.writeFloat(5000.f, -1000.f, 1000.f, 0.01f);
+        packet.writeFloat(0.5f, 0.f, 1.f, 1.f / 255.f);
+        CHECK(packet.getBitSize() == 7 + 4 + 7 + 64 + 18 + 18 + 8);
+
+        std::int64_t integer = 0;
+        CHECK(packet.readInteger(integer, 0, 100));
+        CHECK(integer == 42);
+        CHECK(packet.readInteger(integer, -8, 7));
+        CHECK(integer == -5);
+        CHECK(packet.readInteger(integer, 0, 100));
+        CHECK(integer == 100);
+        CHECK(packet.readInteger(integer,
+                                 std::numeric_limits<std::int64_t>::min(),
+                                 std::numeric_limits<std::int64_t>::max()));
+        CHECK(integer == std::numeric_limits<std::int64_t>::min());
+        CHECK(packet.readInteger(integer, 3, 3));
+        CHECK(integer == 3);
+
+        float number = 0.f;
+        CHECK(packet.readFloat(number, -1000.f, 1000.f, 0.01f));
+        CHECK(number > 12.339f);
+        CHECK(number < 12.351f);
+        CHECK(packet.readFloat(number, -1000.f, 1000.f, 0.01f));
+        CHECK(number == 1000.f);
+        CHECK(packet.readFloat(number, 0.f, 1.f, 1.f / 255.f));
+        CHECK(number > 0.49f);
+        CHECK(number < 0.51f);
+        CHECK(packet.getRemainingBits() == 0);
+    }
+
+    SECTION("Too many quantization steps")
+    {
+        // 10^10 steps don't fit in 32 bits, the values above the last step are clamped to it
+        sf::BitPacket packet;
+        packet.writeFloat(100.f, 0.f, 1e9f, 0.1f);
+        packet.writeFloat(1e9f, 0.f, 1e9f, 0.1f);
+        CHECK(packet.getBitSize() == 64);
+
+        float number = 0.f;
+        CHECK(packet.readFloat(number, 0.f, 1e9f, 0.1f));
+        CHECK(number == 100.f);
+        CHECK(packet.readFloat(number, 0.f, 1e9f, 0.1f));
+        CHECK(number > 4.29e8f);
+        CHECK(number < 4.3e8f);
+    }
+
+    SECTION("Send and receive")
+    {
+        const std::vector<Entity> entities = makeEntities(50);
+
+        TestBitPacket sent;
+        write(sent, entities);
+
+        std::size_t size = 0;
+        const void* data = sent.onSend(size);
+        CHECK(size == 1 + (sent.getBitSize() + 7) / 8);
+
+        TestBitPacket received;
+        received.onReceive(data, size);
+        CHECK(received.getDataSize() == (sent.getBitSize() + 7) / 8);
+
+        std::vector<Entity> result(entities.size());
+        read(received, result);
+        CHECK(bool{received});
+        CHECK(result[10].id == 10);
+        CHECK(result[10].health == 100);
+        CHECK(result[11].isMoving == false);
+    }
+
+    SECTION("Delta encoding")
+    {
+        std::vector<Entity> entities = makeEntities(100);
+
+        sf::BitPacket baseline;
+        write(baseline, entities);
+
+        // Only a few entities change between snapshots
+        entities[3].x += 1.f;
+        entities[50].health = 20;
+
+        TestBitPacket sent;
+        sent.setBaseline(baseline);
+        write(sent, entities);
+
+        std::size_t size = 0;
+        const void* data = sent.onSend(size);
+        CHECK(size < 32);
+
+        // The receiver needs the baseline
+        TestBitPacket withoutBaseline;
+        withoutBaseline.onReceive(data, size);
+        CHECK(!withoutBaseline);
+
+        TestBitPacket received;
+        received.setBaseline(baseline);
+        received.onReceive(data, size);
+        REQUIRE(bool{received});
+        CHECK(received.getBitSize() == (sent.getBitSize() + 7) / 8 * 8);
+
+        std::vector<Entity> result(entities.size());
+        read(received, result);
+        CHECK(bool{received});
+        CHECK(result[3].x > entities[3].x - 0.01f);
+        CHECK(result[3].x < entities[3].x + 0.01f);
+        CHECK(result[50].health == 20);
+        CHECK(result[99].id == 99);
+
+        // A packet longer than its baseline, ending in zeros, compresses far below its size
+        TestBitPacket longer;
+        longer.setBaseline(baseline);
+        write(longer, entities);
+        for (int i = 0; i < 1000; ++i)
+            longer.writeInteger(0, 0, 255);
+
+        data = longer.onSend(size);
+        CHECK(size < 32);
+
+        TestBitPacket longerReceived;
+        longerReceived.setBaseline(baseline);
+        longerReceived.onReceive(data, size);
+        REQUIRE(bool{longerReceived});
+        CHECK(longerReceived.getBitSize() == (longer.getBitSize() + 7) / 8 * 8);
+
+        read(longerReceived, result);
+        std::int64_t value = -1;
+        for (int i = 0; i < 1000; ++i)
+            longerReceived.readInteger(value, 0, 255);
+        CHECK(bool{longerReceived});
+        CHECK(result[50].health == 20);
+        CHECK(value == 0);
+    }
+
+    SECTION("Malformed delta")
+    {
+        sf::BitPacket baseline;
+        baseline.writeBits(0x12345678, 32);
+
+        TestBitPacket received;
+        received.setBaseline(baseline);
+
+        // Run lengths whose sum wraps around, which would move the write position backwards
+        const std::vector<std::uint8_t>
+            wrapping{1, 4, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 1, 0x41};
+        received.onReceive(wrapping.data(), wrapping.size());
+        CHECK(!received);
+        CHECK(received.getDataSize() == 0);
+
+        // Run length encoded with more than 64 bits
+        const std::vector<std::uint8_t>
+            tooLong{1, 4, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 1, 0x41};
+        received.onReceive(tooLong.data(), tooLong.size());
+        CHECK(!received);
+        CHECK(received.getDataSize() == 0);
+    }
+
+    SECTION("UdpSocket")
+    {
+        sf::UdpSocket receiver;
+        REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::BitPacket sent;
+        sent.writeInteger(77, 0, 127);
+        sent.writeBool(true);
+
+        sf::UdpSocket sender;
+        REQUIRE(sender.send(sent, sf::IpAddress::LocalHost, receiver.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::BitPacket                received;
+        std::optional<sf::IpAddress> address;
+        unsigned short               port = 0;
+        REQUIRE(receiver.receive(received, address, port) == sf::Socket::Status::Done);
+
+        std::int64_t value = 0;
+        bool         flag  = false;
+        CHECK(received.readInteger(value, 0, 127).readBool(flag));
+        CHECK(value == 77);
+        CHECK(flag);
+    }
+}
+
+TEST_CASE("[Network] sf::BitPacket benchmark", "[.benchmark]")
+{
+    std::vector<Entity> entities = makeEntities(1000);
+
+    sf::BitPacket baseline;
+    write(baseline, entities);
+
+    // Compare the size of a snapshot with the different encodings
+    sf::Packet full;
+    for (const Entity& entity : entities)
+    {
+        full << static_cast<std::int32_t>(entity.id) << entity.x << entity.y << entity.z
+             << static_cast<std::int32_t>(entity.health) << entity.isMoving;
+    }
+
+    for (std::size_t i = 0; i < entities.size(); i += 10)
+        entities[i].x += 1.f;
+
+    TestBitPacket bitPacked;
+    write(bitPacked, entities);
+    std::size_t bitPackedSize = 0;
+    static_cast<void>(bitPacked.onSend(bitPackedSize));
+
+    TestBitPacket delta;
+    delta.setBaseline(baseline);
+    write(delta, entities);
+    std::size_t deltaSize = 0;
+    static_cast<void>(delta.onSend(deltaSize));
+
+    WARN("Snapshot of " << entities.size() << " entities: " << full.getDataSize() << " bytes with sf::Packet, "
+                        << bitPackedSize << " bytes bit-packed, " << deltaSize << " bytes delta-encoded");
+
+    BENCHMARK("encode")
+    {
+        sf::BitPacket packet;
+        write(packet, entities);
+        return packet.getBitSize();
+    };
+
+    std::vector<Entity> result(entities.size());
+    BENCHMARK("decode")
+    {
+        TestBitPacket packet = bitPacked;
+        read(packet, result);
+        return result.back().id;
+    };
+
+    BENCHMARK("delta encode")
+    {
+        std::size_t size = 0;
+        static_cast<void>(delta.onSend(size));
+        return size;
+    };
+
+    BENCHMARK("delta decode")
+    {
+        TestBitPacket packet;
+        packet.setBaseline(baseline);
+        std::size_t size = 0;
+        const void* data = delta.onSend(size);
+        packet.onReceive(data, size);
+        return packet.getBitSize();
+    };
+}
@@ -0,0 +1,207 @@
+#include <SFML/Network/EventLoop.hpp>
+
+// Other 1st party headers
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+TEST_CASE("[Network] sf::EventLoop")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::EventLoop>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::EventLoop>);
+    }
+
+    SECTION("post()")
+    {
+        for (const std::size_t threadCount : {0u, 2u})
+        {
+            sf::EventLoop    loop(threadCount);
+            std::atomic<int> count{0};
+            for (int i = 0; i < 10; ++i)
+                loop.post([&] { ++count; });
+
+            // Work posted by a task keeps the loop running
+            loop.post([&] { loop.post([&] { ++count; }); });
+
+            CHECK(loop.run() >= 11);
+            CHECK(count == 11);
+            CHECK(loop.run() == 0);
+        }
+    }
+
+    SECTION("TCP")
+    {
+        // Every client sends a packet that the server sends back
+        struct Peer
+        {
+            sf::TcpSocket socket;
+            sf::Packet    packet;
+            int           index{};
+        };
+
+        constexpr int clientCount = 50;
+
+        for (const std::size_t threadCount : {0u, 4u})
+        {
+            sf::EventLoop   loop(threadCount);
+            sf::TcpListener listener;
+            REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+            // Handlers may run on the thread pool, so they only count the results
+            std::list<Peer>  serverPeers;
+            std::list<Peer>  clients;
+            std::atomic<int> errors{0};
+            std::atomic<int> echoed{0};
+            const auto       check = [&](sf::Socket::Status status)
+            {
+                if (status != sf::Socket::Status::Done)
+                    ++errors;
+                return status == sf::Socket::Status::Done;
+            };
+
+            const auto echo = [&](Peer& peer)
+            {
+                loop.asyncReceive(peer.socket,
+                                  peer.packet,
+                                  [&](sf::Socket::Status status)
+                                  {
+                                      if (check(status))
+                                          loop.asyncSend(peer.socket, peer.packet, check);
+                                  });
+            };
+
+            std::function<void()> accept = [&]
+            {
+                Peer& peer = serverPeers.emplace_back();
+                loop.asyncAccept(listener,
+                                 peer.socket,
+                                 [&](sf::Socket::Status status)
+                                 {
+                                     if (check(status))
+                                         echo(peer);
+                                     if (serverPeers.size() < clientCount)
+                                         accept();
+                                 });
+            };
+            accept();
+
+            const auto receiveEcho = [&](Peer& client)
+            {
+                loop.asyncReceive(client.socket,
+                                  client.packet,
+                                  [&](sf::Socket::Status status)
+                                  {
+                                      std::string text;
+                                      int         value = -1;
+                                      if (check(status) && (client.packet >> text >> value) && (text == "Hello") &&
+                                          (value == client.index))
+                                          ++echoed;
+                                  });
+            };
+
+            for (int i = 0; i < clientCount; ++i)
+            {
+                Peer& client = clients.emplace_back();
+                client.index = i;
+                client.packet << "Hello" << i;
+                loop.asyncConnect(client.socket,
+                                  sf::IpAddress::LocalHost,
+                                  listener.getLocalPort(),
+                                  [&](sf::Socket::Status status)
+                                  {
+                                      if (check(status))
+                                          loop.asyncSend(client.socket,
+                                                         client.packet,
+                                                         [&](sf::Socket::Status sendStatus)
+                                                         {
+                                                             if (check(sendStatus))
+                                                                 receiveEcho(client);
+                                                         });
+                                  });
+            }
+
+            loop.run();
+            CHECK(errors == 0);
+            CHECK(echoed == clientCount);
+        }
+    }
+
+    SECTION("UDP")
+    {
+        sf::EventLoop loop;
+        sf::UdpSocket receiver;
+        sf::UdpSocket sender;
+        REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        std::array<char, 16> buffer{};
+        std::size_t          size = 0;
+        loop.asyncReceive(receiver,
+                          buffer.data(),
+                          buffer.size(),
+                          [&](sf::Socket::Status           status,
+                              std::size_t                  received,
+                              std::optional<sf::IpAddress> address,
+                              unsigned short)
+                          {
+                              CHECK(status == sf::Socket::Status::Done);
+                              CHECK(address == sf::IpAddress::LocalHost);
+                              size = received;
+                          });
+
+        const std::string message = "datagram";
+        loop.asyncSend(sender,
+                       message.data(),
+                       message.size(),
+                       sf::IpAddress::LocalHost,
+                       receiver.getLocalPort(),
+                       [](sf::Socket::Status status) { CHECK(status == sf::Socket::Status::Done); });
+
+        CHECK(loop.run() == 2);
+        CHECK(size == message.size());
+        CHECK(std::string(buffer.data(), size) == message);
+    }
+
+    SECTION("cancel()")
+    {
+        sf::EventLoop loop;
+        sf::UdpSocket socket;
+        REQUIRE(socket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        std::array<char, 16> buffer{};
+        sf::Socket::Status   first  = sf::Socket::Status::Done;
+        sf::Socket::Status   second = sf::Socket::Status::Done;
+        loop.asyncReceive(socket,
+                          buffer.data(),
+                          buffer.size(),
+                          [&](sf::Socket::Status status, std::size_t, std::optional<sf::IpAddress>, unsigned short)
+                          { first = status; });
+
+        // Only one receive can be pending at a time
+        loop.asyncReceive(socket,
+                          buffer.data(),
+                          buffer.size(),
+                          [&](sf::Socket::Status status, std::size_t, std::optional<sf::IpAddress>, unsigned short)
+                          { second = status; });
+
+        CHECK(loop.runOnce(sf::milliseconds(10)) == 1);
+        CHECK(second == sf::Socket::Status::Error);
+        CHECK(first == sf::Socket::Status::Done);
+
+        loop.cancel(socket);
+        CHECK(loop.run() == 1);
+        CHECK(first == sf::Socket::Status::Error);
+    }
+}
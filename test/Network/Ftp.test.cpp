@@ -1,8 +1,201 @@
 #include <SFML/Network/Ftp.hpp>
 
+// Other 1st party headers
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/TcpListener.hpp>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
+
+#include <cstdint>
+
+namespace
+{
+// Local FTP server storing files in memory, handling each control connection on its own thread
+class TestServer
+{
+public:
+    explicit TestServer(const sf::IpAddress& address = sf::IpAddress::LocalHost) : m_address(address)
+    {
+        (void)m_listener.listen(sf::Socket::AnyPort, m_address);
+        m_thread = std::thread(
+            [this]
+            {
+                for (;;)
+                {
+                    sf::TcpSocket& control = m_controls.emplace_back();
+                    if ((m_listener.accept(control) != sf::Socket::Status::Done) || m_stopping)
+                        return;
+
+                    m_sessions.emplace_back([this, &control] { serve(control); });
+                }
+            });
+    }
+
+    ~TestServer()
+    {
+        // Wake the accepting thread up with a last connection
+        m_stopping = true;
+        sf::TcpSocket socket;
+        (void)socket.connect(m_address, m_listener.getLocalPort());
+        m_thread.join();
+        for (std::thread& session : m_sessions)
+            session.join();
+    }
+
+    unsigned short getPort() const
+    {
+        return m_listener.getLocalPort();
+    }
+
+    void setFile(const std::string& name, const std::string& content)
+    {
+        const std::lock_guard lock(m_mutex);
+        m_files[name] = content;
+    }
+
+    std::string getFile(const std::string& name)
+    {
+        const std::lock_guard lock(m_mutex);
+        return m_files[name];
+    }
+
+private:
+    static void reply(sf::TcpSocket& control, const std::string& line)
+    {
+        const std::string data = line + "\r\n";
+        (void)control.send(data.data(), data.size());
+    }
+
+    void serve(sf::TcpSocket& control)
+    {
+        reply(control, "220 Ready");
+
+        std::string     input;
+        sf::TcpListener dataListener;
+        std::uint64_t   rest = 0;
+        for (;;)
+        {
+            // Read the next command
+            std::string::size_type end = 0;
+            while ((end = input.find("\r\n")) == std::string::npos)
+            {
+                char        buffer[256];
+                std::size_t received = 0;
+                if (control.receive(buffer, sizeof(buffer), received) != sf::Socket::Status::Done)
+                    return;
+                input.append(buffer, received);
+            }
+
+            const std::string line = input.substr(0, end);
+            input.erase(0, end + 2);
+            const std::string command  = line.substr(0, line.find(' '));
+            const std::string argument = line.substr(std::min(command.size() + 1, line.size()));
+
+            sf::TcpSocket data;
+            if (command == "PASV")
+            {
+                (void)dataListener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost);
+                const unsigned short port = dataListener.getLocalPort();
+                reply(control,
+                      "227 Entering Passive Mode (127,0,0,1," + std::to_string(port / 256) + "," +
+                          std::to_string(port % 256) + ")");
+            }
+            else if (command == "EPSV")
+            {
+                (void)dataListener.listen(sf::Socket::AnyPort, m_address);
+                const unsigned short port = dataListener.getLocalPort();
+                reply(control, "229 Entering Extended Passive Mode (|||" + std::to_string(port) + "|)");
+            }
+            else if (command == "TYPE")
+            {
+                reply(control, "200 Type set");
+            }
+            else if (command == "SIZE")
+            {
+                const std::lock_guard lock(m_mutex);
+                const auto            it = m_files.find(argument);
+                reply(control, (it != m_files.end()) ? "213 " + std::to_string(it->second.size()) : "550 No file");
+            }
+            else if (command == "REST")
+            {
+                rest = std::stoull(argument);
+                reply(control, "350 Restarting");
+            }
+            else if (command == "RETR")
+            {
+                const std::string content = getFile(argument).substr(rest);
+                reply(control, "150 Sending");
+                (void)dataListener.accept(data);
+                const bool sent = content.empty() ||
+                                  (data.send(content.data(), content.size()) == sf::Socket::Status::Done);
+                data.disconnect();
+                reply(control, sent ? "226 Done" : "426 Aborted");
+                rest = 0;
+            }
+            else if (command == "STOR")
+            {
+                reply(control, "150 Receiving");
+                (void)dataListener.accept(data);
+
+                std::string content = getFile(argument).substr(0, rest);
+                char        buffer[64 * 1024];
+                std::size_t received = 0;
+                while (data.receive(buffer, sizeof(buffer), received) == sf::Socket::Status::Done)
+                    content.append(buffer, received);
+
+                setFile(argument, content);
+                reply(control, "226 Done");
+                rest = 0;
+            }
+            else if (command == "QUIT")
+            {
+                reply(control, "221 Bye");
+                return;
+            }
+            else
+            {
+                reply(control, "502 Not implemented");
+            }
+        }
+    }
+
+    sf::IpAddress                      m_address;
+    sf::TcpListener                    m_listener;
+    std::list<sf::TcpSocket>           m_controls;
+    std::thread                        m_thread;
+    std::vector<std::thread>           m_sessions;
+    std::mutex                         m_mutex;
+    std::map<std::string, std::string> m_files;
+    std::atomic<bool>                  m_stopping{false};
+};
+
+std::string makeContent(std::size_t size, int seed)
+{
+    std::string content(size, '\0');
+    for (std::size_t i = 0; i < size; ++i)
+        content[i] = static_cast<char>(i * 31 + static_cast<std::size_t>(seed));
+    return content;
+}
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+} // namespace
 
 TEST_CASE("[Network] sf::Ftp")
 {
@@ -99,4 +292,124 @@ TEST_CASE("[Network] sf::Ftp")
             CHECK(listingResponse.getListing() == std::vector<std::string>{"foo", "bar"});
         }
     }
+
+    SECTION("Transfers")
+    {
+        TestServer server;
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sfml-ftp-test";
+        std::filesystem::create_directories(directory);
+
+        sf::Ftp ftp;
+        REQUIRE(ftp.connect(sf::IpAddress::LocalHost, server.getPort()).isOk());
+
+        const std::string content = makeContent(3 * 1024 * 1024 + 5, 1);
+
+        // Progress reports follow the transfer, with the size of the whole file
+        std::vector<sf::Ftp::TransferProgress> reports;
+        const auto                             record = [&](const sf::Ftp::TransferProgress& progress)
+        {
+            reports.push_back(progress);
+            return true;
+        };
+
+        SECTION("Upload")
+        {
+            std::ofstream(directory / "upload.bin", std::ios::binary) << content;
+            CHECK(ftp.upload(directory / "upload.bin", "", sf::Ftp::TransferMode::Binary, false, false, record).isOk());
+            CHECK(server.getFile("upload.bin") == content);
+            REQUIRE(!reports.empty());
+            CHECK(reports.back().position == content.size());
+            CHECK(reports.back().size == content.size());
+
+            // Only the missing part is sent when resuming
+            reports.clear();
+            server.setFile("upload.bin", content.substr(0, 1000));
+            CHECK(ftp.upload(directory / "upload.bin", "", sf::Ftp::TransferMode::Binary, false, true, record).isOk());
+            CHECK(server.getFile("upload.bin") == content);
+            REQUIRE(!reports.empty());
+            CHECK(reports.front().position == content.size());
+        }
+
+        SECTION("Download")
+        {
+            server.setFile("download.bin", content);
+            CHECK(ftp.download("download.bin", directory, sf::Ftp::TransferMode::Binary, false, record).isOk());
+            CHECK(readFile(directory / "download.bin") == content);
+            REQUIRE(!reports.empty());
+            CHECK(reports.front().position < content.size());
+            CHECK(reports.back().position == content.size());
+            CHECK(reports.back().size == content.size());
+
+            // Aborting keeps the partial file when it is meant to be resumed
+            const auto abort = [](const sf::Ftp::TransferProgress&) { return false; };
+            CHECK(!ftp.download("download.bin", directory, sf::Ftp::TransferMode::Binary, false, abort).isOk());
+            CHECK(!std::filesystem::exists(directory / "download.bin"));
+            CHECK(!ftp.download("download.bin", directory, sf::Ftp::TransferMode::Binary, true, abort).isOk());
+            const std::uintmax_t partialSize = std::filesystem::file_size(directory / "download.bin");
+            CHECK(partialSize > 0);
+            CHECK(partialSize < content.size());
+
+            // Resuming only receives the missing part
+            reports.clear();
+            CHECK(ftp.download("download.bin", directory, sf::Ftp::TransferMode::Binary, true, record).isOk());
+            CHECK(readFile(directory / "download.bin") == content);
+            REQUIRE(!reports.empty());
+            CHECK(reports.front().position > partialSize);
+        }
+
+        SECTION("Concurrent transfers")
+        {
+            // One Ftp instance per transfer
+            std::vector<std::string> contents;
+            for (int i = 0; i < 4; ++i)
+            {
+                contents.push_back(makeContent(512 * 1024 + static_cast<std::size_t>(i), i));
+                server.setFile("file" + std::to_string(i), contents.back());
+            }
+
+            for (int i = 0; i < 4; ++i)
+                std::filesystem::create_directories(directory / std::to_string(i));
+
+            std::vector<std::thread> threads;
+            std::atomic<int>         succeeded{0};
+            for (int i = 0; i < 4; ++i)
+                threads.emplace_back(
+                    [&, i]
+                    {
+                        sf::Ftp client;
+                        if (client.connect(sf::IpAddress::LocalHost, server.getPort()).isOk() &&
+                            client.download("file" + std::to_string(i), directory / std::to_string(i)).isOk())
+                            ++succeeded;
+                    });
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            CHECK(succeeded == 4);
+            for (std::size_t i = 0; i < contents.size(); ++i)
+                CHECK(readFile(directory / std::to_string(i) / ("file" + std::to_string(i))) == contents[i]);
+        }
+
+        CHECK(ftp.disconnect().isOk());
+        std::filesystem::remove_all(directory);
+    }
+
+    SECTION("IPv6 transfers")
+    {
+        // The data connection uses the extended passive mode
+        TestServer server(sf::IpAddress::LocalHostV6);
+        server.setFile("file.txt", "IPv6 content");
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sfml-ftp-test-ipv6";
+        std::filesystem::create_directories(directory);
+
+        sf::Ftp ftp;
+        REQUIRE(ftp.connect(sf::IpAddress::LocalHostV6, server.getPort()).isOk());
+        CHECK(ftp.download("file.txt", directory).isOk());
+        CHECK(readFile(directory / "file.txt") == "IPv6 content");
+        CHECK(ftp.disconnect().isOk());
+
+        std::filesystem::remove_all(directory);
+    }
 }
@@ -1,8 +1,139 @@
 #include <SFML/Network/Http.hpp>
 
+// Other 1st party headers
+#include <SFML/Network/Resolver.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsContext.hpp>
+#include <SFML/Network/TlsSocket.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <SystemUtil.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
+
+namespace
+{
+std::string loadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+// Local server answering "/chunked" with a chunked body and any other path with the path itself
+class TestServer
+{
+public:
+    TestServer()
+    {
+        (void)m_listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost);
+        m_thread = std::thread([this] { run(); });
+    }
+
+    ~TestServer()
+    {
+        m_running = false;
+        m_thread.join();
+    }
+
+    unsigned short getPort() const
+    {
+        return m_listener.getLocalPort();
+    }
+
+    int getConnectionCount() const
+    {
+        return m_connections;
+    }
+
+private:
+    struct Client
+    {
+        sf::TcpSocket socket;
+        std::string   buffer;
+    };
+
+    void run()
+    {
+        std::list<Client>  clients;
+        sf::SocketSelector selector;
+        selector.add(m_listener);
+        while (m_running)
+        {
+            if (!selector.wait(sf::milliseconds(20)))
+                continue;
+
+            if (selector.isReady(m_listener))
+            {
+                Client& client = clients.emplace_back();
+                if (m_listener.accept(client.socket) == sf::Socket::Status::Done)
+                {
+                    selector.add(client.socket);
+                    ++m_connections;
+                }
+            }
+
+            for (auto it = clients.begin(); it != clients.end();)
+            {
+                if (!selector.isReady(it->socket) || serve(*it))
+                {
+                    ++it;
+                    continue;
+                }
+
+                selector.remove(it->socket);
+                it = clients.erase(it);
+            }
+        }
+    }
+
+    static bool serve(Client& client)
+    {
+        char        data[1024];
+        std::size_t received = 0;
+        if (client.socket.receive(data, sizeof(data), received) != sf::Socket::Status::Done)
+            return false;
+
+        // Answer every complete request, there may be several of them
+        client.buffer.append(data, received);
+        for (auto end = client.buffer.find("\r\n\r\n"); end != std::string::npos; end = client.buffer.find("\r\n\r\n"))
+        {
+            const auto        pathBegin = client.buffer.find(' ') + 1;
+            const auto        pathEnd   = client.buffer.find(' ', pathBegin);
+            const std::string path      = client.buffer.substr(pathBegin, pathEnd - pathBegin);
+            client.buffer.erase(0, end + 4);
+
+            std::string response = "HTTP/1.1 200 OK\r\n";
+            if (path == "/chunked")
+                response += "Transfer-Encoding: chunked\r\n\r\n"
+                            "7;ext=1\r\nHello, \r\n5\r\nworld\r\n0\r\nX-Trailer: done\r\n\r\n";
+            else
+                response += "Content-Length: " + std::to_string(path.size()) + "\r\n\r\n" + path;
+
+            if (client.socket.send(response.data(), response.size()) != sf::Socket::Status::Done)
+                return false;
+        }
+
+        return true;
+    }
+
+    sf::TcpListener   m_listener;
+    std::thread       m_thread;
+    std::atomic<bool> m_running{true};
+    std::atomic<int>  m_connections{0};
+};
+} // namespace
 
 TEST_CASE("[Network] sf::Http")
 {
@@ -45,4 +176,229 @@ TEST_CASE("[Network] sf::Http")
             CHECK(response.getBody().empty());
         }
     }
+
+    SECTION("Persistent connections")
+    {
+        TestServer server;
+        sf::Http   http("127.0.0.1", server.getPort());
+
+        SECTION("Sequential requests")
+        {
+            for (int i = 0; i < 5; ++i)
+            {
+                const sf::Http::Response response = http.sendRequest(sf::Http::Request("/page" + std::to_string(i)));
+                CHECK(response.getStatus() == sf::Http::Response::Status::Ok);
+                CHECK(response.getBody() == "/page" + std::to_string(i));
+            }
+
+            const sf::Http::Response response = http.sendRequest(sf::Http::Request("/chunked"));
+            CHECK(response.getBody() == "Hello, world");
+            CHECK(response.getField("x-trailer") == "done");
+            CHECK(server.getConnectionCount() == 1);
+        }
+
+        SECTION("Streaming")
+        {
+            std::string              body;
+            const sf::Http::Response response = http.sendRequest(sf::Http::Request("/chunked"),
+                                                                 [&](const void* data, std::size_t size)
+                                                                 {
+                                                                     body.append(static_cast<const char*>(data), size);
+                                                                     return true;
+                                                                 });
+            CHECK(response.getStatus() == sf::Http::Response::Status::Ok);
+            CHECK(response.getBody().empty());
+            CHECK(body == "Hello, world");
+        }
+
+        SECTION("Pipelining")
+        {
+            const std::vector<sf::Http::Request> requests{sf::Http::Request("/a"),
+                                                          sf::Http::Request("/chunked"),
+                                                          sf::Http::Request("/c")};
+            const std::vector<sf::Http::Response> responses = http.sendRequests(requests);
+            REQUIRE(responses.size() == 3);
+            CHECK(responses[0].getBody() == "/a");
+            CHECK(responses[1].getBody() == "Hello, world");
+            CHECK(responses[2].getBody() == "/c");
+            CHECK(server.getConnectionCount() == 1);
+        }
+
+        SECTION("Pipelining many requests")
+        {
+            // Far more data than the socket buffers hold in both directions
+            const std::string              path = "/" + std::string(2000, 'p');
+            std::vector<sf::Http::Request> requests(20000, sf::Http::Request(path));
+
+            const std::vector<sf::Http::Response> responses = http.sendRequests(requests);
+            REQUIRE(responses.size() == requests.size());
+            CHECK(std::all_of(responses.begin(),
+                              responses.end(),
+                              [&](const sf::Http::Response& response) { return response.getBody() == path; }));
+            CHECK(server.getConnectionCount() == 1);
+        }
+
+        SECTION("Concurrent requests")
+        {
+            std::atomic<int>         succeeded{0};
+            std::vector<std::thread> threads;
+            for (int i = 0; i < 4; ++i)
+                threads.emplace_back(
+                    [&]
+                    {
+                        for (int j = 0; j < 10; ++j)
+                            if (http.sendRequest(sf::Http::Request("/x")).getBody() == "/x")
+                                ++succeeded;
+                    });
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            CHECK(succeeded == 40);
+            CHECK(server.getConnectionCount() <= 4);
+        }
+
+        SECTION("No idle connections")
+        {
+            http.setMaxIdleConnections(0);
+            CHECK(http.sendRequest(sf::Http::Request("/a")).getBody() == "/a");
+            CHECK(http.sendRequest(sf::Http::Request("/b")).getBody() == "/b");
+            CHECK(server.getConnectionCount() == 2);
+        }
+    }
+
+    SECTION("Closed idle connections")
+    {
+        // Server answering the first request of each connection, then closing it when it receives the second one
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+        std::atomic<int> postCount{0};
+        std::thread      thread(
+            [&]
+            {
+                for (int connection = 0; connection < 2; ++connection)
+                {
+                    sf::TcpSocket socket;
+                    if (listener.accept(socket) != sf::Socket::Status::Done)
+                        return;
+
+                    std::string buffer;
+                    for (int request = 0; request < 2; ++request)
+                    {
+                        char        data[1024];
+                        std::size_t received = 0;
+                        while ((buffer.find("\r\n\r\n") == std::string::npos) &&
+                               (socket.receive(data, sizeof(data), received) == sf::Socket::Status::Done))
+                            buffer.append(data, received);
+
+                        postCount += buffer.rfind("POST", 0) == 0 ? 1 : 0;
+                        buffer.erase(0, buffer.find("\r\n\r\n") + 4);
+
+                        const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+                        if (request == 0)
+                            (void)socket.send(response.data(), response.size());
+                    }
+                }
+            });
+
+        sf::Http http("http://localhost", listener.getLocalPort());
+        CHECK(http.sendRequest(sf::Http::Request("/")).getBody() == "ok");
+
+        // A GET request is sent again on a new connection
+        CHECK(http.sendRequest(sf::Http::Request("/")).getBody() == "ok");
+
+        // A POST request may have been handled by the server, it isn't sent again
+        CHECK(http.sendRequest(sf::Http::Request("/", sf::Http::Request::Method::Post)).getStatus() ==
+              sf::Http::Response::Status::ConnectionFailed);
+        thread.join();
+        CHECK(postCount == 1);
+    }
+
+    SECTION("Host name resolution")
+    {
+        TestServer server;
+        sf::Resolver::getDefault().addHost("www.sfml.test", {sf::IpAddress::LocalHost});
+
+        sf::Http http("http://www.sfml.test/", server.getPort());
+        CHECK(http.sendRequest(sf::Http::Request("/page")).getBody() == "/page");
+
+        sf::Resolver::getDefault().removeHost("www.sfml.test");
+    }
+
+    SECTION("HTTPS")
+    {
+#ifndef SFML_USE_OPENSSL
+        // Without TLS support, HTTPS hosts are rejected
+        CHECK(sf::Http("https://www.sfml.test").sendRequest(sf::Http::Request("/")).getStatus() ==
+              sf::Http::Response::Status::ConnectionFailed);
+        SKIP("TLS support is not enabled");
+#endif
+
+        const std::string certificate   = loadFile("Network/tls-certificate.pem");
+        auto              serverContext = sf::TlsContext::createServer(certificate, loadFile("Network/tls-key.pem"));
+        auto              clientContext = sf::TlsContext::createClient();
+        REQUIRE(serverContext);
+        REQUIRE(clientContext);
+        REQUIRE(clientContext->addTrustedCertificates(certificate));
+
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+        sf::Resolver::getDefault().addHost("www.sfml.test", {sf::IpAddress::LocalHost});
+
+        std::thread thread(
+            [&]
+            {
+                sf::TlsSocket socket(*serverContext);
+                if (socket.accept(listener) != sf::Socket::Status::Done)
+                    return;
+
+                std::string request;
+                char        data[1024];
+                std::size_t received = 0;
+                while ((request.find("\r\n\r\n") == std::string::npos) &&
+                       (socket.receive(data, sizeof(data), received) == sf::Socket::Status::Done))
+                    request.append(data, received);
+
+                const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 6\r\nConnection: close\r\n\r\nsecure";
+                (void)socket.send(response.data(), response.size());
+            });
+
+        // The certificate of the test server is not trusted by the system
+        sf::Http http;
+        http.setTlsContext(*clientContext);
+        http.setHost("https://www.sfml.test/", listener.getLocalPort());
+        const sf::Http::Response response = http.sendRequest(sf::Http::Request("/"));
+        thread.join();
+        CHECK(response.getStatus() == sf::Http::Response::Status::Ok);
+        CHECK(response.getBody() == "secure");
+
+        sf::Resolver::getDefault().removeHost("www.sfml.test");
+    }
+}
+
+TEST_CASE("[Network] sf::Http request benchmark", "[.benchmark]")
+{
+    // Requests to a server running in the same process, so that the rates only depend on the client
+    TestServer server;
+    sf::Http   http("http://127.0.0.1", server.getPort());
+
+    const auto request = [&] { return http.sendRequest(sf::Http::Request("/page")).getBody().size(); };
+    reportLatencies("http request, persistent connection", 1'000, [&] { (void)request(); });
+
+    BENCHMARK("persistent connection")
+    {
+        return request();
+    };
+
+    const std::vector<sf::Http::Request> requests(16, sf::Http::Request("/page"));
+    BENCHMARK("pipelining, 16 requests")
+    {
+        return http.sendRequests(requests).size();
+    };
+
+    http.setMaxIdleConnections(0);
+    BENCHMARK("new connection per request")
+    {
+        return http.sendRequest(sf::Http::Request("/page")).getBody().size();
+    };
 }
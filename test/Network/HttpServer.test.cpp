@@ -0,0 +1,184 @@
+#include <SFML/Network/HttpServer.hpp>
+
+// Other 1st party headers
+#include <SFML/Network/Http.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("[Network] sf::HttpServer")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::HttpServer>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::HttpServer>);
+    }
+
+    SECTION("Construction")
+    {
+        const sf::HttpServer server;
+        CHECK(server.getLocalPort() == 0);
+        CHECK(server.getConnectionCount() == 0);
+    }
+
+    SECTION("Requests")
+    {
+        using Method = sf::Http::Request::Method;
+        using Status = sf::Http::Response::Status;
+
+        sf::HttpServer server;
+        REQUIRE(server.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+        server.setMaxBodySize(1024);
+
+        server.addRoute(Method::Get,
+                        "/hello",
+                        [](const sf::HttpServer::Request& request, sf::HttpServer::Response& response)
+                        {
+                            response.fields["Content-Type"] = "text/plain";
+                            response.body                   = "Hello " + request.query;
+                        });
+        server.addRoute(Method::Get,
+                        "/items/",
+                        [](const sf::HttpServer::Request& request, sf::HttpServer::Response& response)
+                        { response.body = request.uri; });
+        server.addRoute(Method::Post,
+                        "/echo",
+                        [](const sf::HttpServer::Request& request, sf::HttpServer::Response& response)
+                        { response.body = request.body; });
+
+        // The body of uploads is passed to the handler as it arrives instead of being stored
+        std::size_t uploaded = 0;
+        server.addRoute(
+            Method::Post,
+            "/upload",
+            [&](const sf::HttpServer::Request& request, sf::HttpServer::Response& response)
+            { response.body = std::to_string(uploaded) + (request.body.empty() ? "" : " stored"); },
+            [&](const sf::HttpServer::Request&, const void*, std::size_t size)
+            {
+                uploaded += size;
+                return true;
+            });
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sfml-httpserver-test";
+        std::filesystem::create_directories(directory / "sub");
+        std::ofstream(directory / "sub" / "index.html") << "<p>index</p>";
+        const std::string file(300 * 1024, 'f');
+        std::ofstream(directory / "large.txt", std::ios::binary) << file;
+        server.addStaticFiles("/static", directory);
+
+        std::atomic<bool> running{true};
+        std::thread       thread(
+            [&]
+            {
+                while (running)
+                    server.update(sf::milliseconds(10));
+            });
+
+        sf::Http http("127.0.0.1", server.getLocalPort());
+
+        const sf::Http::Response hello = http.sendRequest(sf::Http::Request("/hello?name=world"));
+        CHECK(hello.getStatus() == Status::Ok);
+        CHECK(hello.getField("content-type") == "text/plain");
+        CHECK(hello.getBody() == "Hello name=world");
+
+        const sf::Http::Response head = http.sendRequest(sf::Http::Request("/hello", Method::Head));
+        CHECK(head.getStatus() == Status::Ok);
+        CHECK(head.getField("content-length") == "6");
+        CHECK(head.getBody().empty());
+
+        CHECK(http.sendRequest(sf::Http::Request("/items/a%20b")).getBody() == "/items/a b");
+        CHECK(http.sendRequest(sf::Http::Request("/missing")).getStatus() == Status::NotFound);
+        CHECK(http.sendRequest(sf::Http::Request("/hello", Method::Post)).getStatus() == Status::NotFound);
+        CHECK(http.sendRequest(sf::Http::Request("/echo", Method::Post, "body")).getBody() == "body");
+
+        const std::string large(100 * 1024, 'u');
+        CHECK(http.sendRequest(sf::Http::Request("/upload", Method::Post, large)).getBody() == "102400");
+
+        const std::vector<sf::Http::Response> responses = http.sendRequests(
+            {sf::Http::Request("/static/large.txt"), sf::Http::Request("/static/sub/"), sf::Http::Request("/hello")});
+        REQUIRE(responses.size() == 3);
+        CHECK(responses[0].getBody() == file);
+        CHECK(responses[0].getField("content-type") == "text/plain; charset=utf-8");
+        CHECK(responses[1].getBody() == "<p>index</p>");
+        CHECK(responses[2].getBody() == "Hello ");
+
+        CHECK(http.sendRequest(sf::Http::Request("/static/../sfml-httpserver-test/large.txt")).getStatus() ==
+              Status::NotFound);
+        CHECK(http.sendRequest(sf::Http::Request("/static/missing.txt")).getStatus() == Status::NotFound);
+
+        // Bodies too large to be stored are rejected, and the connection is closed
+        CHECK(static_cast<int>(http.sendRequest(sf::Http::Request("/echo", Method::Post, large)).getStatus()) == 413);
+        CHECK(http.sendRequest(sf::Http::Request("/echo", Method::Post, "again")).getBody() == "again");
+
+        running = false;
+        thread.join();
+
+        // All the requests that succeeded used the same connection, except the one after the rejected upload
+        CHECK(server.getConnectionCount() == 1);
+
+        server.close();
+        CHECK(server.getConnectionCount() == 0);
+        CHECK(server.getLocalPort() == 0);
+        std::filesystem::remove_all(directory);
+    }
+
+// Windows doesn't allow replacing a file that is open
+#ifndef SFML_SYSTEM_WINDOWS
+    SECTION("Files stay open while they are sent")
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sfml-httpserver-file-test";
+        std::filesystem::create_directories(directory);
+
+        // Large enough not to fit in the socket buffers, so that it is sent in many partial sends
+        const std::string file(32 * 1024 * 1024, 'o');
+        std::ofstream(directory / "large.txt", std::ios::binary) << file;
+
+        sf::HttpServer server;
+        REQUIRE(server.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+        server.addStaticFiles("/static", directory);
+
+        std::atomic<bool> running{true};
+        std::thread       thread(
+            [&]
+            {
+                while (running)
+                    server.update(sf::milliseconds(10));
+            });
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, server.getLocalPort()) == sf::Socket::Status::Done);
+        const std::string request = "GET /static/large.txt HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+        REQUIRE(client.send(request.data(), request.size()) == sf::Socket::Status::Done);
+
+        std::string       received;
+        std::vector<char> buffer(64 * 1024);
+        std::size_t       size = 0;
+        REQUIRE(client.receive(buffer.data(), buffer.size(), size) == sf::Socket::Status::Done);
+        received.append(buffer.data(), size);
+
+        // Replace the file once its response has started, the rest of the response still comes from the original
+        std::ofstream(directory / "replacement.txt", std::ios::binary) << "replaced";
+        std::filesystem::rename(directory / "replacement.txt", directory / "large.txt");
+
+        while (client.receive(buffer.data(), buffer.size(), size) == sf::Socket::Status::Done)
+            received.append(buffer.data(), size);
+
+        running = false;
+        thread.join();
+
+        const std::size_t bodyStart = received.find("\r\n\r\n");
+        REQUIRE(bodyStart != std::string::npos);
+        CHECK(received.size() - bodyStart - 4 == file.size());
+        CHECK(received.compare(bodyStart + 4, std::string::npos, file) == 0);
+        std::filesystem::remove_all(directory);
+    }
+#endif
+}
@@ -2,9 +2,12 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
 #include <sstream>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -65,6 +68,37 @@ TEST_CASE("[Network] sf::IpAddress")
             const sf::IpAddress ipAddress(0xCB00719A);
             CHECK(ipAddress.toString() == "203.0.113.154"s);
             CHECK(ipAddress.toInteger() == 0xCB00719A);
+            CHECK(ipAddress.getType() == sf::IpAddress::Type::IpV4);
+        }
+
+        SECTION("IPv6")
+        {
+            const auto ipAddress = sf::IpAddress::resolve("2001:db8::ff00:42:8329"sv);
+            REQUIRE(ipAddress.has_value());
+            CHECK(ipAddress->getType() == sf::IpAddress::Type::IpV6);
+            CHECK(ipAddress->toString() == "2001:db8::ff00:42:8329"s);
+            CHECK(ipAddress->toInteger() == 0);
+            const std::array<std::uint8_t, 16> bytes = ipAddress->toBytes();
+            CHECK(bytes[0] == 0x20);
+            CHECK(bytes[1] == 0x01);
+            CHECK(bytes[10] == 0xFF);
+            CHECK(bytes[15] == 0x29);
+            CHECK(sf::IpAddress(ipAddress->toBytes()) == *ipAddress);
+
+            CHECK(sf::IpAddress::resolve("[::1]"sv) == sf::IpAddress::LocalHostV6);
+            CHECK(sf::IpAddress::resolve("::"sv) == sf::IpAddress::AnyV6);
+            CHECK(!sf::IpAddress::resolve("2001:db8::g"sv).has_value());
+
+            // IPv4-mapped addresses are IPv4 addresses
+            const auto mapped = sf::IpAddress::resolve("::ffff:192.0.2.1"sv);
+            REQUIRE(mapped.has_value());
+            CHECK(mapped->getType() == sf::IpAddress::Type::IpV4);
+            CHECK(*mapped == sf::IpAddress(192, 0, 2, 1));
+            CHECK(sf::IpAddress(mapped->toBytes()) == *mapped);
+
+            const std::vector<sf::IpAddress> all = sf::IpAddress::resolveAll("localhost"sv);
+            CHECK(std::find(all.begin(), all.end(), sf::IpAddress::LocalHost) != all.end());
+            CHECK(sf::IpAddress::resolveAll("::1"sv) == std::vector{sf::IpAddress::LocalHostV6});
         }
     }
 
@@ -99,6 +133,12 @@ TEST_CASE("[Network] sf::IpAddress")
 
         CHECK(sf::IpAddress::Broadcast.toString() == "255.255.255.255"s);
         CHECK(sf::IpAddress::Broadcast.toInteger() == 0xFFFFFFFF);
+
+        CHECK(sf::IpAddress::AnyV6.toString() == "::"s);
+        CHECK(sf::IpAddress::AnyV6.getType() == sf::IpAddress::Type::IpV6);
+
+        CHECK(sf::IpAddress::LocalHostV6.toString() == "::1"s);
+        CHECK(sf::IpAddress::LocalHostV6.getType() == sf::IpAddress::Type::IpV6);
     }
 
     SECTION("Operators")
@@ -117,6 +157,8 @@ TEST_CASE("[Network] sf::IpAddress")
 
         SECTION("operator<")
         {
+            CHECK(sf::IpAddress::Broadcast < sf::IpAddress::AnyV6);
+            CHECK(sf::IpAddress::AnyV6 < sf::IpAddress::LocalHostV6);
             CHECK(sf::IpAddress(1) < sf::IpAddress(2));
             CHECK(sf::IpAddress(0, 0, 0, 0) < sf::IpAddress(1, 0, 0, 0));
             CHECK(sf::IpAddress(1, 0, 0, 0) < sf::IpAddress(0, 1, 0, 0));
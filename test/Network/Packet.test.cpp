@@ -11,6 +11,8 @@
 #include <vector>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <cwchar>
 
 #define CHECK_PACKET_STREAM_OPERATORS(expected)              \
@@ -268,6 +270,160 @@ TEST_CASE("[Network] sf::Packet")
         }
     }
 
+    SECTION("reserve()")
+    {
+        sf::Packet packet;
+        packet.reserve(64);
+        CHECK(packet.getDataSize() == 0);
+        CHECK(packet.getData() == nullptr);
+    }
+
+    SECTION("writeArray()/readArray()")
+    {
+        const std::array<std::int16_t, 5>  shorts = {-1, 0, 1, 0x1234, std::numeric_limits<std::int16_t>::min()};
+        const std::array<std::uint32_t, 3> ints   = {0, 0x12345678, std::numeric_limits<std::uint32_t>::max()};
+        const std::array<std::int64_t, 3>  longs  = {-2, 0x0102030405060708, std::numeric_limits<std::int64_t>::min()};
+        const std::array<double, 2>        floats = {1.5, -0.25};
+
+        // The encoding is the same as the one of the stream operators
+        sf::Packet expected;
+        for (const auto value : shorts)
+            expected << value;
+        for (const auto value : ints)
+            expected << value;
+        for (const auto value : longs)
+            expected << value;
+        for (const auto value : floats)
+            expected << value;
+
+        sf::Packet packet;
+        packet.writeArray(shorts.data(), shorts.size());
+        packet.writeArray(ints.data(), ints.size());
+        packet.writeArray(longs.data(), longs.size());
+        packet.writeArray(floats.data(), floats.size());
+        REQUIRE(packet.getDataSize() == expected.getDataSize());
+        CHECK(std::memcmp(packet.getData(), expected.getData(), packet.getDataSize()) == 0);
+
+        std::array<std::int16_t, 5>  readShorts{};
+        std::array<std::uint32_t, 3> readInts{};
+        std::array<std::int64_t, 3>  readLongs{};
+        std::array<double, 2>        readFloats{};
+        CHECK(packet.readArray(readShorts.data(), readShorts.size()));
+        CHECK(packet.readArray(readInts.data(), readInts.size()));
+        CHECK(packet.readArray(readLongs.data(), readLongs.size()));
+        CHECK(packet.readArray(readFloats.data(), readFloats.size()));
+        CHECK(packet.endOfPacket());
+        CHECK(readShorts == shorts);
+        CHECK(readInts == ints);
+        CHECK(readLongs == longs);
+        CHECK(readFloats == floats);
+
+        // Long arrays are converted by blocks, check that the block boundaries are handled
+        std::vector<std::uint16_t> longShorts(37);
+        std::vector<std::uint32_t> longInts(37);
+        std::vector<std::uint64_t> longLongs(37);
+        for (std::size_t i = 0; i < 37; ++i)
+        {
+            longShorts[i] = static_cast<std::uint16_t>(i * 0x0102);
+            longInts[i]   = static_cast<std::uint32_t>(i * 0x01020304);
+            longLongs[i]  = i * 0x0102030405060708;
+        }
+
+        sf::Packet longExpected;
+        for (const auto value : longShorts)
+            longExpected << value;
+        for (const auto value : longInts)
+            longExpected << value;
+        for (const auto value : longLongs)
+            longExpected << value;
+
+        sf::Packet bulkPacket;
+        bulkPacket.writeArray(longShorts.data(), longShorts.size());
+        bulkPacket.writeArray(longInts.data(), longInts.size());
+        bulkPacket.writeArray(longLongs.data(), longLongs.size());
+        REQUIRE(bulkPacket.getDataSize() == longExpected.getDataSize());
+        CHECK(std::memcmp(bulkPacket.getData(), longExpected.getData(), bulkPacket.getDataSize()) == 0);
+
+        std::vector<std::uint16_t> readLongShorts(37);
+        std::vector<std::uint32_t> readLongInts(37);
+        std::vector<std::uint64_t> readLongLongs(37);
+        CHECK(bulkPacket.readArray(readLongShorts.data(), readLongShorts.size()));
+        CHECK(bulkPacket.readArray(readLongInts.data(), readLongInts.size()));
+        CHECK(bulkPacket.readArray(readLongLongs.data(), readLongLongs.size()));
+        CHECK(readLongShorts == longShorts);
+        CHECK(readLongInts == longInts);
+        CHECK(readLongLongs == longLongs);
+
+        // Reading past the end invalidates the packet without extracting anything
+        std::array<std::uint8_t, 1> extra{42};
+        CHECK(!packet.readArray(extra.data(), extra.size()));
+        CHECK(extra[0] == 42);
+
+        // A count whose size in bytes wraps around is rejected rather than read out of bounds
+        constexpr auto maxSize = std::numeric_limits<std::size_t>::max();
+        sf::Packet     shortPacket;
+        shortPacket << std::uint32_t{1} << std::uint64_t{2};
+
+        std::array<std::uint32_t, 1> wrappedInts{7};
+        CHECK(!shortPacket.readArray(wrappedInts.data(), maxSize / sizeof(std::uint32_t) + 2));
+        CHECK(wrappedInts[0] == 7);
+        CHECK(shortPacket.getReadPosition() == 0);
+
+        sf::Packet                   longPacket = shortPacket;
+        std::array<std::uint64_t, 1> wrappedLongs{7};
+        CHECK(!longPacket.readArray(wrappedLongs.data(), maxSize / sizeof(std::uint64_t) + 2));
+        CHECK(wrappedLongs[0] == 7);
+    }
+
+    SECTION("writeVarUint()/writeVarInt()")
+    {
+        sf::Packet packet;
+        packet.writeVarUint(0);
+        packet.writeVarUint(127);
+        packet.writeVarUint(128);
+        packet.writeVarUint(std::numeric_limits<std::uint64_t>::max());
+        packet.writeVarInt(-1);
+        packet.writeVarInt(63);
+        packet.writeVarInt(-64);
+        packet.writeVarInt(std::numeric_limits<std::int64_t>::min());
+        packet.writeVarInt(std::numeric_limits<std::int64_t>::max());
+        CHECK(packet.getDataSize() == 1 + 1 + 2 + 10 + 1 + 1 + 1 + 10 + 10);
+
+        std::uint64_t unsignedValue = 0;
+        CHECK(packet.readVarUint(unsignedValue));
+        CHECK(unsignedValue == 0);
+        CHECK(packet.readVarUint(unsignedValue));
+        CHECK(unsignedValue == 127);
+        CHECK(packet.readVarUint(unsignedValue));
+        CHECK(unsignedValue == 128);
+        CHECK(packet.readVarUint(unsignedValue));
+        CHECK(unsignedValue == std::numeric_limits<std::uint64_t>::max());
+
+        std::int64_t signedValue = 0;
+        CHECK(packet.readVarInt(signedValue));
+        CHECK(signedValue == -1);
+        CHECK(packet.readVarInt(signedValue));
+        CHECK(signedValue == 63);
+        CHECK(packet.readVarInt(signedValue));
+        CHECK(signedValue == -64);
+        CHECK(packet.readVarInt(signedValue));
+        CHECK(signedValue == std::numeric_limits<std::int64_t>::min());
+        CHECK(packet.readVarInt(signedValue));
+        CHECK(signedValue == std::numeric_limits<std::int64_t>::max());
+        CHECK(packet.endOfPacket());
+
+        // Truncated and overlong encodings are rejected
+        sf::Packet truncated;
+        truncated << std::uint8_t{0x80};
+        CHECK(!truncated.readVarUint(unsignedValue));
+
+        sf::Packet overlong;
+        for (int i = 0; i < 10; ++i)
+            overlong << std::uint8_t{0xFF};
+        overlong << std::uint8_t{0x01};
+        CHECK(!overlong.readVarUint(unsignedValue));
+    }
+
     SECTION("onSend")
     {
         Packet      packet;
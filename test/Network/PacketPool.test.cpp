@@ -0,0 +1,54 @@
+#include <SFML/Network/PacketPool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <type_traits>
+#include <utility>
+
+#include <cstdint>
+
+TEST_CASE("[Network] sf::PacketPool")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(std::is_copy_constructible_v<sf::PacketPool>);
+        STATIC_CHECK(std::is_copy_assignable_v<sf::PacketPool>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::PacketPool>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::PacketPool>);
+    }
+
+    SECTION("Construction")
+    {
+        const sf::PacketPool pool;
+        CHECK(pool.getSize() == 0);
+    }
+
+    SECTION("acquire()/release()")
+    {
+        sf::PacketPool pool(1);
+
+        sf::Packet packet = pool.acquire();
+        CHECK(packet.getDataSize() == 0);
+        packet << std::uint32_t{42};
+        const void* storage = packet.getData();
+
+        pool.release(std::move(packet));
+        CHECK(pool.getSize() == 1);
+
+        // Packets beyond the maximum are not kept
+        pool.release(sf::Packet());
+        CHECK(pool.getSize() == 1);
+
+        // The recycled packet is empty but keeps its storage
+        sf::Packet recycled = pool.acquire();
+        CHECK(pool.getSize() == 0);
+        CHECK(recycled.getDataSize() == 0);
+        CHECK(recycled.getReadPosition() == 0);
+        recycled << std::uint32_t{7};
+        CHECK(recycled.getData() == storage);
+
+        pool.release(std::move(recycled));
+        pool.clear();
+        CHECK(pool.getSize() == 0);
+    }
+}
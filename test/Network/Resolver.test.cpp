@@ -0,0 +1,124 @@
+#include <SFML/Network/Resolver.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("[Network] sf::Resolver")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::Resolver>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::Resolver>);
+    }
+
+    sf::Resolver resolver;
+
+    SECTION("resolve()")
+    {
+        CHECK(resolver.resolve("127.0.0.1") == std::vector{sf::IpAddress::LocalHost});
+        CHECK(resolver.resolve("::1") == std::vector{sf::IpAddress::LocalHostV6});
+        CHECK(resolver.resolve("").empty());
+    }
+
+    SECTION("resolveAsync()")
+    {
+        SECTION("Future")
+        {
+            std::future<std::vector<sf::IpAddress>> future = resolver.resolveAsync("127.0.0.1");
+            CHECK(future.get() == std::vector{sf::IpAddress::LocalHost});
+        }
+
+        SECTION("Callback")
+        {
+            std::vector<sf::IpAddress> addresses;
+            std::atomic<bool>          done = false;
+            resolver.resolveAsync("127.0.0.1",
+                                  [&](const std::vector<sf::IpAddress>& result)
+                                  {
+                                      addresses = result;
+                                      done      = true;
+                                  });
+
+            while (!done)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            CHECK(addresses == std::vector{sf::IpAddress::LocalHost});
+        }
+
+        SECTION("Concurrent requests")
+        {
+            std::vector<std::future<std::vector<sf::IpAddress>>> futures;
+            for (int i = 0; i < 16; ++i)
+                futures.push_back(resolver.resolveAsync(i % 2 == 0 ? "127.0.0.1" : "::1"));
+
+            for (std::size_t i = 0; i < futures.size(); ++i)
+            {
+                const sf::IpAddress expected = i % 2 == 0 ? sf::IpAddress::LocalHost : sf::IpAddress::LocalHostV6;
+                CHECK(futures[i].get() == std::vector{expected});
+            }
+        }
+    }
+
+    SECTION("Cache")
+    {
+        // Cached names complete right away, in the calling thread
+        const auto completesInPlace = [&resolver](const char* host)
+        {
+            auto caller = std::make_shared<std::promise<std::thread::id>>();
+            auto future = caller->get_future();
+            resolver.resolveAsync(host,
+                                  [caller](const std::vector<sf::IpAddress>&)
+                                  { caller->set_value(std::this_thread::get_id()); });
+            return future.get() == std::this_thread::get_id();
+        };
+
+        CHECK(resolver.resolve("127.0.0.1") == std::vector{sf::IpAddress::LocalHost});
+        CHECK(completesInPlace("127.0.0.1"));
+
+        SECTION("Negative caching")
+        {
+            CHECK(resolver.resolve("unresolvable.invalid").empty());
+            CHECK(completesInPlace("unresolvable.invalid"));
+        }
+
+        SECTION("clearCache()")
+        {
+            resolver.clearCache();
+            CHECK(resolver.resolveAsync("127.0.0.1").get() == std::vector{sf::IpAddress::LocalHost});
+        }
+
+        SECTION("No caching")
+        {
+            resolver.setTimeToLive(sf::Time::Zero, sf::Time::Zero);
+            resolver.clearCache();
+            CHECK(resolver.resolve("127.0.0.1") == std::vector{sf::IpAddress::LocalHost});
+            CHECK(!completesInPlace("127.0.0.1"));
+        }
+    }
+
+    SECTION("addHost()/removeHost()")
+    {
+        const std::vector addresses{sf::IpAddress(10, 0, 0, 1), sf::IpAddress::LocalHostV6};
+        resolver.addHost("Server.SFML.test", addresses);
+        CHECK(resolver.resolve("server.sfml.test") == addresses);
+        CHECK(resolver.resolveAsync("SERVER.sfml.TEST").get() == addresses);
+
+        // Static hosts survive the cache
+        resolver.setTimeToLive(sf::Time::Zero, sf::Time::Zero);
+        resolver.clearCache();
+        CHECK(resolver.resolve("server.sfml.test") == addresses);
+
+        // Static hosts can be made unresolvable
+        resolver.addHost("127.0.0.1", {});
+        CHECK(resolver.resolve("127.0.0.1").empty());
+
+        resolver.removeHost("127.0.0.1");
+        CHECK(resolver.resolve("127.0.0.1") == std::vector{sf::IpAddress::LocalHost});
+    }
+}
@@ -1,11 +1,25 @@
 #include <SFML/Network/SocketSelector.hpp>
 
 // Other 1st party headers
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/UdpSocket.hpp>
 
+#include <SFML/System/Time.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <SystemUtil.hpp>
+#include <optional>
+#include <string>
 #include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
 
 TEST_CASE("[Network] sf::SocketSelector")
 {
@@ -24,4 +38,179 @@ TEST_CASE("[Network] sf::SocketSelector")
         const sf::SocketSelector socketSelector;
         CHECK(!socketSelector.isReady(socket));
     }
+
+    SECTION("Readiness")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Status::Done);
+
+        sf::SocketSelector socketSelector;
+        socketSelector.add(server);
+        CHECK(!socketSelector.wait(sf::milliseconds(1)));
+        CHECK(socketSelector.getReadySockets().empty());
+
+        socketSelector.add(client, sf::SocketSelector::Interest::Send);
+        REQUIRE(socketSelector.wait(sf::seconds(1)));
+        REQUIRE(socketSelector.getReadySockets().size() == 1);
+        CHECK(socketSelector.getReadySockets()[0].socket == &client);
+        CHECK(socketSelector.getReadySockets()[0].send);
+        CHECK(!socketSelector.getReadySockets()[0].receive);
+        CHECK(socketSelector.isReadyToSend(client));
+        CHECK(!socketSelector.isReady(client));
+        CHECK(!socketSelector.isReady(server));
+
+        const char data = 'x';
+        REQUIRE(client.send(&data, 1) == sf::Socket::Status::Done);
+        socketSelector.add(client, sf::SocketSelector::Interest::Receive);
+        REQUIRE(socketSelector.wait(sf::seconds(1)));
+        REQUIRE(socketSelector.getReadySockets().size() == 1);
+        CHECK(socketSelector.getReadySockets()[0].socket == &server);
+        CHECK(socketSelector.isReady(server));
+        CHECK(!socketSelector.isReadyToSend(client));
+
+        sf::SocketSelector copy(socketSelector);
+        CHECK(copy.isReady(server));
+        REQUIRE(copy.wait(sf::seconds(1)));
+        CHECK(copy.isReady(server));
+
+        socketSelector.remove(server);
+        CHECK(!socketSelector.wait(sf::milliseconds(1)));
+        CHECK(!socketSelector.isReady(server));
+
+        socketSelector.clear();
+        CHECK(socketSelector.getReadySockets().empty());
+    }
+
+    SECTION("Packets sent back to back")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket server;
+        REQUIRE(listener.accept(server) == sf::Socket::Status::Done);
+
+        sf::Packet first;
+        first << std::uint32_t{1};
+        sf::Packet second;
+        second << std::uint32_t{2};
+        client.queue(first);
+        client.queue(second);
+        REQUIRE(client.flush() == sf::Socket::Status::Done);
+
+        // Receiving the first packet must not hide the second one from the selector
+        sf::SocketSelector socketSelector;
+        socketSelector.add(server);
+        std::uint32_t value = 0;
+        for (const std::uint32_t expected : {1u, 2u})
+        {
+            REQUIRE(socketSelector.wait(sf::seconds(1)));
+            REQUIRE(socketSelector.isReady(server));
+
+            sf::Packet packet;
+            REQUIRE(server.receive(packet) == sf::Socket::Status::Done);
+            CHECK((packet >> value));
+            CHECK(value == expected);
+        }
+
+        CHECK(!socketSelector.wait(sf::milliseconds(1)));
+    }
+
+    SECTION("Statistics")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket client;
+        REQUIRE(client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::SocketSelector socketSelector;
+        socketSelector.add(client, sf::SocketSelector::Interest::ReceiveAndSend);
+        CHECK(!socketSelector.isStatisticsEnabled());
+        REQUIRE(socketSelector.wait(sf::seconds(1)));
+        CHECK(socketSelector.getStatistics().waitCalls == 0);
+
+        socketSelector.setStatisticsEnabled(true);
+        REQUIRE(socketSelector.wait(sf::seconds(1)));
+        socketSelector.add(client);
+        CHECK(!socketSelector.wait(sf::milliseconds(20)));
+
+        const sf::SocketSelector::Statistics statistics = sf::SocketSelector(socketSelector).getStatistics();
+        CHECK(statistics.waitCalls == 2);
+        CHECK(statistics.timeouts == 1);
+        CHECK(statistics.readySockets == 1);
+        CHECK(statistics.maxWaitTime >= sf::milliseconds(15));
+        CHECK(statistics.waitTime >= statistics.maxWaitTime);
+
+        socketSelector.resetStatistics();
+        CHECK(socketSelector.getStatistics().waitCalls == 0);
+        socketSelector.setStatisticsEnabled(false);
+        CHECK(!socketSelector.isStatisticsEnabled());
+    }
+}
+
+TEST_CASE("[Network] sf::SocketSelector scalability benchmark", "[.benchmark]")
+{
+    // One socket becomes ready among more and more idle ones, which shows how
+    // the cost of the calls grows with the number of sockets being watched
+    sf::UdpSocket          sender;
+    constexpr std::byte    data{42};
+    std::vector<std::byte> buffer(1);
+
+    for (const std::size_t count : {10u, 100u, 1000u, 10'000u})
+    {
+        std::vector<sf::UdpSocket> sockets(count);
+        sf::SocketSelector         selector;
+        std::size_t                opened = 0;
+        while ((opened < count) &&
+               (sockets[opened].bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done))
+            selector.add(sockets[opened++]);
+
+        // The limit of open files of the process may be lower than the largest sizes
+        if (opened < count)
+        {
+            WARN("Only " << opened << " of " << count << " sockets could be opened, skipping the larger sizes");
+            break;
+        }
+
+        std::size_t next = 0;
+        const auto  wait = [&]
+        {
+            sf::UdpSocket& target = sockets[next++ % count];
+            (void)sender.send(&data, sizeof(data), sf::IpAddress::LocalHost, target.getLocalPort());
+            const bool ready = selector.wait(sf::seconds(1)) && selector.isReady(target);
+
+            std::optional<sf::IpAddress> address;
+            unsigned short               port     = 0;
+            std::size_t                  received = 0;
+            (void)target.receive(buffer.data(), buffer.size(), received, address, port);
+            return ready;
+        };
+
+        const std::string suffix = ", " + std::to_string(count) + " sockets";
+        reportLatencies("selector wait" + suffix, 1'000, [&] { (void)wait(); });
+
+        BENCHMARK("wait" + suffix)
+        {
+            return wait();
+        };
+
+        BENCHMARK("add and remove" + suffix)
+        {
+            sf::SocketSelector other;
+            for (sf::UdpSocket& socket : sockets)
+                other.add(socket);
+            for (sf::UdpSocket& socket : sockets)
+                other.remove(socket);
+            return other.getReadySockets().size();
+        };
+    }
 }
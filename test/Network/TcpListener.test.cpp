@@ -5,7 +5,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 TEST_CASE("[Network] sf::TcpListener")
 {
@@ -38,6 +41,43 @@ TEST_CASE("[Network] sf::TcpListener")
             CHECK(tcpListener.listen(0, sf::IpAddress::Broadcast) == sf::Socket::Status::Error);
             CHECK(tcpListener.getLocalPort() == 0);
         }
+
+        SECTION("Backlog")
+        {
+            sf::TcpListener::ListenOptions options;
+            options.backlog = 16;
+            CHECK(tcpListener.listen(0, sf::IpAddress::LocalHost, options) == sf::Socket::Status::Done);
+            CHECK(tcpListener.getLocalPort() != 0);
+        }
+
+        SECTION("Dual-stack")
+        {
+            REQUIRE(tcpListener.listen(0, sf::IpAddress::AnyV6) == sf::Socket::Status::Done);
+
+            // IPv4 peers are reported with their IPv4 address
+            for (const sf::IpAddress& address : {sf::IpAddress::LocalHostV6, sf::IpAddress::LocalHost})
+            {
+                sf::TcpSocket client;
+                sf::TcpSocket server;
+                REQUIRE(client.connect(address, tcpListener.getLocalPort()) == sf::Socket::Status::Done);
+                REQUIRE(tcpListener.accept(server) == sf::Socket::Status::Done);
+                CHECK(server.getRemoteAddress() == address);
+                CHECK(server.getRemotePort() == client.getLocalPort());
+            }
+
+            sf::TcpListener::ListenOptions options;
+            options.ipV6Only = true;
+            REQUIRE(tcpListener.listen(0, sf::IpAddress::AnyV6, options) == sf::Socket::Status::Done);
+            sf::TcpSocket client;
+            CHECK(client.connect(sf::IpAddress::LocalHost, tcpListener.getLocalPort()) != sf::Socket::Status::Done);
+        }
+
+        SECTION("Port in use")
+        {
+            REQUIRE(tcpListener.listen(0, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+            sf::TcpListener other;
+            CHECK(other.listen(tcpListener.getLocalPort(), sf::IpAddress::LocalHost) == sf::Socket::Status::Error);
+        }
     }
 
     SECTION("close()")
@@ -55,4 +95,99 @@ TEST_CASE("[Network] sf::TcpListener")
         sf::TcpSocket   tcpSocket;
         CHECK(tcpListener.accept(tcpSocket) == sf::Socket::Status::Error);
     }
+
+    SECTION("acceptAll()")
+    {
+        sf::TcpListener            tcpListener;
+        std::vector<sf::TcpSocket> sockets;
+        CHECK(tcpListener.acceptAll(sockets, 8) == sf::Socket::Status::Error);
+        CHECK(sockets.empty());
+
+        REQUIRE(tcpListener.listen(0, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+        tcpListener.setBlocking(false);
+        CHECK(tcpListener.acceptAll(sockets, 8) == sf::Socket::Status::NotReady);
+        CHECK(sockets.empty());
+
+        std::vector<sf::TcpSocket> clients(5);
+        for (auto& client : clients)
+            REQUIRE(client.connect(sf::IpAddress::LocalHost, tcpListener.getLocalPort()) == sf::Socket::Status::Done);
+
+        // The connections are pending once connect returns, but may not be visible to accept immediately
+        while (sockets.size() < 3)
+            (void)tcpListener.acceptAll(sockets, 3 - sockets.size(), false);
+        CHECK(sockets.size() == 3);
+
+        while (sockets.size() < 5)
+            (void)tcpListener.acceptAll(sockets, 8, false);
+        CHECK(sockets.size() == 5);
+        CHECK(tcpListener.acceptAll(sockets, 8) == sf::Socket::Status::NotReady);
+
+        for (const auto& socket : sockets)
+        {
+            CHECK(!socket.isBlocking());
+            CHECK(socket.getRemoteAddress() == sf::IpAddress::LocalHost);
+        }
+
+        // A blocking listener waits for the first connection, then takes the pending ones
+        tcpListener.setBlocking(true);
+        sockets.clear();
+        clients.clear();
+        clients.resize(2);
+        for (auto& client : clients)
+            REQUIRE(client.connect(sf::IpAddress::LocalHost, tcpListener.getLocalPort()) == sf::Socket::Status::Done);
+        while (sockets.size() < 2)
+            CHECK(tcpListener.acceptAll(sockets, 8) == sf::Socket::Status::Done);
+        CHECK(sockets.back().isBlocking());
+    }
+
+#ifndef SFML_SYSTEM_WINDOWS
+    SECTION("Shared port")
+    {
+        sf::TcpListener::ListenOptions options;
+        options.reusePort = true;
+
+        constexpr std::size_t        listenerCount = 4;
+        std::vector<sf::TcpListener> listeners(listenerCount);
+        REQUIRE(listeners[0].listen(0, sf::IpAddress::LocalHost, options) == sf::Socket::Status::Done);
+        const unsigned short port = listeners[0].getLocalPort();
+        for (std::size_t i = 1; i < listenerCount; ++i)
+            REQUIRE(listeners[i].listen(port, sf::IpAddress::LocalHost, options) == sf::Socket::Status::Done);
+
+        // Each worker accepts its own share of the connections
+        constexpr std::size_t    connectionCount = 64;
+        std::atomic<std::size_t> accepted{};
+        std::vector<std::size_t> counts(listenerCount);
+        std::vector<std::thread> workers;
+        for (std::size_t i = 0; i < listenerCount; ++i)
+        {
+            workers.emplace_back(
+                [&, i]
+                {
+                    listeners[i].setBlocking(false);
+                    std::vector<sf::TcpSocket> sockets;
+                    while (accepted < connectionCount)
+                    {
+                        const std::size_t before = sockets.size();
+                        if (listeners[i].acceptAll(sockets, connectionCount) == sf::Socket::Status::Done)
+                            accepted += sockets.size() - before;
+                        else
+                            std::this_thread::yield();
+                    }
+                    counts[i] = sockets.size();
+                });
+        }
+
+        std::vector<sf::TcpSocket> clients(connectionCount);
+        for (auto& client : clients)
+            REQUIRE(client.connect(sf::IpAddress::LocalHost, port) == sf::Socket::Status::Done);
+
+        for (auto& worker : workers)
+            worker.join();
+
+        std::size_t total = 0;
+        for (const std::size_t count : counts)
+            total += count;
+        CHECK(total == connectionCount);
+    }
+#endif
 }
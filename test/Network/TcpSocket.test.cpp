@@ -2,10 +2,22 @@
 
 // Other 1st party headers
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/TcpListener.hpp>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <SystemUtil.hpp>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
 
 TEST_CASE("[Network] sf::TcpSocket")
 {
@@ -24,4 +36,582 @@ TEST_CASE("[Network] sf::TcpSocket")
         CHECK(!tcpSocket.getRemoteAddress().has_value());
         CHECK(tcpSocket.getRemotePort() == 0);
     }
+
+    SECTION("connect() to several addresses")
+    {
+        const std::vector<sf::IpAddress> addresses{sf::IpAddress::LocalHostV6, sf::IpAddress::LocalHost};
+
+        // Only one of the addresses accepts the connection
+        for (const sf::IpAddress& address : addresses)
+        {
+            sf::TcpListener listener;
+            REQUIRE(listener.listen(sf::Socket::AnyPort, address) == sf::Socket::Status::Done);
+
+            sf::TcpSocket client;
+            client.setBlocking(false);
+            REQUIRE(client.connect(addresses, listener.getLocalPort(), sf::seconds(5)) == sf::Socket::Status::Done);
+            CHECK(client.getRemoteAddress() == address);
+            CHECK(!client.isBlocking());
+
+            sf::TcpSocket server;
+            REQUIRE(listener.accept(server) == sf::Socket::Status::Done);
+            CHECK(server.getRemotePort() == client.getLocalPort());
+
+            // Names and literal addresses are resolved first
+            CHECK(client.connect(address.toString(), listener.getLocalPort()) == sf::Socket::Status::Done);
+        }
+
+        SECTION("Options are kept")
+        {
+            sf::TcpListener listener;
+            REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+            sf::TcpSocket::PacketCompression compression;
+            compression.enabled   = true;
+            compression.threshold = 16;
+
+            sf::TcpSocket client;
+            client.setPacketCompression(compression);
+            client.setStatisticsEnabled(true);
+            REQUIRE(client.connect(addresses, listener.getLocalPort(), sf::seconds(5)) == sf::Socket::Status::Done);
+            CHECK(client.getPacketCompression().enabled);
+            CHECK(client.getPacketCompression().threshold == 16);
+            CHECK(client.isStatisticsEnabled());
+
+            // The peer decompresses what the client sends
+            sf::TcpSocket server;
+            REQUIRE(listener.accept(server) == sf::Socket::Status::Done);
+            server.setPacketCompression(compression);
+
+            sf::Packet packet;
+            packet << std::string(1000, 'a');
+            REQUIRE(client.send(packet) == sf::Socket::Status::Done);
+            REQUIRE(server.receive(packet) == sf::Socket::Status::Done);
+
+            std::string received;
+            CHECK(packet >> received);
+            CHECK(received == std::string(1000, 'a'));
+            CHECK(client.getStatistics().packetsSent == 1);
+        }
+
+        sf::TcpSocket client;
+        CHECK(client.connect(addresses, 1) != sf::Socket::Status::Done);
+        CHECK(client.connect(std::vector<sf::IpAddress>(), 1) == sf::Socket::Status::Error);
+        CHECK(client.connect("", 1) == sf::Socket::Status::Error);
+    }
+
+    SECTION("Packets")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket sender;
+        REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket receiver;
+        REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+        sender.setBlocking(false);
+        receiver.setBlocking(false);
+
+        // Large enough to require partial sends and several reads on both ends
+        const std::string large(3 * 1024 * 1024 + 17, 'x');
+
+        for (const std::string& message : {std::string("small"), large, std::string(), large})
+        {
+            sf::Packet packet;
+            packet << message;
+
+            sf::Packet         received;
+            sf::Socket::Status sendStatus    = sf::Socket::Status::Partial;
+            sf::Socket::Status receiveStatus = sf::Socket::Status::NotReady;
+            while (receiveStatus != sf::Socket::Status::Done)
+            {
+                if (sendStatus != sf::Socket::Status::Done)
+                {
+                    sendStatus = sender.send(packet);
+                    REQUIRE(sendStatus != sf::Socket::Status::Error);
+                }
+
+                receiveStatus = receiver.receive(received);
+                REQUIRE(receiveStatus != sf::Socket::Status::Error);
+            }
+
+            CHECK(sendStatus == sf::Socket::Status::Done);
+            CHECK(received.getDataSize() == packet.getDataSize());
+
+            std::string result;
+            CHECK(received >> result);
+            CHECK(result == message);
+            CHECK(received.endOfPacket());
+        }
+    }
+
+    SECTION("Queued packets")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket sender;
+        REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket receiver;
+        REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+        CHECK(sender.getSendQueueSize() == 0);
+        CHECK(sender.flush() == sf::Socket::Status::Done);
+
+        for (std::uint32_t i = 0; i < 100; ++i)
+        {
+            sf::Packet packet;
+            packet << i;
+            sender.queue(packet);
+        }
+
+        CHECK(sender.getSendQueueSize() == 100 * 8);
+        CHECK(sender.flush() == sf::Socket::Status::Done);
+        CHECK(sender.getSendQueueSize() == 0);
+
+        // Raw data following the packets must not be lost in the receive buffer
+        const char raw = 'r';
+        REQUIRE(sender.send(&raw, 1) == sf::Socket::Status::Done);
+
+        std::vector<sf::Packet> packets;
+        while (packets.size() < 100)
+            REQUIRE(receiver.receivePackets(packets) == sf::Socket::Status::Done);
+
+        REQUIRE(packets.size() == 100);
+        for (std::uint32_t i = 0; i < 100; ++i)
+        {
+            std::uint32_t value = 0;
+            CHECK(packets[i] >> value);
+            CHECK(value == i);
+        }
+
+        char        received     = 0;
+        std::size_t receivedSize = 0;
+        REQUIRE(receiver.receive(&received, 1, receivedSize) == sf::Socket::Status::Done);
+        CHECK(receivedSize == 1);
+        CHECK(received == 'r');
+    }
+
+    SECTION("Files")
+    {
+        // Large enough to require partial sends over a non-blocking socket
+        std::string content(2 * 1024 * 1024 + 3, '\0');
+        for (std::size_t i = 0; i < content.size(); ++i)
+            content[i] = static_cast<char>(i * 7);
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "sfml-tcpsocket-sendfile.bin";
+        std::ofstream(path, std::ios::binary).write(content.data(), static_cast<std::streamsize>(content.size()));
+
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket sender;
+        REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket receiver;
+        REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+        sender.setBlocking(false);
+        receiver.setBlocking(false);
+
+        // Send everything but the first 5 bytes
+        constexpr std::uint64_t offset = 5;
+        const std::size_t       size   = content.size() - offset;
+        std::size_t             total  = 0;
+        std::string             received;
+        std::vector<char>       buffer(64 * 1024);
+        while (received.size() < size)
+        {
+            if (total < size)
+            {
+                std::size_t              sent   = 0;
+                const sf::Socket::Status status = sender.sendFile(path, offset + total, size - total, sent);
+                REQUIRE(status != sf::Socket::Status::Error);
+                total += sent;
+            }
+
+            std::size_t count = 0;
+            if (receiver.receive(buffer.data(), buffer.size(), count) == sf::Socket::Status::Done)
+                received.append(buffer.data(), count);
+        }
+
+        CHECK(received == content.substr(offset));
+
+        std::size_t sent = 0;
+        CHECK(sender.sendFile(path, content.size() - 1, 2, sent) == sf::Socket::Status::Error);
+        CHECK(sender.sendFile(path.string() + ".missing", 0, 1, sent) == sf::Socket::Status::Error);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Statistics")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket sender;
+        REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket receiver;
+        REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+        CHECK(!sender.isStatisticsEnabled());
+        sender.setStatisticsEnabled(true);
+        receiver.setStatisticsEnabled(true);
+        CHECK(sender.isStatisticsEnabled());
+
+        sf::Packet small;
+        small << std::uint32_t{42};
+        sf::Packet large;
+        large.append(std::vector<std::byte>(100'000).data(), 100'000);
+
+        REQUIRE(sender.send(small) == sf::Socket::Status::Done);
+        REQUIRE(sender.send(large) == sf::Socket::Status::Done);
+
+        sf::Packet packet;
+        REQUIRE(receiver.receive(packet) == sf::Socket::Status::Done);
+        REQUIRE(receiver.receive(packet) == sf::Socket::Status::Done);
+
+        receiver.setBlocking(false);
+        CHECK(receiver.receive(packet) == sf::Socket::Status::NotReady);
+
+        const sf::Socket::Statistics sent = sender.getStatistics();
+        CHECK(sent.bytesSent == 8 + 100'004);
+        CHECK(sent.packetsSent == 2);
+        CHECK(sent.sendCalls >= 2);
+        CHECK(sent.sentSizes[0] == 1);
+        CHECK(sent.sentSizes[11] == 1);
+        CHECK(sent.bytesReceived == 0);
+
+        const sf::Socket::Statistics received = receiver.getStatistics();
+        CHECK(received.bytesReceived == 8 + 100'004);
+        CHECK(received.packetsReceived == 2);
+        CHECK(received.receiveCalls >= 2);
+        CHECK(received.receivedSizes[0] == 1);
+        CHECK(received.receivedSizes[11] == 1);
+        CHECK(received.notReady == 1);
+        CHECK(received.errors == 0);
+
+#ifdef SFML_SYSTEM_LINUX
+        CHECK(sender.getRoundTripTime().has_value());
+#endif
+        CHECK(!sf::TcpSocket().getRoundTripTime().has_value());
+
+        sender.resetStatistics();
+        CHECK(sender.getStatistics().bytesSent == 0);
+        CHECK(sender.isStatisticsEnabled());
+
+        sender.setStatisticsEnabled(false);
+        REQUIRE(sender.send(small) == sf::Socket::Status::Done);
+        CHECK(sender.getStatistics().packetsSent == 0);
+    }
+
+    SECTION("Compressed packets")
+    {
+        sf::TcpListener listener;
+        REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+        sf::TcpSocket sender;
+        REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+        sf::TcpSocket receiver;
+        REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+        CHECK(!sender.getPacketCompression().enabled);
+
+        // A typical message as the dictionary, so that similar ones compress well
+        const std::string                typical = R"({"type":"move","entity":1000,"x":120,"y":42})";
+        sf::TcpSocket::PacketCompression compression;
+        compression.enabled   = true;
+        compression.threshold = 16;
+        for (const char c : typical)
+            compression.dictionary.push_back(static_cast<std::byte>(c));
+
+        sender.setPacketCompression(compression);
+        receiver.setPacketCompression(compression);
+        CHECK(sender.getPacketCompression().enabled);
+        CHECK(sender.getPacketCompression().dictionary == compression.dictionary);
+
+        SECTION("Send and receive")
+        {
+            sender.setBlocking(false);
+            receiver.setBlocking(false);
+
+            // Compressible and incompressible data, large enough to require partial sends on both ends
+            std::string counting;
+            for (int i = 0; counting.size() < 3 * 1024 * 1024; ++i)
+                counting += std::to_string(i) + ' ';
+
+            std::string   noise(2 * 1024 * 1024, '\0');
+            std::uint32_t state = 1;
+            for (char& c : noise)
+            {
+                state = state * 1664525 + 1013904223;
+                c     = static_cast<char>(state >> 24);
+            }
+
+            const std::string similar = R"({"type":"move","entity":1001,"x":121,"y":42})";
+            for (const std::string& message : {similar, counting, noise, std::string(), std::string("short")})
+            {
+                sf::Packet packet;
+                packet << message;
+
+                sf::Packet         received;
+                sf::Socket::Status sendStatus    = sf::Socket::Status::Partial;
+                sf::Socket::Status receiveStatus = sf::Socket::Status::NotReady;
+                while (receiveStatus != sf::Socket::Status::Done)
+                {
+                    if (sendStatus != sf::Socket::Status::Done)
+                    {
+                        sendStatus = sender.send(packet);
+                        REQUIRE(sendStatus != sf::Socket::Status::Error);
+                    }
+
+                    receiveStatus = receiver.receive(received);
+                    REQUIRE(receiveStatus != sf::Socket::Status::Error);
+                }
+
+                std::string result;
+                CHECK(received >> result);
+                CHECK(result == message);
+                CHECK(received.endOfPacket());
+            }
+        }
+
+        SECTION("Queued packets")
+        {
+            for (int i = 0; i < 10; ++i)
+            {
+                sf::Packet packet;
+                packet << std::string(1000, static_cast<char>('a' + i));
+                sender.queue(packet);
+            }
+
+            // The compressed packets are much smaller than the originals, with their size prefix
+            CHECK(sender.getSendQueueSize() < 10 * 100);
+            CHECK(sender.flush() == sf::Socket::Status::Done);
+
+            std::vector<sf::Packet> packets;
+            while (packets.size() < 10)
+                REQUIRE(receiver.receivePackets(packets) == sf::Socket::Status::Done);
+
+            for (std::size_t i = 0; i < packets.size(); ++i)
+            {
+                std::string result;
+                CHECK(packets[i] >> result);
+                CHECK(result == std::string(1000, static_cast<char>('a' + i)));
+            }
+        }
+
+        SECTION("Peer without compression")
+        {
+            // Compressed packets have the highest bit of their size prefix set
+            receiver.setPacketCompression({});
+
+            sf::Packet packet;
+            packet << std::string(1000, 'x');
+            REQUIRE(sender.send(packet) == sf::Socket::Status::Done);
+
+            std::array<unsigned char, 4> prefix{};
+            std::size_t                  received = 0;
+            REQUIRE(receiver.receive(prefix.data(), prefix.size(), received) == sf::Socket::Status::Done);
+            CHECK(received == prefix.size());
+            CHECK((prefix[0] & 0x80) != 0);
+        }
+
+        SECTION("Corrupted packet")
+        {
+            // Flagged as compressed, announcing 16 bytes, followed by an invalid sequence
+            const std::array<unsigned char, 10> raw{0x80, 0, 0, 6, 0, 0, 0, 16, 0x4F, 0xFF};
+            REQUIRE(sender.send(raw.data(), raw.size()) == sf::Socket::Status::Done);
+
+            sf::Packet packet;
+            CHECK(receiver.receive(packet) == sf::Socket::Status::Error);
+        }
+    }
+}
+
+TEST_CASE("[Network] sf::TcpSocket compression benchmark", "[.benchmark]")
+{
+    // A world snapshot: entities with slowly varying values, as found in level data and state updates
+    sf::Packet snapshot;
+    for (std::int32_t id = 0; id < 4000; ++id)
+        snapshot << id << static_cast<float>(id % 64) * 16.f << 128.f << std::int32_t{100} << (id % 3 == 0);
+
+    // A small update, similar to the dictionary
+    sf::Packet update;
+    update << std::string(R"({"type":"move","entity":1234,"x":56,"y":78})");
+
+    sf::TcpSocket::PacketCompression compression;
+    compression.enabled   = true;
+    compression.threshold = 16;
+
+    sf::TcpSocket::PacketCompression dictionaryCompression = compression;
+    for (const char c : std::string(R"({"type":"move","entity":1000,"x":120,"y":42})"))
+        dictionaryCompression.dictionary.push_back(static_cast<std::byte>(c));
+
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+    sf::TcpSocket sender;
+    REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+    sf::TcpSocket receiver;
+    REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+    // Size of a packet on the wire, with its size prefix
+    const auto wireSize = [](sf::Packet& packet, const sf::TcpSocket::PacketCompression& options)
+    {
+        sf::TcpSocket socket;
+        socket.setPacketCompression(options);
+        socket.queue(packet);
+        return socket.getSendQueueSize();
+    };
+
+    WARN("Bytes on the wire: snapshot " << wireSize(snapshot, {}) << ", compressed " << wireSize(snapshot, compression)
+                                        << "; update " << wireSize(update, {}) << ", compressed "
+                                        << wireSize(update, compression) << ", with a dictionary "
+                                        << wireSize(update, dictionaryCompression));
+
+    // Round trips over the loopback interface, where the bandwidth is free and only the CPU time shows
+    const auto roundTrip = [&](sf::Packet& packet)
+    {
+        sf::Packet received;
+        (void)sender.send(packet);
+        (void)receiver.receive(received);
+        return received.getDataSize();
+    };
+
+    sender.setPacketCompression({});
+    receiver.setPacketCompression({});
+    BENCHMARK("snapshot, uncompressed")
+    {
+        return roundTrip(snapshot);
+    };
+
+    BENCHMARK("update, uncompressed")
+    {
+        return roundTrip(update);
+    };
+
+    sender.setPacketCompression(compression);
+    receiver.setPacketCompression(compression);
+    BENCHMARK("snapshot, compressed")
+    {
+        return roundTrip(snapshot);
+    };
+
+    sender.setPacketCompression(dictionaryCompression);
+    receiver.setPacketCompression(dictionaryCompression);
+    BENCHMARK("update, with a dictionary")
+    {
+        return roundTrip(update);
+    };
+}
+
+TEST_CASE("[Network] sf::TcpSocket loopback benchmark", "[.benchmark]")
+{
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+    sf::TcpSocket sender;
+    REQUIRE(sender.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) == sf::Socket::Status::Done);
+
+    sf::TcpSocket receiver;
+    REQUIRE(listener.accept(receiver) == sf::Socket::Status::Done);
+
+    // Small messages going back and forth, where the latency of the calls shows
+    std::array<std::byte, 64> message{};
+    std::array<std::byte, 64> buffer{};
+
+    const auto receiveAll = [&](sf::TcpSocket& socket)
+    {
+        std::size_t received = 0;
+        for (std::size_t total = 0; total < buffer.size(); total += received)
+        {
+            if (socket.receive(buffer.data() + total, buffer.size() - total, received) != sf::Socket::Status::Done)
+                return total;
+        }
+
+        return buffer.size();
+    };
+
+    const auto rawRoundTrip = [&]
+    {
+        (void)sender.send(message.data(), message.size());
+        (void)receiveAll(receiver);
+        (void)receiver.send(buffer.data(), buffer.size());
+        return receiveAll(sender);
+    };
+
+    sf::Packet smallPacket;
+    smallPacket.append(message.data(), message.size());
+    sf::Packet receivedPacket;
+    const auto packetRoundTrip = [&]
+    {
+        (void)sender.send(smallPacket);
+        (void)receiver.receive(receivedPacket);
+        (void)receiver.send(receivedPacket);
+        (void)sender.receive(receivedPacket);
+        return receivedPacket.getDataSize();
+    };
+
+    reportLatencies("tcp raw round trip, 64 B", 10'000, [&] { (void)rawRoundTrip(); });
+    reportLatencies("tcp packet round trip, 64 B", 10'000, [&] { (void)packetRoundTrip(); });
+
+    BENCHMARK("raw round trip, 64 B")
+    {
+        return rawRoundTrip();
+    };
+
+    BENCHMARK("packet round trip, 64 B")
+    {
+        return packetRoundTrip();
+    };
+
+    // Large transfers, sending and receiving in turn without blocking so that neither side waits for the other
+    sender.setBlocking(false);
+    receiver.setBlocking(false);
+    const auto isPending = [](sf::Socket::Status status)
+    { return (status == sf::Socket::Status::NotReady) || (status == sf::Socket::Status::Partial); };
+
+    std::vector<std::byte> block(1024 * 1024);
+    std::vector<std::byte> sink(64 * 1024);
+    BENCHMARK("raw transfer, 1 MiB")
+    {
+        std::size_t        sent          = 0;
+        std::size_t        received      = 0;
+        sf::Socket::Status receiveStatus = sf::Socket::Status::NotReady;
+        while ((received < block.size()) && (isPending(receiveStatus) || (receiveStatus == sf::Socket::Status::Done)))
+        {
+            std::size_t count = 0;
+            if (sent < block.size())
+                (void)sender.send(block.data() + sent, block.size() - sent, count);
+            sent += count;
+
+            receiveStatus = receiver.receive(sink.data(), sink.size(), count);
+            received += count;
+        }
+
+        return received;
+    };
+
+    sf::Packet largePacket;
+    largePacket.append(block.data(), block.size());
+    BENCHMARK("packet transfer, 1 MiB")
+    {
+        sf::Socket::Status sendStatus    = sf::Socket::Status::NotReady;
+        sf::Socket::Status receiveStatus = sf::Socket::Status::NotReady;
+        while (isPending(receiveStatus) && (isPending(sendStatus) || (sendStatus == sf::Socket::Status::Done)))
+        {
+            if (sendStatus != sf::Socket::Status::Done)
+                sendStatus = sender.send(largePacket);
+
+            receiveStatus = receiver.receive(receivedPacket);
+        }
+
+        return receivedPacket.getDataSize();
+    };
 }
@@ -0,0 +1,279 @@
+#include <SFML/Network/TlsSocket.hpp>
+
+// Other 1st party headers
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsContext.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+std::string loadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+std::optional<sf::TlsContext> createServerContext()
+{
+    return sf::TlsContext::createServer(loadFile("Network/tls-certificate.pem"), loadFile("Network/tls-key.pem"));
+}
+
+std::optional<sf::TlsContext> createClientContext()
+{
+    std::optional<sf::TlsContext> context = sf::TlsContext::createClient();
+    if (context && !context->addTrustedCertificates(loadFile("Network/tls-certificate.pem")))
+        return std::nullopt;
+
+    return context;
+}
+} // namespace
+
+TEST_CASE("[Network] sf::TlsSocket")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_default_constructible_v<sf::TlsSocket>);
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::TlsSocket>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::TlsSocket>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::TlsSocket>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::TlsSocket>);
+
+        STATIC_CHECK(!std::is_default_constructible_v<sf::TlsContext>);
+        STATIC_CHECK(std::is_copy_constructible_v<sf::TlsContext>);
+        STATIC_CHECK(std::is_copy_assignable_v<sf::TlsContext>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::TlsContext>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::TlsContext>);
+    }
+
+    SECTION("Invalid contexts")
+    {
+        CHECK(!sf::TlsContext::createServer("", ""));
+        CHECK(!sf::TlsContext::createServer(loadFile("Network/tls-certificate.pem"), ""));
+
+        if (auto context = sf::TlsContext::createClient())
+            CHECK(!context->addTrustedCertificates("not a certificate"));
+    }
+
+#ifndef SFML_USE_OPENSSL
+    // Without TLS support, the contexts can't be created
+    CHECK(!createServerContext());
+    CHECK(!createClientContext());
+    SKIP("TLS support is not enabled");
+#endif
+
+    auto serverContext = createServerContext();
+    auto clientContext = createClientContext();
+    REQUIRE(serverContext);
+    REQUIRE(clientContext);
+
+    sf::TcpListener listener;
+    REQUIRE(listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+    SECTION("Data and packets")
+    {
+        sf::TlsSocket      server(*serverContext);
+        sf::Socket::Status serverStatus = sf::Socket::Status::Error;
+        std::thread        thread([&] { serverStatus = server.accept(listener); });
+
+        sf::TlsSocket client(*clientContext);
+        CHECK(client.connect("localhost", listener.getLocalPort()) == sf::Socket::Status::Done);
+        thread.join();
+        REQUIRE(serverStatus == sf::Socket::Status::Done);
+        CHECK(!client.isSessionResumed());
+
+        // Raw data
+        const std::string message = "Hello over TLS";
+        REQUIRE(client.send(message.data(), message.size()) == sf::Socket::Status::Done);
+
+        std::string received(message.size(), '\0');
+        std::size_t total = 0;
+        while (total < message.size())
+        {
+            std::size_t count = 0;
+            REQUIRE(server.receive(received.data() + total, received.size() - total, count) ==
+                    sf::Socket::Status::Done);
+            total += count;
+        }
+        CHECK(received == message);
+
+        // Packets, small and spanning many records, in both directions
+        std::vector<std::uint32_t> values(100'000);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<std::uint32_t>(i * 7);
+
+        sf::Packet small;
+        small << std::uint32_t{42} << "small";
+        sf::Packet large;
+        for (const std::uint32_t value : values)
+            large << value;
+
+        thread = std::thread(
+            [&]
+            {
+                if (server.send(small) == sf::Socket::Status::Done)
+                    serverStatus = server.send(large);
+            });
+
+        sf::Packet    packet;
+        std::uint32_t number = 0;
+        std::string   text;
+        REQUIRE(client.receive(packet) == sf::Socket::Status::Done);
+        CHECK((packet >> number >> text));
+        CHECK(number == 42);
+        CHECK(text == "small");
+
+        REQUIRE(client.receive(packet) == sf::Socket::Status::Done);
+        CHECK(packet.getDataSize() == values.size() * sizeof(std::uint32_t));
+        bool same = true;
+        for (const std::uint32_t value : values)
+            same = same && (packet >> number) && (number == value);
+        CHECK(same);
+        thread.join();
+        CHECK(serverStatus == sf::Socket::Status::Done);
+
+        // Closing the connection is seen by the peer
+        client.disconnect();
+        CHECK(server.receive(packet) == sf::Socket::Status::Disconnected);
+    }
+
+    SECTION("Non-blocking")
+    {
+        sf::TlsSocket server(*serverContext);
+        server.getTcpSocket().setBlocking(false);
+        sf::TlsSocket client(*clientContext);
+        client.getTcpSocket().setBlocking(false);
+
+        REQUIRE(client.connect({sf::IpAddress::LocalHost}, listener.getLocalPort(), "localhost", sf::seconds(5)) ==
+                sf::Socket::Status::NotReady);
+
+        sf::Socket::Status serverStatus = server.accept(listener);
+        sf::Socket::Status clientStatus = sf::Socket::Status::NotReady;
+        while ((serverStatus == sf::Socket::Status::NotReady) || (clientStatus == sf::Socket::Status::NotReady))
+        {
+            if (serverStatus == sf::Socket::Status::NotReady)
+                serverStatus = server.handshake();
+            if (clientStatus == sf::Socket::Status::NotReady)
+                clientStatus = client.handshake();
+        }
+        REQUIRE(serverStatus == sf::Socket::Status::Done);
+        REQUIRE(clientStatus == sf::Socket::Status::Done);
+
+        // A large packet is sent in several calls, while the receiver makes room for it
+        sf::Packet sent;
+        for (std::uint32_t i = 0; i < 1'000'000; ++i)
+            sent << i;
+
+        sf::Packet         packet;
+        sf::Socket::Status sendStatus    = sf::Socket::Status::NotReady;
+        sf::Socket::Status receiveStatus = sf::Socket::Status::NotReady;
+        bool               partial       = false;
+        while ((sendStatus != sf::Socket::Status::Done) || (receiveStatus != sf::Socket::Status::Done))
+        {
+            if (sendStatus != sf::Socket::Status::Done)
+                sendStatus = client.send(sent);
+            partial = partial || (sendStatus == sf::Socket::Status::Partial);
+            REQUIRE(((sendStatus == sf::Socket::Status::Done) || (sendStatus == sf::Socket::Status::Partial) ||
+                     (sendStatus == sf::Socket::Status::NotReady)));
+
+            if (receiveStatus != sf::Socket::Status::Done)
+                receiveStatus = server.receive(packet);
+            REQUIRE(((receiveStatus == sf::Socket::Status::Done) || (receiveStatus == sf::Socket::Status::NotReady)));
+        }
+        CHECK(partial);
+        CHECK(packet.getDataSize() == sent.getDataSize());
+        bool same = true;
+        for (std::uint32_t i = 0; i < 1'000'000; ++i)
+        {
+            std::uint32_t value = 0;
+            same                = same && (packet >> value) && (value == i);
+        }
+        CHECK(same);
+    }
+
+    SECTION("Session resumption")
+    {
+        for (const bool resumed : {false, true})
+        {
+            sf::TlsSocket server(*serverContext);
+            std::thread   thread(
+                [&]
+                {
+                    sf::Packet packet;
+                    packet << "ping";
+                    if (server.accept(listener) == sf::Socket::Status::Done)
+                        (void)server.send(packet);
+                });
+
+            // Exchanging data lets the client get the session from the server
+            sf::TlsSocket client(*clientContext);
+            CHECK(client.connect({sf::IpAddress::LocalHost}, listener.getLocalPort(), "www.sfml.test") ==
+                  sf::Socket::Status::Done);
+            sf::Packet packet;
+            CHECK(client.receive(packet) == sf::Socket::Status::Done);
+            CHECK(client.isSessionResumed() == resumed);
+            thread.join();
+        }
+
+        // Without its cache, the client starts a new session
+        clientContext->clearSessionCache();
+        sf::TlsSocket server(*serverContext);
+        std::thread   thread([&] { (void)server.accept(listener); });
+        sf::TlsSocket client(*clientContext);
+        CHECK(client.connect({sf::IpAddress::LocalHost}, listener.getLocalPort(), "www.sfml.test") ==
+              sf::Socket::Status::Done);
+        CHECK(!client.isSessionResumed());
+        thread.join();
+    }
+
+    SECTION("Certificate verification")
+    {
+        // The certificate is not trusted by the system, and doesn't match other names
+        auto untrusted = sf::TlsContext::createClient();
+        REQUIRE(untrusted);
+
+        for (const auto& [context, name] : {std::pair(*untrusted, "localhost"), std::pair(*clientContext, "sfml.test")})
+        {
+            sf::TlsSocket server(*serverContext);
+            std::thread   thread([&] { (void)server.accept(listener); });
+
+            sf::TlsSocket client(context);
+            CHECK(client.connect({sf::IpAddress::LocalHost}, listener.getLocalPort(), name) ==
+                  sf::Socket::Status::Error);
+            client.disconnect();
+            thread.join();
+        }
+
+        // Unless verification is disabled
+        untrusted->setPeerVerification(false);
+        sf::TlsSocket server(*serverContext);
+        std::thread   thread([&] { (void)server.accept(listener); });
+        sf::TlsSocket client(*untrusted);
+        CHECK(client.connect("localhost", listener.getLocalPort()) == sf::Socket::Status::Done);
+        thread.join();
+    }
+
+    SECTION("Roles")
+    {
+        sf::TlsSocket server(*serverContext);
+        CHECK(server.connect("localhost", listener.getLocalPort()) == sf::Socket::Status::Error);
+        sf::TlsSocket client(*clientContext);
+        CHECK(client.accept(listener) == sf::Socket::Status::Error);
+    }
+}
@@ -0,0 +1,228 @@
+#include <SFML/Network/UdpConnection.hpp>
+
+// Other 1st party headers
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+// Update both ends until the condition holds, or give up after a few seconds
+template <typename Condition>
+bool pump(sf::UdpConnection& first, sf::UdpConnection& second, Condition condition)
+{
+    const sf::Clock clock;
+    while (clock.getElapsedTime() < sf::seconds(10))
+    {
+        if ((first.update() == sf::Socket::Status::Error) || (second.update() == sf::Socket::Status::Error))
+            return false;
+
+        if (condition())
+            return true;
+
+        sf::sleep(sf::milliseconds(1));
+    }
+
+    return false;
+}
+} // namespace
+
+TEST_CASE("[Network] sf::UdpConnection")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::UdpConnection>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::UdpConnection>);
+        STATIC_CHECK(std::is_nothrow_move_constructible_v<sf::UdpConnection>);
+        STATIC_CHECK(std::is_nothrow_move_assignable_v<sf::UdpConnection>);
+    }
+
+    sf::UdpSocket clientSocket;
+    sf::UdpSocket serverSocket;
+    REQUIRE(clientSocket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+    REQUIRE(serverSocket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+
+    sf::UdpConnection client(clientSocket, sf::IpAddress::LocalHost, serverSocket.getLocalPort());
+    sf::UdpConnection server(serverSocket, sf::IpAddress::LocalHost, clientSocket.getLocalPort());
+
+    SECTION("Construction")
+    {
+        CHECK(client.getRemoteAddress() == sf::IpAddress::LocalHost);
+        CHECK(client.getRemotePort() == serverSocket.getLocalPort());
+        CHECK(client.getChannelDelivery(0) == sf::UdpConnection::Delivery::ReliableOrdered);
+        CHECK(client.getChannelDelivery(sf::UdpConnection::MaxChannels - 1) ==
+              sf::UdpConnection::Delivery::ReliableOrdered);
+        CHECK(client.getRoundTripTime() > sf::Time::Zero);
+        CHECK(client.getPendingReliableCount() == 0);
+
+        sf::Packet  packet;
+        std::size_t channel = 0;
+        CHECK(client.receive(packet, channel) == sf::Socket::Status::NotReady);
+    }
+
+    SECTION("send()")
+    {
+        sf::Packet packet;
+        packet << 1;
+        CHECK(client.send(packet, sf::UdpConnection::MaxChannels) == sf::Socket::Status::Error);
+
+        std::vector<std::byte> tooLarge(sf::UdpConnection::MaxMessageSize + 1);
+        packet.clear();
+        packet.append(tooLarge.data(), tooLarge.size());
+        CHECK(client.send(packet) == sf::Socket::Status::Error);
+        CHECK(client.getPendingReliableCount() == 0);
+    }
+
+    SECTION("Reliable messages")
+    {
+        client.setChannelDelivery(1, sf::UdpConnection::Delivery::ReliableUnordered);
+
+        for (std::int32_t i = 0; i < 100; ++i)
+        {
+            sf::Packet packet;
+            packet << i;
+            REQUIRE(client.send(packet, 0) == sf::Socket::Status::Done);
+            REQUIRE(client.send(packet, 1) == sf::Socket::Status::Done);
+        }
+
+        // A large message is fragmented and reassembled
+        std::vector<std::uint8_t> large(100'000);
+        for (std::size_t i = 0; i < large.size(); ++i)
+            large[i] = static_cast<std::uint8_t>(i * 7);
+
+        sf::Packet packet;
+        packet.append(large.data(), large.size());
+        REQUIRE(client.send(packet, 2) == sf::Socket::Status::Done);
+        CHECK(client.getPendingReliableCount() == 201);
+
+        std::array<std::vector<std::int32_t>, 3> received;
+        const auto                               receiveAll = [&]
+        {
+            std::size_t channel = 0;
+            while (server.receive(packet, channel) == sf::Socket::Status::Done)
+            {
+                if (channel == 2)
+                {
+                    CHECK(packet.getDataSize() == large.size());
+                    CHECK(std::memcmp(packet.getData(), large.data(), large.size()) == 0);
+                    received[2].push_back(0);
+                    continue;
+                }
+
+                std::int32_t value = 0;
+                CHECK(packet >> value);
+                received[channel].push_back(value);
+            }
+
+            return (received[0].size() == 100) && (received[1].size() == 100) && (received[2].size() == 1) &&
+                   (client.getPendingReliableCount() == 0);
+        };
+        REQUIRE(pump(client, server, receiveAll));
+
+        for (std::int32_t i = 0; i < 100; ++i)
+            CHECK(received[0][static_cast<std::size_t>(i)] == i);
+    }
+
+    SECTION("Largest message")
+    {
+        std::vector<std::uint8_t> largest(sf::UdpConnection::MaxMessageSize);
+        for (std::size_t i = 0; i < largest.size(); ++i)
+            largest[i] = static_cast<std::uint8_t>(i * 13);
+
+        sf::Packet packet;
+        packet.append(largest.data(), largest.size());
+        REQUIRE(client.send(packet) == sf::Socket::Status::Done);
+
+        // The fragments are sent a window at a time, so neither the peer nor the acknowledgements get flooded
+        bool       received   = false;
+        const auto receiveAll = [&]
+        {
+            std::size_t channel = 0;
+            if (server.receive(packet, channel) == sf::Socket::Status::Done)
+            {
+                CHECK(packet.getDataSize() == largest.size());
+                CHECK(std::memcmp(packet.getData(), largest.data(), largest.size()) == 0);
+                received = true;
+            }
+
+            return received && (client.getPendingReliableCount() == 0);
+        };
+        REQUIRE(pump(client, server, receiveAll));
+    }
+
+    SECTION("Simulated network")
+    {
+        sf::UdpConnection::Simulation simulation;
+        simulation.packetLoss = 0.2f;
+        simulation.duplicates = 0.1f;
+        simulation.latency    = sf::milliseconds(5);
+        simulation.jitter     = sf::milliseconds(10);
+        client.setSimulation(simulation);
+        server.setSimulation(simulation);
+        client.setChannelDelivery(1, sf::UdpConnection::Delivery::Unreliable);
+
+        for (std::int32_t i = 0; i < 500; ++i)
+        {
+            sf::Packet packet;
+            packet << i;
+            REQUIRE(client.send(packet, static_cast<std::size_t>(i % 2)) == sf::Socket::Status::Done);
+        }
+
+        std::vector<std::int32_t> reliable;
+        std::vector<std::int32_t> unreliable;
+        const auto                receiveAll = [&]
+        {
+            sf::Packet   packet;
+            std::size_t  channel = 0;
+            std::int32_t value   = 0;
+            while (server.receive(packet, channel) == sf::Socket::Status::Done)
+            {
+                CHECK(packet >> value);
+                (channel == 0 ? reliable : unreliable).push_back(value);
+            }
+
+            return (reliable.size() == 250) && (client.getPendingReliableCount() == 0);
+        };
+        REQUIRE(pump(client, server, receiveAll));
+
+        // Reliable messages all arrive in order, unreliable ones are lost but never duplicated
+        for (std::size_t i = 0; i < reliable.size(); ++i)
+            CHECK(reliable[i] == static_cast<std::int32_t>(i * 2));
+
+        CHECK(unreliable.size() < 250);
+        for (const std::int32_t value : unreliable)
+        {
+            CHECK(value % 2 == 1);
+            CHECK(std::count(unreliable.begin(), unreliable.end(), value) == 1);
+        }
+
+        CHECK(client.getRoundTripTime() >= sf::milliseconds(5));
+    }
+
+    SECTION("handleDatagram()")
+    {
+        // Malformed datagrams are ignored
+        const std::array<std::uint8_t, 12> garbage{0, 1, 0, 0, 0, 0, 0, 0, 0xFF, 0, 0, 0};
+        server.handleDatagram(garbage.data(), garbage.size());
+        server.handleDatagram(garbage.data(), 3);
+        server.handleDatagram(nullptr, 0);
+
+        sf::Packet  packet;
+        std::size_t channel = 0;
+        CHECK(server.receive(packet, channel) == sf::Socket::Status::NotReady);
+    }
+}
@@ -1,8 +1,16 @@
 #include <SFML/Network/UdpSocket.hpp>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <SystemUtil.hpp>
+#include <array>
+#include <optional>
+#include <string>
 #include <type_traits>
+#include <vector>
+
+#include <cstddef>
 
 TEST_CASE("[Network] sf::UdpSocket")
 {
@@ -35,4 +43,167 @@ TEST_CASE("[Network] sf::UdpSocket")
         udpSocket.unbind();
         CHECK(udpSocket.getLocalPort() == 0);
     }
+
+    SECTION("IPv6")
+    {
+        // A socket bound to an IPv6 address also exchanges with IPv4 peers
+        sf::UdpSocket receiver;
+        REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::AnyV6) == sf::Socket::Status::Done);
+
+        for (const sf::IpAddress& address : {sf::IpAddress::LocalHostV6, sf::IpAddress::LocalHost})
+        {
+            sf::UdpSocket sender;
+            REQUIRE(sender.send("ping", 4, address, receiver.getLocalPort()) == sf::Socket::Status::Done);
+
+            std::array<char, 16>         buffer{};
+            std::size_t                  received = 0;
+            std::optional<sf::IpAddress> remoteAddress;
+            unsigned short               remotePort = 0;
+            REQUIRE(receiver.receive(buffer.data(), buffer.size(), received, remoteAddress, remotePort) ==
+                    sf::Socket::Status::Done);
+            CHECK(std::string(buffer.data(), received) == "ping");
+            CHECK(remoteAddress == address);
+            CHECK(remotePort == sender.getLocalPort());
+
+            REQUIRE(receiver.send("pong", 4, *remoteAddress, remotePort) == sf::Socket::Status::Done);
+            REQUIRE(sender.receive(buffer.data(), buffer.size(), received, remoteAddress, remotePort) ==
+                    sf::Socket::Status::Done);
+            CHECK(std::string(buffer.data(), received) == "pong");
+        }
+    }
+
+    SECTION("sendBatch()/receiveBatch()")
+    {
+        sf::UdpSocket receiver;
+        REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+        receiver.setBlocking(false);
+
+        std::array<char, 16>                           buffer{};
+        std::array<sf::UdpSocket::IncomingDatagram, 1> single{};
+        single[0].data     = buffer.data();
+        single[0].capacity = buffer.size();
+
+        std::size_t received = 0;
+        CHECK(receiver.receiveBatch(single.data(), single.size(), received) == sf::Socket::Status::NotReady);
+        CHECK(received == 0);
+
+        // Equally sized datagrams to the same peer, which may be grouped for segmentation offload,
+        // followed by a shorter one and one of a different size
+        std::array<std::array<char, 100>, 8>           payloads{};
+        std::array<sf::UdpSocket::OutgoingDatagram, 8> outgoing{};
+        for (std::size_t i = 0; i < outgoing.size(); ++i)
+        {
+            payloads[i].fill(static_cast<char>('a' + i));
+            const std::size_t size = i < 5 ? 100 : (i == 5 ? 10 : 50);
+            outgoing[i]            = {payloads[i].data(), size, sf::IpAddress::LocalHost, receiver.getLocalPort()};
+        }
+
+        sf::UdpSocket sender;
+        sender.setStatisticsEnabled(true);
+        receiver.setStatisticsEnabled(true);
+
+        std::size_t sent = 0;
+        REQUIRE(sender.sendBatch(outgoing.data(), outgoing.size(), sent) == sf::Socket::Status::Done);
+        CHECK(sent == outgoing.size());
+
+        std::array<std::array<char, 200>, 10>           buffers{};
+        std::array<sf::UdpSocket::IncomingDatagram, 10> incoming{};
+        for (std::size_t i = 0; i < incoming.size(); ++i)
+        {
+            incoming[i].data     = buffers[i].data();
+            incoming[i].capacity = buffers[i].size();
+        }
+
+        std::size_t total = 0;
+        while (total < outgoing.size())
+        {
+            const auto status = receiver.receiveBatch(incoming.data() + total, incoming.size() - total, received);
+            REQUIRE(status != sf::Socket::Status::Error);
+            total += received;
+        }
+
+        REQUIRE(total == outgoing.size());
+        for (std::size_t i = 0; i < outgoing.size(); ++i)
+        {
+            CHECK(incoming[i].size == outgoing[i].size);
+            CHECK(incoming[i].remoteAddress == sf::IpAddress::LocalHost);
+            CHECK(incoming[i].remotePort == sender.getLocalPort());
+            CHECK(buffers[i][0] == static_cast<char>('a' + i));
+            CHECK(buffers[i][incoming[i].size - 1] == static_cast<char>('a' + i));
+        }
+
+        CHECK(sender.getStatistics().packetsSent == 8);
+        CHECK(sender.getStatistics().bytesSent == 610);
+        CHECK(sender.getStatistics().sentSizes[0] == 3);
+        CHECK(sender.getStatistics().sentSizes[1] == 5);
+        CHECK(receiver.getStatistics().packetsReceived == 8);
+        CHECK(receiver.getStatistics().bytesReceived == 610);
+    }
+}
+
+TEST_CASE("[Network] sf::UdpSocket loopback benchmark", "[.benchmark]")
+{
+    // Send bursts of small datagrams over the loopback interface and receive all of them,
+    // keeping bursts small enough to fit in the default receive buffer of the system
+    constexpr std::size_t burstSize    = 64;
+    constexpr std::size_t datagramSize = 64;
+
+    sf::UdpSocket receiver;
+    REQUIRE(receiver.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) == sf::Socket::Status::Done);
+    sf::UdpSocket sender;
+
+    const unsigned short port = receiver.getLocalPort();
+
+    std::vector<std::byte>                       payload(datagramSize);
+    std::vector<std::byte>                       buffers(burstSize * datagramSize);
+    std::vector<sf::UdpSocket::OutgoingDatagram> outgoing(burstSize);
+    std::vector<sf::UdpSocket::IncomingDatagram> incoming(burstSize);
+    for (std::size_t i = 0; i < burstSize; ++i)
+    {
+        outgoing[i] = {payload.data(), datagramSize, sf::IpAddress::LocalHost, port};
+        incoming[i].data     = buffers.data() + i * datagramSize;
+        incoming[i].capacity = datagramSize;
+    }
+
+    BENCHMARK("single")
+    {
+        std::optional<sf::IpAddress> address;
+        unsigned short               remotePort = 0;
+        std::size_t                  received   = 0;
+        for (std::size_t i = 0; i < burstSize; ++i)
+            (void)sender.send(payload.data(), payload.size(), sf::IpAddress::LocalHost, port);
+        for (std::size_t i = 0; i < burstSize; ++i)
+            (void)receiver.receive(buffers.data(), datagramSize, received, address, remotePort);
+        return received;
+    };
+
+    BENCHMARK("batch")
+    {
+        std::size_t sent     = 0;
+        std::size_t received = 0;
+        (void)sender.sendBatch(outgoing.data(), outgoing.size(), sent);
+        for (std::size_t total = 0; total < sent; total += received)
+            (void)receiver.receiveBatch(incoming.data() + total, incoming.size() - total, received);
+        return sent;
+    };
+
+    // A datagram sent back and forth, where the latency of the calls shows
+    const auto roundTrip = [&]
+    {
+        std::optional<sf::IpAddress> address;
+        unsigned short               remotePort = 0;
+        std::size_t                  received   = 0;
+        (void)sender.send(payload.data(), payload.size(), sf::IpAddress::LocalHost, port);
+        (void)receiver.receive(buffers.data(), datagramSize, received, address, remotePort);
+        (void)receiver.send(buffers.data(), received, sf::IpAddress::LocalHost, remotePort);
+        (void)sender.receive(buffers.data(), datagramSize, received, address, remotePort);
+        return received;
+    };
+
+    reportLatencies("udp round trip, " + std::to_string(datagramSize) + " B", 10'000, [&] { (void)roundTrip(); });
+
+    BENCHMARK("round trip")
+    {
+        return roundTrip();
+    };
 }
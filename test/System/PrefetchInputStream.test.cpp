@@ -0,0 +1,122 @@
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/PrefetchInputStream.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace
+{
+class FailingInputStream : public sf::InputStream
+{
+public:
+    std::optional<std::size_t> read(void*, std::size_t) override
+    {
+        return std::nullopt;
+    }
+
+    std::optional<std::size_t> seek(std::size_t position) override
+    {
+        return position;
+    }
+
+    std::optional<std::size_t> tell() override
+    {
+        return 0;
+    }
+
+    std::optional<std::size_t> getSize() override
+    {
+        return 100;
+    }
+};
+} // namespace
+
+TEST_CASE("[System] sf::PrefetchInputStream")
+{
+    SECTION("Type traits")
+    {
+        STATIC_CHECK(!std::is_copy_constructible_v<sf::PrefetchInputStream>);
+        STATIC_CHECK(!std::is_copy_assignable_v<sf::PrefetchInputStream>);
+        STATIC_CHECK(!std::is_nothrow_move_constructible_v<sf::PrefetchInputStream>);
+        STATIC_CHECK(!std::is_nothrow_move_assignable_v<sf::PrefetchInputStream>);
+    }
+
+    using namespace std::literals::string_view_literals;
+
+    static constexpr auto   input = "We Love SFML, and we read it ahead of time!"sv;
+    sf::MemoryInputStream   memoryInputStream(input.data(), input.size());
+    sf::PrefetchInputStream prefetchInputStream(memoryInputStream, 8);
+    std::array<char, 64>    output{};
+
+    SECTION("Construction")
+    {
+        CHECK(prefetchInputStream.tell().value() == 0);
+        CHECK(prefetchInputStream.getSize().value() == input.size());
+        CHECK(prefetchInputStream.getStatistics().windowSize == 8);
+    }
+
+    SECTION("read()")
+    {
+        CHECK(prefetchInputStream.read(output.data(), 7).value() == 7);
+        CHECK(std::string_view(output.data(), 7) == "We Love"sv);
+        CHECK(prefetchInputStream.tell().value() == 7);
+
+        // Read more than the window size
+        CHECK(prefetchInputStream.read(output.data(), 20).value() == 20);
+        CHECK(std::string_view(output.data(), 20) == " SFML, and we read i"sv);
+
+        // Read beyond input
+        CHECK(prefetchInputStream.read(output.data(), 100).value() == input.size() - 27);
+        CHECK(std::string_view(output.data(), input.size() - 27) == "t ahead of time!"sv);
+        CHECK(prefetchInputStream.read(output.data(), 100).value() == 0);
+
+        const auto statistics = prefetchInputStream.getStatistics();
+        CHECK(statistics.fetchedSize == input.size());
+        CHECK(statistics.bufferedSize == 0);
+        CHECK(statistics.endOfStream);
+        CHECK(!statistics.error);
+        CHECK(prefetchInputStream.isAvailable(100));
+    }
+
+    SECTION("seek()")
+    {
+        SECTION("Within window")
+        {
+            CHECK(prefetchInputStream.read(output.data(), 5).value() == 5);
+            CHECK(prefetchInputStream.seek(3).value() == 3);
+            CHECK(prefetchInputStream.read(output.data(), 4).value() == 4);
+            CHECK(std::string_view(output.data(), 4) == "Love"sv);
+        }
+
+        SECTION("Outside of window")
+        {
+            CHECK(prefetchInputStream.seek(29).value() == 29);
+            CHECK(prefetchInputStream.tell().value() == 29);
+            CHECK(prefetchInputStream.read(output.data(), 5).value() == 5);
+            CHECK(std::string_view(output.data(), 5) == "ahead"sv);
+
+            CHECK(prefetchInputStream.seek(0).value() == 0);
+            CHECK(prefetchInputStream.read(output.data(), 2).value() == 2);
+            CHECK(std::string_view(output.data(), 2) == "We"sv);
+        }
+
+        SECTION("Beyond input")
+        {
+            CHECK(prefetchInputStream.seek(1'000).value() == input.size());
+            CHECK(prefetchInputStream.tell().value() == input.size());
+            CHECK(prefetchInputStream.read(output.data(), 5).value() == 0);
+        }
+    }
+
+    SECTION("Source error")
+    {
+        FailingInputStream      failingInputStream;
+        sf::PrefetchInputStream failingPrefetchInputStream(failingInputStream);
+        CHECK(!failingPrefetchInputStream.read(output.data(), 5).has_value());
+        CHECK(failingPrefetchInputStream.getStatistics().error);
+    }
+}
@@ -1,17 +1,22 @@
 #include <SFML/System/Angle.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
 
 #include <catch2/catch_approx.hpp>
+#include <catch2/catch_message.hpp>
 
 #include <SystemUtil.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <sstream>
 
 #include <cassert>
+#include <cstdlib>
 
 
 namespace sf
@@ -92,3 +97,46 @@ std::vector<std::byte> loadIntoMemory(const std::filesystem::path& path)
     assert(result);
     return buffer;
 }
+
+void reportLatencies(const std::string& name, std::size_t count, const std::function<void()>& operation)
+{
+    if (count == 0)
+    {
+        WARN(name << ": no samples");
+        return;
+    }
+
+    std::vector<sf::Time> samples;
+    samples.reserve(count);
+    sf::Clock clock;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        clock.restart();
+        operation();
+        samples.push_back(clock.getElapsedTime());
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&](std::size_t rank) { return samples[(samples.size() - 1) * rank / 100]; };
+
+    WARN(name << ": p50 " << percentile(50) << ", p90 " << percentile(90) << ", p99 " << percentile(99) << ", max "
+              << samples.back());
+
+    const char* path = std::getenv("SFML_BENCHMARK_LATENCY_FILE");
+    if (!path)
+        return;
+
+    std::string escapedName;
+    for (const char character : name)
+    {
+        if ((character == '"') || (character == '\\'))
+            escapedName += '\\';
+        escapedName += character;
+    }
+
+    std::ofstream file(path, std::ios::app);
+    file << R"({"name": ")" << escapedName << R"(", "samples": )" << samples.size()
+         << R"(, "p50_us": )" << percentile(50).asMicroseconds() << R"(, "p90_us": )" << percentile(90).asMicroseconds()
+         << R"(, "p99_us": )" << percentile(99).asMicroseconds() << R"(, "max_us": )" << samples.back().asMicroseconds()
+         << "}\n";
+}
@@ -6,7 +6,9 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <iosfwd>
+#include <string>
 #include <vector>
 
 #include <cstddef>
@@ -64,3 +66,14 @@ std::ostream& operator<<(std::ostream& os, const Approx<T>& approx)
 }
 
 [[nodiscard]] std::vector<std::byte> loadIntoMemory(const std::filesystem::path& path);
+
+////////////////////////////////////////////////////////////
+/// Time \a count calls of \a operation and report the
+/// percentiles of their durations, which show the tail
+/// latency that the mean of a benchmark hides.
+/// They are printed as a warning ("p50 12us, p90 15us,
+/// p99 31us, max 120us"), and appended as a JSON line to the
+/// file named by the SFML_BENCHMARK_LATENCY_FILE environment
+/// variable, if set, so that they can be tracked across versions.
+////////////////////////////////////////////////////////////
+void reportLatencies(const std::string& name, std::size_t count, const std::function<void()>& operation);